@@ -0,0 +1,92 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_ARROW_READ_RESULT_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_ARROW_READ_RESULT_H
+
+#include "google/cloud/bigquery/read_stream.h"
+#include "google/cloud/bigquery/row_set.h"
+#include "google/cloud/bigquery/version.h"
+#include "google/cloud/optional.h"
+#include "google/cloud/status_or.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace BIGQUERY_CLIENT_NS {
+
+// A record batch as returned by the service, serialized as an Arrow IPC
+// message. Applications can decode it with any Arrow implementation, using the
+// schema in `ArrowReadSession`.
+struct ArrowRecordBatch {
+  std::string serialized_record_batch;
+  std::int64_t row_count;
+};
+
+// The result of `bigquery::Client::ParallelReadArrow()`.
+//
+// `serialized_schema` is the Arrow schema of the table, serialized as an Arrow
+// IPC message. All the record batches read from `streams` use this schema.
+struct ArrowReadSession {
+  std::string serialized_schema;
+  std::vector<ReadStream> streams;
+};
+
+namespace internal {
+
+class ArrowReadResultSource {
+ public:
+  virtual ~ArrowReadResultSource() = default;
+  virtual StatusOr<optional<ArrowRecordBatch>> NextBatch() = 0;
+  virtual double FractionConsumed() = 0;
+};
+
+}  // namespace internal
+
+// Represents the result of a read operation returning Arrow record batches.
+//
+// The record batches are returned as they arrive, without decoding the rows.
+// Note that at most one pass can be made over the data.
+class ArrowReadResult {
+ public:
+  ArrowReadResult() = default;
+  explicit ArrowReadResult(
+      std::unique_ptr<internal::ArrowReadResultSource> source)
+      : source_(std::move(source)) {}
+
+  // Returns a `RowSet` which can be used to iterate through the record batches
+  // presented by this object.
+  RowSet<ArrowRecordBatch> Batches() {
+    return RowSet<ArrowRecordBatch>(
+        [this]() mutable { return source_->NextBatch(); });
+  }
+
+  // Returns a value between 0 and 1, inclusive, that indicates the estimated
+  // progress in the stream, see `ReadResult::FractionConsumed()`.
+  double FractionConsumed() { return source_->FractionConsumed(); }
+
+ private:
+  std::unique_ptr<internal::ArrowReadResultSource> source_;
+};
+
+}  // namespace BIGQUERY_CLIENT_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_ARROW_READ_RESULT_H
@@ -17,17 +17,20 @@
 """Automatically generated source lists for bigquery_client - DO NOT EDIT."""
 
 bigquery_client_hdrs = [
+    "arrow_read_result.h",
     "client.h",
     "connection.h",
     "connection_options.h",
     "internal/connection_impl.h",
     "internal/storage_stub.h",
     "internal/stream_reader.h",
+    "internal/streaming_arrow_read_result_source.h",
     "internal/streaming_read_result_source.h",
     "read_result.h",
     "read_stream.h",
     "row.h",
     "row_set.h",
+    "table_exporter.h",
     "version.h",
     "version_info.h",
 ]
@@ -37,7 +40,9 @@ bigquery_client_srcs = [
     "connection_options.cc",
     "internal/connection_impl.cc",
     "internal/storage_stub.cc",
+    "internal/streaming_arrow_read_result_source.cc",
     "internal/streaming_read_result_source.cc",
     "read_stream.cc",
+    "table_exporter.cc",
     "version.cc",
 ]
@@ -18,4 +18,5 @@
 
 bigquery_client_unit_tests = [
     "internal/connection_impl_test.cc",
+    "table_exporter_test.cc",
 ]
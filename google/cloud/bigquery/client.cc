@@ -43,6 +43,17 @@ StatusOr<std::vector<ReadStream>> Client::ParallelRead(
   return conn_->ParallelRead(parent_project_id, table, columns);
 }
 
+ArrowReadResult Client::ReadArrow(ReadStream const& read_stream) {
+  return conn_->ReadArrow(read_stream);
+}
+
+StatusOr<ArrowReadSession> Client::ParallelReadArrow(
+    std::string const& parent_project_id, std::string const& table,
+    std::vector<std::string> const& columns, int requested_streams) {
+  return conn_->ParallelReadArrow(parent_project_id, table, columns,
+                                  requested_streams);
+}
+
 std::shared_ptr<Connection> MakeConnection(ConnectionOptions const& options) {
   std::shared_ptr<internal::StorageStub> stub =
       internal::MakeDefaultStorageStub(options);
@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_CLIENT_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_CLIENT_H
 
+#include "google/cloud/bigquery/arrow_read_result.h"
 #include "google/cloud/bigquery/connection.h"
 #include "google/cloud/bigquery/connection_options.h"
 #include "google/cloud/bigquery/read_result.h"
@@ -76,6 +77,23 @@ class Client {
       std::string const& parent_project_id, std::string const& table,
       std::vector<std::string> const& columns = {});
 
+  // Performs a read using a `ReadStream` returned by
+  // `bigquery::Client::ParallelReadArrow()`, returning the data as serialized
+  // Arrow record batches.
+  ArrowReadResult ReadArrow(ReadStream const& read_stream);
+
+  // Creates one or more `ReadStream`s that return the data from a table as
+  // Arrow record batches. The result includes the serialized Arrow schema for
+  // all the record batches.
+  //
+  // `requested_streams` is the maximum number of streams, the service may
+  // return fewer. If zero the service picks the number of streams.
+  //
+  // The same row ordering and expiration caveats as `ParallelRead()` apply.
+  StatusOr<ArrowReadSession> ParallelReadArrow(
+      std::string const& parent_project_id, std::string const& table,
+      std::vector<std::string> const& columns, int requested_streams);
+
  private:
   std::shared_ptr<Connection> conn_;
 };
@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_CONNECTION_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_CONNECTION_H
 
+#include "google/cloud/bigquery/arrow_read_result.h"
 #include "google/cloud/bigquery/read_result.h"
 #include "google/cloud/bigquery/read_stream.h"
 #include "google/cloud/bigquery/row.h"
@@ -35,6 +36,12 @@ class Connection {
   virtual StatusOr<std::vector<ReadStream>> ParallelRead(
       std::string const& parent_project_id, std::string const& table,
       std::vector<std::string> const& columns = {}) = 0;
+
+  virtual ArrowReadResult ReadArrow(ReadStream const& read_stream) = 0;
+
+  virtual StatusOr<ArrowReadSession> ParallelReadArrow(
+      std::string const& parent_project_id, std::string const& table,
+      std::vector<std::string> const& columns, int requested_streams) = 0;
 };
 
 }  // namespace BIGQUERY_CLIENT_NS
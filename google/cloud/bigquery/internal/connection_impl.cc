@@ -14,6 +14,7 @@
 
 #include "google/cloud/bigquery/internal/connection_impl.h"
 #include "google/cloud/bigquery/internal/storage_stub.h"
+#include "google/cloud/bigquery/internal/streaming_arrow_read_result_source.h"
 #include "google/cloud/bigquery/internal/streaming_read_result_source.h"
 #include "google/cloud/bigquery/version.h"
 #include "google/cloud/status_or.h"
@@ -73,7 +74,9 @@ ReadResult ConnectionImpl::Read(ReadStream const& read_stream) {
 StatusOr<std::vector<ReadStream>> ConnectionImpl::ParallelRead(
     std::string const& parent_project_id, std::string const& table,
     std::vector<std::string> const& columns) {
-  auto response = NewReadSession(parent_project_id, table, columns);
+  auto response =
+      NewReadSession(parent_project_id, table, columns,
+                     bigquerystorage_proto::DATA_FORMAT_UNSPECIFIED, 0);
   if (!response.ok()) {
     return response.status();
   }
@@ -86,9 +89,38 @@ StatusOr<std::vector<ReadStream>> ConnectionImpl::ParallelRead(
   return result;
 }
 
+ArrowReadResult ConnectionImpl::ReadArrow(ReadStream const& read_stream) {
+  bigquerystorage_proto::ReadRowsRequest request;
+  request.mutable_read_position()->mutable_stream()->set_name(
+      read_stream.stream_name());
+  auto source = std::unique_ptr<StreamingArrowReadResultSource>(
+      new StreamingArrowReadResultSource(read_stub_->ReadRows(request)));
+  return ArrowReadResult(std::move(source));
+}
+
+StatusOr<ArrowReadSession> ConnectionImpl::ParallelReadArrow(
+    std::string const& parent_project_id, std::string const& table,
+    std::vector<std::string> const& columns, int requested_streams) {
+  auto response = NewReadSession(parent_project_id, table, columns,
+                                 bigquerystorage_proto::ARROW,
+                                 requested_streams);
+  if (!response.ok()) {
+    return response.status();
+  }
+
+  ArrowReadSession result;
+  result.serialized_schema =
+      std::move(*response->mutable_arrow_schema()->mutable_serialized_schema());
+  for (bigquerystorage_proto::Stream const& stream : response->streams()) {
+    result.streams.push_back(MakeReadStream(stream.name()));
+  }
+  return result;
+}
+
 StatusOr<bigquerystorage_proto::ReadSession> ConnectionImpl::NewReadSession(
     std::string const& parent_project_id, std::string const& table,
-    std::vector<std::string> const& columns) {
+    std::vector<std::string> const& columns,
+    bigquerystorage_proto::DataFormat format, int requested_streams) {
   auto parts = StrSplit<':'>(table);
   if (parts.size() != 2) {
     return Status(
@@ -113,6 +145,8 @@ StatusOr<bigquerystorage_proto::ReadSession> ConnectionImpl::NewReadSession(
   for (std::string const& column : columns) {
     request.mutable_read_options()->add_selected_fields(column);
   }
+  request.set_format(format);
+  request.set_requested_streams(requested_streams);
 
   return read_stub_->CreateReadSession(request);
 }
@@ -39,6 +39,13 @@ class ConnectionImpl : public Connection {
       std::string const& parent_project_id, std::string const& table,
       std::vector<std::string> const& columns = {}) override;
 
+  ArrowReadResult ReadArrow(ReadStream const& read_stream) override;
+
+  StatusOr<ArrowReadSession> ParallelReadArrow(
+      std::string const& parent_project_id, std::string const& table,
+      std::vector<std::string> const& columns,
+      int requested_streams) override;
+
  private:
   friend std::shared_ptr<ConnectionImpl> MakeConnection(
       std::shared_ptr<StorageStub> read_stub);
@@ -46,8 +53,11 @@ class ConnectionImpl : public Connection {
 
   google::cloud::StatusOr<
       google::cloud::bigquery::storage::v1beta1::ReadSession>
-  NewReadSession(std::string const& parent_project_id, std::string const& table,
-                 std::vector<std::string> const& columns = {});
+  NewReadSession(
+      std::string const& parent_project_id, std::string const& table,
+      std::vector<std::string> const& columns,
+      google::cloud::bigquery::storage::v1beta1::DataFormat format,
+      int requested_streams);
 
   std::shared_ptr<StorageStub> read_stub_;
 };
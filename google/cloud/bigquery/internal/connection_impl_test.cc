@@ -16,6 +16,7 @@
 #include "google/cloud/bigquery/internal/storage_stub.h"
 #include "google/cloud/bigquery/testing/mock_storage_stub.h"
 #include "google/cloud/bigquery/version.h"
+#include "google/cloud/optional.h"
 #include "google/cloud/status_or.h"
 #include <google/cloud/bigquery/storage/v1beta1/storage.pb.h>
 #include <google/protobuf/text_format.h>
@@ -23,6 +24,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -119,6 +121,101 @@ TEST(ConnectionImplTest, ParallelReadRpcSuccess) {
                                           MakeReadStream("stream-2")));
 }
 
+class FakeResponseReader
+    : public StreamReader<bigquerystorage_proto::ReadRowsResponse> {
+ public:
+  explicit FakeResponseReader(
+      std::vector<bigquerystorage_proto::ReadRowsResponse> responses)
+      : responses_(std::move(responses)) {}
+
+  StatusOr<optional<bigquerystorage_proto::ReadRowsResponse>> NextValue()
+      override {
+    if (next_ == responses_.size()) {
+      return optional<bigquerystorage_proto::ReadRowsResponse>();
+    }
+    return optional<bigquerystorage_proto::ReadRowsResponse>(
+        responses_[next_++]);
+  }
+
+ private:
+  std::vector<bigquerystorage_proto::ReadRowsResponse> responses_;
+  std::size_t next_ = 0;
+};
+
+TEST(ConnectionImplTest, ParallelReadArrowRpcSuccess) {
+  auto mock = std::make_shared<bigquery_testing::MockStorageStub>();
+  auto conn = MakeConnection(mock);
+  EXPECT_CALL(*mock, CreateReadSession(_))
+      .WillOnce(testing::Invoke(
+          [](bigquerystorage_proto::CreateReadSessionRequest const& request)
+              -> StatusOr<bigquerystorage_proto::ReadSession> {
+            EXPECT_THAT(request.format(), Eq(bigquerystorage_proto::ARROW));
+            EXPECT_THAT(request.requested_streams(), Eq(2));
+
+            bigquerystorage_proto::ReadSession response;
+            std::string const text = R"pb(
+              name: "my-session"
+              arrow_schema { serialized_schema: "my-schema" }
+              streams { name: "stream-0" }
+              streams { name: "stream-1" }
+            )pb";
+            EXPECT_TRUE(TextFormat::ParseFromString(text, &response));
+            return response;
+          }));
+
+  StatusOr<ArrowReadSession> result = conn->ParallelReadArrow(
+      "my-parent-project", "my-project:my-dataset.my-table", {}, 2);
+  ASSERT_THAT(result.ok(), IsTrue());
+  EXPECT_THAT(result->serialized_schema, Eq("my-schema"));
+  EXPECT_THAT(result->streams, ElementsAre(MakeReadStream("stream-0"),
+                                           MakeReadStream("stream-1")));
+}
+
+TEST(ConnectionImplTest, ReadArrowSkipsResponsesWithoutBatches) {
+  auto mock = std::make_shared<bigquery_testing::MockStorageStub>();
+  auto conn = MakeConnection(mock);
+  EXPECT_CALL(*mock, ReadRows(_))
+      .WillOnce(testing::Invoke(
+          [](bigquerystorage_proto::ReadRowsRequest const& request) {
+            EXPECT_THAT(request.read_position().stream().name(),
+                        Eq("stream-0"));
+            std::vector<bigquerystorage_proto::ReadRowsResponse> responses(3);
+            std::string const text[] = {
+                R"pb(
+                  arrow_record_batch { serialized_record_batch: "batch-0" }
+                  row_count: 2
+                  status { progress { at_response_end: 0.5 } }
+                )pb",
+                R"pb(
+                  status { progress { at_response_end: 0.5 } }
+                )pb",
+                R"pb(
+                  arrow_record_batch { serialized_record_batch: "batch-1" }
+                  row_count: 3
+                  status { progress { at_response_end: 1.0 } }
+                )pb",
+            };
+            for (std::size_t i = 0; i != responses.size(); ++i) {
+              EXPECT_TRUE(TextFormat::ParseFromString(text[i], &responses[i]));
+            }
+            return std::unique_ptr<
+                StreamReader<bigquerystorage_proto::ReadRowsResponse>>(
+                new FakeResponseReader(std::move(responses)));
+          }));
+
+  ArrowReadResult result = conn->ReadArrow(MakeReadStream("stream-0"));
+  std::vector<std::string> batches;
+  std::int64_t rows = 0;
+  for (auto& batch : result.Batches()) {
+    ASSERT_THAT(batch.ok(), IsTrue());
+    batches.push_back(batch->serialized_record_batch);
+    rows += batch->row_count;
+  }
+  EXPECT_THAT(batches, ElementsAre("batch-0", "batch-1"));
+  EXPECT_THAT(rows, Eq(5));
+  EXPECT_THAT(result.FractionConsumed(), Eq(1.0));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace BIGQUERY_CLIENT_NS
@@ -0,0 +1,53 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigquery/internal/streaming_arrow_read_result_source.h"
+#include "google/cloud/bigquery/version.h"
+#include "google/cloud/optional.h"
+#include "google/cloud/status_or.h"
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace BIGQUERY_CLIENT_NS {
+namespace internal {
+
+StatusOr<optional<ArrowRecordBatch>>
+StreamingArrowReadResultSource::NextBatch() {
+  for (;;) {
+    auto next = reader_->NextValue();
+    if (!next.ok()) {
+      return next.status();
+    }
+    if (!next.value()) {
+      return optional<ArrowRecordBatch>();
+    }
+    auto& response = *next.value();
+    fraction_consumed_ = response.status().progress().at_response_end();
+    // Responses may only carry progress or throttling information, skip them.
+    if (!response.has_arrow_record_batch()) {
+      continue;
+    }
+    auto& batch = *response.mutable_arrow_record_batch();
+    return optional<ArrowRecordBatch>(ArrowRecordBatch{
+        std::move(*batch.mutable_serialized_record_batch()),
+        response.row_count()});
+  }
+}
+
+}  // namespace internal
+}  // namespace BIGQUERY_CLIENT_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
@@ -72,19 +72,25 @@ class RowSet {
     }
 
     void Advance() {
-      auto next = std::move((*source_)());
-      if (!next.ok()) {
-        curr_ = next.status();
+      // An error is returned as the last element, the iteration ends after it.
+      if (!curr_.ok() && started_) {
         source_ = nullptr;
+        return;
+      }
+      started_ = true;
+      auto next = (*source_)();
+      if (!next.ok()) {
+        curr_ = std::move(next).status();
       } else if (!next.value()) {
         source_ = nullptr;
       } else {
-        curr_ = *next.value();
+        curr_ = std::move(*next.value());
       }
     }
 
     std::function<StatusOr<optional<RowType>>()>* source_;
     StatusOr<RowType> curr_;
+    bool started_ = false;
   };
 
   explicit RowSet(std::function<StatusOr<optional<RowType>>()> source)
@@ -17,5 +17,6 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 bigquery_client_integration_samples = [
+    "export_table.cc",
     "read.cc",
 ]
@@ -0,0 +1,74 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigquery/client.h"
+#include "google/cloud/bigquery/table_exporter.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+using google::cloud::StatusOr;
+using google::cloud::bigquery::Client;
+using google::cloud::bigquery::ConnectionOptions;
+using google::cloud::bigquery::ExportOptions;
+using google::cloud::bigquery::ExportProgress;
+using google::cloud::bigquery::ExportResult;
+using google::cloud::bigquery::ExportTableToArrow;
+using google::cloud::bigquery::MakeConnection;
+
+int ExportTable(std::string const& project_id, std::string const& table,
+                std::string const& file_prefix, int concurrency) {
+  ConnectionOptions connection_options;
+  Client client(MakeConnection(connection_options));
+
+  ExportOptions options;
+  options.file_prefix = file_prefix;
+  options.requested_streams = concurrency;
+  options.concurrency = concurrency;
+  options.progress = [](ExportProgress const& p) {
+    std::cout << "\rstreams: " << p.streams_done << "/" << p.streams_total
+              << " rows: " << p.rows << " bytes: " << p.bytes << std::flush;
+  };
+
+  StatusOr<ExportResult> result =
+      ExportTableToArrow(client, project_id, table, options);
+  std::cout << "\n";
+  if (!result.ok()) {
+    std::cerr << "Export failed with error: " << result.status() << "\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "Exported " << result->rows << " rows (" << result->bytes
+            << " bytes) to " << result->files.size() << " files:\n";
+  for (auto const& f : result->files) std::cout << "  " << f << "\n";
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc != 4 && argc != 5) {
+    std::cerr << "Usage: " << argv[0]
+              << " <project-id> <PROJECT_ID:DATASET_ID.TABLE_ID> <file-prefix>"
+              << " [concurrency]\n";
+    return EXIT_FAILURE;
+  }
+  int concurrency = argc == 5 ? std::atoi(argv[4]) : 4;
+  if (concurrency <= 0) {
+    std::cerr << "The concurrency must be a positive number.\n";
+    return EXIT_FAILURE;
+  }
+  return ExportTable(argv[1], argv[2], argv[3], concurrency);
+}
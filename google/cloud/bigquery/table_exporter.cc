@@ -0,0 +1,183 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigquery/table_exporter.h"
+#include "google/cloud/bigquery/version.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace BIGQUERY_CLIENT_NS {
+namespace {
+
+// The end-of-stream marker in the Arrow IPC streaming format: a continuation
+// token followed by a zero-length message.
+char const kEndOfStream[] = {'\xFF', '\xFF', '\xFF', '\xFF',
+                             '\x00', '\x00', '\x00', '\x00'};
+
+std::string ExportFileName(std::string const& prefix, std::size_t index) {
+  std::ostringstream os;
+  os << prefix << "-" << std::setw(5) << std::setfill('0') << index
+     << ".arrows";
+  return std::move(os).str();
+}
+
+// The state shared by all the threads in an export.
+class ExportState {
+ public:
+  ExportState(ExportOptions const& options, std::size_t streams_total)
+      : options_(options),
+        progress_{streams_total, 0, 0, 0},
+        next_stream_(0),
+        failed_(false) {}
+
+  // Returns the index of the next stream to export, or `streams_total` if none
+  // remain (or the export failed).
+  std::size_t NextStream() {
+    if (failed_.load()) return progress_.streams_total;
+    return (std::min)(next_stream_.fetch_add(1), progress_.streams_total);
+  }
+
+  bool failed() const { return failed_.load(); }
+
+  void OnBatch(std::int64_t rows, std::size_t bytes) {
+    std::lock_guard<std::mutex> lk(mu_);
+    progress_.rows += rows;
+    progress_.bytes += static_cast<std::int64_t>(bytes);
+    if (options_.progress) options_.progress(progress_);
+  }
+
+  void OnStreamDone() {
+    std::lock_guard<std::mutex> lk(mu_);
+    ++progress_.streams_done;
+    if (options_.progress) options_.progress(progress_);
+  }
+
+  void OnError(Status status) {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (status_.ok()) status_ = std::move(status);
+    failed_.store(true);
+  }
+
+  Status status() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return status_;
+  }
+
+  ExportProgress progress() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return progress_;
+  }
+
+ private:
+  ExportOptions const& options_;
+  mutable std::mutex mu_;
+  ExportProgress progress_;  // GUARDED_BY(mu_)
+  Status status_;            // GUARDED_BY(mu_)
+  std::atomic<std::size_t> next_stream_;
+  std::atomic<bool> failed_;
+};
+
+Status ExportStream(Client& client, ReadStream const& stream,
+                    std::string const& serialized_schema,
+                    std::string const& file_name, ExportState& state) {
+  std::ofstream os(file_name, std::ios::binary | std::ios::trunc);
+  if (!os.is_open()) {
+    return Status(StatusCode::kInvalidArgument,
+                  "cannot open export file " + file_name);
+  }
+  os.write(serialized_schema.data(),
+           static_cast<std::streamsize>(serialized_schema.size()));
+  auto result = client.ReadArrow(stream);
+  for (auto& batch : result.Batches()) {
+    if (!batch) return std::move(batch).status();
+    if (state.failed()) return Status();
+    auto const& data = batch->serialized_record_batch;
+    os.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!os) {
+      return Status(StatusCode::kUnknown,
+                    "cannot write to export file " + file_name);
+    }
+    state.OnBatch(batch->row_count, data.size());
+  }
+  os.write(kEndOfStream, sizeof(kEndOfStream));
+  os.close();
+  if (!os) {
+    return Status(StatusCode::kUnknown,
+                  "cannot close export file " + file_name);
+  }
+  state.OnStreamDone();
+  return Status();
+}
+
+}  // namespace
+
+StatusOr<ExportResult> ExportTableToArrow(Client client,
+                                          std::string const& parent_project_id,
+                                          std::string const& table,
+                                          ExportOptions const& options) {
+  if (options.file_prefix.empty() || options.concurrency <= 0 ||
+      options.requested_streams < 0) {
+    return Status(StatusCode::kInvalidArgument,
+                  "ExportOptions requires a file_prefix, a positive "
+                  "concurrency, and a non-negative requested_streams");
+  }
+  auto session = client.ParallelReadArrow(parent_project_id, table,
+                                          options.columns,
+                                          options.requested_streams);
+  if (!session) return std::move(session).status();
+
+  auto const& streams = session->streams;
+  ExportResult result;
+  for (std::size_t i = 0; i != streams.size(); ++i) {
+    result.files.push_back(ExportFileName(options.file_prefix, i));
+  }
+
+  ExportState state(options, streams.size());
+  auto worker = [&] {
+    for (auto i = state.NextStream(); i < streams.size();
+         i = state.NextStream()) {
+      auto status = ExportStream(client, streams[i],
+                                 session->serialized_schema, result.files[i],
+                                 state);
+      if (!status.ok()) state.OnError(std::move(status));
+    }
+  };
+  auto const thread_count = (std::min)(
+      static_cast<std::size_t>(options.concurrency), streams.size());
+  std::vector<std::thread> threads;
+  // The calling thread reads streams too.
+  for (std::size_t i = 1; i < thread_count; ++i) threads.emplace_back(worker);
+  worker();
+  for (auto& t : threads) t.join();
+
+  auto status = state.status();
+  if (!status.ok()) return status;
+  auto const progress = state.progress();
+  result.rows = progress.rows;
+  result.bytes = progress.bytes;
+  return result;
+}
+
+}  // namespace BIGQUERY_CLIENT_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,89 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_TABLE_EXPORTER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_TABLE_EXPORTER_H
+
+#include "google/cloud/bigquery/client.h"
+#include "google/cloud/bigquery/version.h"
+#include "google/cloud/status_or.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace BIGQUERY_CLIENT_NS {
+
+// The progress of `ExportTableToArrow()`, reported after each record batch is
+// written and after each stream is completed.
+struct ExportProgress {
+  std::size_t streams_total;
+  std::size_t streams_done;
+  std::int64_t rows;
+  std::int64_t bytes;
+};
+
+struct ExportOptions {
+  // The output files are named `<file_prefix>-<stream index>.arrows`.
+  std::string file_prefix;
+
+  // The columns to export, all the columns if empty.
+  std::vector<std::string> columns;
+
+  // The maximum number of streams requested from the service, the service
+  // picks the number of streams if zero.
+  int requested_streams = 0;
+
+  // The number of streams read at the same time. Each stream holds at most one
+  // record batch in memory, so this bounds the memory used by the export.
+  int concurrency = 4;
+
+  // If set, called with the progress of the export. The calls are serialized,
+  // but they may happen in any of the threads reading streams.
+  std::function<void(ExportProgress const&)> progress;
+};
+
+struct ExportResult {
+  std::vector<std::string> files;
+  std::int64_t rows;
+  std::int64_t bytes;
+};
+
+// Exports `table` to local files in the Arrow IPC streaming format.
+//
+// The export opens a `ParallelReadArrow()` session and reads up to
+// `options.concurrency` streams at the same time. Each stream is written to its
+// own file: the serialized schema, followed by the record batches as they
+// arrive, and the end-of-stream marker. The record batches are not decoded,
+// they are written exactly as the service returns them.
+//
+// `table` must be in the form `PROJECT_ID:DATASET_ID.TABLE_ID`. The read is
+// performed on behalf of `parent_project_id`.
+//
+// On the first error the remaining streams are abandoned and the error is
+// returned. Any files already created are left in place.
+StatusOr<ExportResult> ExportTableToArrow(Client client,
+                                          std::string const& parent_project_id,
+                                          std::string const& table,
+                                          ExportOptions const& options);
+
+}  // namespace BIGQUERY_CLIENT_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_TABLE_EXPORTER_H
@@ -0,0 +1,216 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigquery/table_exporter.h"
+#include "google/cloud/bigquery/connection.h"
+#include "google/cloud/bigquery/version.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace BIGQUERY_CLIENT_NS {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::HasSubstr;
+
+std::string const kEndOfStream("\xFF\xFF\xFF\xFF\x00\x00\x00\x00", 8);
+
+class FakeArrowSource : public internal::ArrowReadResultSource {
+ public:
+  FakeArrowSource(std::vector<std::string> batches, Status final_status)
+      : batches_(std::move(batches)), final_status_(std::move(final_status)) {}
+
+  StatusOr<optional<ArrowRecordBatch>> NextBatch() override {
+    if (next_ == batches_.size()) {
+      if (!final_status_.ok()) return final_status_;
+      return optional<ArrowRecordBatch>();
+    }
+    auto const& data = batches_[next_++];
+    return optional<ArrowRecordBatch>(
+        ArrowRecordBatch{data, static_cast<std::int64_t>(data.size())});
+  }
+
+  double FractionConsumed() override {
+    return batches_.empty() ? 1.0
+                            : static_cast<double>(next_) / batches_.size();
+  }
+
+ private:
+  std::vector<std::string> batches_;
+  Status final_status_;
+  std::size_t next_ = 0;
+};
+
+// A connection returning a fixed set of streams. Each record batch reports as
+// many rows as it has bytes, which makes the totals easy to verify.
+class FakeConnection : public Connection {
+ public:
+  ReadResult Read(ReadStream const&) override { return ReadResult(); }
+
+  StatusOr<std::vector<ReadStream>> ParallelRead(
+      std::string const&, std::string const&,
+      std::vector<std::string> const&) override {
+    return Status(StatusCode::kUnimplemented, "not used");
+  }
+
+  ArrowReadResult ReadArrow(ReadStream const& read_stream) override {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto const& name = read_stream.stream_name();
+    auto& batches = stream_batches[name];
+    auto status = stream_errors.count(name) == 0 ? Status()
+                                                 : stream_errors[name];
+    return ArrowReadResult(std::unique_ptr<internal::ArrowReadResultSource>(
+        new FakeArrowSource(batches, std::move(status))));
+  }
+
+  StatusOr<ArrowReadSession> ParallelReadArrow(
+      std::string const&, std::string const&,
+      std::vector<std::string> const& columns,
+      int requested_streams) override {
+    last_columns = columns;
+    last_requested_streams = requested_streams;
+    if (!session_status.ok()) return session_status;
+    ArrowReadSession session;
+    session.serialized_schema = "schema:";
+    for (auto const& kv : stream_batches) {
+      session.streams.push_back(internal::MakeReadStream(kv.first));
+    }
+    return session;
+  }
+
+  std::map<std::string, std::vector<std::string>> stream_batches;
+  std::map<std::string, Status> stream_errors;
+  Status session_status;
+  std::vector<std::string> last_columns;
+  int last_requested_streams = -1;
+
+ private:
+  std::mutex mu_;
+};
+
+std::string ReadFile(std::string const& file_name) {
+  std::ifstream is(file_name, std::ios::binary);
+  return std::string{std::istreambuf_iterator<char>{is}, {}};
+}
+
+class TableExporterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    conn = std::make_shared<FakeConnection>();
+    options.file_prefix = ::testing::TempDir() + "table-exporter-test";
+  }
+  void TearDown() override {
+    for (auto const& f : created) std::remove(f.c_str());
+  }
+
+  std::shared_ptr<FakeConnection> conn;
+  ExportOptions options;
+  std::vector<std::string> created;
+};
+
+TEST_F(TableExporterTest, Success) {
+  conn->stream_batches = {
+      {"stream-0", {"aa", "bbb"}},
+      {"stream-1", {}},
+      {"stream-2", {"c", "dddd", "ee"}},
+  };
+  options.columns = {"col-0", "col-1"};
+  options.requested_streams = 3;
+  options.concurrency = 2;
+  std::mutex mu;
+  std::vector<ExportProgress> reports;
+  options.progress = [&](ExportProgress const& p) {
+    std::lock_guard<std::mutex> lk(mu);
+    reports.push_back(p);
+  };
+
+  auto result = ExportTableToArrow(Client(conn), "my-parent-project",
+                                   "my-project:my-dataset.my-table", options);
+  ASSERT_STATUS_OK(result);
+  created = result->files;
+  EXPECT_THAT(conn->last_columns, ElementsAre("col-0", "col-1"));
+  EXPECT_THAT(conn->last_requested_streams, Eq(3));
+  ASSERT_THAT(result->files.size(), Eq(3U));
+  EXPECT_THAT(result->files[0], Eq(options.file_prefix + "-00000.arrows"));
+  EXPECT_THAT(result->rows, Eq(12));
+  EXPECT_THAT(result->bytes, Eq(12));
+
+  EXPECT_THAT(ReadFile(result->files[0]), Eq("schema:aabbb" + kEndOfStream));
+  EXPECT_THAT(ReadFile(result->files[1]), Eq("schema:" + kEndOfStream));
+  EXPECT_THAT(ReadFile(result->files[2]),
+              Eq("schema:cddddee" + kEndOfStream));
+
+  // One report per batch, and one per stream.
+  ASSERT_THAT(reports.size(), Eq(8U));
+  auto const& last = reports.back();
+  EXPECT_THAT(last.streams_total, Eq(3U));
+  EXPECT_THAT(last.streams_done, Eq(3U));
+  EXPECT_THAT(last.rows, Eq(12));
+}
+
+TEST_F(TableExporterTest, SessionError) {
+  conn->session_status = Status(StatusCode::kPermissionDenied, "uh-oh");
+  auto result = ExportTableToArrow(Client(conn), "my-parent-project",
+                                   "my-project:my-dataset.my-table", options);
+  EXPECT_THAT(result.status().code(), Eq(StatusCode::kPermissionDenied));
+}
+
+TEST_F(TableExporterTest, StreamError) {
+  conn->stream_batches = {
+      {"stream-0", {"aa"}},
+      {"stream-1", {"bb"}},
+  };
+  conn->stream_errors["stream-1"] =
+      Status(StatusCode::kUnavailable, "try-again");
+  for (std::size_t i = 0; i != conn->stream_batches.size(); ++i) {
+    created.push_back(options.file_prefix + "-0000" + std::to_string(i) +
+                      ".arrows");
+  }
+  options.concurrency = 1;
+
+  auto result = ExportTableToArrow(Client(conn), "my-parent-project",
+                                   "my-project:my-dataset.my-table", options);
+  EXPECT_THAT(result.status().code(), Eq(StatusCode::kUnavailable));
+  EXPECT_THAT(result.status().message(), HasSubstr("try-again"));
+}
+
+TEST_F(TableExporterTest, InvalidOptions) {
+  options.concurrency = 0;
+  auto result = ExportTableToArrow(Client(conn), "my-parent-project",
+                                   "my-project:my-dataset.my-table", options);
+  EXPECT_THAT(result.status().code(), Eq(StatusCode::kInvalidArgument));
+
+  options.concurrency = 1;
+  options.file_prefix.clear();
+  result = ExportTableToArrow(Client(conn), "my-parent-project",
+                              "my-project:my-dataset.my-table", options);
+  EXPECT_THAT(result.status().code(), Eq(StatusCode::kInvalidArgument));
+}
+
+}  // namespace
+}  // namespace BIGQUERY_CLIENT_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
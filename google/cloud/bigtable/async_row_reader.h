@@ -28,6 +28,7 @@
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/future.h"
 #include "google/cloud/grpc_error_delegate.h"
+#include "google/cloud/internal/async_callback_rpc.h"
 #include "google/cloud/optional.h"
 #include "google/cloud/status_or.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
@@ -129,17 +130,30 @@ class AsyncRowReader : public std::enable_shared_from_this<
 
     auto client = client_;
     auto self = this->shared_from_this();
+    auto on_read = [self](google::bigtable::v2::ReadRowsResponse r) {
+      return self->OnDataReceived(std::move(r));
+    };
+    auto on_finish = [self](Status s) { self->OnStreamFinished(std::move(s)); };
+    if (client->UseCallbackApi()) {
+      google::cloud::internal::MakeCallbackStreamingReadRpc<
+          google::bigtable::v2::ReadRowsResponse>(
+          [client](grpc::ClientContext* context,
+                   google::bigtable::v2::ReadRowsRequest const* request,
+                   google::cloud::internal::ClientReadReactor<
+                       google::bigtable::v2::ReadRowsResponse>* reactor) {
+            client->CallbackReadRows(context, request, reactor);
+          },
+          request, std::move(context), std::move(on_read),
+          std::move(on_finish));
+      return;
+    }
     cq_.MakeStreamingReadRpc(
         [client](grpc::ClientContext* context,
                  google::bigtable::v2::ReadRowsRequest const& request,
                  grpc::CompletionQueue* cq) {
           return client->PrepareAsyncReadRows(context, request, cq);
         },
-        request, std::move(context),
-        [self](google::bigtable::v2::ReadRowsResponse r) {
-          return self->OnDataReceived(std::move(r));
-        },
-        [self](Status s) { self->OnStreamFinished(std::move(s)); });
+        request, std::move(context), std::move(on_read), std::move(on_finish));
   }
 
   /**
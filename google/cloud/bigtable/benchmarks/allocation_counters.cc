@@ -0,0 +1,136 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/allocation_counters.h"
+#include "google/cloud/bigtable/internal/copy_accounting.h"
+#include "google/cloud/internal/port_platform.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace benchmarks {
+namespace {
+// These are constant-initialized, so they are usable before any dynamic
+// initialization calls `operator new`.
+std::atomic<std::uint64_t> allocations{0};
+std::atomic<std::uint64_t> bytes_allocated{0};
+thread_local std::uint64_t thread_allocations = 0;
+thread_local std::uint64_t thread_bytes_allocated = 0;
+
+void* CountedAllocate(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  bytes_allocated.fetch_add(size, std::memory_order_relaxed);
+  ++thread_allocations;
+  thread_bytes_allocated += size;
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void* CountedAllocateOrThrow(std::size_t size) {
+  auto* p = CountedAllocate(size);
+  while (p == nullptr) {
+    auto handler = std::get_new_handler();
+    if (handler == nullptr) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+      throw std::bad_alloc();
+#else
+      std::abort();
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    }
+    handler();
+    p = std::malloc(size == 0 ? 1 : size);
+  }
+  return p;
+}
+}  // namespace
+
+AllocationCounters CurrentAllocationCounters() {
+  return AllocationCounters{
+      allocations.load(std::memory_order_relaxed),
+      bytes_allocated.load(std::memory_order_relaxed),
+      google::cloud::bigtable::internal::BytesCopiedCounter().load(
+          std::memory_order_relaxed)};
+}
+
+AllocationCounters CurrentThreadAllocationCounters() {
+  return AllocationCounters{
+      thread_allocations, thread_bytes_allocated,
+      google::cloud::bigtable::internal::ThreadBytesCopiedCounter()};
+}
+
+AllocationCounters operator-(AllocationCounters const& lhs,
+                             AllocationCounters const& rhs) {
+  return AllocationCounters{lhs.allocations - rhs.allocations,
+                            lhs.bytes_allocated - rhs.bytes_allocated,
+                            lhs.bytes_copied - rhs.bytes_copied};
+}
+
+std::string FormatAllocationCounters(AllocationCounters const& counters,
+                                     std::uint64_t operations) {
+  auto per_op = [operations](std::uint64_t value) {
+    return operations == 0 ? 0.0 : static_cast<double>(value) / operations;
+  };
+  std::ostringstream os;
+  os << "# allocations per operation    =" << per_op(counters.allocations)
+     << "\n# bytes allocated per operation="
+     << per_op(counters.bytes_allocated)
+     << "\n# bytes copied per operation   =";
+  if (google::cloud::bigtable::internal::CopyAccountingEnabled()) {
+    os << per_op(counters.bytes_copied) << "\n";
+  } else {
+    os << "n/a\n";
+  }
+  return std::move(os).str();
+}
+
+}  // namespace benchmarks
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+// Replace the global allocation functions, the array and `std::nothrow_t`
+// variants are replaced too, because some standard libraries do not implement
+// them in terms of the basic `operator new`.
+void* operator new(std::size_t size) {
+  return google::cloud::bigtable::benchmarks::CountedAllocateOrThrow(size);
+}
+
+void* operator new[](std::size_t size) {
+  return google::cloud::bigtable::benchmarks::CountedAllocateOrThrow(size);
+}
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept {
+  return google::cloud::bigtable::benchmarks::CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept {
+  return google::cloud::bigtable::benchmarks::CountedAllocate(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete[](void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+void operator delete(void* p, std::nothrow_t const&) noexcept { std::free(p); }
+
+void operator delete[](void* p, std::nothrow_t const&) noexcept {
+  std::free(p);
+}
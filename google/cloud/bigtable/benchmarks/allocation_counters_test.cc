@@ -0,0 +1,84 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/allocation_counters.h"
+#include <gmock/gmock.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace benchmarks {
+namespace {
+
+using ::testing::HasSubstr;
+
+TEST(AllocationCountersTest, CountsAllocations) {
+  auto const start = CurrentAllocationCounters();
+  std::vector<std::unique_ptr<std::vector<char>>> allocated;
+  for (int i = 0; i != 10; ++i) {
+    allocated.emplace_back(new std::vector<char>(1024));
+  }
+  auto const delta = CurrentAllocationCounters() - start;
+  EXPECT_EQ(10, allocated.size());
+  EXPECT_LE(20, delta.allocations);
+  EXPECT_LE(10 * 1024, delta.bytes_allocated);
+}
+
+TEST(AllocationCountersTest, ThreadCountersExcludeOtherThreads) {
+  auto const start = CurrentThreadAllocationCounters();
+  std::thread([] {
+    std::vector<std::unique_ptr<std::vector<char>>> allocated;
+    for (int i = 0; i != 10; ++i) {
+      allocated.emplace_back(new std::vector<char>(1024 * 1024));
+    }
+  }).join();
+  auto const other = CurrentThreadAllocationCounters() - start;
+  EXPECT_GT(10 * 1024 * 1024, other.bytes_allocated);
+
+  auto const mid = CurrentThreadAllocationCounters();
+  std::vector<std::unique_ptr<std::vector<char>>> allocated;
+  for (int i = 0; i != 10; ++i) {
+    allocated.emplace_back(new std::vector<char>(1024));
+  }
+  auto const delta = CurrentThreadAllocationCounters() - mid;
+  EXPECT_LE(20, delta.allocations);
+  EXPECT_LE(10 * 1024, delta.bytes_allocated);
+}
+
+TEST(AllocationCountersTest, Difference) {
+  AllocationCounters lhs{10, 2048, 300};
+  AllocationCounters rhs{4, 1024, 100};
+  auto const actual = lhs - rhs;
+  EXPECT_EQ(6, actual.allocations);
+  EXPECT_EQ(1024, actual.bytes_allocated);
+  EXPECT_EQ(200, actual.bytes_copied);
+}
+
+TEST(AllocationCountersTest, Format) {
+  auto const actual = FormatAllocationCounters({10, 2048, 300}, 4);
+  EXPECT_THAT(actual, HasSubstr("# allocations per operation    =2.5\n"));
+  EXPECT_THAT(actual, HasSubstr("# bytes allocated per operation=512\n"));
+  EXPECT_THAT(actual, HasSubstr("# bytes copied per operation   ="));
+  EXPECT_THAT(FormatAllocationCounters({10, 2048, 300}, 0),
+              HasSubstr("# allocations per operation    =0\n"));
+}
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -180,6 +180,17 @@ void Benchmark::PrintLatencyResult(std::ostream& os,
     sep = ", ";
   }
   os << "\n";
+
+  AllocationCounters total{};
+  for (auto const& op : result.operations) {
+    total.allocations += op.allocations.allocations;
+    total.bytes_allocated += op.allocations.bytes_allocated;
+    total.bytes_copied += op.allocations.bytes_copied;
+  }
+  // Any real operation allocates, zero means the allocations were not measured.
+  if (total.allocations != 0) {
+    os << FormatAllocationCounters(total, nsamples);
+  }
 }
 
 std::string Benchmark::ResultsCsvHeader() {
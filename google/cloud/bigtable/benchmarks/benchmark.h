@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_BENCHMARK_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_BENCHMARK_H
 
+#include "google/cloud/bigtable/benchmarks/allocation_counters.h"
 #include "google/cloud/bigtable/benchmarks/embedded_server.h"
 #include "google/cloud/bigtable/benchmarks/setup.h"
 #include "google/cloud/bigtable/table.h"
@@ -32,6 +33,8 @@ namespace benchmarks {
 struct OperationResult {
   google::cloud::Status status;
   std::chrono::microseconds latency;
+  /// The allocations made by the operation, all zero if they were not measured.
+  AllocationCounters allocations;
 };
 
 struct BenchmarkResult {
@@ -69,15 +72,22 @@ class Benchmark {
   /// Return the key for row @p id.
   std::string MakeKey(long id) const;
 
-  /// Measure the time to compute an operation.
+  /**
+   * Measure the time to compute an operation, and the allocations it makes.
+   *
+   * Only the allocations in the calling thread are counted, operations that
+   * complete in other threads should not use this function.
+   */
   template <typename Operation>
   static OperationResult TimeOperation(Operation&& op) {
+    auto const start_counters = CurrentThreadAllocationCounters();
     auto start = std::chrono::steady_clock::now();
     auto status = op();
     using std::chrono::duration_cast;
     auto elapsed = duration_cast<std::chrono::microseconds>(
         std::chrono::steady_clock::now() - start);
-    return OperationResult{status, elapsed};
+    return OperationResult{status, elapsed,
+                           CurrentThreadAllocationCounters() - start_counters};
   }
 
   /// Print the result of a throughput test in human readable form.
@@ -85,7 +95,12 @@ class Benchmark {
                              std::string const& phase,
                              BenchmarkResult const& result) const;
 
-  /// Print the result of a latency test in human readable form.
+  /**
+   * Print the result of a latency test in human readable form.
+   *
+   * If the operations measured their allocations, this includes the average
+   * allocations (and copies) per operation.
+   */
   void PrintLatencyResult(std::ostream& os, std::string const& test_name,
                           std::string const& operation,
                           BenchmarkResult& result) const;
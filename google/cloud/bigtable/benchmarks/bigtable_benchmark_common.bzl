@@ -17,6 +17,7 @@
 """Automatically generated source lists for bigtable_benchmark_common - DO NOT EDIT."""
 
 bigtable_benchmark_common_hdrs = [
+    "allocation_counters.h",
     "benchmark.h",
     "constants.h",
     "embedded_server.h",
@@ -25,6 +26,7 @@ bigtable_benchmark_common_hdrs = [
 ]
 
 bigtable_benchmark_common_srcs = [
+    "allocation_counters.cc",
     "benchmark.cc",
     "embedded_server.cc",
     "random_mutation.cc",
@@ -136,7 +136,8 @@ TEST(BenchmarkTest, PrintLatencyResult) {
   int count = 0;
   std::generate(result.operations.begin(), result.operations.end(), [&count]() {
     return OperationResult{google::cloud::Status{},
-                           std::chrono::microseconds(++count * 100)};
+                           std::chrono::microseconds(++count * 100),
+                           AllocationCounters{3, 1024, 0}};
   });
 
   std::ostringstream os;
@@ -155,6 +156,10 @@ TEST(BenchmarkTest, PrintLatencyResult) {
   EXPECT_THAT(output, HasSubstr("p0=100.000us"));
   EXPECT_THAT(output, HasSubstr("p95=9.500ms"));
   EXPECT_THAT(output, HasSubstr("p100=10.000ms"));
+
+  // The output includes the average allocations per operation.
+  EXPECT_THAT(output, HasSubstr("# allocations per operation    =3\n"));
+  EXPECT_THAT(output, HasSubstr("# bytes allocated per operation=1024\n"));
 }
 
 TEST(BenchmarkTest, PrintCsv) {
@@ -171,7 +176,8 @@ TEST(BenchmarkTest, PrintCsv) {
   int count = 0;
   std::generate(result.operations.begin(), result.operations.end(), [&count]() {
     return OperationResult{google::cloud::Status{},
-                           std::chrono::microseconds(++count * 100)};
+                           std::chrono::microseconds(++count * 100),
+                           AllocationCounters{}};
   });
 
   std::string header = bm.ResultsCsvHeader();
@@ -277,7 +277,9 @@ void AsyncBenchmark::OnReadRow(
 
   std::unique_lock<std::mutex> lk(mu_);
   outstanding_requests_--;
-  results_.operations.push_back({row.status(), usecs});
+  // The allocations for asynchronous operations are spread across the
+  // completion queue threads, they cannot be attributed to each operation.
+  results_.operations.push_back({row.status(), usecs, AllocationCounters{}});
   ++results_.row_count;
   if (now < deadline_) {
     lk.unlock();
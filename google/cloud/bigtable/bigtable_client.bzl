@@ -20,7 +20,9 @@ bigtable_client_hdrs = [
     "admin_client.h",
     "app_profile_config.h",
     "async_row_reader.h",
+    "bulk_mutation_builder.h",
     "cell.h",
+    "cell_stream_handler.h",
     "client_options.h",
     "cluster_config.h",
     "cluster_list_responses.h",
@@ -37,6 +39,7 @@ bigtable_client_hdrs = [
     "instance_config.h",
     "instance_list_responses.h",
     "instance_update_config.h",
+    "internal/adaptive_batch_limit.h",
     "internal/async_bulk_apply.h",
     "internal/async_longrunning_op.h",
     "internal/async_poll_op.h",
@@ -44,12 +47,16 @@ bigtable_client_hdrs = [
     "internal/async_retry_op.h",
     "internal/async_retry_unary_rpc_and_poll.h",
     "internal/bulk_mutator.h",
+    "internal/cell_stream_parser.h",
     "internal/client_options_defaults.h",
     "internal/common_client.h",
     "internal/conjunction.h",
+    "internal/copy_accounting.h",
     "internal/google_bytes_traits.h",
+    "internal/mutation_spill_log.h",
     "internal/prefix_range_end.h",
     "internal/readrowsparser.h",
+    "internal/row_key_regex_planner.h",
     "internal/rowreaderiterator.h",
     "internal/rpc_policy_parameters.h",
     "internal/rpc_policy_parameters.inc",
@@ -57,6 +64,7 @@ bigtable_client_hdrs = [
     "metadata_update_policy.h",
     "mutation_batcher.h",
     "mutations.h",
+    "ordered_key.h",
     "polling_policy.h",
     "read_modify_write_rule.h",
     "row.h",
@@ -67,6 +75,7 @@ bigtable_client_hdrs = [
     "row_set.h",
     "rpc_backoff_policy.h",
     "rpc_retry_policy.h",
+    "split_planner.h",
     "table.h",
     "table_admin.h",
     "table_config.h",
@@ -77,6 +86,7 @@ bigtable_client_hdrs = [
 bigtable_client_srcs = [
     "admin_client.cc",
     "app_profile_config.cc",
+    "bulk_mutation_builder.cc",
     "client_options.cc",
     "cluster_config.cc",
     "data_client.cc",
@@ -88,22 +98,29 @@ bigtable_client_srcs = [
     "instance_admin_client.cc",
     "instance_config.cc",
     "instance_update_config.cc",
+    "internal/adaptive_batch_limit.cc",
     "internal/async_bulk_apply.cc",
     "internal/bulk_mutator.cc",
+    "internal/cell_stream_parser.cc",
     "internal/common_client.cc",
+    "internal/copy_accounting.cc",
     "internal/google_bytes_traits.cc",
+    "internal/mutation_spill_log.cc",
     "internal/prefix_range_end.cc",
     "internal/readrowsparser.cc",
+    "internal/row_key_regex_planner.cc",
     "internal/rowreaderiterator.cc",
     "metadata_update_policy.cc",
     "mutation_batcher.cc",
     "mutations.cc",
+    "ordered_key.cc",
     "polling_policy.cc",
     "row_range.cc",
     "row_reader.cc",
     "row_set.cc",
     "rpc_backoff_policy.cc",
     "rpc_retry_policy.cc",
+    "split_planner.cc",
     "table.cc",
     "table_admin.cc",
     "table_config.cc",
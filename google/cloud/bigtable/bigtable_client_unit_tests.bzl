@@ -25,6 +25,7 @@ bigtable_client_unit_tests = [
     "async_read_stream_test.cc",
     "async_row_reader_test.cc",
     "bigtable_version_test.cc",
+    "bulk_mutation_builder_test.cc",
     "cell_test.cc",
     "client_options_test.cc",
     "cluster_config_test.cc",
@@ -40,11 +41,14 @@ bigtable_client_unit_tests = [
     "instance_admin_test.cc",
     "instance_config_test.cc",
     "instance_update_config_test.cc",
+    "internal/adaptive_batch_limit_test.cc",
     "internal/async_longrunning_op_test.cc",
     "internal/async_retry_multi_page_test.cc",
     "internal/bulk_mutator_test.cc",
     "internal/google_bytes_traits_test.cc",
+    "internal/mutation_spill_log_test.cc",
     "internal/prefix_range_end_test.cc",
+    "internal/row_key_regex_planner_test.cc",
     "mutation_batcher_test.cc",
     "mutations_test.cc",
     "table_admin_test.cc",
@@ -54,12 +58,15 @@ bigtable_client_unit_tests = [
     "table_config_test.cc",
     "table_readrow_test.cc",
     "table_readrows_test.cc",
+    "table_stream_rows_test.cc",
     "table_sample_row_keys_test.cc",
     "table_test.cc",
     "table_readmodifywriterow_test.cc",
     "read_modify_write_rule_test.cc",
     "row_reader_test.cc",
     "row_test.cc",
+    "ordered_key_test.cc",
+    "split_planner_test.cc",
     "row_range_test.cc",
     "row_set_test.cc",
     "rpc_backoff_policy_test.cc",
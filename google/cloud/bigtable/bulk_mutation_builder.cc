@@ -0,0 +1,111 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/bulk_mutation_builder.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace btproto = google::bigtable::v2;
+
+std::size_t constexpr BulkMutationBuilder::kDefaultInitialBlockSize;
+
+BulkMutationBuilder::RowBuilder& BulkMutationBuilder::RowBuilder::SetCell(
+    std::string const& family, std::string const& column,
+    std::chrono::milliseconds timestamp, std::string const& value) {
+  auto& set_cell = *entry_->add_mutations()->mutable_set_cell();
+  set_cell.set_family_name(family);
+  set_cell.set_column_qualifier(column);
+  set_cell.set_timestamp_micros(
+      std::chrono::duration_cast<std::chrono::microseconds>(timestamp).count());
+  set_cell.set_value(value);
+  return *this;
+}
+
+BulkMutationBuilder::RowBuilder& BulkMutationBuilder::RowBuilder::SetCell(
+    std::string const& family, std::string const& column,
+    std::string const& value) {
+  auto& set_cell = *entry_->add_mutations()->mutable_set_cell();
+  set_cell.set_family_name(family);
+  set_cell.set_column_qualifier(column);
+  set_cell.set_timestamp_micros(ServerSetTimestamp());
+  set_cell.set_value(value);
+  return *this;
+}
+
+BulkMutationBuilder::RowBuilder&
+BulkMutationBuilder::RowBuilder::DeleteFromColumn(std::string const& family,
+                                                  std::string const& column) {
+  auto& d = *entry_->add_mutations()->mutable_delete_from_column();
+  d.set_family_name(family);
+  d.set_column_qualifier(column);
+  return *this;
+}
+
+BulkMutationBuilder::RowBuilder&
+BulkMutationBuilder::RowBuilder::DeleteFromFamily(std::string const& family) {
+  entry_->add_mutations()->mutable_delete_from_family()->set_family_name(
+      family);
+  return *this;
+}
+
+BulkMutationBuilder::RowBuilder&
+BulkMutationBuilder::RowBuilder::DeleteFromRow() {
+  entry_->add_mutations()->mutable_delete_from_row();
+  return *this;
+}
+
+BulkMutationBuilder::BulkMutationBuilder(std::size_t initial_block_size)
+    : initial_block_size_(initial_block_size) {
+  Reset();
+}
+
+BulkMutationBuilder::RowBuilder BulkMutationBuilder::AddRow(
+    std::string const& row_key) {
+  auto* entry = request_->add_entries();
+  entry->set_row_key(row_key);
+  return RowBuilder(entry);
+}
+
+BulkMutationBuilder& BulkMutationBuilder::Add(SingleRowMutation mutation) {
+  mutation.MoveTo(request_->add_entries());
+  return *this;
+}
+
+BulkMutation BulkMutationBuilder::Build() {
+  BulkMutation result(std::move(request_));
+  Reset();
+  return result;
+}
+
+void BulkMutationBuilder::Reset() {
+  google::protobuf::ArenaOptions options;
+  options.start_block_size = initial_block_size_;
+  options.max_block_size = (std::max)(options.max_block_size,
+                                      initial_block_size_);
+  auto arena = std::make_shared<google::protobuf::Arena>(options);
+  auto* request =
+      google::protobuf::Arena::CreateMessage<btproto::MutateRowsRequest>(
+          arena.get());
+  // The request is owned by the arena, share the arena's control block so the
+  // arena lives as long as the request is in use.
+  request_ = std::shared_ptr<btproto::MutateRowsRequest>(arena, request);
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,143 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BULK_MUTATION_BUILDER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BULK_MUTATION_BUILDER_H
+
+#include "google/cloud/bigtable/mutations.h"
+#include "google/cloud/bigtable/version.h"
+#include <google/bigtable/v2/bigtable.pb.h>
+#include <google/protobuf/arena.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Build a `BulkMutation` in place, using a protobuf arena.
+ *
+ * Creating a `BulkMutation` from `SingleRowMutation` and `Mutation` objects
+ * allocates a few protos for each cell, and then moves them into the request.
+ * Applications that write millions of cells per minute may prefer to use this
+ * class, which writes the rows and cells directly into a request allocated in
+ * a `google::protobuf::Arena`. All the memory is released at once when the
+ * `BulkMutation` (and any operation using it) is destroyed.
+ *
+ * `Table::BulkApply()` and `Table::AsyncBulkApply()` consume the resulting
+ * `BulkMutation` without copying the data, including any retries.
+ *
+ * @par Example
+ * @code
+ * bigtable::BulkMutationBuilder builder;
+ * for (int i = 0; i != 1000; ++i) {
+ *   builder.AddRow("row-" + std::to_string(i))
+ *       .SetCell("fam", "col", std::chrono::milliseconds(0), "value");
+ * }
+ * auto failures = table.BulkApply(builder.Build());
+ * @endcode
+ */
+class BulkMutationBuilder {
+ public:
+  /// Add mutations to a single row in the builder.
+  class RowBuilder {
+   public:
+    /// Set a cell value.
+    RowBuilder& SetCell(std::string const& family, std::string const& column,
+                        std::chrono::milliseconds timestamp,
+                        std::string const& value);
+
+    /**
+     * Set a cell value where the server sets the time.
+     *
+     * These mutations are not idempotent and not retried by default.
+     */
+    RowBuilder& SetCell(std::string const& family, std::string const& column,
+                        std::string const& value);
+
+    /// Delete all the cells in a column.
+    RowBuilder& DeleteFromColumn(std::string const& family,
+                                 std::string const& column);
+
+    /// Delete all the cells in a column family.
+    RowBuilder& DeleteFromFamily(std::string const& family);
+
+    /// Delete all the cells in the row.
+    RowBuilder& DeleteFromRow();
+
+   private:
+    friend class BulkMutationBuilder;
+    explicit RowBuilder(google::bigtable::v2::MutateRowsRequest::Entry* entry)
+        : entry_(entry) {}
+
+    google::bigtable::v2::MutateRowsRequest::Entry* entry_;
+  };
+
+  static std::size_t constexpr kDefaultInitialBlockSize = 64 * 1024;
+
+  /**
+   * Create an empty builder.
+   *
+   * @param initial_block_size the size of the first block allocated by the
+   *     arena, applications that know the approximate size of the mutations
+   *     can avoid extra allocations by setting this value.
+   */
+  explicit BulkMutationBuilder(
+      std::size_t initial_block_size = kDefaultInitialBlockSize);
+
+  /**
+   * Add a new row to the mutation.
+   *
+   * The returned object is invalidated by `Build()`.
+   */
+  RowBuilder AddRow(std::string const& row_key);
+
+  /// Add a `SingleRowMutation` to the mutation, this copies its contents.
+  BulkMutationBuilder& Add(SingleRowMutation mutation);
+
+  /// Return true if there are no mutations in this builder.
+  bool empty() const { return request_->entries().empty(); }
+
+  /// Return the number of rows in this builder.
+  std::size_t size() const { return request_->entries().size(); }
+
+  /// Return the estimated size in bytes of all the mutations in this builder.
+  std::size_t estimated_size_in_bytes() const {
+    return request_->ByteSizeLong();
+  }
+
+  /**
+   * Return the mutations as a `BulkMutation`, without copying them.
+   *
+   * The builder is reset to an empty state, using a new arena.
+   */
+  BulkMutation Build();
+
+ private:
+  void Reset();
+
+  std::size_t initial_block_size_;
+  std::shared_ptr<google::bigtable::v2::MutateRowsRequest> request_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BULK_MUTATION_BUILDER_H
@@ -0,0 +1,148 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/bulk_mutation_builder.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+namespace btproto = google::bigtable::v2;
+using namespace google::cloud::testing_util::chrono_literals;
+
+btproto::MutateRowsRequest ToProto(BulkMutation mutation) {
+  btproto::MutateRowsRequest request;
+  mutation.MoveTo(&request);
+  return request;
+}
+
+TEST(BulkMutationBuilderTest, Empty) {
+  BulkMutationBuilder builder;
+  EXPECT_TRUE(builder.empty());
+  EXPECT_EQ(0, builder.size());
+
+  auto mutation = builder.Build();
+  EXPECT_TRUE(mutation.empty());
+  EXPECT_EQ(0, mutation.size());
+}
+
+TEST(BulkMutationBuilderTest, AddRow) {
+  BulkMutationBuilder builder(1024);
+  builder.AddRow("r1")
+      .SetCell("fam", "c1", 1234_ms, "v1")
+      .SetCell("fam", "c2", "v2");
+  builder.AddRow("r2")
+      .DeleteFromColumn("fam", "c1")
+      .DeleteFromFamily("fam")
+      .DeleteFromRow();
+  EXPECT_FALSE(builder.empty());
+  EXPECT_EQ(2, builder.size());
+  auto const estimated = builder.estimated_size_in_bytes();
+  EXPECT_LT(0, estimated);
+
+  auto mutation = builder.Build();
+  EXPECT_EQ(2, mutation.size());
+  EXPECT_EQ(estimated, mutation.estimated_size_in_bytes());
+  EXPECT_TRUE(builder.empty());
+
+  auto request = ToProto(std::move(mutation));
+  ASSERT_EQ(2, request.entries_size());
+  auto const& r1 = request.entries(0);
+  EXPECT_EQ("r1", r1.row_key());
+  ASSERT_EQ(2, r1.mutations_size());
+  EXPECT_EQ("fam", r1.mutations(0).set_cell().family_name());
+  EXPECT_EQ("c1", r1.mutations(0).set_cell().column_qualifier());
+  EXPECT_EQ(1234000, r1.mutations(0).set_cell().timestamp_micros());
+  EXPECT_EQ("v1", r1.mutations(0).set_cell().value());
+  EXPECT_EQ("c2", r1.mutations(1).set_cell().column_qualifier());
+  EXPECT_EQ(ServerSetTimestamp(),
+            r1.mutations(1).set_cell().timestamp_micros());
+
+  auto const& r2 = request.entries(1);
+  EXPECT_EQ("r2", r2.row_key());
+  ASSERT_EQ(3, r2.mutations_size());
+  EXPECT_EQ("c1", r2.mutations(0).delete_from_column().column_qualifier());
+  EXPECT_EQ("fam", r2.mutations(1).delete_from_family().family_name());
+  EXPECT_TRUE(r2.mutations(2).has_delete_from_row());
+}
+
+TEST(BulkMutationBuilderTest, AddSingleRowMutation) {
+  SingleRowMutation m("r1", SetCell("fam", "c1", 0_ms, "v1"));
+  BulkMutationBuilder builder;
+  builder.Add(m).Add(SingleRowMutation("r2", DeleteFromRow()));
+  EXPECT_EQ(2, builder.size());
+  // The original mutation is not modified.
+  btproto::MutateRowsRequest::Entry original;
+  m.MoveTo(&original);
+  EXPECT_EQ("r1", original.row_key());
+  EXPECT_EQ(1, original.mutations_size());
+
+  auto request = ToProto(builder.Build());
+  ASSERT_EQ(2, request.entries_size());
+  EXPECT_EQ("r1", request.entries(0).row_key());
+  ASSERT_EQ(1, request.entries(0).mutations_size());
+  EXPECT_EQ("v1", request.entries(0).mutations(0).set_cell().value());
+  EXPECT_EQ("r2", request.entries(1).row_key());
+}
+
+TEST(BulkMutationBuilderTest, BuildResets) {
+  BulkMutationBuilder builder;
+  builder.AddRow("r1").DeleteFromRow();
+  auto m1 = builder.Build();
+  builder.AddRow("r2").DeleteFromRow();
+  builder.AddRow("r3").DeleteFromRow();
+  auto m2 = builder.Build();
+
+  // Each mutation owns its own arena, they remain valid after the builder is
+  // gone.
+  builder = BulkMutationBuilder();
+  auto r1 = ToProto(std::move(m1));
+  auto r2 = ToProto(std::move(m2));
+  ASSERT_EQ(1, r1.entries_size());
+  EXPECT_EQ("r1", r1.entries(0).row_key());
+  ASSERT_EQ(2, r2.entries_size());
+  EXPECT_EQ("r2", r2.entries(0).row_key());
+  EXPECT_EQ("r3", r2.entries(1).row_key());
+}
+
+TEST(BulkMutationBuilderTest, CopyAndAppend) {
+  BulkMutationBuilder builder;
+  builder.AddRow("r1").DeleteFromRow();
+  auto mutation = builder.Build();
+
+  // Copies of an arena-backed mutation are independent of the original.
+  BulkMutation copy = mutation;
+  copy.emplace_back(SingleRowMutation("r2", DeleteFromRow()));
+  mutation.emplace_back(SingleRowMutation("r3", DeleteFromRow()));
+  EXPECT_EQ(2, copy.size());
+  EXPECT_EQ(2, mutation.size());
+
+  auto request = ToProto(std::move(mutation));
+  ASSERT_EQ(2, request.entries_size());
+  EXPECT_EQ("r1", request.entries(0).row_key());
+  EXPECT_EQ("r3", request.entries(1).row_key());
+  request = ToProto(std::move(copy));
+  ASSERT_EQ(2, request.entries_size());
+  EXPECT_EQ("r2", request.entries(1).row_key());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,104 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CELL_STREAM_HANDLER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CELL_STREAM_HANDLER_H
+
+#include "google/cloud/bigtable/cell.h"
+#include "google/cloud/bigtable/row_key.h"
+#include "google/cloud/bigtable/version.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * The metadata for a cell delivered by `Table::StreamRows()`.
+ *
+ * The value of the cell is not part of the header, it is delivered separately,
+ * possibly in multiple pieces, via `CellStreamHandler::OnCellValue()`.
+ */
+struct CellHeader {
+  RowKeyType row_key;
+  std::string family_name;
+  ColumnQualifierType column_qualifier;
+  std::int64_t timestamp_micros;
+  std::vector<std::string> labels;
+
+  /**
+   * The total size of the value, if the service splits it across chunks.
+   *
+   * This is zero when the value arrives in a single chunk, otherwise it is the
+   * hint sent by the service, and can be used to pre-allocate buffers.
+   */
+  std::int64_t value_size;
+};
+
+/**
+ * Receives the cells of a `Table::StreamRows()` scan as they arrive.
+ *
+ * `Table::ReadRows()` accumulates all the cells of a row before returning it
+ * to the application, which requires the full row to fit in memory. Rows with
+ * millions of cells, or with very large values, are better consumed using
+ * this interface: the library only buffers the chunk it is parsing, and
+ * delivers the data to the handler in the order received from the service.
+ *
+ * The callbacks for one row are always delivered in this sequence:
+ * - For each cell: one call to `OnCellStart()`, zero or more calls to
+ *   `OnCellValue()`, and one call to `OnCellEnd()`.
+ * - Then exactly one of `OnRowCommit()` or `OnRowReset()`.
+ *
+ * A call to `OnRowReset()` means that all the cells delivered since the
+ * previous `OnRowCommit()` must be discarded, including any partial cell, as
+ * `OnRowReset()` may arrive before the `OnCellEnd()` for the current cell. The
+ * service can reset a row at any time, and the library also resets the current
+ * row when the stream is interrupted and the scan is resumed. In both cases
+ * the row is delivered again, from its first cell.
+ *
+ * All the callbacks are invoked from the thread calling `Table::StreamRows()`.
+ */
+class CellStreamHandler {
+ public:
+  virtual ~CellStreamHandler() = default;
+
+  /// A new cell starts, its value follows in calls to `OnCellValue()`.
+  virtual void OnCellStart(CellHeader header) = 0;
+
+  /// Receive the next piece of the value for the current cell.
+  virtual void OnCellValue(CellValueType value) = 0;
+
+  /// The current cell is complete.
+  virtual void OnCellEnd() = 0;
+
+  /**
+   * All the cells for @p row_key have been delivered.
+   *
+   * @return `false` to stop the scan, in which case `Table::StreamRows()`
+   *     cancels the request and returns an OK status.
+   */
+  virtual bool OnRowCommit(RowKeyType const& row_key) = 0;
+
+  /// Discard any cells for @p row_key received since the last commit.
+  virtual void OnRowReset(RowKeyType const& row_key) = 0;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CELL_STREAM_HANDLER_H
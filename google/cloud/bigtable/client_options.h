@@ -291,6 +291,26 @@ class ClientOptions {
     channel_arguments_.SetSslTargetNameOverride(name);
   }
 
+  /**
+   * Use the gRPC callback API for asynchronous data operations.
+   *
+   * By default the asynchronous operations in `Table` run on the
+   * `CompletionQueue` provided by the application, and all the responses are
+   * delivered through the threads running that completion queue. With this
+   * option the `Async*()` RPCs in `Table` (including `AsyncReadRows()` and
+   * `AsyncBulkApply()`) use the gRPC callback API instead, the responses are
+   * delivered from threads owned by gRPC. This avoids one hand-off between
+   * threads per response, but the application callbacks must not block. The
+   * completion queue is still used for the backoff timers between retries.
+   */
+  ClientOptions& set_use_callback_api(bool use_callback_api) {
+    use_callback_api_ = use_callback_api;
+    return *this;
+  }
+
+  /// Return true if the asynchronous data operations use the callback API.
+  bool use_callback_api() const { return use_callback_api_; }
+
   /// Return the user agent prefix used by the library.
   static std::string UserAgentPrefix();
 
@@ -314,6 +334,7 @@ class ClientOptions {
   // testing, where the emulator for instance admin operations may be different
   // than the emulator for admin and data operations.
   std::string instance_admin_endpoint_;
+  bool use_callback_api_ = false;
 };
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
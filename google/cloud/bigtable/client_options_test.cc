@@ -420,6 +420,13 @@ TEST(ClientOptionsTest, SetSslTargetNameOverride) {
             grpc::string(test_args.args[3].key));
 }
 
+TEST(ClientOptionsTest, UseCallbackApi) {
+  bigtable::ClientOptions client_options_object = bigtable::ClientOptions();
+  EXPECT_FALSE(client_options_object.use_callback_api());
+  client_options_object.set_use_callback_api(true);
+  EXPECT_TRUE(client_options_object.use_callback_api());
+}
+
 TEST(ClientOptionsTest, UserAgentPrefix) {
   std::string const actual = bigtable::ClientOptions::UserAgentPrefix();
 
@@ -14,6 +14,7 @@
 
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/internal/common_client.h"
+#include "google/cloud/internal/throw_delegate.h"
 
 namespace btproto = google::bigtable::v2;
 
@@ -45,6 +46,7 @@ class DefaultDataClient : public DataClient {
                     ClientOptions options)
       : project_(std::move(project)),
         instance_(std::move(instance)),
+        use_callback_api_(options.use_callback_api()),
         impl_(std::move(options)) {}
 
   DefaultDataClient(std::string project, std::string instance)
@@ -159,9 +161,59 @@ class DefaultDataClient : public DataClient {
     return impl_.Stub()->PrepareAsyncMutateRows(context, request, cq);
   }
 
+  bool UseCallbackApi() const override { return use_callback_api_; }
+
+  void CallbackMutateRow(grpc::ClientContext* context,
+                         btproto::MutateRowRequest const* request,
+                         btproto::MutateRowResponse* response,
+                         std::function<void(grpc::Status)> on_done) override {
+    auto stub = impl_.Stub();
+    google::cloud::internal::CallbackStub(*stub)->MutateRow(
+        context, request, response, std::move(on_done));
+  }
+
+  void CallbackCheckAndMutateRow(
+      grpc::ClientContext* context,
+      btproto::CheckAndMutateRowRequest const* request,
+      btproto::CheckAndMutateRowResponse* response,
+      std::function<void(grpc::Status)> on_done) override {
+    auto stub = impl_.Stub();
+    google::cloud::internal::CallbackStub(*stub)->CheckAndMutateRow(
+        context, request, response, std::move(on_done));
+  }
+
+  void CallbackReadModifyWriteRow(
+      grpc::ClientContext* context,
+      btproto::ReadModifyWriteRowRequest const* request,
+      btproto::ReadModifyWriteRowResponse* response,
+      std::function<void(grpc::Status)> on_done) override {
+    auto stub = impl_.Stub();
+    google::cloud::internal::CallbackStub(*stub)->ReadModifyWriteRow(
+        context, request, response, std::move(on_done));
+  }
+
+  void CallbackReadRows(grpc::ClientContext* context,
+                        btproto::ReadRowsRequest const* request,
+                        google::cloud::internal::ClientReadReactor<
+                            btproto::ReadRowsResponse>* reactor) override {
+    auto stub = impl_.Stub();
+    google::cloud::internal::CallbackStub(*stub)->ReadRows(context, request,
+                                                           reactor);
+  }
+
+  void CallbackMutateRows(grpc::ClientContext* context,
+                          btproto::MutateRowsRequest const* request,
+                          google::cloud::internal::ClientReadReactor<
+                              btproto::MutateRowsResponse>* reactor) override {
+    auto stub = impl_.Stub();
+    google::cloud::internal::CallbackStub(*stub)->MutateRows(context, request,
+                                                             reactor);
+  }
+
  private:
   std::string project_;
   std::string instance_;
+  bool use_callback_api_;
   Impl impl_;
 };
 
@@ -170,6 +222,46 @@ std::string const& DefaultDataClient::project_id() const { return project_; }
 std::string const& DefaultDataClient::instance_id() const { return instance_; }
 }  // namespace internal
 
+namespace {
+[[noreturn]] void CallbackApiUnimplemented(char const* function_name) {
+  google::cloud::internal::ThrowLogicError(
+      std::string(function_name) +
+      ": DataClient::UseCallbackApi() returned true, but this function is not"
+      " overridden");
+}
+}  // namespace
+
+void DataClient::CallbackMutateRow(grpc::ClientContext*,
+                                   btproto::MutateRowRequest const*,
+                                   btproto::MutateRowResponse*,
+                                   std::function<void(grpc::Status)>) {
+  CallbackApiUnimplemented(__func__);
+}
+
+void DataClient::CallbackCheckAndMutateRow(
+    grpc::ClientContext*, btproto::CheckAndMutateRowRequest const*,
+    btproto::CheckAndMutateRowResponse*, std::function<void(grpc::Status)>) {
+  CallbackApiUnimplemented(__func__);
+}
+
+void DataClient::CallbackReadModifyWriteRow(
+    grpc::ClientContext*, btproto::ReadModifyWriteRowRequest const*,
+    btproto::ReadModifyWriteRowResponse*, std::function<void(grpc::Status)>) {
+  CallbackApiUnimplemented(__func__);
+}
+
+void DataClient::CallbackReadRows(
+    grpc::ClientContext*, btproto::ReadRowsRequest const*,
+    google::cloud::internal::ClientReadReactor<btproto::ReadRowsResponse>*) {
+  CallbackApiUnimplemented(__func__);
+}
+
+void DataClient::CallbackMutateRows(
+    grpc::ClientContext*, btproto::MutateRowsRequest const*,
+    google::cloud::internal::ClientReadReactor<btproto::MutateRowsResponse>*) {
+  CallbackApiUnimplemented(__func__);
+}
+
 std::shared_ptr<DataClient> CreateDefaultDataClient(std::string project_id,
                                                     std::string instance_id,
                                                     ClientOptions options) {
@@ -19,7 +19,9 @@
 #include "google/cloud/bigtable/completion_queue.h"
 #include "google/cloud/bigtable/row.h"
 #include "google/cloud/bigtable/version.h"
+#include "google/cloud/internal/async_callback_rpc.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <functional>
 
 namespace google {
 namespace cloud {
@@ -172,6 +174,54 @@ class DataClient {
       const ::google::bigtable::v2::MutateRowsRequest& request,
       ::grpc::CompletionQueue* cq) = 0;
   //@}
+
+  /**
+   * Return true if the asynchronous operations should use the callback API.
+   *
+   * When this returns `true` the asynchronous operations in `Table` use the
+   * `Callback*()` member functions, instead of the `Async*()` and
+   * `PrepareAsync*()` functions. The default implementation returns `false`,
+   * so existing implementations of this class (including mocks) are
+   * unaffected.
+   *
+   * @see `ClientOptions::set_use_callback_api()`
+   */
+  virtual bool UseCallbackApi() const { return false; }
+
+  //@{
+  /**
+   * @name the `google.bigtable.v2.Bigtable` wrappers for the gRPC callback API.
+   *
+   * These mirror the signatures of the gRPC-generated callback interface. The
+   * default implementations raise a `std::logic_error`, classes that return
+   * `true` from `UseCallbackApi()` must override all of them.
+   */
+  virtual void CallbackMutateRow(
+      grpc::ClientContext* context,
+      google::bigtable::v2::MutateRowRequest const* request,
+      google::bigtable::v2::MutateRowResponse* response,
+      std::function<void(grpc::Status)> on_done);
+  virtual void CallbackCheckAndMutateRow(
+      grpc::ClientContext* context,
+      google::bigtable::v2::CheckAndMutateRowRequest const* request,
+      google::bigtable::v2::CheckAndMutateRowResponse* response,
+      std::function<void(grpc::Status)> on_done);
+  virtual void CallbackReadModifyWriteRow(
+      grpc::ClientContext* context,
+      google::bigtable::v2::ReadModifyWriteRowRequest const* request,
+      google::bigtable::v2::ReadModifyWriteRowResponse* response,
+      std::function<void(grpc::Status)> on_done);
+  virtual void CallbackReadRows(
+      grpc::ClientContext* context,
+      google::bigtable::v2::ReadRowsRequest const* request,
+      google::cloud::internal::ClientReadReactor<
+          google::bigtable::v2::ReadRowsResponse>* reactor);
+  virtual void CallbackMutateRows(
+      grpc::ClientContext* context,
+      google::bigtable::v2::MutateRowsRequest const* request,
+      google::cloud::internal::ClientReadReactor<
+          google::bigtable::v2::MutateRowsResponse>* reactor);
+  //@}
 };
 
 /// Create the default implementation of ClientInterface.
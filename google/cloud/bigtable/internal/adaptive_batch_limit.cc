@@ -0,0 +1,61 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/adaptive_batch_limit.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+AdaptiveBatchLimit::AdaptiveBatchLimit(std::size_t min_limit,
+                                       std::size_t max_limit,
+                                       std::chrono::microseconds target_latency,
+                                       double max_error_rate)
+    : min_limit_((std::max)(min_limit, std::size_t{1})),
+      max_limit_((std::max)(max_limit, min_limit_)),
+      target_latency_(target_latency),
+      max_error_rate_(max_error_rate),
+      limit_(max_limit_),
+      healthy_batches_(0),
+      // Allow the first overloaded batch to reduce the limit.
+      batches_since_decrease_(max_limit_) {}
+
+void AdaptiveBatchLimit::OnBatchComplete(std::chrono::microseconds latency,
+                                         std::size_t mutations,
+                                         std::size_t failures) {
+  ++batches_since_decrease_;
+  bool const too_slow =
+      target_latency_.count() > 0 && latency > target_latency_;
+  bool const too_many_errors =
+      mutations > 0 && static_cast<double>(failures) >
+                           max_error_rate_ * static_cast<double>(mutations);
+  if (too_slow || too_many_errors) {
+    healthy_batches_ = 0;
+    if (batches_since_decrease_ < limit_) return;
+    limit_ = (std::max)(min_limit_, limit_ / 2);
+    batches_since_decrease_ = 0;
+    return;
+  }
+  if (++healthy_batches_ < limit_) return;
+  healthy_batches_ = 0;
+  limit_ = (std::min)(max_limit_, limit_ + 1);
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
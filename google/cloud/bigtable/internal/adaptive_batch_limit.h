@@ -0,0 +1,78 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ADAPTIVE_BATCH_LIMIT_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ADAPTIVE_BATCH_LIMIT_H
+
+#include "google/cloud/bigtable/version.h"
+#include <chrono>
+#include <cstddef>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Adjusts the number of outstanding batches based on their latency and errors.
+ *
+ * This implements additive-increase/multiplicative-decrease (AIMD): the limit
+ * grows by one after a full round of healthy batches (as many batches as the
+ * current limit), and it is halved when a batch is slower than the latency
+ * target or has too many failed mutations. Batches that were already in
+ * flight when the limit was reduced reflect the old load, so the limit is
+ * reduced at most once per round.
+ *
+ * This class is not thread-safe, the caller must provide synchronization.
+ */
+class AdaptiveBatchLimit {
+ public:
+  /**
+   * Creates a controller starting at @p max_limit.
+   *
+   * @param min_limit the limit never goes below this value (or 1).
+   * @param max_limit the limit never goes above this value.
+   * @param target_latency batches slower than this reduce the limit, zero
+   *     disables the latency check.
+   * @param max_error_rate batches where the fraction of failed mutations
+   *     exceeds this value reduce the limit.
+   */
+  AdaptiveBatchLimit(std::size_t min_limit, std::size_t max_limit,
+                     std::chrono::microseconds target_latency,
+                     double max_error_rate);
+
+  /// The current limit on outstanding batches.
+  std::size_t limit() const { return limit_; }
+
+  /// Update the limit after a batch completes.
+  void OnBatchComplete(std::chrono::microseconds latency,
+                       std::size_t mutations, std::size_t failures);
+
+ private:
+  std::size_t min_limit_;
+  std::size_t max_limit_;
+  std::chrono::microseconds target_latency_;
+  double max_error_rate_;
+  std::size_t limit_;
+  std::size_t healthy_batches_;
+  std::size_t batches_since_decrease_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ADAPTIVE_BATCH_LIMIT_H
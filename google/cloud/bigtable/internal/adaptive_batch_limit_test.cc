@@ -0,0 +1,84 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/adaptive_batch_limit.h"
+#include <gmock/gmock.h>
+
+namespace bigtable = google::cloud::bigtable;
+using bigtable::internal::AdaptiveBatchLimit;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+TEST(AdaptiveBatchLimitTest, StartsAtMaximum) {
+  AdaptiveBatchLimit limit(1, 8, milliseconds(100), 0.1);
+  EXPECT_EQ(8U, limit.limit());
+}
+
+TEST(AdaptiveBatchLimitTest, InvalidBounds) {
+  AdaptiveBatchLimit limit(0, 0, milliseconds(100), 0.1);
+  EXPECT_EQ(1U, limit.limit());
+  limit.OnBatchComplete(milliseconds(200), 1, 0);
+  EXPECT_EQ(1U, limit.limit());
+}
+
+TEST(AdaptiveBatchLimitTest, SlowBatchesHalveTheLimit) {
+  AdaptiveBatchLimit limit(2, 16, milliseconds(100), 0.1);
+  limit.OnBatchComplete(milliseconds(200), 10, 0);
+  EXPECT_EQ(8U, limit.limit());
+
+  // The batches already in flight do not reduce the limit again.
+  for (int i = 0; i != 7; ++i) {
+    limit.OnBatchComplete(milliseconds(200), 10, 0);
+    EXPECT_EQ(8U, limit.limit());
+  }
+  limit.OnBatchComplete(milliseconds(200), 10, 0);
+  EXPECT_EQ(4U, limit.limit());
+
+  // Never below the minimum.
+  for (int i = 0; i != 100; ++i) {
+    limit.OnBatchComplete(milliseconds(200), 10, 0);
+  }
+  EXPECT_EQ(2U, limit.limit());
+}
+
+TEST(AdaptiveBatchLimitTest, ErrorsHalveTheLimit) {
+  AdaptiveBatchLimit limit(1, 8, milliseconds(0), 0.1);
+  // At the threshold is still healthy.
+  limit.OnBatchComplete(milliseconds(500), 10, 1);
+  EXPECT_EQ(8U, limit.limit());
+  limit.OnBatchComplete(milliseconds(500), 10, 2);
+  EXPECT_EQ(4U, limit.limit());
+}
+
+TEST(AdaptiveBatchLimitTest, HealthyBatchesIncreaseTheLimit) {
+  AdaptiveBatchLimit limit(1, 4, milliseconds(100), 0.1);
+  limit.OnBatchComplete(milliseconds(200), 10, 0);
+  EXPECT_EQ(2U, limit.limit());
+
+  // One full round of healthy batches adds one to the limit.
+  limit.OnBatchComplete(milliseconds(10), 10, 0);
+  EXPECT_EQ(2U, limit.limit());
+  limit.OnBatchComplete(milliseconds(10), 10, 0);
+  EXPECT_EQ(3U, limit.limit());
+  for (int i = 0; i != 3; ++i) {
+    limit.OnBatchComplete(microseconds(10), 10, 0);
+  }
+  EXPECT_EQ(4U, limit.limit());
+
+  // Never above the maximum.
+  for (int i = 0; i != 100; ++i) {
+    limit.OnBatchComplete(microseconds(10), 10, 0);
+  }
+  EXPECT_EQ(4U, limit.limit());
+}
@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/internal/async_bulk_apply.h"
+#include "google/cloud/internal/async_callback_rpc.h"
 #include "google/cloud/internal/make_unique.h"
+#include <iterator>
 
 namespace google {
 namespace cloud {
@@ -28,11 +30,11 @@ future<std::vector<FailedMutation>> AsyncRetryBulkApply::Create(
     MetadataUpdatePolicy metadata_update_policy,
     std::shared_ptr<bigtable::DataClient> client,
     std::string const& app_profile_id, std::string const& table_name,
-    BulkMutation mut) {
+    BulkMutation mut, MutationDoneCallback on_mutation_done) {
   std::shared_ptr<AsyncRetryBulkApply> bulk_apply(new AsyncRetryBulkApply(
       std::move(rpc_retry_policy), std::move(rpc_backoff_policy),
       idempotent_policy, std::move(metadata_update_policy), std::move(client),
-      app_profile_id, table_name, std::move(mut)));
+      app_profile_id, table_name, std::move(mut), std::move(on_mutation_done)));
   bulk_apply->StartIterationIfNeeded(std::move(cq));
   return bulk_apply->promise_.get_future();
 }
@@ -44,12 +46,13 @@ AsyncRetryBulkApply::AsyncRetryBulkApply(
     MetadataUpdatePolicy metadata_update_policy,
     std::shared_ptr<bigtable::DataClient> client,
     std::string const& app_profile_id, std::string const& table_name,
-    BulkMutation mut)
+    BulkMutation mut, MutationDoneCallback on_mutation_done)
     : rpc_retry_policy_(std::move(rpc_retry_policy)),
       rpc_backoff_policy_(std::move(rpc_backoff_policy)),
       metadata_update_policy_(std::move(metadata_update_policy)),
       client_(std::move(client)),
-      state_(app_profile_id, table_name, idempotent_policy, std::move(mut)) {}
+      state_(app_profile_id, table_name, idempotent_policy, std::move(mut)),
+      on_mutation_done_(std::move(on_mutation_done)) {}
 
 void AsyncRetryBulkApply::StartIterationIfNeeded(CompletionQueue cq) {
   if (!state_.HasPendingMutations()) {
@@ -57,7 +60,17 @@ void AsyncRetryBulkApply::StartIterationIfNeeded(CompletionQueue cq) {
     // in the case of the retry policy begin expired we hit this point because
     // the mutations are no longer "pending", they are all resolved with a
     // error status.
-    promise_.set_value(std::move(state_).OnRetryDone());
+    auto failures = std::move(state_).OnRetryDone();
+    if (on_mutation_done_) {
+      for (auto const& f : failures) {
+        on_mutation_done_(f.original_index(), f.status());
+      }
+      failures.insert(failures.begin(),
+                      std::make_move_iterator(reported_failures_.begin()),
+                      std::make_move_iterator(reported_failures_.end()));
+      reported_failures_.clear();
+    }
+    promise_.set_value(std::move(failures));
     return;
   }
 
@@ -67,30 +80,55 @@ void AsyncRetryBulkApply::StartIterationIfNeeded(CompletionQueue cq) {
   metadata_update_policy_.Setup(*context);
   auto client = client_;
   auto self = shared_from_this();
+  auto on_read = [self](google::bigtable::v2::MutateRowsResponse r) {
+    self->OnRead(std::move(r));
+    return make_ready_future(true);
+  };
+  auto on_finish = [self, cq](Status s) { self->OnFinish(cq, std::move(s)); };
+  if (client->UseCallbackApi()) {
+    google::cloud::internal::MakeCallbackStreamingReadRpc<
+        google::bigtable::v2::MutateRowsResponse>(
+        [client](grpc::ClientContext* context,
+                 google::bigtable::v2::MutateRowsRequest const* request,
+                 google::cloud::internal::ClientReadReactor<
+                     google::bigtable::v2::MutateRowsResponse>* reactor) {
+          client->CallbackMutateRows(context, request, reactor);
+        },
+        state_.BeforeStart(), std::move(context), std::move(on_read),
+        std::move(on_finish));
+    return;
+  }
   cq.MakeStreamingReadRpc(
       [client](grpc::ClientContext* context,
                google::bigtable::v2::MutateRowsRequest const& request,
                grpc::CompletionQueue* cq) {
         return client->PrepareAsyncMutateRows(context, request, cq);
       },
-      state_.BeforeStart(), std::move(context),
-      [self, cq](google::bigtable::v2::MutateRowsResponse r) {
-        self->OnRead(std::move(r));
-        return make_ready_future(true);
-      },
-      [self, cq](Status s) { self->OnFinish(cq, std::move(s)); });
+      state_.BeforeStart(), std::move(context), std::move(on_read),
+      std::move(on_finish));
 }
 
 void AsyncRetryBulkApply::OnRead(
     google::bigtable::v2::MutateRowsResponse response) {
-  state_.OnRead(response);
+  auto succeeded = state_.OnRead(response);
+  if (!on_mutation_done_) return;
+  for (auto index : succeeded) on_mutation_done_(index, Status());
+  ReportFailures();
 }
 
 void AsyncRetryBulkApply::OnFinish(CompletionQueue cq, Status status) {
   state_.OnFinish(std::move(status));
+  if (on_mutation_done_) ReportFailures();
   StartIterationIfNeeded(std::move(cq));
 }
 
+void AsyncRetryBulkApply::ReportFailures() {
+  for (auto& f : state_.ConsumeAccumulatedFailures()) {
+    on_mutation_done_(f.original_index(), f.status());
+    reported_failures_.push_back(std::move(f));
+  }
+}
+
 }  // namespace internal
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
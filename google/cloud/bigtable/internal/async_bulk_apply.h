@@ -23,6 +23,7 @@
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/internal/make_unique.h"
+#include <functional>
 
 namespace google {
 namespace cloud {
@@ -36,10 +37,19 @@ namespace internal {
  * retry loops: only those mutations that are idempotent and had a transient
  * failure can be retried, and the result for each mutation arrives in a stream.
  * This class implements that retry loop.
+ *
+ * If `on_mutation_done` is set it is called with the original index and final
+ * status of each mutation as soon as that status is known, that is, as soon as
+ * the mutation succeeds or fails with a permanent error. The callbacks are
+ * invoked serially, and all of them are invoked before the returned future is
+ * satisfied.
  */
 class AsyncRetryBulkApply
     : public std::enable_shared_from_this<AsyncRetryBulkApply> {
  public:
+  using MutationDoneCallback =
+      std::function<void(int, google::cloud::Status const&)>;
+
   static future<std::vector<FailedMutation>> Create(
       CompletionQueue cq, std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
       std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
@@ -47,7 +57,7 @@ class AsyncRetryBulkApply
       MetadataUpdatePolicy metadata_update_policy,
       std::shared_ptr<bigtable::DataClient> client,
       std::string const& app_profile_id, std::string const& table_name,
-      BulkMutation mut);
+      BulkMutation mut, MutationDoneCallback on_mutation_done = {});
 
  private:
   AsyncRetryBulkApply(std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
@@ -56,10 +66,14 @@ class AsyncRetryBulkApply
                       MetadataUpdatePolicy metadata_update_policy,
                       std::shared_ptr<bigtable::DataClient> client,
                       std::string const& app_profile_id,
-                      std::string const& table_name, BulkMutation mut);
+                      std::string const& table_name, BulkMutation mut,
+                      MutationDoneCallback on_mutation_done);
 
   void StartIterationIfNeeded(CompletionQueue cq);
 
+  /// Report any new permanent failures to `on_mutation_done_`.
+  void ReportFailures();
+
   void OnRead(google::bigtable::v2::MutateRowsResponse response);
   void OnFinish(CompletionQueue cq, google::cloud::Status status);
 
@@ -68,6 +82,9 @@ class AsyncRetryBulkApply
   MetadataUpdatePolicy metadata_update_policy_;
   std::shared_ptr<bigtable::DataClient> client_;
   BulkMutatorState state_;
+  MutationDoneCallback on_mutation_done_;
+  /// The failures already reported to `on_mutation_done_`.
+  std::vector<FailedMutation> reported_failures_;
   promise<std::vector<FailedMutation>> promise_;
 };
 
@@ -26,6 +26,20 @@ namespace internal {
 
 namespace btproto = google::bigtable::v2;
 
+namespace {
+/// Create a request in the same arena (if any) as @p owner.
+std::shared_ptr<btproto::MutateRowsRequest> MakeRequest(
+    std::shared_ptr<btproto::MutateRowsRequest> const& owner) {
+  auto* arena = owner->GetArena();
+  if (arena == nullptr) return std::make_shared<btproto::MutateRowsRequest>();
+  // `owner` keeps the arena alive, share its control block.
+  return std::shared_ptr<btproto::MutateRowsRequest>(
+      owner,
+      google::protobuf::Arena::CreateMessage<btproto::MutateRowsRequest>(
+          arena));
+}
+}  // namespace
+
 BulkMutatorState::BulkMutatorState(std::string const& app_profile_id,
                                    std::string const& table_name,
                                    IdempotentMutationPolicy& idempotent_policy,
@@ -34,22 +48,22 @@ BulkMutatorState::BulkMutatorState(std::string const& app_profile_id,
   // "pending_*" variables initializes the next request.  So in the constructor
   // we start by putting the data on the "pending_*" variables.
   // Move the mutations to the "pending" request proto, this is a zero copy
-  // optimization.
-  mut.MoveTo(&pending_mutations_);
-  pending_mutations_.set_app_profile_id(app_profile_id);
-  pending_mutations_.set_table_name(table_name);
+  // optimization, even if the mutations were built in an arena.
+  pending_mutations_ = mut.ReleaseRequest();
+  pending_mutations_->set_app_profile_id(app_profile_id);
+  pending_mutations_->set_table_name(table_name);
 
   // As we receive successful responses, we shrink the size of the request (only
   // those pending are resent).  But if any fails we want to report their index
   // in the original sequence provided by the user. This vector maps from the
   // index in the current sequence of mutations to the index in the original
   // sequence of mutations.
-  pending_annotations_.reserve(pending_mutations_.entries_size());
+  pending_annotations_.reserve(pending_mutations_->entries_size());
 
   // We save the idempotency of each mutation, to be used later as we decide if
   // they should be retried or not.
   int index = 0;
-  for (auto const& e : pending_mutations_.entries()) {
+  for (auto const& e : pending_mutations_->entries()) {
     // This is a giant && across all the mutations for each row.
     auto r = std::all_of(e.mutations().begin(), e.mutations().end(),
                          [&idempotent_policy](btproto::Mutation const& m) {
@@ -60,17 +74,17 @@ BulkMutatorState::BulkMutatorState(std::string const& app_profile_id,
 }
 
 google::bigtable::v2::MutateRowsRequest const& BulkMutatorState::BeforeStart() {
-  mutations_.Swap(&pending_mutations_);
+  mutations_ = std::move(pending_mutations_);
   annotations_.swap(pending_annotations_);
   for (auto& a : annotations_) {
     a.has_mutation_result = false;
   }
-  pending_mutations_ = {};
-  pending_mutations_.set_app_profile_id(mutations_.app_profile_id());
-  pending_mutations_.set_table_name(mutations_.table_name());
+  pending_mutations_ = MakeRequest(mutations_);
+  pending_mutations_->set_app_profile_id(mutations_->app_profile_id());
+  pending_mutations_->set_table_name(mutations_->table_name());
   pending_annotations_ = {};
 
-  return mutations_;
+  return *mutations_;
 }
 
 std::vector<int> BulkMutatorState::OnRead(
@@ -97,13 +111,13 @@ std::vector<int> BulkMutatorState::OnRead(
       res.push_back(annotation.original_index);
       continue;
     }
-    auto& original = *mutations_.mutable_entries(index);
+    auto& original = *mutations_->mutable_entries(index);
     // Failed responses are handled according to the current policies.
     if (SafeGrpcRetry::IsTransientFailure(code) && annotation.is_idempotent) {
       // Retryable requests are saved in the pending mutations, along with the
       // mapping from their index in pending_mutations_ to the original
       // vector and other miscellanea.
-      pending_mutations_.add_entries()->Swap(&original);
+      pending_mutations_->add_entries()->Swap(&original);
       pending_annotations_.push_back(annotation);
     } else {
       // Failures are saved for reporting, notice that we avoid copying, and
@@ -126,11 +140,11 @@ void BulkMutatorState::OnFinish(google::cloud::Status finish_status) {
       continue;
     }
     // If there are any mutations with unknown state, they need to be handled.
-    auto& original = *mutations_.mutable_entries(index);
+    auto& original = *mutations_->mutable_entries(index);
     if (annotation.is_idempotent) {
       // If the mutation was retryable, move it to the pending mutations to try
       // again, along with their index.
-      pending_mutations_.add_entries()->Swap(&original);
+      pending_mutations_->add_entries()->Swap(&original);
       pending_annotations_.push_back(annotation);
     } else {
       if (last_status_.ok()) {
@@ -160,7 +174,7 @@ std::vector<FailedMutation> BulkMutatorState::ConsumeAccumulatedFailures() {
 std::vector<FailedMutation> BulkMutatorState::OnRetryDone() && {
   std::vector<FailedMutation> result(std::move(failures_));
 
-  auto size = pending_mutations_.mutable_entries()->size();
+  auto size = pending_mutations_->mutable_entries()->size();
   for (int idx = 0; idx != size; idx++) {
     int original_index = pending_annotations_[idx].original_index;
     if (last_status_.ok()) {
@@ -35,7 +35,7 @@ class BulkMutatorState {
                    BulkMutation mut);
 
   bool HasPendingMutations() const {
-    return pending_mutations_.entries_size() != 0;
+    return pending_mutations_->entries_size() != 0;
   }
 
   /// Returns the Request parameter for the next MutateRows() RPC.
@@ -65,8 +65,14 @@ class BulkMutatorState {
   std::vector<FailedMutation> OnRetryDone() &&;
 
  private:
-  /// The current request proto.
-  google::bigtable::v2::MutateRowsRequest mutations_;
+  /**
+   * The current request proto.
+   *
+   * The request protos are allocated in the same arena (if any) as the
+   * `BulkMutation` used to create this object. The `std::shared_ptr<>` keeps
+   * the arena alive, and moving entries between the two requests is cheap.
+   */
+  std::shared_ptr<google::bigtable::v2::MutateRowsRequest> mutations_;
 
   /**
    * The status of the last MutateRows() RPC
@@ -104,7 +110,7 @@ class BulkMutatorState {
   std::vector<Annotations> annotations_;
 
   /// Accumulate mutations for the next request.
-  google::bigtable::v2::MutateRowsRequest pending_mutations_;
+  std::shared_ptr<google::bigtable::v2::MutateRowsRequest> pending_mutations_;
 
   /// Accumulate annotations for the next request.
   std::vector<Annotations> pending_annotations_;
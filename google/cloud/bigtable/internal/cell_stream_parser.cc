@@ -0,0 +1,157 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/cell_stream_parser.h"
+#include "google/cloud/bigtable/internal/google_bytes_traits.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+using google::bigtable::v2::ReadRowsResponse_CellChunk;
+
+void CellStreamParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
+                                   grpc::Status& status) {
+  if (end_of_stream_) {
+    status = grpc::Status(grpc::StatusCode::INTERNAL,
+                          "HandleChunk after end of stream");
+    return;
+  }
+  if (stopped_) {
+    status = grpc::Status(grpc::StatusCode::INTERNAL,
+                          "HandleChunk after the scan was stopped");
+    return;
+  }
+
+  if (chunk.reset_row()) {
+    // A reset chunk carries no cell data, so a non-zero value size means the
+    // service reset the row in the middle of a cell value.
+    if (chunk.value_size() != 0) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Reset row with an unfinished cell");
+      return;
+    }
+    if (row_key_.empty()) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Reset row without a row in progress");
+      return;
+    }
+    AbandonRow();
+    return;
+  }
+
+  if (!chunk.row_key().empty()) {
+    if (row_key_.empty()) {
+      if (CompareRowKey(last_committed_row_key_, chunk.row_key()) >= 0) {
+        status = grpc::Status(grpc::StatusCode::INTERNAL,
+                              "Row keys are expected in increasing order");
+        return;
+      }
+      using std::swap;
+      swap(*chunk.mutable_row_key(), row_key_);
+    } else if (row_key_ != chunk.row_key()) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Different row key in cell chunk");
+      return;
+    }
+  }
+
+  if (chunk.has_family_name()) {
+    if (!chunk.has_qualifier()) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "New column family must specify qualifier");
+      return;
+    }
+    using std::swap;
+    swap(*chunk.mutable_family_name()->mutable_value(), family_);
+  }
+
+  if (chunk.has_qualifier()) {
+    using std::swap;
+    swap(*chunk.mutable_qualifier()->mutable_value(), column_);
+  }
+
+  if (cell_first_chunk_) {
+    if (row_key_.empty()) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Missing row key in first chunk of cell");
+      return;
+    }
+    // The row, family, and column are copied because the service may omit
+    // them in future chunks. See the CellChunk comments in bigtable.proto.
+    CellHeader header{row_key_, family_, column_, chunk.timestamp_micros(),
+                      {}, chunk.value_size()};
+    std::move(chunk.mutable_labels()->begin(), chunk.mutable_labels()->end(),
+              std::back_inserter(header.labels));
+    handler_.OnCellStart(std::move(header));
+  }
+
+  if (!chunk.value().empty()) {
+    handler_.OnCellValue(std::move(*chunk.mutable_value()));
+  }
+
+  // Last chunk in the cell has zero for value size
+  cell_first_chunk_ = chunk.value_size() == 0;
+  if (cell_first_chunk_) {
+    handler_.OnCellEnd();
+  }
+
+  if (chunk.commit_row()) {
+    if (!cell_first_chunk_) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Commit row with an unfinished cell");
+      return;
+    }
+    using std::swap;
+    swap(last_committed_row_key_, row_key_);
+    row_key_.clear();
+    ++committed_rows_;
+    stopped_ = !handler_.OnRowCommit(last_committed_row_key_);
+  }
+}
+
+void CellStreamParser::HandleEndOfStream(grpc::Status& status) {
+  if (end_of_stream_) {
+    status = grpc::Status(grpc::StatusCode::INTERNAL,
+                          "HandleEndOfStream called twice");
+    return;
+  }
+  end_of_stream_ = true;
+
+  if (!cell_first_chunk_) {
+    status = grpc::Status(grpc::StatusCode::INTERNAL,
+                          "end of stream with unfinished cell");
+    return;
+  }
+
+  if (!row_key_.empty()) {
+    status = grpc::Status(grpc::StatusCode::INTERNAL,
+                          "end of stream with unfinished row");
+    return;
+  }
+}
+
+void CellStreamParser::AbandonRow() {
+  if (row_key_.empty()) return;
+  handler_.OnRowReset(row_key_);
+  row_key_.clear();
+  cell_first_chunk_ = true;
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,107 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_CELL_STREAM_PARSER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_CELL_STREAM_PARSER_H
+
+#include "google/cloud/bigtable/cell_stream_handler.h"
+#include "google/cloud/bigtable/version.h"
+#include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <cstdint>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Validates a stream of ReadRows chunks and forwards them to a handler.
+ *
+ * This class enforces the same rules as `ReadRowsParser`, but instead of
+ * accumulating the cells of a row it calls the `CellStreamHandler` callbacks
+ * as soon as each chunk is validated. Its memory usage does not depend on the
+ * size of the rows.
+ *
+ * NO RECYCLING of the parser object: a single parser should be used for each
+ * stream of ReadRows responses. After an error the parser is left in an
+ * undefined state.
+ */
+class CellStreamParser {
+ public:
+  explicit CellStreamParser(CellStreamHandler& handler)
+      : handler_(handler),
+        cell_first_chunk_(true),
+        committed_rows_(0),
+        end_of_stream_(false),
+        stopped_(false) {}
+
+  /**
+   * Pass an input chunk proto to the parser.
+   *
+   * On validation errors @p status is set to an INTERNAL error.
+   */
+  void HandleChunk(google::bigtable::v2::ReadRowsResponse_CellChunk chunk,
+                   grpc::Status& status);
+
+  /**
+   * Signal that the input stream reached the end.
+   *
+   * On validation errors @p status is set to an INTERNAL error.
+   */
+  void HandleEndOfStream(grpc::Status& status);
+
+  /**
+   * Discard the row in progress, if any.
+   *
+   * Called when the stream is interrupted, the handler receives
+   * `OnRowReset()` if it has received any data since the last commit.
+   */
+  void AbandonRow();
+
+  /// True if the handler asked to stop the scan.
+  bool stopped() const { return stopped_; }
+
+  /// The number of rows committed so far.
+  std::int64_t committed_rows() const { return committed_rows_; }
+
+  /// The key of the last committed row, empty if no row was committed.
+  RowKeyType const& last_committed_row_key() const {
+    return last_committed_row_key_;
+  }
+
+ private:
+  CellStreamHandler& handler_;
+
+  /// The key of the row in progress, empty between rows.
+  RowKeyType row_key_;
+  std::string family_;
+  ColumnQualifierType column_;
+
+  /// True iff the next chunk starts a new cell.
+  bool cell_first_chunk_;
+
+  RowKeyType last_committed_row_key_;
+  std::int64_t committed_rows_;
+  bool end_of_stream_;
+  bool stopped_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_CELL_STREAM_PARSER_H
@@ -0,0 +1,262 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/cell_stream_parser.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <google/protobuf/text_format.h>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+
+namespace bigtable = google::cloud::bigtable;
+using bigtable::internal::CellStreamParser;
+using google::bigtable::v2::ReadRowsResponse_CellChunk;
+
+namespace {
+/// Record the handler callbacks as strings, to simplify the assertions.
+class RecordingHandler : public bigtable::CellStreamHandler {
+ public:
+  void OnCellStart(bigtable::CellHeader header) override {
+    std::ostringstream os;
+    os << "start " << header.row_key << " " << header.family_name << ":"
+       << header.column_qualifier << " @" << header.timestamp_micros
+       << " size=" << header.value_size;
+    for (auto const& l : header.labels) os << " label=" << l;
+    events.push_back(os.str());
+  }
+  void OnCellValue(bigtable::CellValueType value) override {
+    events.push_back("value " + value);
+  }
+  void OnCellEnd() override { events.emplace_back("end"); }
+  bool OnRowCommit(bigtable::RowKeyType const& row_key) override {
+    events.push_back("commit " + row_key);
+    return --commits_before_stop != 0;
+  }
+  void OnRowReset(bigtable::RowKeyType const& row_key) override {
+    events.push_back("reset " + row_key);
+  }
+
+  std::vector<std::string> events;
+  int commits_before_stop = -1;
+};
+
+ReadRowsResponse_CellChunk ParseChunk(std::string const& text) {
+  ReadRowsResponse_CellChunk chunk;
+  if (!google::protobuf::TextFormat::ParseFromString(text, &chunk)) {
+    ADD_FAILURE() << "could not parse chunk: " << text;
+  }
+  return chunk;
+}
+}  // namespace
+
+TEST(CellStreamParserTest, NoChunksSucceeds) {
+  RecordingHandler handler;
+  CellStreamParser parser(handler);
+  grpc::Status status;
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+  EXPECT_TRUE(handler.events.empty());
+}
+
+TEST(CellStreamParserTest, HandleEndOfStreamCalledTwiceFails) {
+  RecordingHandler handler;
+  CellStreamParser parser(handler);
+  grpc::Status status;
+  parser.HandleEndOfStream(status);
+  parser.HandleEndOfStream(status);
+  EXPECT_FALSE(status.ok());
+}
+
+TEST(CellStreamParserTest, HandleChunkAfterEndOfStreamFails) {
+  RecordingHandler handler;
+  CellStreamParser parser(handler);
+  grpc::Status status;
+  parser.HandleEndOfStream(status);
+  parser.HandleChunk(ParseChunk(R"(row_key: "RK" value_size: 1)"), status);
+  EXPECT_FALSE(status.ok());
+  EXPECT_TRUE(handler.events.empty());
+}
+
+TEST(CellStreamParserTest, SplitValueIsDeliveredIncrementally) {
+  RecordingHandler handler;
+  CellStreamParser parser(handler);
+  grpc::Status status;
+  parser.HandleChunk(ParseChunk(R"(
+    row_key: "RK"
+    family_name: < value: "F">
+    qualifier: < value: "C">
+    timestamp_micros: 42
+    labels: "L"
+    value: "abc"
+    value_size: 6
+  )"),
+                     status);
+  ASSERT_TRUE(status.ok());
+  EXPECT_EQ(std::vector<std::string>({"start RK F:C @42 size=6 label=L",
+                                      "value abc"}),
+            handler.events);
+
+  parser.HandleChunk(ParseChunk(R"(value: "def" commit_row: true)"), status);
+  ASSERT_TRUE(status.ok());
+  EXPECT_EQ(std::vector<std::string>({"start RK F:C @42 size=6 label=L",
+                                      "value abc", "value def", "end",
+                                      "commit RK"}),
+            handler.events);
+  EXPECT_EQ("RK", parser.last_committed_row_key());
+  EXPECT_EQ(1, parser.committed_rows());
+
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+}
+
+TEST(CellStreamParserTest, AbandonRowResetsPartialRow) {
+  RecordingHandler handler;
+  CellStreamParser parser(handler);
+  grpc::Status status;
+  parser.HandleChunk(ParseChunk(R"(
+    row_key: "RK"
+    family_name: < value: "F">
+    qualifier: < value: "C">
+    value: "abc"
+    value_size: 6
+  )"),
+                     status);
+  ASSERT_TRUE(status.ok());
+  parser.AbandonRow();
+  EXPECT_EQ(std::vector<std::string>(
+                {"start RK F:C @0 size=6", "value abc", "reset RK"}),
+            handler.events);
+
+  // Abandoning again is a no-op, there is no row in progress.
+  parser.AbandonRow();
+  EXPECT_EQ(3U, handler.events.size());
+  EXPECT_EQ(0, parser.committed_rows());
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+}
+
+TEST(CellStreamParserTest, HandlerCanStopTheScan) {
+  RecordingHandler handler;
+  handler.commits_before_stop = 1;
+  CellStreamParser parser(handler);
+  grpc::Status status;
+  parser.HandleChunk(ParseChunk(R"(
+    row_key: "R1"
+    family_name: < value: "F">
+    qualifier: < value: "C">
+    value: "v"
+    commit_row: true
+  )"),
+                     status);
+  ASSERT_TRUE(status.ok());
+  EXPECT_TRUE(parser.stopped());
+
+  parser.HandleChunk(ParseChunk(R"(row_key: "R2" commit_row: true)"), status);
+  EXPECT_FALSE(status.ok());
+  EXPECT_EQ(4U, handler.events.size());
+}
+
+// **** Acceptance tests helpers ****
+
+namespace {
+/// Rebuild the rows from the callbacks, to compare against `ReadRowsParser`.
+class RowBuildingHandler : public bigtable::CellStreamHandler {
+ public:
+  void OnCellStart(bigtable::CellHeader header) override {
+    header_ = std::move(header);
+    value_.clear();
+  }
+  void OnCellValue(bigtable::CellValueType value) override {
+    value_ += value;
+  }
+  void OnCellEnd() override {
+    std::ostringstream os;
+    os << "rk: " << header_.row_key << "\n";
+    os << "fm: " << header_.family_name << "\n";
+    os << "qual: " << header_.column_qualifier << "\n";
+    os << "ts: " << header_.timestamp_micros << "\n";
+    os << "value: " << value_ << "\n";
+    os << "label: ";
+    char const* del = "";
+    for (auto const& label : header_.labels) {
+      os << del << label;
+      del = ",";
+    }
+    os << "\n";
+    pending_.push_back(os.str());
+  }
+  bool OnRowCommit(bigtable::RowKeyType const&) override {
+    std::move(pending_.begin(), pending_.end(), std::back_inserter(cells));
+    pending_.clear();
+    return true;
+  }
+  void OnRowReset(bigtable::RowKeyType const&) override { pending_.clear(); }
+
+  std::vector<std::string> cells;
+
+ private:
+  bigtable::CellHeader header_;
+  std::string value_;
+  std::vector<std::string> pending_;
+};
+}  // namespace
+
+class AcceptanceTest : public ::testing::Test {
+ protected:
+  AcceptanceTest() : parser_(handler_) {}
+
+  std::vector<std::string> ExtractCells() { return handler_.cells; }
+
+  std::vector<ReadRowsResponse_CellChunk> ConvertChunks(
+      std::vector<std::string> chunk_strings) {
+    using google::protobuf::TextFormat;
+
+    std::vector<ReadRowsResponse_CellChunk> chunks;
+    for (std::string const& chunk_string : chunk_strings) {
+      ReadRowsResponse_CellChunk chunk;
+      if (!TextFormat::ParseFromString(chunk_string, &chunk)) {
+        return {};
+      }
+      chunks.emplace_back(std::move(chunk));
+    }
+
+    return chunks;
+  }
+
+  google::cloud::Status FeedChunks(
+      std::vector<ReadRowsResponse_CellChunk> chunks) {
+    grpc::Status status;
+    for (auto const& chunk : chunks) {
+      parser_.HandleChunk(chunk, status);
+      if (!status.ok()) {
+        return google::cloud::Status(google::cloud::StatusCode::kInternal,
+                                     status.error_message());
+      }
+    }
+    parser_.HandleEndOfStream(status);
+    if (!status.ok()) {
+      return google::cloud::Status(google::cloud::StatusCode::kInternal,
+                                   status.error_message());
+    }
+    return google::cloud::Status{};
+  }
+
+ private:
+  RowBuildingHandler handler_;
+  CellStreamParser parser_;
+};
+
+// The acceptance tests for `ReadRowsParser` also apply to this parser.
+#include "google/cloud/bigtable/internal/readrowsparser_acceptance_tests.inc"
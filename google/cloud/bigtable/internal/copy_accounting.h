@@ -0,0 +1,68 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_COPY_ACCOUNTING_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_COPY_ACCOUNTING_H
+
+#include "google/cloud/bigtable/version.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Count the bytes copied while parsing `ReadRows` responses.
+ *
+ * The benchmarks use these counters to report the bytes copied per operation.
+ * They are off by default, each copy would pay for an atomic increment. Enable
+ * them with the `GOOGLE_CLOUD_CPP_BIGTABLE_ENABLE_COPY_ACCOUNTING` CMake
+ * option, or with `--define=bigtable_enable_copy_accounting=true` in Bazel.
+ */
+#ifndef GOOGLE_CLOUD_CPP_BIGTABLE_ENABLE_COPY_ACCOUNTING
+#define GOOGLE_CLOUD_CPP_BIGTABLE_ENABLE_COPY_ACCOUNTING 0
+#endif  // GOOGLE_CLOUD_CPP_BIGTABLE_ENABLE_COPY_ACCOUNTING
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+/// Return true if the library was compiled with copy accounting.
+constexpr bool CopyAccountingEnabled() {
+  return GOOGLE_CLOUD_CPP_BIGTABLE_ENABLE_COPY_ACCOUNTING != 0;
+}
+
+/// The total number of bytes copied by the instrumented code paths.
+std::atomic<std::uint64_t>& BytesCopiedCounter();
+
+/// The number of bytes copied by the instrumented code paths in this thread.
+std::uint64_t& ThreadBytesCopiedCounter();
+
+/// Record a copy of @p count bytes, a no-op unless copy accounting is enabled.
+inline void RecordBytesCopied(std::size_t count) {
+#if GOOGLE_CLOUD_CPP_BIGTABLE_ENABLE_COPY_ACCOUNTING
+  BytesCopiedCounter().fetch_add(count, std::memory_order_relaxed);
+  ThreadBytesCopiedCounter() += count;
+#else
+  (void)count;
+#endif  // GOOGLE_CLOUD_CPP_BIGTABLE_ENABLE_COPY_ACCOUNTING
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_COPY_ACCOUNTING_H
@@ -0,0 +1,234 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/mutation_spill_log.h"
+#include "google/cloud/internal/big_endian.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+namespace btproto = google::bigtable::v2;
+
+std::size_t constexpr MutationSpillLog::kHeaderSize;
+
+namespace {
+Status IoError(std::string const& path, char const* what) {
+  return Status(StatusCode::kUnavailable,
+                std::string("MutationSpillLog: ") + what + " <" + path + ">");
+}
+
+std::uint32_t DecodeUint32(std::string const& buffer, std::size_t pos) {
+  // The size is always correct, so decoding cannot fail.
+  return *google::cloud::internal::DecodeBigEndian<std::uint32_t>(
+      buffer.substr(pos, sizeof(std::uint32_t)));
+}
+
+// The bigtable library does not depend on the Crc32c library, a table-driven
+// implementation is fast enough for the spill log.
+std::array<std::uint32_t, 256> MakeCrc32cTable() {
+  std::uint32_t constexpr kPolynomial = 0x82F63B78;  // Castagnoli, reflected
+  std::array<std::uint32_t, 256> table{};
+  for (std::uint32_t i = 0; i != table.size(); ++i) {
+    auto c = i;
+    for (int k = 0; k != 8; ++k) c = (c & 1U) ? (c >> 1) ^ kPolynomial : c >> 1;
+    table[i] = c;
+  }
+  return table;
+}
+
+/// Extend the CRC32C checksum @p crc with @p data.
+std::uint32_t Crc32c(std::uint32_t crc, std::string const& data) {
+  static auto const kTable = MakeCrc32cTable();
+  crc = ~crc;
+  for (unsigned char c : data) crc = kTable[(crc ^ c) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+/**
+ * The checksum of a record.
+ *
+ * It covers the size and number of mutations too, so a zero-filled header,
+ * as found at the end of a file after a crash, does not validate.
+ */
+std::uint32_t RecordChecksum(std::uint32_t size, std::uint32_t num_mutations,
+                             std::string const& payload) {
+  using google::cloud::internal::EncodeBigEndian;
+  return Crc32c(
+      Crc32c(0, EncodeBigEndian(size) + EncodeBigEndian(num_mutations)),
+      payload);
+}
+}  // namespace
+
+StatusOr<std::unique_ptr<MutationSpillLog>> MutationSpillLog::Open(
+    std::string path) {
+  // Create the file if needed, without discarding any previous contents.
+  if (!std::ofstream(path, std::ios::binary | std::ios::app).is_open()) {
+    return Status(StatusCode::kInvalidArgument,
+                  "MutationSpillLog: cannot create <" + path + ">");
+  }
+  std::unique_ptr<MutationSpillLog> log(new MutationSpillLog(std::move(path)));
+  log->file_.open(log->path_,
+                  std::ios::binary | std::ios::in | std::ios::out);
+  if (!log->file_.is_open()) {
+    return Status(StatusCode::kInvalidArgument,
+                  "MutationSpillLog: cannot open <" + log->path_ + ">");
+  }
+  auto status = log->Recover();
+  if (!status.ok()) return status;
+  return log;
+}
+
+Status MutationSpillLog::Append(
+    btproto::MutateRowsRequest::Entry const& entry) {
+  using google::cloud::internal::EncodeBigEndian;
+  // Recover() treats a record without mutations as the end of the log.
+  if (entry.mutations_size() == 0) {
+    return Status(StatusCode::kInvalidArgument,
+                  "MutationSpillLog: cannot append a record without mutations");
+  }
+  auto const payload = entry.SerializeAsString();
+  auto const size = static_cast<std::uint32_t>(payload.size());
+  auto const num_mutations = static_cast<std::uint32_t>(entry.mutations_size());
+  Header const header{size, num_mutations,
+                      RecordChecksum(size, num_mutations, payload)};
+  auto const record = EncodeBigEndian(header.size) +
+                      EncodeBigEndian(header.num_mutations) +
+                      EncodeBigEndian(header.crc32c) + payload;
+  file_.seekp(write_offset_);
+  file_.write(record.data(), record.size());
+  file_.flush();
+  if (!file_) {
+    // Any partial write is overwritten by the next Append().
+    file_.clear();
+    return IoError(path_, "cannot append record to");
+  }
+  write_offset_ += static_cast<std::streamoff>(record.size());
+  headers_.push_back(header);
+  return Status();
+}
+
+StatusOr<SingleRowMutation> MutationSpillLog::Next() {
+  // The record is consumed even if it cannot be read, the location of the
+  // following records is known from their headers.
+  auto const header = headers_.front();
+  auto const offset = read_offset_ + static_cast<std::streamoff>(kHeaderSize);
+  headers_.pop_front();
+  read_offset_ = offset + static_cast<std::streamoff>(header.size);
+
+  std::string payload(header.size, '\0');
+  file_.seekg(offset);
+  file_.read(&payload[0], payload.size());
+  if (!file_) {
+    file_.clear();
+    return IoError(path_, "cannot read record from");
+  }
+
+  btproto::MutateRowsRequest::Entry entry;
+  if (RecordChecksum(header.size, header.num_mutations, payload) !=
+          header.crc32c ||
+      !entry.ParseFromString(payload)) {
+    return Status(StatusCode::kDataLoss,
+                  "MutationSpillLog: corrupted record in <" + path_ + ">");
+  }
+  return SingleRowMutation(std::move(entry));
+}
+
+Status MutationSpillLog::Reset() {
+  headers_.clear();
+  read_offset_ = 0;
+  write_offset_ = 0;
+  file_.close();
+  file_.open(path_, std::ios::binary | std::ios::in | std::ios::out |
+                        std::ios::trunc);
+  if (!file_.is_open()) return IoError(path_, "cannot truncate");
+  return Status();
+}
+
+Status MutationSpillLog::Recover() {
+  file_.seekg(0, std::ios::end);
+  std::streamoff const file_size = file_.tellg();
+  std::streamoff offset = 0;
+  std::string buffer(kHeaderSize, '\0');
+  std::string payload;
+  while (offset + static_cast<std::streamoff>(kHeaderSize) <= file_size) {
+    file_.seekg(offset);
+    if (!file_.read(&buffer[0], buffer.size())) break;
+    Header const header{DecodeUint32(buffer, 0),
+                        DecodeUint32(buffer, sizeof(std::uint32_t)),
+                        DecodeUint32(buffer, 2 * sizeof(std::uint32_t))};
+    // Append() never writes empty records, these are zeros past the end of the
+    // last record written before a crash.
+    if (header.size == 0 || header.num_mutations == 0) break;
+    auto const end = offset + static_cast<std::streamoff>(kHeaderSize) +
+                     static_cast<std::streamoff>(header.size);
+    if (end > file_size) break;
+    // A torn write may leave a record with a valid size but garbage contents.
+    payload.assign(header.size, '\0');
+    if (!file_.read(&payload[0], payload.size())) break;
+    if (RecordChecksum(header.size, header.num_mutations, payload) !=
+        header.crc32c) {
+      break;
+    }
+    headers_.push_back(header);
+    offset = end;
+  }
+  file_.clear();
+  recovered_ = headers_.size();
+  write_offset_ = offset;
+  if (offset == file_size) return Status();
+
+  // The last record was only partially written when the process stopped.
+  // Copy the valid records to a new file, because the standard library
+  // cannot truncate a file in place.
+  auto const tmp = path_ + ".tmp";
+  {
+    std::ofstream os(tmp, std::ios::binary | std::ios::trunc);
+    std::vector<char> chunk(64 * 1024);
+    file_.seekg(0);
+    for (auto remaining = offset; remaining > 0;) {
+      auto const n = (std::min)(remaining,
+                                static_cast<std::streamoff>(chunk.size()));
+      file_.read(chunk.data(), n);
+      os.write(chunk.data(), n);
+      if (!file_ || !os) return IoError(path_, "cannot recover");
+      remaining -= n;
+    }
+  }
+  file_.close();
+  // On POSIX `rename()` atomically replaces the log, so a crash at any point
+  // leaves either the old or the new file. Some platforms (notably Windows)
+  // refuse to rename over an existing file, only then remove it first.
+  if (std::rename(tmp.c_str(), path_.c_str()) != 0) {
+    std::remove(path_.c_str());
+    if (std::rename(tmp.c_str(), path_.c_str()) != 0) {
+      return IoError(path_, "cannot replace");
+    }
+  }
+  file_.open(path_, std::ios::binary | std::ios::in | std::ios::out);
+  if (!file_.is_open()) return IoError(path_, "cannot reopen");
+  return Status();
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
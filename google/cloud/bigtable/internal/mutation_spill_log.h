@@ -0,0 +1,124 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_MUTATION_SPILL_LOG_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_MUTATION_SPILL_LOG_H
+
+#include "google/cloud/bigtable/mutations.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include <google/bigtable/v2/bigtable.pb.h>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * A write-ahead log of mutations, stored in a local file.
+ *
+ * `MutationBatcher` uses this class to hold mutations that do not fit in its
+ * outstanding budget. Mutations are appended to the end of the file, and read
+ * back in the same order. The file is only truncated via `Reset()`, once all
+ * the mutations read from it are known to be applied. If the process crashes
+ * any mutations in the file are recovered by the next `Open()`, including
+ * mutations that may have been applied already.
+ *
+ * Each record is a header, with the size of the serialized
+ * `MutateRowsRequest::Entry`, its number of mutations, and a CRC32C checksum
+ * of the size, the number of mutations, and the serialized entry (all as 32-bit
+ * big-endian integers), followed by the serialized entry. On recovery the log
+ * ends at the first record that is empty, incomplete, or fails its checksum,
+ * as that record was only partially written when the process stopped.
+ *
+ * Only the headers of unread records are kept in memory. This class is not
+ * thread-safe.
+ */
+class MutationSpillLog {
+ public:
+  /// Open (or create) the log in @p path and recover any existing records.
+  static StatusOr<std::unique_ptr<MutationSpillLog>> Open(std::string path);
+
+  /// The file storing the log.
+  std::string const& path() const { return path_; }
+
+  /// Return true if all the records have been read.
+  bool empty() const { return headers_.empty(); }
+
+  /// The number of records not read yet.
+  std::size_t size() const { return headers_.size(); }
+
+  /// The number of records found by `Open()`.
+  std::size_t recovered() const { return recovered_; }
+
+  /// The serialized size of the next record, requires `!empty()`.
+  std::size_t next_request_size() const { return headers_.front().size; }
+
+  /// The number of mutations in the next record, requires `!empty()`.
+  std::size_t next_num_mutations() const {
+    return headers_.front().num_mutations;
+  }
+
+  /**
+   * Append @p entry to the log and flush it to the operating system.
+   *
+   * Entries without mutations are rejected with `kInvalidArgument`.
+   */
+  Status Append(google::bigtable::v2::MutateRowsRequest::Entry const& entry);
+
+  /**
+   * Read the next record, requires `!empty()`.
+   *
+   * The record is consumed even if it cannot be read or parsed.
+   */
+  StatusOr<SingleRowMutation> Next();
+
+  /// Discard all the records and truncate the file.
+  Status Reset();
+
+ private:
+  struct Header {
+    std::uint32_t size;
+    std::uint32_t num_mutations;
+    std::uint32_t crc32c;
+  };
+
+  static std::size_t constexpr kHeaderSize = 3 * sizeof(std::uint32_t);
+
+  explicit MutationSpillLog(std::string path) : path_(std::move(path)) {}
+
+  Status Recover();
+
+  std::string path_;
+  std::fstream file_;
+  std::deque<Header> headers_;
+  std::size_t recovered_ = 0;
+  std::streamoff read_offset_ = 0;
+  std::streamoff write_offset_ = 0;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_MUTATION_SPILL_LOG_H
@@ -0,0 +1,251 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/mutation_spill_log.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+#include <cstdio>
+#include <fstream>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+namespace btproto = google::bigtable::v2;
+using namespace google::cloud::testing_util::chrono_literals;
+
+class MutationSpillLogTest : public ::testing::Test {
+ protected:
+  MutationSpillLogTest() {
+    auto generator = google::cloud::internal::MakeDefaultPRNG();
+    path_ = ::testing::TempDir() + "spill-" +
+            google::cloud::internal::Sample(generator, 16,
+                                            "abcdefghijklmnopqrstuvwxyz") +
+            ".log";
+  }
+  ~MutationSpillLogTest() override { std::remove(path_.c_str()); }
+
+  std::string path_;
+};
+
+btproto::MutateRowsRequest::Entry MakeEntry(std::string row_key,
+                                            int num_mutations) {
+  SingleRowMutation mut(std::move(row_key));
+  for (int i = 0; i != num_mutations; ++i) {
+    mut.emplace_back(SetCell("fam", "col" + std::to_string(i), 0_ms, "v"));
+  }
+  btproto::MutateRowsRequest::Entry entry;
+  mut.MoveTo(&entry);
+  return entry;
+}
+
+std::string RowKey(SingleRowMutation mut) {
+  btproto::MutateRowsRequest::Entry entry;
+  mut.MoveTo(&entry);
+  return entry.row_key();
+}
+
+TEST_F(MutationSpillLogTest, AppendAndRead) {
+  auto log = MutationSpillLog::Open(path_);
+  ASSERT_STATUS_OK(log);
+  EXPECT_TRUE((*log)->empty());
+  EXPECT_EQ(0, (*log)->recovered());
+
+  auto const e1 = MakeEntry("r1", 1);
+  auto const e2 = MakeEntry("r2", 3);
+  ASSERT_STATUS_OK((*log)->Append(e1));
+  ASSERT_STATUS_OK((*log)->Append(e2));
+  EXPECT_EQ(2, (*log)->size());
+  EXPECT_EQ(e1.ByteSizeLong(), (*log)->next_request_size());
+  EXPECT_EQ(1, (*log)->next_num_mutations());
+
+  auto m1 = (*log)->Next();
+  ASSERT_STATUS_OK(m1);
+  EXPECT_EQ("r1", RowKey(*std::move(m1)));
+  EXPECT_EQ(3, (*log)->next_num_mutations());
+  // Appending while reading preserves the order.
+  ASSERT_STATUS_OK((*log)->Append(MakeEntry("r3", 2)));
+  auto m2 = (*log)->Next();
+  ASSERT_STATUS_OK(m2);
+  EXPECT_EQ("r2", RowKey(*std::move(m2)));
+  auto m3 = (*log)->Next();
+  ASSERT_STATUS_OK(m3);
+  EXPECT_EQ("r3", RowKey(*std::move(m3)));
+  EXPECT_TRUE((*log)->empty());
+}
+
+TEST_F(MutationSpillLogTest, Recover) {
+  {
+    auto log = MutationSpillLog::Open(path_);
+    ASSERT_STATUS_OK(log);
+    ASSERT_STATUS_OK((*log)->Append(MakeEntry("r1", 1)));
+    ASSERT_STATUS_OK((*log)->Append(MakeEntry("r2", 2)));
+    // Reading a record does not remove it from the file.
+    ASSERT_STATUS_OK((*log)->Next());
+  }
+  auto log = MutationSpillLog::Open(path_);
+  ASSERT_STATUS_OK(log);
+  EXPECT_EQ(2, (*log)->recovered());
+  ASSERT_EQ(2, (*log)->size());
+  auto m1 = (*log)->Next();
+  ASSERT_STATUS_OK(m1);
+  EXPECT_EQ("r1", RowKey(*std::move(m1)));
+  auto m2 = (*log)->Next();
+  ASSERT_STATUS_OK(m2);
+  EXPECT_EQ("r2", RowKey(*std::move(m2)));
+}
+
+TEST_F(MutationSpillLogTest, RecoverDiscardsPartialRecord) {
+  {
+    auto log = MutationSpillLog::Open(path_);
+    ASSERT_STATUS_OK(log);
+    ASSERT_STATUS_OK((*log)->Append(MakeEntry("r1", 1)));
+  }
+  {
+    // Simulate a crash in the middle of writing the second record.
+    std::ofstream os(path_, std::ios::binary | std::ios::app);
+    os.write("\0\0\1\0\0\0\0\1\0\0\0\0partial", 19);
+  }
+  {
+    auto log = MutationSpillLog::Open(path_);
+    ASSERT_STATUS_OK(log);
+    EXPECT_EQ(1, (*log)->recovered());
+    ASSERT_STATUS_OK((*log)->Append(MakeEntry("r2", 1)));
+  }
+  auto log = MutationSpillLog::Open(path_);
+  ASSERT_STATUS_OK(log);
+  ASSERT_EQ(2, (*log)->recovered());
+  ASSERT_STATUS_OK((*log)->Next());
+  auto m2 = (*log)->Next();
+  ASSERT_STATUS_OK(m2);
+  EXPECT_EQ("r2", RowKey(*std::move(m2)));
+}
+
+TEST_F(MutationSpillLogTest, RecoverDiscardsCorruptRecord) {
+  {
+    auto log = MutationSpillLog::Open(path_);
+    ASSERT_STATUS_OK(log);
+    ASSERT_STATUS_OK((*log)->Append(MakeEntry("r1", 1)));
+    ASSERT_STATUS_OK((*log)->Append(MakeEntry("r2", 1)));
+  }
+  {
+    // Simulate a torn write: the last record is complete, but its contents
+    // are garbage.
+    std::fstream f(path_, std::ios::binary | std::ios::in | std::ios::out);
+    f.seekp(-1, std::ios::end);
+    f.put('\xFF');
+  }
+  {
+    auto log = MutationSpillLog::Open(path_);
+    ASSERT_STATUS_OK(log);
+    EXPECT_EQ(1, (*log)->recovered());
+    ASSERT_STATUS_OK((*log)->Append(MakeEntry("r3", 1)));
+  }
+  auto log = MutationSpillLog::Open(path_);
+  ASSERT_STATUS_OK(log);
+  ASSERT_EQ(2, (*log)->recovered());
+  auto m1 = (*log)->Next();
+  ASSERT_STATUS_OK(m1);
+  EXPECT_EQ("r1", RowKey(*std::move(m1)));
+  auto m3 = (*log)->Next();
+  ASSERT_STATUS_OK(m3);
+  EXPECT_EQ("r3", RowKey(*std::move(m3)));
+}
+
+TEST_F(MutationSpillLogTest, RecoverDiscardsZeroFill) {
+  {
+    auto log = MutationSpillLog::Open(path_);
+    ASSERT_STATUS_OK(log);
+    ASSERT_STATUS_OK((*log)->Append(MakeEntry("r1", 1)));
+    ASSERT_STATUS_OK((*log)->Append(MakeEntry("r2", 2)));
+  }
+  {
+    // Simulate the zeros left past the last record after a crash, enough for
+    // several 12-byte (bogus) headers.
+    std::ofstream os(path_, std::ios::binary | std::ios::app);
+    std::string const zeros(4096, '\0');
+    os.write(zeros.data(), zeros.size());
+  }
+  {
+    auto log = MutationSpillLog::Open(path_);
+    ASSERT_STATUS_OK(log);
+    EXPECT_EQ(2, (*log)->recovered());
+    ASSERT_STATUS_OK((*log)->Append(MakeEntry("r3", 1)));
+  }
+  auto log = MutationSpillLog::Open(path_);
+  ASSERT_STATUS_OK(log);
+  ASSERT_EQ(3, (*log)->recovered());
+  ASSERT_STATUS_OK((*log)->Next());
+  ASSERT_STATUS_OK((*log)->Next());
+  auto m3 = (*log)->Next();
+  ASSERT_STATUS_OK(m3);
+  EXPECT_EQ("r3", RowKey(*std::move(m3)));
+}
+
+TEST_F(MutationSpillLogTest, AppendRejectsEmpty) {
+  auto log = MutationSpillLog::Open(path_);
+  ASSERT_STATUS_OK(log);
+  auto status = (*log)->Append(MakeEntry("r1", 0));
+  EXPECT_EQ(StatusCode::kInvalidArgument, status.code());
+  EXPECT_TRUE((*log)->empty());
+}
+
+TEST_F(MutationSpillLogTest, NextDetectsCorruption) {
+  auto log = MutationSpillLog::Open(path_);
+  ASSERT_STATUS_OK(log);
+  ASSERT_STATUS_OK((*log)->Append(MakeEntry("r1", 1)));
+  {
+    std::fstream f(path_, std::ios::binary | std::ios::in | std::ios::out);
+    f.seekp(-1, std::ios::end);
+    f.put('\xFF');
+  }
+  auto m = (*log)->Next();
+  EXPECT_EQ(StatusCode::kDataLoss, m.status().code());
+  EXPECT_TRUE((*log)->empty());
+}
+
+TEST_F(MutationSpillLogTest, Reset) {
+  {
+    auto log = MutationSpillLog::Open(path_);
+    ASSERT_STATUS_OK(log);
+    ASSERT_STATUS_OK((*log)->Append(MakeEntry("r1", 1)));
+    ASSERT_STATUS_OK((*log)->Next());
+    ASSERT_STATUS_OK((*log)->Reset());
+    EXPECT_TRUE((*log)->empty());
+    ASSERT_STATUS_OK((*log)->Append(MakeEntry("r2", 1)));
+  }
+  auto log = MutationSpillLog::Open(path_);
+  ASSERT_STATUS_OK(log);
+  ASSERT_EQ(1, (*log)->recovered());
+  auto m = (*log)->Next();
+  ASSERT_STATUS_OK(m);
+  EXPECT_EQ("r2", RowKey(*std::move(m)));
+}
+
+TEST_F(MutationSpillLogTest, OpenError) {
+  auto log = MutationSpillLog::Open(path_ + "/not-a-directory/file.log");
+  EXPECT_EQ(StatusCode::kInvalidArgument, log.status().code());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/bigtable/internal/copy_accounting.h"
 #include "google/cloud/grpc_error_delegate.h"
 
 namespace google {
@@ -73,6 +74,7 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
     swap(*chunk.mutable_value(), cell_.value);
   } else {
     internal::AppendCellValue(cell_.value, chunk.value());
+    RecordBytesCopied(chunk.value().size());
   }
 
   cell_first_chunk_ = false;
@@ -93,6 +95,7 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
         return;
       }
       row_key_ = cell_.row;
+      RecordBytesCopied(row_key_.size());
     } else {
       if (row_key_ != cell_.row) {
         status = grpc::Status(grpc::StatusCode::INTERNAL,
@@ -125,6 +128,7 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
     }
     row_ready_ = true;
     last_seen_row_key_ = row_key_;
+    RecordBytesCopied(last_seen_row_key_.size());
     cell_.row.clear();
   }
 }
@@ -172,6 +176,8 @@ Cell ReadRowsParser::MovePartialToCell() {
   // message comments in bigtable.proto.
   Cell cell(cell_.row, cell_.family, cell_.column, cell_.timestamp,
             std::move(cell_.value), std::move(cell_.labels));
+  RecordBytesCopied(cell_.row.size() + cell_.family.size() +
+                    cell_.column.size());
   cell_.value.clear();
   return cell;
 }
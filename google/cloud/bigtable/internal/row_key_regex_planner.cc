@@ -0,0 +1,435 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/row_key_regex_planner.h"
+#include <algorithm>
+#include <cctype>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+/// A literal prefix, `open` is true while more literals can be appended to it.
+struct Candidate {
+  std::string prefix;
+  bool open;
+};
+
+/**
+ * A (very) small parser for the subset of the RE2 syntax we can plan.
+ *
+ * The parser returns `false` as soon as it finds a construct it does not
+ * understand, the caller then uses the original `RowSet`.
+ */
+class RegexPlanner {
+ public:
+  explicit RegexPlanner(std::string const& pattern) : p_(pattern) {}
+
+  bool Parse(std::vector<Candidate>& result) {
+    if (!ParseAlternation(result)) return false;
+    return i_ == p_.size();
+  }
+
+ private:
+  enum class AtomType { kLiteral, kGroup, kOther };
+
+  bool ParseAlternation(std::vector<Candidate>& result) {
+    for (;;) {
+      std::vector<Candidate> sequence{{std::string{}, true}};
+      if (!ParseSequence(sequence)) return false;
+      result.insert(result.end(), sequence.begin(), sequence.end());
+      if (result.size() > kMaxRowKeyRegexPlanSize) return false;
+      if (i_ == p_.size() || p_[i_] != '|') return true;
+      ++i_;
+    }
+  }
+
+  bool ParseSequence(std::vector<Candidate>& sequence) {
+    while (i_ != p_.size() && p_[i_] != '|' && p_[i_] != ')') {
+      std::string literal;
+      std::vector<Candidate> group;
+      AtomType type;
+      if (!ParseAtom(type, literal, group)) return false;
+      // Anchors do not consume any characters, and all the expressions are
+      // anchored by the server anyway.
+      if (type == AtomType::kLiteral && literal.empty()) continue;
+
+      int min_repeat;
+      bool repeated;
+      if (!ParseRepetition(repeated, min_repeat)) return false;
+      if (type == AtomType::kOther || (repeated && min_repeat == 0)) {
+        Close(sequence);
+        continue;
+      }
+      if (type == AtomType::kLiteral) {
+        // A non-ASCII character may be more than one byte, and the repetition
+        // applies to all of them.
+        if (repeated && static_cast<unsigned char>(literal[0]) >= 0x80) {
+          Close(sequence);
+          continue;
+        }
+        group.push_back(Candidate{std::move(literal), true});
+      }
+      std::vector<Candidate> product;
+      for (auto const& c : sequence) {
+        if (!c.open) {
+          product.push_back(c);
+          continue;
+        }
+        for (auto const& g : group) {
+          product.push_back(Candidate{c.prefix + g.prefix, g.open});
+        }
+      }
+      if (product.size() > kMaxRowKeyRegexPlanSize) return false;
+      sequence = std::move(product);
+      if (repeated) Close(sequence);
+    }
+    return true;
+  }
+
+  bool ParseAtom(AtomType& type, std::string& literal,
+                 std::vector<Candidate>& group) {
+    auto const c = p_[i_++];
+    switch (c) {
+      case '^':
+      case '$':
+        type = AtomType::kLiteral;
+        return true;
+      case '.':
+        type = AtomType::kOther;
+        return true;
+      case '[':
+        type = AtomType::kOther;
+        return SkipCharacterClass();
+      case '(':
+        type = AtomType::kGroup;
+        return ParseGroup(group);
+      case '\\':
+        return ParseEscape(type, literal);
+      case '*':
+      case '+':
+      case '?':
+      case ')':
+        return false;
+      default:
+        break;
+    }
+    type = AtomType::kLiteral;
+    literal.push_back(c);
+    // Keep multi-byte UTF-8 characters together.
+    if (static_cast<unsigned char>(c) >= 0xC0) {
+      while (i_ != p_.size() &&
+             (static_cast<unsigned char>(p_[i_]) & 0xC0U) == 0x80U) {
+        literal.push_back(p_[i_++]);
+      }
+    }
+    return true;
+  }
+
+  bool ParseGroup(std::vector<Candidate>& group) {
+    if (i_ != p_.size() && p_[i_] == '?') {
+      // Only non-capturing and named groups, flags change the meaning of the
+      // literals.
+      if (p_.compare(i_, 2, "?:") == 0) {
+        i_ += 2;
+      } else if (p_.compare(i_, 3, "?P<") == 0) {
+        auto end = p_.find('>', i_);
+        if (end == std::string::npos) return false;
+        i_ = end + 1;
+      } else {
+        return false;
+      }
+    }
+    if (!ParseAlternation(group)) return false;
+    if (i_ == p_.size() || p_[i_] != ')') return false;
+    ++i_;
+    return true;
+  }
+
+  bool ParseEscape(AtomType& type, std::string& literal) {
+    if (i_ == p_.size()) return false;
+    auto const c = p_[i_++];
+    type = AtomType::kLiteral;
+    if (!std::isalnum(static_cast<unsigned char>(c))) {
+      literal.push_back(c);
+      return true;
+    }
+    switch (c) {
+      case 'A':
+      case 'z':
+        return true;
+      case 'a':
+        literal.push_back('\a');
+        return true;
+      case 'f':
+        literal.push_back('\f');
+        return true;
+      case 'n':
+        literal.push_back('\n');
+        return true;
+      case 'r':
+        literal.push_back('\r');
+        return true;
+      case 't':
+        literal.push_back('\t');
+        return true;
+      case 'v':
+        literal.push_back('\v');
+        return true;
+      case 'x':
+        return ParseHexEscape(literal);
+      case 'd':
+      case 'D':
+      case 's':
+      case 'S':
+      case 'w':
+      case 'W':
+      case 'C':
+        type = AtomType::kOther;
+        return true;
+      case 'p':
+      case 'P':
+        type = AtomType::kOther;
+        if (i_ != p_.size() && p_[i_] == '{') {
+          auto end = p_.find('}', i_);
+          if (end == std::string::npos) return false;
+          i_ = end + 1;
+        } else if (i_ != p_.size()) {
+          ++i_;
+        }
+        return true;
+      default:
+        break;
+    }
+    // Octal escapes, word boundaries, \Q...\E, etc.
+    return false;
+  }
+
+  bool ParseHexEscape(std::string& literal) {
+    if (p_.size() - i_ < 2) return false;
+    auto const hi = HexValue(p_[i_]);
+    auto const lo = HexValue(p_[i_ + 1]);
+    if (hi < 0 || lo < 0) return false;
+    auto const value = hi * 16 + lo;
+    // Values above 0x7F are encoded as UTF-8 in RE2 (unless the pattern uses
+    // Latin-1), do not guess.
+    if (value >= 0x80) return false;
+    i_ += 2;
+    literal.push_back(static_cast<char>(value));
+    return true;
+  }
+
+  static int HexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+  }
+
+  bool SkipCharacterClass() {
+    if (i_ != p_.size() && p_[i_] == '^') ++i_;
+    if (i_ != p_.size() && p_[i_] == ']') ++i_;
+    while (i_ != p_.size() && p_[i_] != ']') {
+      if (p_[i_] == '\\') {
+        i_ += 2;
+        continue;
+      }
+      if (p_.compare(i_, 2, "[:") == 0) {
+        auto end = p_.find(":]", i_ + 2);
+        if (end == std::string::npos) return false;
+        i_ = end + 2;
+        continue;
+      }
+      ++i_;
+    }
+    if (i_ >= p_.size()) return false;
+    ++i_;
+    return true;
+  }
+
+  /// Parse any repetition operator, RE2 treats invalid `{` as a literal.
+  bool ParseRepetition(bool& repeated, int& min_repeat) {
+    repeated = false;
+    min_repeat = 1;
+    if (i_ == p_.size()) return true;
+    auto const c = p_[i_];
+    if (c == '*' || c == '?' || c == '+') {
+      repeated = true;
+      min_repeat = c == '+' ? 1 : 0;
+      ++i_;
+    } else if (c == '{') {
+      auto j = i_ + 1;
+      int n = 0;
+      auto const start = j;
+      while (j != p_.size() &&
+             std::isdigit(static_cast<unsigned char>(p_[j]))) {
+        n = (std::min)(n * 10 + (p_[j] - '0'), 1000);
+        ++j;
+      }
+      if (j == start) return true;
+      if (j != p_.size() && p_[j] == ',') {
+        ++j;
+        while (j != p_.size() &&
+               std::isdigit(static_cast<unsigned char>(p_[j]))) {
+          ++j;
+        }
+      }
+      if (j == p_.size() || p_[j] != '}') return true;
+      repeated = true;
+      min_repeat = n;
+      i_ = j + 1;
+    } else {
+      return true;
+    }
+    // Non-greedy repetitions match the same strings.
+    if (i_ != p_.size() && p_[i_] == '?') ++i_;
+    // RE2 rejects repeated repetitions, so does the server.
+    if (i_ != p_.size() &&
+        (p_[i_] == '*' || p_[i_] == '+' || p_[i_] == '?')) {
+      return false;
+    }
+    return true;
+  }
+
+  static void Close(std::vector<Candidate>& sequence) {
+    for (auto& c : sequence) c.open = false;
+  }
+
+  std::string const& p_;
+  std::size_t i_ = 0;
+};
+
+bool StartsWith(std::string const& s, std::string const& prefix) {
+  return s.compare(0, prefix.size(), prefix) == 0;
+}
+
+// A sink anywhere in the filter emits rows directly to the output, those rows
+// skip any row key regex that follows in the chain.
+bool ContainsSink(::google::bigtable::v2::RowFilter const& filter) {
+  using ::google::bigtable::v2::RowFilter;
+  switch (filter.filter_case()) {
+    case RowFilter::kSink:
+      return true;
+    case RowFilter::kChain:
+      return std::any_of(filter.chain().filters().begin(),
+                         filter.chain().filters().end(), ContainsSink);
+    case RowFilter::kInterleave:
+      return std::any_of(filter.interleave().filters().begin(),
+                         filter.interleave().filters().end(), ContainsSink);
+    case RowFilter::kCondition:
+      return ContainsSink(filter.condition().predicate_filter()) ||
+             ContainsSink(filter.condition().true_filter()) ||
+             ContainsSink(filter.condition().false_filter());
+    default:
+      return false;
+  }
+}
+
+void CollectRowKeyRegex(::google::bigtable::v2::RowFilter const& filter,
+                        std::vector<std::string>& patterns) {
+  if (filter.has_chain()) {
+    for (auto const& f : filter.chain().filters()) {
+      CollectRowKeyRegex(f, patterns);
+    }
+    return;
+  }
+  if (filter.filter_case() ==
+      ::google::bigtable::v2::RowFilter::kRowKeyRegexFilter) {
+    patterns.push_back(filter.row_key_regex_filter());
+  }
+}
+
+}  // namespace
+
+optional<RowKeyRegexPlan> PlanRowKeyRegex(std::string const& pattern) {
+  std::vector<Candidate> candidates;
+  if (!RegexPlanner(pattern).Parse(candidates)) return {};
+
+  RowKeyRegexPlan plan;
+  for (auto& c : candidates) {
+    if (c.open) {
+      // The empty row key is not valid, no rows can match it.
+      if (!c.prefix.empty()) plan.keys.push_back(std::move(c.prefix));
+      continue;
+    }
+    if (c.prefix.empty()) return {};
+    plan.prefixes.push_back(std::move(c.prefix));
+  }
+
+  // Remove prefixes (and keys) covered by shorter prefixes, after sorting any
+  // covered element appears right after the prefix that covers it.
+  std::sort(plan.prefixes.begin(), plan.prefixes.end());
+  std::vector<std::string> prefixes;
+  for (auto& p : plan.prefixes) {
+    if (!prefixes.empty() && StartsWith(p, prefixes.back())) continue;
+    prefixes.push_back(std::move(p));
+  }
+  plan.prefixes = std::move(prefixes);
+
+  std::sort(plan.keys.begin(), plan.keys.end());
+  plan.keys.erase(std::unique(plan.keys.begin(), plan.keys.end()),
+                  plan.keys.end());
+  plan.keys.erase(
+      std::remove_if(plan.keys.begin(), plan.keys.end(),
+                     [&plan](std::string const& key) {
+                       return std::any_of(plan.prefixes.begin(),
+                                          plan.prefixes.end(),
+                                          [&key](std::string const& p) {
+                                            return StartsWith(key, p);
+                                          });
+                     }),
+      plan.keys.end());
+  return plan;
+}
+
+RowSet NarrowRowSetByRowKeyRegex(RowSet const& row_set, Filter const& filter) {
+  if (ContainsSink(filter.as_proto())) return row_set;
+  std::vector<std::string> patterns;
+  CollectRowKeyRegex(filter.as_proto(), patterns);
+  for (auto const& pattern : patterns) {
+    auto plan = PlanRowKeyRegex(pattern);
+    if (!plan) continue;
+
+    RowSet result;
+    for (auto const& key : plan->keys) {
+      if (!row_set.Intersect(RowRange::Closed(key, key)).IsEmpty()) {
+        result.Append(key);
+      }
+    }
+    for (auto const& prefix : plan->prefixes) {
+      auto const intersection = row_set.Intersect(RowRange::Prefix(prefix));
+      auto const& proto = intersection.as_proto();
+      for (auto const& key : proto.row_keys()) result.Append(key);
+      for (auto const& r : proto.row_ranges()) {
+        RowRange range(r);
+        if (!range.IsEmpty()) result.Append(std::move(range));
+      }
+    }
+    // A RowSet without any keys or ranges means "all rows", we want "no rows".
+    if (result.as_proto().row_keys().empty() &&
+        result.as_proto().row_ranges().empty()) {
+      return RowSet(RowRange::Empty());
+    }
+    return result;
+  }
+  return row_set;
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,74 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_KEY_REGEX_PLANNER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_KEY_REGEX_PLANNER_H
+
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/row_set.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/optional.h"
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/// The row keys and key prefixes that can match a row key regular expression.
+struct RowKeyRegexPlan {
+  /// Row keys that match the expression exactly.
+  std::vector<std::string> keys;
+  /// Any row key matching the expression starts with one of these prefixes.
+  std::vector<std::string> prefixes;
+};
+
+/// The maximum number of keys and prefixes in a plan.
+constexpr std::size_t kMaxRowKeyRegexPlanSize = 64;
+
+/**
+ * Extract the literal keys and prefixes from a row key regular expression.
+ *
+ * Cloud Bigtable matches row key regular expressions against the full row key.
+ * Expressions such as `user#123#.*` or `(user|group)#123#.*` can only match
+ * keys with a few literal prefixes, and the rows matching those prefixes are
+ * contiguous ranges. This function computes these prefixes, so the client can
+ * scan only those ranges instead of the full `RowSet`.
+ *
+ * The analysis is conservative: it understands literals (including escaped
+ * literals), groups, alternations, anchors, and repetitions. Any construct
+ * that could make the analysis incorrect (e.g. flags such as `(?i)`) makes the
+ * function return an empty `optional<>`, as does an expression that can match
+ * keys without a non-empty literal prefix.
+ */
+optional<RowKeyRegexPlan> PlanRowKeyRegex(std::string const& pattern);
+
+/**
+ * Narrow @p row_set using the row key regular expressions in @p filter.
+ *
+ * Only the expressions that must be satisfied by all the rows returned by
+ * @p filter (i.e. the filter itself or the elements of a chain) are used. The
+ * filter is not changed, the regular expression is still evaluated by the
+ * server. Returns @p row_set unchanged if the filter cannot be used.
+ */
+RowSet NarrowRowSetByRowKeyRegex(RowSet const& row_set, Filter const& filter);
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_KEY_REGEX_PLANNER_H
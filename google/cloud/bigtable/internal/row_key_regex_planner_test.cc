@@ -0,0 +1,196 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/row_key_regex_planner.h"
+#include <gmock/gmock.h>
+
+namespace bigtable = google::cloud::bigtable;
+using bigtable::internal::NarrowRowSetByRowKeyRegex;
+using bigtable::internal::PlanRowKeyRegex;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(RowKeyRegexPlannerTest, LiteralPrefix) {
+  auto plan = PlanRowKeyRegex("^user#123#.*");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_THAT(plan->keys, IsEmpty());
+  EXPECT_THAT(plan->prefixes, ElementsAre("user#123#"));
+}
+
+TEST(RowKeyRegexPlannerTest, ExactKey) {
+  auto plan = PlanRowKeyRegex("user#123$");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_THAT(plan->keys, ElementsAre("user#123"));
+  EXPECT_THAT(plan->prefixes, IsEmpty());
+}
+
+TEST(RowKeyRegexPlannerTest, Alternation) {
+  auto plan = PlanRowKeyRegex("a#.*|b#.*|c");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_THAT(plan->keys, ElementsAre("c"));
+  EXPECT_THAT(plan->prefixes, ElementsAre("a#", "b#"));
+}
+
+TEST(RowKeyRegexPlannerTest, Groups) {
+  auto plan = PlanRowKeyRegex("(?:user|group)#(1|2)\\d+");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_THAT(plan->keys, IsEmpty());
+  EXPECT_THAT(plan->prefixes,
+              ElementsAre("group#1", "group#2", "user#1", "user#2"));
+
+  plan = PlanRowKeyRegex("(?P<kind>a|b.*)c");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_THAT(plan->keys, ElementsAre("ac"));
+  EXPECT_THAT(plan->prefixes, ElementsAre("b"));
+}
+
+TEST(RowKeyRegexPlannerTest, Repetitions) {
+  auto plan = PlanRowKeyRegex("abc?d");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_THAT(plan->prefixes, ElementsAre("ab"));
+
+  plan = PlanRowKeyRegex("abc+d");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_THAT(plan->prefixes, ElementsAre("abc"));
+
+  plan = PlanRowKeyRegex("ab{2,3}c");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_THAT(plan->prefixes, ElementsAre("ab"));
+
+  plan = PlanRowKeyRegex("ab{0,3}c");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_THAT(plan->prefixes, ElementsAre("a"));
+
+  plan = PlanRowKeyRegex("a(bc)*d");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_THAT(plan->prefixes, ElementsAre("a"));
+
+  // RE2 treats `{` as a literal if it does not start a repetition.
+  plan = PlanRowKeyRegex("a{b");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_THAT(plan->keys, ElementsAre("a{b"));
+}
+
+TEST(RowKeyRegexPlannerTest, Escapes) {
+  auto plan = PlanRowKeyRegex("a\\.b\\x41\\n[0-9]");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_THAT(plan->prefixes, ElementsAre("a.bA\n"));
+
+  plan = PlanRowKeyRegex("a\\Cb");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_THAT(plan->prefixes, ElementsAre("a"));
+
+  plan = PlanRowKeyRegex("ab[\\]x]c");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_THAT(plan->prefixes, ElementsAre("ab"));
+}
+
+TEST(RowKeyRegexPlannerTest, CoveredPrefixes) {
+  auto plan = PlanRowKeyRegex("ab.*|abc.*|abd|b|b");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_THAT(plan->keys, ElementsAre("b"));
+  EXPECT_THAT(plan->prefixes, ElementsAre("ab"));
+}
+
+TEST(RowKeyRegexPlannerTest, Unplannable) {
+  // No literal prefix.
+  EXPECT_FALSE(PlanRowKeyRegex(".*user"));
+  EXPECT_FALSE(PlanRowKeyRegex("a.*|.*b"));
+  EXPECT_FALSE(PlanRowKeyRegex("a?b"));
+  // Flags change the meaning of literals.
+  EXPECT_FALSE(PlanRowKeyRegex("(?i)abc"));
+  // Escapes we do not try to interpret.
+  EXPECT_FALSE(PlanRowKeyRegex("a\\Qb.c\\E"));
+  EXPECT_FALSE(PlanRowKeyRegex("a\\xFF"));
+  // Invalid expressions.
+  EXPECT_FALSE(PlanRowKeyRegex("a(b"));
+  EXPECT_FALSE(PlanRowKeyRegex("ab)"));
+  EXPECT_FALSE(PlanRowKeyRegex("a[bc"));
+  EXPECT_FALSE(PlanRowKeyRegex("a**"));
+  // Too many prefixes.
+  EXPECT_FALSE(PlanRowKeyRegex("(0|1|2|3)(0|1|2|3)(0|1|2|3)(0|1|2|3)"));
+}
+
+TEST(RowKeyRegexPlannerTest, NarrowAllRows) {
+  auto actual = NarrowRowSetByRowKeyRegex(
+      bigtable::RowSet(), bigtable::Filter::RowKeysRegex("a#.*|b"));
+  auto const& proto = actual.as_proto();
+  ASSERT_EQ(1, proto.row_keys_size());
+  EXPECT_EQ("b", proto.row_keys(0));
+  ASSERT_EQ(1, proto.row_ranges_size());
+  EXPECT_EQ("a#", proto.row_ranges(0).start_key_closed());
+  EXPECT_EQ("a$", proto.row_ranges(0).end_key_open());
+}
+
+TEST(RowKeyRegexPlannerTest, NarrowIntersects) {
+  bigtable::RowSet row_set(bigtable::RowRange::Range("a#5", "c"),
+                           std::string("a#0"), std::string("z"));
+  auto actual = NarrowRowSetByRowKeyRegex(
+      row_set, bigtable::Filter::RowKeysRegex("a#.*|b"));
+  auto const& proto = actual.as_proto();
+  EXPECT_THAT(proto.row_keys(), ElementsAre("b", "a#0"));
+  ASSERT_EQ(1, proto.row_ranges_size());
+  EXPECT_EQ("a#5", proto.row_ranges(0).start_key_closed());
+  EXPECT_EQ("a$", proto.row_ranges(0).end_key_open());
+}
+
+TEST(RowKeyRegexPlannerTest, NarrowToEmpty) {
+  bigtable::RowSet row_set(bigtable::RowRange::Range("x", "y"));
+  auto actual = NarrowRowSetByRowKeyRegex(
+      row_set, bigtable::Filter::RowKeysRegex("a.*"));
+  EXPECT_TRUE(actual.IsEmpty());
+}
+
+TEST(RowKeyRegexPlannerTest, NarrowChain) {
+  using F = bigtable::Filter;
+  auto actual = NarrowRowSetByRowKeyRegex(
+      bigtable::RowSet(),
+      F::Chain(F::Latest(1), F::Chain(F::RowKeysRegex("k.*"))));
+  auto const& proto = actual.as_proto();
+  ASSERT_EQ(1, proto.row_ranges_size());
+  EXPECT_EQ("k", proto.row_ranges(0).start_key_closed());
+}
+
+TEST(RowKeyRegexPlannerTest, NarrowIgnoresInterleave) {
+  using F = bigtable::Filter;
+  bigtable::RowSet row_set(bigtable::RowRange::Range("a", "z"));
+  auto filter = F::Interleave(F::RowKeysRegex("k.*"), F::Latest(1));
+  auto actual = NarrowRowSetByRowKeyRegex(row_set, filter);
+  auto const& proto = actual.as_proto();
+  ASSERT_EQ(1, proto.row_ranges_size());
+  EXPECT_EQ("a", proto.row_ranges(0).start_key_closed());
+  EXPECT_EQ("z", proto.row_ranges(0).end_key_open());
+}
+
+TEST(RowKeyRegexPlannerTest, NarrowIgnoresSink) {
+  using F = bigtable::Filter;
+  bigtable::RowSet row_set(bigtable::RowRange::Range("a", "z"));
+  // The sunk rows never reach the regex, narrowing would drop them.
+  auto filter = F::Chain(F::Interleave(F::Sink(), F::PassAllFilter()),
+                         F::RowKeysRegex("^a"));
+  auto actual = NarrowRowSetByRowKeyRegex(row_set, filter);
+  auto const& proto = actual.as_proto();
+  ASSERT_EQ(1, proto.row_ranges_size());
+  EXPECT_EQ("a", proto.row_ranges(0).start_key_closed());
+  EXPECT_EQ("z", proto.row_ranges(0).end_key_open());
+}
+
+TEST(RowKeyRegexPlannerTest, NarrowUnplannable) {
+  bigtable::RowSet row_set(bigtable::RowRange::Range("a", "z"));
+  auto actual = NarrowRowSetByRowKeyRegex(
+      row_set, bigtable::Filter::RowKeysRegex(".*k"));
+  auto const& proto = actual.as_proto();
+  ASSERT_EQ(1, proto.row_ranges_size());
+  EXPECT_EQ("a", proto.row_ranges(0).start_key_closed());
+}
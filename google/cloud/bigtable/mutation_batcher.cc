@@ -15,6 +15,8 @@
 #include "google/cloud/bigtable/mutation_batcher.h"
 #include "google/cloud/bigtable/internal/client_options_defaults.h"
 #include "google/cloud/grpc_error_delegate.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include "google/cloud/log.h"
 #include <sstream>
 
 namespace google {
@@ -31,12 +33,46 @@ auto constexpr kDefaultMaxSizePerBatch =
 auto constexpr kDefaultMaxBatches = 8;
 auto constexpr kDefaultMaxOutstandingSize =
     kDefaultMaxSizePerBatch * kDefaultMaxBatches;
+// With adaptive throttling, reduce the outstanding batches if more than this
+// fraction of the mutations in a batch fail.
+auto constexpr kDefaultMaxErrorRate = 0.1;
 
 MutationBatcher::Options::Options()
     : max_mutations_per_batch(kBigtableMutationLimit),
       max_size_per_batch(kDefaultMaxSizePerBatch),
       max_batches(kDefaultMaxBatches),
-      max_outstanding_size(kDefaultMaxOutstandingSize) {}
+      max_outstanding_size(kDefaultMaxOutstandingSize),
+      adaptive_throttling(false),
+      target_latency(0),
+      min_batches(1),
+      max_error_rate(kDefaultMaxErrorRate) {}
+
+MutationBatcher::MutationBatcher(Table table, Options options)
+    : table_(std::move(table)),
+      options_(std::move(options)),
+      num_outstanding_batches_(),
+      outstanding_size_(),
+      num_requests_pending_(),
+      batch_limit_(options_.min_batches, options_.max_batches,
+                   options_.target_latency, options_.max_error_rate),
+      cur_batch_(std::make_shared<Batch>()),
+      num_spilled_(),
+      num_spilling_(),
+      num_recovered_(),
+      num_spilled_in_flight_(),
+      spilled_ready_size_(),
+      spill_io_active_(false),
+      spill_needs_reset_(false) {
+  if (options_.spill_file.empty()) return;
+  auto log = internal::MutationSpillLog::Open(options_.spill_file);
+  if (!log) {
+    google::cloud::internal::ThrowRuntimeError(log.status().message());
+  }
+  spill_log_ = *std::move(log);
+  num_recovered_ = spill_log_->recovered();
+  num_spilled_ = num_recovered_;
+  num_requests_pending_ = num_recovered_;
+}
 
 std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
     CompletionQueue& cq, SingleRowMutation mut) {
@@ -65,7 +101,12 @@ std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
   ++num_requests_pending_;
 
   if (!CanAppendToBatch(pending)) {
-    pending_mutations_.push(std::move(pending));
+    if (!spill_log_) {
+      pending_mutations_.push(std::move(pending));
+      return res;
+    }
+    auto admission_promises_to_satisfy = Spill(cq, std::move(pending), lk);
+    SatisfyPromises(std::move(admission_promises_to_satisfy), lk);
     return res;
   }
   std::vector<AdmissionPromise> admission_promises_to_satisfy;
@@ -79,13 +120,24 @@ std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
 
 future<void> MutationBatcher::AsyncWaitForNoPendingRequests() {
   std::unique_lock<std::mutex> lk(mu_);
-  if (num_requests_pending_ == 0) {
+  if (num_requests_pending_ == 0 && !spill_io_active_) {
     return make_ready_future();
   }
   no_more_pending_promises_.emplace_back();
   return no_more_pending_promises_.back().get_future();
 }
 
+std::size_t MutationBatcher::current_max_batches() {
+  std::unique_lock<std::mutex> lk(mu_);
+  return MaxBatches();
+}
+
+void MutationBatcher::ReplaySpillFile(CompletionQueue& cq) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto admission_promises = TryAdmit(cq, lk);
+  SatisfyPromises(std::move(admission_promises), lk);
+}
+
 MutationBatcher::PendingSingleRowMutation::PendingSingleRowMutation(
     SingleRowMutation mut_arg, CompletionPromise completion_promise,
     AdmissionPromise admission_promise)
@@ -126,22 +178,23 @@ grpc::Status MutationBatcher::IsValid(PendingSingleRowMutation& mut) const {
   return grpc::Status();
 }
 
-bool MutationBatcher::HasSpaceFor(PendingSingleRowMutation const& mut) const {
-  return outstanding_size_ + mut.request_size <=
-             options_.max_outstanding_size &&
-         cur_batch_->requests_size + mut.request_size <=
+bool MutationBatcher::HasSpaceFor(std::size_t request_size,
+                                  std::size_t num_mutations) const {
+  return outstanding_size_ + request_size <= options_.max_outstanding_size &&
+         cur_batch_->requests_size + request_size <=
              options_.max_size_per_batch &&
-         cur_batch_->num_mutations + mut.num_mutations <=
+         cur_batch_->num_mutations + num_mutations <=
              options_.max_mutations_per_batch;
 }
 
 bool MutationBatcher::FlushIfPossible(CompletionQueue cq) {
   if (cur_batch_->num_mutations > 0 &&
-      num_outstanding_batches_ < options_.max_batches) {
+      num_outstanding_batches_ < MaxBatches()) {
     ++num_outstanding_batches_;
 
     auto batch = std::make_shared<Batch>();
     cur_batch_.swap(batch);
+    batch->start = std::chrono::steady_clock::now();
     table_.AsyncBulkApply(std::move(batch->requests), cq)
         .then([this, cq,
                batch](future<std::vector<FailedMutation>> failed) mutable {
@@ -173,61 +226,206 @@ void MutationBatcher::OnBulkApplyDone(
     data.done = true;
   }
   // Any remaining mutations are treated as successful.
+  std::size_t num_spilled = 0;
   for (auto& data : batch.mutation_data) {
     if (!data.done) {
       data.completion_promise.set_value(Status());
       data.done = true;
     }
+    if (data.spilled) ++num_spilled;
   }
   auto const num_mutations = batch.mutation_data.size();
   batch.mutation_data.clear();
+  auto const latency = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - batch.start);
 
   std::unique_lock<std::mutex> lk(mu_);
+  if (options_.adaptive_throttling) {
+    batch_limit_.OnBatchComplete(latency, num_mutations, failed.size());
+  }
   outstanding_size_ -= batch.requests_size;
   num_requests_pending_ -= num_mutations;
   num_outstanding_batches_--;
-  SatisfyPromises(TryAdmit(cq), lk);  // unlocks the lock
+  num_spilled_in_flight_ -= num_spilled;
+  auto admission_promises = TryAdmit(cq, lk);
+  SatisfyPromises(std::move(admission_promises), lk);  // unlocks the lock
 }
 
 std::vector<MutationBatcher::AdmissionPromise> MutationBatcher::TryAdmit(
-    CompletionQueue& cq) {
+    CompletionQueue& cq, std::unique_lock<std::mutex>& lk) {
   // Defer satisfying promises until we release the lock.
   std::vector<AdmissionPromise> admission_promises;
 
-  do {
-    while (!pending_mutations_.empty() &&
-           HasSpaceFor(pending_mutations_.front())) {
-      auto& mut = pending_mutations_.front();
-      admission_promises.emplace_back(std::move(mut.admission_promise));
-      Admit(std::move(mut));
-      pending_mutations_.pop();
+  for (;;) {
+    do {
+      // Mutations recovered or spilled to disk are older than any mutations
+      // waiting in memory.
+      while (!spilled_ready_.empty() && HasSpaceFor(spilled_ready_.front())) {
+        auto& mut = spilled_ready_.front();
+        spilled_ready_size_ -= mut.request_size;
+        Admit(std::move(mut), /*spilled=*/true);
+        spilled_ready_.pop_front();
+      }
+      while (!pending_mutations_.empty() &&
+             HasSpaceFor(pending_mutations_.front())) {
+        auto& mut = pending_mutations_.front();
+        admission_promises.emplace_back(std::move(mut.admission_promise));
+        Admit(std::move(mut));
+        pending_mutations_.pop();
+      }
+    } while (FlushIfPossible(cq));
+
+    // Only one thread at a time reads or truncates the file, the others do
+    // not wait for it.
+    if (!spill_log_ || spill_io_active_) break;
+    if (num_spilled_ != 0 &&
+        spilled_ready_size_ < options_.max_size_per_batch) {
+      ReadSpilled(lk);
+      continue;
+    }
+    if (spill_needs_reset_ && num_spilled_ == 0 &&
+        num_spilled_in_flight_ == 0) {
+      // All the spilled mutations have completed, the file can be truncated.
+      ResetSpillFile(lk);
     }
-  } while (FlushIfPossible(cq));
+    break;
+  }
   return admission_promises;
 }
 
-void MutationBatcher::Admit(PendingSingleRowMutation mut) {
+void MutationBatcher::Admit(PendingSingleRowMutation mut, bool spilled) {
   outstanding_size_ += mut.request_size;
   cur_batch_->requests_size += mut.request_size;
   cur_batch_->num_mutations += mut.num_mutations;
   cur_batch_->requests.emplace_back(std::move(mut.mut));
-  cur_batch_->mutation_data.emplace_back(MutationData(std::move(mut)));
+  cur_batch_->mutation_data.emplace_back(
+      MutationData(std::move(mut), spilled));
+}
+
+std::vector<MutationBatcher::AdmissionPromise> MutationBatcher::Spill(
+    CompletionQueue& cq, PendingSingleRowMutation mut,
+    std::unique_lock<std::mutex>& lk) {
+  // Newer mutations must not overtake this one while the file is written.
+  ++num_spilling_;
+  lk.unlock();
+  ::google::bigtable::v2::MutateRowsRequest::Entry entry;
+  mut.mut.MoveTo(&entry);
+  std::unique_lock<std::mutex> spill_lk(spill_mu_);
+  auto status = spill_log_->Append(entry);
+  // Acquire `mu_` before releasing `spill_mu_`, so the completion promises are
+  // saved in the same order as the records in the file.
+  lk.lock();
+  spill_lk.unlock();
+  --num_spilling_;
+
+  std::vector<AdmissionPromise> admission_promises;
+  if (status.ok()) {
+    ++num_spilled_;
+    spilled_promises_.push(std::move(mut.completion_promise));
+    // The mutation is safely stored in the spill file, admit it immediately.
+    admission_promises.emplace_back(std::move(mut.admission_promise));
+  } else {
+    GCP_LOG(WARNING) << "cannot spill mutation, keeping it in memory: "
+                     << status;
+    mut.mut = SingleRowMutation(std::move(entry));
+    pending_mutations_.push(std::move(mut));
+  }
+  for (auto& p : TryAdmit(cq, lk)) {
+    admission_promises.emplace_back(std::move(p));
+  }
+  return admission_promises;
+}
+
+void MutationBatcher::ReadSpilled(std::unique_lock<std::mutex>& lk) {
+  spill_io_active_ = true;
+  auto const budget = options_.max_size_per_batch - spilled_ready_size_;
+  lk.unlock();
+
+  std::vector<StatusOr<SingleRowMutation>> mutations;
+  std::unique_lock<std::mutex> spill_lk(spill_mu_);
+  for (std::size_t size = 0; !spill_log_->empty() && size < budget;) {
+    size += spill_log_->next_request_size();
+    mutations.push_back(spill_log_->Next());
+  }
+  spill_lk.unlock();
+
+  lk.lock();
+  spill_io_active_ = false;
+  spill_needs_reset_ = true;
+  num_spilled_ -= mutations.size();
+  for (auto& mut : mutations) {
+    // Recovered mutations are always first in the file, nobody is waiting
+    // for their results. The promises of any mutations spilled after the
+    // ones just read are queued after theirs.
+    CompletionPromise completion_promise;
+    if (num_recovered_ != 0) {
+      --num_recovered_;
+    } else {
+      completion_promise = std::move(spilled_promises_.front());
+      spilled_promises_.pop();
+    }
+    if (!mut) {
+      GCP_LOG(ERROR) << "cannot read mutation from spill file: "
+                     << mut.status();
+      --num_requests_pending_;
+      lost_spilled_.emplace_back(std::move(completion_promise),
+                                 std::move(mut).status());
+      continue;
+    }
+    ++num_spilled_in_flight_;
+    PendingSingleRowMutation pending(*std::move(mut),
+                                     std::move(completion_promise),
+                                     AdmissionPromise());
+    spilled_ready_size_ += pending.request_size;
+    spilled_ready_.push_back(std::move(pending));
+  }
+}
+
+void MutationBatcher::ResetSpillFile(std::unique_lock<std::mutex>& lk) {
+  spill_io_active_ = true;
+  lk.unlock();
+
+  std::unique_lock<std::mutex> spill_lk(spill_mu_);
+  lk.lock();
+  // Other threads may have spilled more mutations before we got `spill_mu_`.
+  // No mutations can be read while `spill_io_active_` is set, and none can be
+  // spilled while we hold `spill_mu_`.
+  bool const reset = num_spilled_ == 0;
+  if (reset) spill_needs_reset_ = false;
+  lk.unlock();
+  auto status = reset ? spill_log_->Reset() : Status();
+  spill_lk.unlock();
+
+  if (!status.ok()) {
+    GCP_LOG(WARNING) << "cannot truncate MutationBatcher spill file: "
+                     << status;
+  }
+  lk.lock();
+  spill_io_active_ = false;
 }
 
 void MutationBatcher::SatisfyPromises(
     std::vector<AdmissionPromise> admission_promises,
     std::unique_lock<std::mutex>& lk) {
   std::vector<NoMorePendingPromise> no_more_pending_promises;
-  if (num_requests_pending_ == 0 && num_outstanding_batches_ == 0) {
+  if (num_requests_pending_ == 0 && num_outstanding_batches_ == 0 &&
+      !spill_io_active_) {
     // We should wait not only on num_requests_pending_ being zero but also on
     // num_outstanding_batches_ because we want to allow the user to kill the
     // completion queue after this promise is fulfilled. Otherwise, the user can
     // destroy the completion queue while the last batch is still being
-    // processed - we've had this bug (#2140).
+    // processed - we've had this bug (#2140). For the same reason wait for any
+    // thread accessing the spill file.
     no_more_pending_promises_.swap(no_more_pending_promises);
   }
+  std::vector<std::pair<CompletionPromise, Status>> lost_spilled;
+  lost_spilled_.swap(lost_spilled);
   lk.unlock();
 
+  for (auto& p : lost_spilled) {
+    p.first.set_value(std::move(p.second));
+  }
+
   // Inform the user that we've admitted these mutations and there might be some
   // space in the buffer finally.
   for (auto& promise : admission_promises) {
@@ -17,16 +17,20 @@
 
 #include "google/cloud/bigtable/client_options.h"
 #include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/internal/adaptive_batch_limit.h"
+#include "google/cloud/bigtable/internal/mutation_spill_log.h"
 #include "google/cloud/bigtable/mutations.h"
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/status.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <chrono>
 #include <deque>
 #include <functional>
 #include <memory>
 #include <queue>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -48,6 +52,9 @@ inline namespace BIGTABLE_CLIENT_NS {
  * Applications must provide a `CompletionQueue` to (asynchronously) execute
  * these operations. The application is responsible of executing the
  * `CompletionQueue` event loop in one or more threads.
+ *
+ * Optionally, mutations that do not fit in the outstanding budget can be
+ * spilled to a local file, see `Options::SetSpillFile()`.
  */
 class MutationBatcher {
  public:
@@ -79,19 +86,77 @@ class MutationBatcher {
       return *this;
     }
 
+    /**
+     * Adapt the number of outstanding batches to the service load.
+     *
+     * With this option the `MutationBatcher` starts with `max_batches`
+     * outstanding batches, halves that number when a batch takes longer than
+     * @p target_latency_arg or more than @p max_error_rate_arg of its
+     * mutations fail, and increases it by one after a round of healthy
+     * batches. The number of outstanding batches is never below
+     * @p min_batches_arg or above `max_batches`.
+     *
+     * Use this option to run bulk loads alongside latency sensitive traffic,
+     * the current limit is available via
+     * `MutationBatcher::current_max_batches()`.
+     */
+    Options& SetAdaptiveThrottling(std::chrono::milliseconds target_latency_arg,
+                                   std::size_t min_batches_arg = 1,
+                                   double max_error_rate_arg = 0.1) {
+      adaptive_throttling = true;
+      target_latency = target_latency_arg;
+      min_batches = min_batches_arg;
+      max_error_rate = max_error_rate_arg;
+      return *this;
+    }
+
+    /**
+     * Spill mutations to a local write-ahead log when the batcher is full.
+     *
+     * By default, mutations that do not fit in `max_outstanding_size` are
+     * kept in memory, and their *admission* future is only satisfied once
+     * they are admitted. With this option such mutations are appended to
+     * @p path_arg instead, and their *admission* future is satisfied as soon
+     * as they are written. They are read back, in order, as capacity returns.
+     * Only a few bytes of bookkeeping per spilled mutation, and up to about
+     * `max_size_per_batch` bytes of mutations read ahead from the file, are
+     * kept in memory. The file is never accessed while holding the lock that
+     * protects the batcher's state, so a slow disk does not block the
+     * completion queue threads or `AsyncApply()` calls that do not spill.
+     *
+     * The file is truncated once all the spilled mutations are applied. If the
+     * process stops before that, a new `MutationBatcher` using the same file
+     * recovers any mutations left in it; call `ReplaySpillFile()` to start
+     * sending them. Some recovered mutations may have been applied already,
+     * use explicit timestamps to make replaying them harmless.
+     *
+     * Data is flushed to the operating system after each mutation, it
+     * survives a process crash but not necessarily a machine crash. If the
+     * file cannot be written the mutation is kept in memory instead.
+     */
+    Options& SetSpillFile(std::string path_arg) {
+      spill_file = std::move(path_arg);
+      return *this;
+    }
+
     std::size_t max_mutations_per_batch;
     std::size_t max_size_per_batch;
     std::size_t max_batches;
     std::size_t max_outstanding_size;
+    bool adaptive_throttling;
+    std::chrono::milliseconds target_latency;
+    std::size_t min_batches;
+    double max_error_rate;
+    std::string spill_file;
   };
 
-  explicit MutationBatcher(Table table, Options options = Options())
-      : table_(std::move(table)),
-        options_(options),
-        num_outstanding_batches_(),
-        outstanding_size_(),
-        num_requests_pending_(),
-        cur_batch_(std::make_shared<Batch>()) {}
+  /**
+   * Create a batcher for @p table.
+   *
+   * @throws std::runtime_error if `options.spill_file` is set but the file
+   *     cannot be opened or recovered.
+   */
+  explicit MutationBatcher(Table table, Options options = Options());
 
   /**
    * Asynchronously apply mutation.
@@ -156,6 +221,24 @@ class MutationBatcher {
    */
   future<void> AsyncWaitForNoPendingRequests();
 
+  /**
+   * The current limit on outstanding batches.
+   *
+   * This is `Options::max_batches` unless adaptive throttling is enabled, in
+   * which case it reflects the recent latency and error rate of the batches.
+   */
+  std::size_t current_max_batches();
+
+  /**
+   * Start sending the mutations recovered from the spill file, if any.
+   *
+   * Mutations recovered when the batcher is created are counted as pending by
+   * `AsyncWaitForNoPendingRequests()`. They are sent, ahead of any new
+   * mutations, after this function or `AsyncApply()` is called. Their results
+   * are not reported to the application.
+   */
+  void ReplaySpillFile(CompletionQueue& cq);
+
  private:
   using CompletionPromise = promise<Status>;
   using AdmissionPromise = promise<void>;
@@ -185,11 +268,14 @@ class MutationBatcher {
    * is "done", so we can simulate a success report.
    */
   struct MutationData {
-    explicit MutationData(PendingSingleRowMutation pending)
+    MutationData(PendingSingleRowMutation pending, bool spilled_arg)
         : completion_promise(std::move(pending.completion_promise)),
-          done(false) {}
+          done(false),
+          spilled(spilled_arg) {}
     CompletionPromise completion_promise;
     bool done;
+    /// Set if the mutation was read from the spill file.
+    bool spilled;
   };
 
   /**
@@ -215,6 +301,8 @@ class MutationBatcher {
     size_t requests_size;
     BulkMutation requests;
     std::vector<MutationData> mutation_data;
+    /// When the batch was sent, used to measure its latency.
+    std::chrono::steady_clock::time_point start;
   };
 
   /// Check if a mutation doesn't exceed allowed limits.
@@ -224,7 +312,10 @@ class MutationBatcher {
    * Check whether there is space for the passed mutation in the currently
    * constructed batch.
    */
-  bool HasSpaceFor(PendingSingleRowMutation const& mut) const;
+  bool HasSpaceFor(PendingSingleRowMutation const& mut) const {
+    return HasSpaceFor(mut.request_size, mut.num_mutations);
+  }
+  bool HasSpaceFor(std::size_t request_size, std::size_t num_mutations) const;
 
   /**
    * Check if one can append a mutation to the currently constructed batch.
@@ -235,7 +326,8 @@ class MutationBatcher {
     // If some mutations are already subject to flow control, don't admit any
     // new, even if there's space for them. Otherwise we might starve big
     // mutations.
-    return pending_mutations_.empty() && HasSpaceFor(mut);
+    return pending_mutations_.empty() && num_spilling_ == 0 &&
+           num_spilled_ == 0 && spilled_ready_.empty() && HasSpaceFor(mut);
   }
 
   /**
@@ -249,17 +341,41 @@ class MutationBatcher {
                        std::vector<FailedMutation> const& failed);
 
   /**
-   * Try to move mutations waiting in `pending_mutations_` to the currently
-   * constructed batch.
+   * Try to move mutations waiting in `spilled_ready_` and `pending_mutations_`
+   * to the currently constructed batch.
+   *
+   * If needed, this also reads more mutations from the spill file, or
+   * truncates the file once all its mutations are applied. `lk` is released
+   * while the file is accessed.
    *
    * @return the admission promises of the newly admitted mutations.
    */
-  std::vector<MutationBatcher::AdmissionPromise> TryAdmit(CompletionQueue& cq);
+  std::vector<MutationBatcher::AdmissionPromise> TryAdmit(
+      CompletionQueue& cq, std::unique_lock<std::mutex>& lk);
 
   /**
    * Append mutation `mut` to the currently constructed batch.
    */
-  void Admit(PendingSingleRowMutation mut);
+  void Admit(PendingSingleRowMutation mut, bool spilled = false);
+
+  /**
+   * Append `mut` to the spill file, `lk` is released while writing the file.
+   *
+   * On success the completion promise is saved until the mutation is read back
+   * from the file. If the file cannot be written the mutation is queued in
+   * `pending_mutations_`.
+   *
+   * @return the admission promises of the newly admitted mutations.
+   */
+  std::vector<MutationBatcher::AdmissionPromise> Spill(
+      CompletionQueue& cq, PendingSingleRowMutation mut,
+      std::unique_lock<std::mutex>& lk);
+
+  /// Read mutations from the spill file into `spilled_ready_`, releases `lk`.
+  void ReadSpilled(std::unique_lock<std::mutex>& lk);
+
+  /// Truncate the spill file if it has no unread mutations, releases `lk`.
+  void ResetSpillFile(std::unique_lock<std::mutex>& lk);
 
   /**
    * Satisfies passed admission promises and potentially the promises of no more
@@ -268,6 +384,12 @@ class MutationBatcher {
   void SatisfyPromises(std::vector<AdmissionPromise>,
                        std::unique_lock<std::mutex>& lk);
 
+  /// The current limit on outstanding batches, requires holding `mu_`.
+  std::size_t MaxBatches() const {
+    return options_.adaptive_throttling ? batch_limit_.limit()
+                                        : options_.max_batches;
+  }
+
   std::mutex mu_;
   Table table_;
   Options options_;
@@ -278,6 +400,8 @@ class MutationBatcher {
   size_t outstanding_size_;
   // Number of uncompleted SingleRowMutations (including not admitted).
   size_t num_requests_pending_;
+  /// Adjusts the limit on outstanding batches, if enabled in `options_`.
+  internal::AdaptiveBatchLimit batch_limit_;
 
   /// Currently contructed batch of mutations.
   std::shared_ptr<Batch> cur_batch_;
@@ -289,6 +413,36 @@ class MutationBatcher {
    */
   std::queue<PendingSingleRowMutation> pending_mutations_;
 
+  /**
+   * Serializes access to `spill_log_`.
+   *
+   * File I/O happens with this mutex held, and without holding `mu_`. When
+   * both are needed `spill_mu_` is acquired first.
+   */
+  std::mutex spill_mu_;
+  /// Holds the mutations that did not fit in memory, if configured.
+  std::unique_ptr<internal::MutationSpillLog> spill_log_;
+  /// The completion promises for the mutations spilled by this object.
+  std::queue<CompletionPromise> spilled_promises_;
+  /// The number of mutations in the spill file not read yet.
+  std::size_t num_spilled_;
+  /// The number of mutations being written to the spill file.
+  std::size_t num_spilling_;
+  /// The number of mutations recovered from the spill file not read yet.
+  std::size_t num_recovered_;
+  /// The number of mutations read from the spill file but not completed.
+  std::size_t num_spilled_in_flight_;
+  /// Mutations read from the spill file, waiting for space in a batch.
+  std::deque<PendingSingleRowMutation> spilled_ready_;
+  /// The total `request_size` of `spilled_ready_`.
+  std::size_t spilled_ready_size_;
+  /// Set while a thread reads or truncates the spill file.
+  bool spill_io_active_;
+  /// Set if mutations were read from the spill file since it was truncated.
+  bool spill_needs_reset_;
+  /// Spilled mutations that could not be read back, satisfied without `mu_`.
+  std::vector<std::pair<CompletionPromise, Status>> lost_spilled_;
+
   /**
    * The list of promises made to this point.
    *
@@ -17,11 +17,14 @@
 #include "google/cloud/bigtable/testing/table_test_fixture.h"
 #include "google/cloud/bigtable/testing/validate_metadata.h"
 #include "google/cloud/future.h"
+#include "google/cloud/internal/random.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include "google/cloud/testing_util/chrono_literals.h"
 #include "google/cloud/testing_util/mock_completion_queue.h"
 #include <google/protobuf/util/message_differencer.h>
 #include <gmock/gmock.h>
+#include <cstdio>
+#include <fstream>
 
 namespace google {
 namespace cloud {
@@ -255,6 +258,16 @@ TEST(OptionsTest, Trivial) {
   ASSERT_EQ(4, opt.max_outstanding_size);
 }
 
+TEST(OptionsTest, AdaptiveThrottling) {
+  MutationBatcher::Options opt;
+  EXPECT_FALSE(opt.adaptive_throttling);
+  opt.SetAdaptiveThrottling(100_ms, 2, 0.5);
+  EXPECT_TRUE(opt.adaptive_throttling);
+  EXPECT_EQ(100_ms, opt.target_latency);
+  EXPECT_EQ(2, opt.min_batches);
+  EXPECT_EQ(0.5, opt.max_error_rate);
+}
+
 TEST_F(MutationBatcherTest, TrivialTest) {
   std::vector<SingleRowMutation> mutations(
       {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")})});
@@ -466,6 +479,24 @@ TEST_F(MutationBatcherTest, ErrorsArePropagated) {
   EXPECT_FALSE(state1.states_[1]->completion_status.ok());
 }
 
+TEST_F(MutationBatcherTest, AdaptiveThrottlingReactsToErrors) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+  batcher_.reset(new MutationBatcher(
+      table_, MutationBatcher::Options().SetMaxBatches(4).SetAdaptiveThrottling(
+                  std::chrono::hours(1))));
+  EXPECT_EQ(4, batcher_->current_max_batches());
+
+  ExpectInteraction({Exchange({mutations[0]}, {ResultPiece({}, {}, {0})})});
+
+  auto state = Apply(mutations[0]);
+  FinishSingleItemStream();
+
+  EXPECT_TRUE(state->completed);
+  EXPECT_FALSE(state->completion_status.ok());
+  EXPECT_EQ(2, batcher_->current_max_batches());
+}
+
 TEST_F(MutationBatcherTest, SmallMutationsDontSkipPending) {
   std::vector<SingleRowMutation> mutations(
       {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
@@ -659,6 +690,149 @@ TEST_F(MutationBatcherTest, WaitForNoPendingEdgeCases) {
   EXPECT_EQ(no_more_pending2.wait_for(1_ms), std::future_status::ready);
 }
 
+std::string SpillFileName() {
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  return ::testing::TempDir() + "batcher-spill-" +
+         google::cloud::internal::Sample(generator, 16,
+                                         "abcdefghijklmnopqrstuvwxyz") +
+         ".log";
+}
+
+std::streamoff FileSize(std::string const& path) {
+  std::ifstream is(path, std::ios::binary | std::ios::ate);
+  return is.tellg();
+}
+
+// Test that mutations are spilled to disk when the batcher is full.
+TEST_F(MutationBatcherTest, SpillWhenFull) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("bar", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+  auto const spill_file = SpillFileName();
+
+  batcher_.reset(new MutationBatcher(
+      table_, MutationBatcher::Options()
+                  .SetMaxBatches(1)
+                  .SetMaxOutstandingSize(MutationSize(mutations[0]))
+                  .SetSpillFile(spill_file)));
+
+  ExpectInteraction({Exchange({mutations[0]}, {ResultPiece({0}, {}, {})}),
+                     Exchange({mutations[1]}, {ResultPiece({0}, {}, {})})});
+
+  auto state0 = Apply(mutations[0]);
+  EXPECT_TRUE(state0->admitted);
+  auto state1 = Apply(mutations[1]);
+  // The second mutation does not fit, but it is admitted once on disk.
+  EXPECT_TRUE(state1->admitted);
+  EXPECT_FALSE(state1->completed);
+  EXPECT_LT(0, FileSize(spill_file));
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+  EXPECT_TRUE(state0->completed);
+  EXPECT_FALSE(state1->completed);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+  EXPECT_TRUE(state1->completed);
+  EXPECT_STATUS_OK(state1->completion_status);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+  // Once all the spilled mutations complete the file is truncated.
+  EXPECT_EQ(0, FileSize(spill_file));
+
+  batcher_.reset();
+  std::remove(spill_file.c_str());
+}
+
+// Test that spilled mutations are read back a few at a time, in order.
+TEST_F(MutationBatcherTest, SpillReadsAheadOneBatch) {
+  std::vector<SingleRowMutation> mutations;
+  for (auto const* key : {"foo0", "foo1", "foo2", "foo3"}) {
+    mutations.emplace_back(
+        SingleRowMutation(key, {bt::SetCell("fam", "col", 0_ms, "baz")}));
+  }
+  auto const spill_file = SpillFileName();
+  auto const size = MutationSize(mutations[0]);
+
+  batcher_.reset(new MutationBatcher(
+      table_, MutationBatcher::Options()
+                  .SetMaxBatches(1)
+                  .SetMaxSizePerBatch(size)
+                  .SetMaxOutstandingSize(size)
+                  .SetSpillFile(spill_file)));
+
+  std::vector<Exchange> exchanges;
+  for (auto const& m : mutations) {
+    exchanges.push_back(Exchange({m}, {ResultPiece({0}, {}, {})}));
+  }
+  ExpectInteraction(exchanges);
+
+  std::vector<std::shared_ptr<MutationState>> states;
+  for (auto const& m : mutations) states.push_back(Apply(m));
+  for (auto const& state : states) EXPECT_TRUE(state->admitted);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  for (std::size_t i = 0; i != states.size(); ++i) {
+    EXPECT_FALSE(states[i]->completed);
+    EXPECT_LT(0, FileSize(spill_file));
+    FinishSingleItemStream();
+    EXPECT_TRUE(states[i]->completed);
+    EXPECT_STATUS_OK(states[i]->completion_status);
+  }
+  EXPECT_EQ(0, NumOperationsOutstanding());
+  EXPECT_EQ(0, FileSize(spill_file));
+  auto no_more_pending = batcher_->AsyncWaitForNoPendingRequests();
+  EXPECT_EQ(no_more_pending.wait_for(1_ms), std::future_status::ready);
+
+  batcher_.reset();
+  std::remove(spill_file.c_str());
+}
+
+// Test that mutations left in the spill file are replayed.
+TEST_F(MutationBatcherTest, SpillFileRecovery) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("bar", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+  auto const spill_file = SpillFileName();
+  {
+    auto log = internal::MutationSpillLog::Open(spill_file);
+    ASSERT_STATUS_OK(log);
+    for (auto m : mutations) {
+      google::bigtable::v2::MutateRowsRequest::Entry entry;
+      m.MoveTo(&entry);
+      ASSERT_STATUS_OK((*log)->Append(entry));
+    }
+  }
+
+  batcher_.reset(new MutationBatcher(
+      table_, MutationBatcher::Options().SetSpillFile(spill_file)));
+  ExpectInteraction(
+      {Exchange({mutations[0], mutations[1]}, {ResultPiece({0, 1}, {}, {})})});
+
+  // The recovered mutations are pending, but not sent until requested.
+  auto no_more_pending = batcher_->AsyncWaitForNoPendingRequests();
+  EXPECT_EQ(no_more_pending.wait_for(1_ms), std::future_status::timeout);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+
+  batcher_->ReplaySpillFile(cq_);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+  FinishSingleItemStream();
+  EXPECT_EQ(no_more_pending.wait_for(1_ms), std::future_status::ready);
+  EXPECT_EQ(0, FileSize(spill_file));
+
+  batcher_.reset();
+  std::remove(spill_file.c_str());
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+// Test that the batcher reports spill files that cannot be opened.
+TEST_F(MutationBatcherTest, SpillFileOpenError) {
+  auto options = MutationBatcher::Options().SetSpillFile(
+      SpillFileName() + "/not-a-directory/spill.log");
+  EXPECT_THROW(MutationBatcher(table_, options), std::runtime_error);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
 }  // namespace
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
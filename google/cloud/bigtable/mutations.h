@@ -26,6 +26,7 @@
 #include <google/bigtable/v2/data.pb.h>
 #include <grpcpp/grpcpp.h>
 #include <chrono>
+#include <memory>
 #include <type_traits>
 
 namespace google {
@@ -448,21 +449,31 @@ class PermanentMutationFailure : public std::runtime_error {
   grpc::Status status_;
 };
 
+class BulkMutationBuilder;
+namespace internal {
+class BulkMutatorState;
+}  // namespace internal
+
 /**
  * Represent a set of mutations across multiple rows.
  *
  * Cloud Bigtable can batch multiple mutations in a single request.
  * The mutations are not atomic, but it is more efficient to send them
  * in a batch than to make multiple smaller requests.
+ *
+ * @see BulkMutationBuilder to create large bulk mutations without allocating
+ *     memory for each cell.
  */
 class BulkMutation {
  public:
   /// Create an empty set of mutations.
-  BulkMutation() : request_() {}
+  BulkMutation()
+      : request_(std::make_shared<google::bigtable::v2::MutateRowsRequest>()) {
+  }
 
   /// Create a multi-row mutation from a range of SingleRowMutations.
   template <typename iterator>
-  BulkMutation(iterator begin, iterator end) {
+  BulkMutation(iterator begin, iterator end) : BulkMutation() {
     static_assert(
         std::is_convertible<decltype(*begin), SingleRowMutation>::value,
         "The iterator value type must be convertible to SingleRowMutation");
@@ -495,9 +506,19 @@ class BulkMutation {
     emplace_many(std::forward<M>(m)...);
   }
 
+  BulkMutation(BulkMutation&&) noexcept = default;
+  BulkMutation& operator=(BulkMutation&&) noexcept = default;
+  BulkMutation(BulkMutation const& rhs)
+      : request_(std::make_shared<google::bigtable::v2::MutateRowsRequest>(
+            rhs.request())) {}
+  BulkMutation& operator=(BulkMutation const& rhs) {
+    BulkMutation tmp(rhs);
+    return *this = std::move(tmp);
+  }
+
   // Add a mutation to the batch.
   BulkMutation& emplace_back(SingleRowMutation mut) {
-    mut.MoveTo(request_.add_entries());
+    mut.MoveTo(mutable_request().add_entries());
     return *this;
   }
 
@@ -509,28 +530,61 @@ class BulkMutation {
 
   // Add a mutation to the batch.
   BulkMutation& push_back(SingleRowMutation mut) {
-    mut.MoveTo(request_.add_entries());
+    mut.MoveTo(mutable_request().add_entries());
     return *this;
   }
 
   /// Move the contents into a bigtable::v2::MutateRowsRequest
   void MoveTo(google::bigtable::v2::MutateRowsRequest* request) {
-    request_.Swap(request);
-    request_ = {};
+    // This is a deep copy if the mutations were built on a different arena.
+    mutable_request().Swap(request);
+    request_.reset();
   }
 
   /// Return true if there are no mutations in this set.
-  bool empty() const { return request_.entries().empty(); }
+  bool empty() const { return request().entries().empty(); }
 
   /// Return the number of mutations in this set.
-  std::size_t size() const { return request_.entries().size(); }
+  std::size_t size() const { return request().entries().size(); }
 
   /// Return the estimated size in bytes of all the mutations in this set.
   std::size_t estimated_size_in_bytes() const {
-    return request_.ByteSizeLong();
+    return request().ByteSizeLong();
   }
 
  private:
+  friend class BulkMutationBuilder;
+  friend class internal::BulkMutatorState;
+
+  /**
+   * Create a bulk mutation from a request proto, possibly allocated in an
+   * arena.
+   *
+   * If the request lives in an arena @p request must keep the arena alive, for
+   * example, using the `std::shared_ptr<>` aliasing constructor.
+   */
+  explicit BulkMutation(
+      std::shared_ptr<google::bigtable::v2::MutateRowsRequest> request)
+      : request_(std::move(request)) {}
+
+  google::bigtable::v2::MutateRowsRequest const& request() const {
+    if (request_) return *request_;
+    return google::bigtable::v2::MutateRowsRequest::default_instance();
+  }
+
+  google::bigtable::v2::MutateRowsRequest& mutable_request() {
+    if (!request_) {
+      request_ = std::make_shared<google::bigtable::v2::MutateRowsRequest>();
+    }
+    return *request_;
+  }
+
+  /// Transfer the request proto, including any arena that owns it.
+  std::shared_ptr<google::bigtable::v2::MutateRowsRequest> ReleaseRequest() {
+    mutable_request();
+    return std::move(request_);
+  }
+
   template <typename... M>
   void emplace_many(SingleRowMutation first, M&&... tail) {
     emplace_back(std::move(first));
@@ -540,7 +594,7 @@ class BulkMutation {
   void emplace_many(SingleRowMutation m) { emplace_back(std::move(m)); }
 
  private:
-  google::bigtable::v2::MutateRowsRequest request_;
+  std::shared_ptr<google::bigtable::v2::MutateRowsRequest> request_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
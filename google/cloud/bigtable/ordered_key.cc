@@ -0,0 +1,156 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/ordered_key.h"
+#include <limits>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+Status InvalidKey(char const* where, std::size_t position) {
+  return Status(StatusCode::kInvalidArgument,
+                std::string(where) + " - invalid encoded field at position " +
+                    std::to_string(position));
+}
+
+std::uint64_t FlipSign(std::int64_t value) {
+  return static_cast<std::uint64_t>(value) ^ (std::uint64_t{1} << 63U);
+}
+
+std::int64_t UnflipSign(std::uint64_t value) {
+  value ^= std::uint64_t{1} << 63U;
+  // Avoid implementation-defined conversions for out of range values.
+  if (value <= static_cast<std::uint64_t>(
+                   std::numeric_limits<std::int64_t>::max())) {
+    return static_cast<std::int64_t>(value);
+  }
+  return -static_cast<std::int64_t>(~value) - 1;
+}
+
+}  // namespace
+
+OrderedKeyEncoder& OrderedKeyEncoder::AppendString(std::string const& value,
+                                                   SortOrder order) {
+  std::string encoded;
+  encoded.reserve(value.size() + 2);
+  for (char c : value) {
+    encoded.push_back(c);
+    if (c == '\0') encoded.push_back('\xFF');
+  }
+  encoded.push_back('\0');
+  encoded.push_back('\x01');
+  AppendEncoded(std::move(encoded), order);
+  return *this;
+}
+
+OrderedKeyEncoder& OrderedKeyEncoder::AppendInt64(std::int64_t value,
+                                                  SortOrder order) {
+  auto const v = FlipSign(value);
+  std::string encoded(8, '\0');
+  for (int i = 0; i != 8; ++i) {
+    encoded[7 - i] = static_cast<char>((v >> (8U * i)) & 0xFFU);
+  }
+  AppendEncoded(std::move(encoded), order);
+  return *this;
+}
+
+OrderedKeyEncoder& OrderedKeyEncoder::AppendUInt64(std::uint64_t value,
+                                                   SortOrder order) {
+  std::string bytes;
+  for (; value != 0; value >>= 8U) {
+    bytes.insert(bytes.begin(), static_cast<char>(value & 0xFFU));
+  }
+  AppendEncoded(static_cast<char>(bytes.size()) + bytes, order);
+  return *this;
+}
+
+OrderedKeyEncoder& OrderedKeyEncoder::AppendTimestamp(
+    std::chrono::system_clock::time_point value, SortOrder order) {
+  auto const micros = std::chrono::duration_cast<std::chrono::microseconds>(
+      value.time_since_epoch());
+  return AppendInt64(static_cast<std::int64_t>(micros.count()), order);
+}
+
+void OrderedKeyEncoder::AppendEncoded(std::string encoded, SortOrder order) {
+  if (order == SortOrder::kDescending) {
+    for (auto& c : encoded) c = static_cast<char>(~c);
+  }
+  key_ += encoded;
+}
+
+unsigned char OrderedKeyDecoder::ByteAt(std::size_t i, SortOrder order) const {
+  auto b = static_cast<unsigned char>(key_[i]);
+  if (order == SortOrder::kDescending) b = static_cast<unsigned char>(~b);
+  return b;
+}
+
+StatusOr<std::string> OrderedKeyDecoder::ReadString(SortOrder order) {
+  std::string value;
+  for (auto i = position_; i + 1 < key_.size(); ++i) {
+    auto const b = ByteAt(i, order);
+    if (b != 0) {
+      value.push_back(static_cast<char>(b));
+      continue;
+    }
+    auto const next = ByteAt(i + 1, order);
+    if (next == 0x01) {
+      position_ = i + 2;
+      return value;
+    }
+    if (next != 0xFF) break;
+    value.push_back('\0');
+    ++i;
+  }
+  return InvalidKey(__func__, position_);
+}
+
+StatusOr<std::int64_t> OrderedKeyDecoder::ReadInt64(SortOrder order) {
+  if (key_.size() - position_ < 8) return InvalidKey(__func__, position_);
+  std::uint64_t v = 0;
+  for (std::size_t i = 0; i != 8; ++i) {
+    v = (v << 8U) | ByteAt(position_ + i, order);
+  }
+  position_ += 8;
+  return UnflipSign(v);
+}
+
+StatusOr<std::uint64_t> OrderedKeyDecoder::ReadUInt64(SortOrder order) {
+  if (position_ == key_.size()) return InvalidKey(__func__, position_);
+  std::size_t const length = ByteAt(position_, order);
+  if (length > 8 || key_.size() - position_ - 1 < length) {
+    return InvalidKey(__func__, position_);
+  }
+  std::uint64_t v = 0;
+  for (std::size_t i = 0; i != length; ++i) {
+    v = (v << 8U) | ByteAt(position_ + 1 + i, order);
+  }
+  position_ += 1 + length;
+  return v;
+}
+
+StatusOr<std::chrono::system_clock::time_point>
+OrderedKeyDecoder::ReadTimestamp(SortOrder order) {
+  auto micros = ReadInt64(order);
+  if (!micros) return std::move(micros).status();
+  return std::chrono::system_clock::time_point(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::microseconds(*micros)));
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,136 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ORDERED_KEY_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ORDERED_KEY_H
+
+#include "google/cloud/bigtable/row_range.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/status_or.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/// The sort order for a field in a key encoded by `OrderedKeyEncoder`.
+enum class SortOrder {
+  kAscending,
+  kDescending,
+};
+
+/**
+ * Builds row keys from a sequence of typed fields, preserving their order.
+ *
+ * Cloud Bigtable sorts rows by the lexicographical order of their keys. Keys
+ * built by concatenating strings, or the textual representation of numbers,
+ * often do not sort as the application expects: "-2" sorts after "-1", "10"
+ * sorts before "9", and separators can appear inside string fields. This class
+ * encodes each field so the byte-wise order of the resulting keys matches the
+ * order of the field values, compared field by field from left to right.
+ *
+ * Each encoded field is self-delimiting, therefore any sequence of leading
+ * fields is a valid key prefix. Use `PrefixRange()` (or `RowRange::Prefix()`
+ * with `key()`) to scan all the rows matching some leading fields, and
+ * `RowRange::Range()` with two encoded keys to scan between two values.
+ *
+ * The encodings are:
+ * - Strings: `\x00` bytes are escaped as `\x00\xFF`, and the field is
+ *   terminated by `\x00\x01`.
+ * - Signed integers: 8 bytes, big-endian, with the sign bit flipped.
+ * - Unsigned integers: the number of significant bytes, followed by those bytes
+ *   in big-endian order.
+ * - Timestamps: the microseconds since the epoch, encoded as signed integers.
+ * - Fields in descending order have every byte of their encoding inverted.
+ *
+ * @par Example
+ * @code
+ * namespace cbt = google::cloud::bigtable;
+ * // Rows for each user, with the most recent events first.
+ * auto key = cbt::OrderedKeyEncoder()
+ *                .AppendString("user-123")
+ *                .AppendTimestamp(event_time, cbt::SortOrder::kDescending)
+ *                .key();
+ * // All the rows for "user-123", as a contiguous scan.
+ * auto range = cbt::OrderedKeyEncoder().AppendString("user-123").PrefixRange();
+ * @endcode
+ *
+ * @see `OrderedKeyDecoder` to extract the fields from an encoded key.
+ */
+class OrderedKeyEncoder {
+ public:
+  OrderedKeyEncoder() = default;
+
+  OrderedKeyEncoder& AppendString(std::string const& value,
+                                  SortOrder order = SortOrder::kAscending);
+  OrderedKeyEncoder& AppendInt64(std::int64_t value,
+                                 SortOrder order = SortOrder::kAscending);
+  OrderedKeyEncoder& AppendUInt64(std::uint64_t value,
+                                  SortOrder order = SortOrder::kAscending);
+
+  /// Append a timestamp, truncated to microseconds.
+  OrderedKeyEncoder& AppendTimestamp(
+      std::chrono::system_clock::time_point value,
+      SortOrder order = SortOrder::kAscending);
+
+  /// The encoded key.
+  std::string const& key() const& { return key_; }
+  std::string&& key() && { return std::move(key_); }
+
+  /// The range of all the keys starting with the fields encoded so far.
+  RowRange PrefixRange() const { return RowRange::Prefix(key_); }
+
+ private:
+  void AppendEncoded(std::string encoded, SortOrder order);
+
+  std::string key_;
+};
+
+/**
+ * Extracts the fields from a key encoded by `OrderedKeyEncoder`.
+ *
+ * The application must read the fields with the same types and sort orders
+ * used to encode them. Reading a field returns an error, and leaves the decoder
+ * unchanged, if the key does not contain a valid encoding of that type at the
+ * current position.
+ */
+class OrderedKeyDecoder {
+ public:
+  explicit OrderedKeyDecoder(std::string key) : key_(std::move(key)) {}
+
+  StatusOr<std::string> ReadString(SortOrder order = SortOrder::kAscending);
+  StatusOr<std::int64_t> ReadInt64(SortOrder order = SortOrder::kAscending);
+  StatusOr<std::uint64_t> ReadUInt64(SortOrder order = SortOrder::kAscending);
+  StatusOr<std::chrono::system_clock::time_point> ReadTimestamp(
+      SortOrder order = SortOrder::kAscending);
+
+  /// Return true if all the fields in the key have been read.
+  bool done() const { return position_ == key_.size(); }
+
+ private:
+  unsigned char ByteAt(std::size_t i, SortOrder order) const;
+
+  std::string key_;
+  std::size_t position_ = 0;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ORDERED_KEY_H
@@ -0,0 +1,177 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/ordered_key.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace bigtable = google::cloud::bigtable;
+using bigtable::OrderedKeyDecoder;
+using bigtable::OrderedKeyEncoder;
+using bigtable::SortOrder;
+
+namespace {
+/**
+ * Verify the keys produced by @p append sort like the values.
+ *
+ * The values are encoded between two other fields, to verify that the encoding
+ * is self-delimiting, and in both ascending and descending order.
+ */
+template <typename T, typename Append>
+void CheckOrder(std::vector<T> values, Append append) {
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  std::vector<std::string> ascending;
+  std::vector<std::string> descending;
+  for (auto const& v : values) {
+    OrderedKeyEncoder a;
+    a.AppendString("prefix");
+    append(a, v, SortOrder::kAscending);
+    ascending.push_back(std::move(a.AppendInt64(-1)).key());
+    OrderedKeyEncoder d;
+    d.AppendString("prefix");
+    append(d, v, SortOrder::kDescending);
+    descending.push_back(std::move(d.AppendInt64(-1)).key());
+  }
+  for (std::size_t i = 1; i < values.size(); ++i) {
+    EXPECT_LT(ascending[i - 1], ascending[i]) << "i=" << i;
+    EXPECT_GT(descending[i - 1], descending[i]) << "i=" << i;
+  }
+}
+}  // namespace
+
+TEST(OrderedKeyTest, StringOrder) {
+  CheckOrder(
+      std::vector<std::string>{"", "a", "ab", "b", "\x01", "\xFF", "\xFF\xFF",
+                               std::string("a\0", 2), std::string("a\0b", 3),
+                               std::string("\0", 1), std::string("\0\0", 2)},
+      [](OrderedKeyEncoder& e, std::string const& v, SortOrder o) {
+        e.AppendString(v, o);
+      });
+}
+
+TEST(OrderedKeyTest, Int64Order) {
+  CheckOrder(
+      std::vector<std::int64_t>{std::numeric_limits<std::int64_t>::min(),
+                                -1000000, -256, -255, -2, -1, 0, 1, 2, 9, 10,
+                                255, 256, 1000000,
+                                std::numeric_limits<std::int64_t>::max()},
+      [](OrderedKeyEncoder& e, std::int64_t v, SortOrder o) {
+        e.AppendInt64(v, o);
+      });
+}
+
+TEST(OrderedKeyTest, UInt64Order) {
+  CheckOrder(
+      std::vector<std::uint64_t>{0, 1, 2, 9, 10, 255, 256, 65535, 65536,
+                                 std::numeric_limits<std::uint64_t>::max()},
+      [](OrderedKeyEncoder& e, std::uint64_t v, SortOrder o) {
+        e.AppendUInt64(v, o);
+      });
+}
+
+TEST(OrderedKeyTest, TimestampOrder) {
+  using std::chrono::system_clock;
+  auto const now = system_clock::now();
+  CheckOrder(
+      std::vector<system_clock::time_point>{
+          system_clock::time_point{}, now - std::chrono::hours(24 * 365 * 60),
+          now - std::chrono::seconds(1), now, now + std::chrono::seconds(1)},
+      [](OrderedKeyEncoder& e, system_clock::time_point v, SortOrder o) {
+        e.AppendTimestamp(v, o);
+      });
+}
+
+TEST(OrderedKeyTest, CompositeOrder) {
+  // Keys sort by the first field, then the second field, and so on.
+  auto key = [](std::string const& s, std::int64_t v) {
+    return OrderedKeyEncoder().AppendString(s).AppendInt64(v).key();
+  };
+  EXPECT_LT(key("a", 10), key("ab", -10));
+  EXPECT_LT(key("a", -10), key("a", 10));
+  EXPECT_LT(key("a", 10), key("b", -10));
+}
+
+TEST(OrderedKeyTest, UInt64IsCompact) {
+  EXPECT_EQ(std::string("\0", 1), OrderedKeyEncoder().AppendUInt64(0).key());
+  EXPECT_EQ("\x01\x01", OrderedKeyEncoder().AppendUInt64(1).key());
+  EXPECT_EQ(std::string("\x02\x01\x00", 3),
+            OrderedKeyEncoder().AppendUInt64(256).key());
+}
+
+TEST(OrderedKeyTest, RoundTrip) {
+  using std::chrono::system_clock;
+  auto const ts = system_clock::time_point(std::chrono::microseconds(123456));
+  auto key = OrderedKeyEncoder()
+                 .AppendString(std::string("a\0b", 3))
+                 .AppendInt64(-42, SortOrder::kDescending)
+                 .AppendUInt64(300)
+                 .AppendTimestamp(ts, SortOrder::kDescending)
+                 .AppendString("tail", SortOrder::kDescending)
+                 .key();
+
+  OrderedKeyDecoder decoder(key);
+  auto s = decoder.ReadString();
+  ASSERT_TRUE(s);
+  EXPECT_EQ(std::string("a\0b", 3), *s);
+  auto i = decoder.ReadInt64(SortOrder::kDescending);
+  ASSERT_TRUE(i);
+  EXPECT_EQ(-42, *i);
+  auto u = decoder.ReadUInt64();
+  ASSERT_TRUE(u);
+  EXPECT_EQ(300, *u);
+  auto t = decoder.ReadTimestamp(SortOrder::kDescending);
+  ASSERT_TRUE(t);
+  EXPECT_EQ(ts, *t);
+  EXPECT_FALSE(decoder.done());
+  auto tail = decoder.ReadString(SortOrder::kDescending);
+  ASSERT_TRUE(tail);
+  EXPECT_EQ("tail", *tail);
+  EXPECT_TRUE(decoder.done());
+}
+
+TEST(OrderedKeyTest, DecodeErrors) {
+  OrderedKeyDecoder unterminated("abc");
+  auto s = unterminated.ReadString();
+  ASSERT_FALSE(s);
+  EXPECT_EQ(google::cloud::StatusCode::kInvalidArgument, s.status().code());
+
+  OrderedKeyDecoder bad_escape(std::string("a\0\x02", 3));
+  EXPECT_FALSE(bad_escape.ReadString());
+
+  OrderedKeyDecoder short_int("1234567");
+  EXPECT_FALSE(short_int.ReadInt64());
+  // A failed read does not consume any input.
+  EXPECT_FALSE(short_int.done());
+
+  OrderedKeyDecoder short_uint("\x03\x01\x02");
+  EXPECT_FALSE(short_uint.ReadUInt64());
+
+  OrderedKeyDecoder empty("");
+  EXPECT_TRUE(empty.done());
+  EXPECT_FALSE(empty.ReadUInt64());
+}
+
+TEST(OrderedKeyTest, PrefixRange) {
+  auto range = OrderedKeyEncoder().AppendString("user").PrefixRange();
+  EXPECT_TRUE(range.Contains(
+      OrderedKeyEncoder().AppendString("user").AppendInt64(-7).key()));
+  EXPECT_TRUE(range.Contains(
+      OrderedKeyEncoder().AppendString("user").AppendString("x").key()));
+  // A string field is not a prefix match for longer strings.
+  EXPECT_FALSE(range.Contains(OrderedKeyEncoder().AppendString("user2").key()));
+  EXPECT_FALSE(range.Contains(OrderedKeyEncoder().AppendString("use").key()));
+}
@@ -0,0 +1,105 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/split_planner.h"
+#include <fstream>
+#include <istream>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+void SplitPlanner::AddKey(std::string row_key, std::int64_t weight) {
+  if (weight < 0) weight = 0;
+  keys_[std::move(row_key)] += weight;
+  total_weight_ += weight;
+}
+
+void SplitPlanner::ReadKeys(std::istream& is, std::int64_t bytes_per_key) {
+  std::string line;
+  while (std::getline(is, line)) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (line.empty()) continue;
+    AddKey(std::move(line), bytes_per_key);
+    line = std::string{};
+  }
+}
+
+Status SplitPlanner::ReadKeysFromFile(std::string const& path,
+                                      std::int64_t bytes_per_key) {
+  std::ifstream is(path);
+  if (!is.is_open()) {
+    return Status(StatusCode::kNotFound, "cannot open key file " + path);
+  }
+  ReadKeys(is, bytes_per_key);
+  return Status();
+}
+
+void SplitPlanner::AddSamples(std::vector<RowKeySample> const& samples) {
+  // The weight of each sample is the data between the previous sample key and
+  // this one, so it is attributed to the previous key. The first range starts
+  // at the beginning of the table, represented by the empty key.
+  std::string previous;
+  std::int64_t previous_offset = 0;
+  for (auto const& s : samples) {
+    AddKey(previous, s.offset_bytes - previous_offset);
+    previous = s.row_key;
+    previous_offset = s.offset_bytes;
+  }
+}
+
+std::vector<std::string> SplitPlanner::Plan(std::size_t tablet_count) const {
+  std::vector<std::string> splits;
+  if (tablet_count <= 1 || total_weight_ <= 0) return splits;
+
+  // The k-th target is at `k * total_weight_ / tablet_count`. A split before a
+  // key is placed at the accumulated weight of all the smaller keys, pick the
+  // split closest to each target.
+  auto const step = static_cast<long double>(total_weight_) /
+                    static_cast<long double>(tablet_count);
+  std::size_t next = 1;
+  auto target = [&] { return step * static_cast<long double>(next); };
+  long double cumulative = 0;
+  for (auto const& kv : keys_) {
+    if (next >= tablet_count) break;
+    auto const following = cumulative + static_cast<long double>(kv.second);
+    auto closer_than_following = [&] {
+      return cumulative >= target() ||
+             (following >= target() &&
+              target() - cumulative <= following - target());
+    };
+    // Splitting before the first key (or before keys with no data) would
+    // create empty tablets.
+    if (cumulative > 0 && closer_than_following()) {
+      splits.push_back(kv.first);
+      // A heavy key may be the closest split for several targets.
+      while (next < tablet_count && closer_than_following()) ++next;
+    }
+    cumulative = following;
+  }
+  return splits;
+}
+
+std::vector<std::string> SplitPlanner::PlanByTabletSize(
+    std::int64_t bytes_per_tablet) const {
+  if (bytes_per_tablet <= 0) return {};
+  auto tablets = total_weight_ / bytes_per_tablet;
+  if (total_weight_ % bytes_per_tablet != 0) ++tablets;
+  return Plan(static_cast<std::size_t>(tablets));
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
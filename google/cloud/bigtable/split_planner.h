@@ -0,0 +1,126 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_SPLIT_PLANNER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_SPLIT_PLANNER_H
+
+#include "google/cloud/bigtable/row_key_sample.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/status.h"
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Computes balanced split points for a new table from a sample of row keys.
+ *
+ * New tables start with a single tablet unless `TableConfig` includes some
+ * `initial_splits`, and bulk loads into such tables are limited to a single
+ * server until Cloud Bigtable rebalances the table. This class computes split
+ * points that divide a sample of the expected row keys into ranges of roughly
+ * equal weight, where each key weighs one unit or the expected number of bytes
+ * for that key.
+ *
+ * The sample can come from an application data structure, a file or stream
+ * with one key per line, or the result of `Table::SampleRows()` for an
+ * existing table with a similar key distribution.
+ *
+ * @par Example
+ * @code
+ * bigtable::SplitPlanner planner;
+ * auto status = planner.ReadKeysFromFile("keys.txt");
+ * if (!status.ok()) throw std::runtime_error(status.message());
+ * bigtable::TableConfig config({{"fam", bigtable::GcRule::MaxNumVersions(1)}},
+ *                              planner.Plan(16));
+ * auto table = admin.CreateTable("my-table", std::move(config));
+ * @endcode
+ */
+class SplitPlanner {
+ public:
+  SplitPlanner() : total_weight_(0) {}
+
+  /**
+   * Adds @p row_key to the sample.
+   *
+   * @param row_key the key, adding the same key again adds to its weight.
+   * @param weight the relative size of the data for this key, e.g. the
+   *     expected number of bytes. Negative values are treated as zero.
+   */
+  void AddKey(std::string row_key, std::int64_t weight = 1);
+
+  /**
+   * Adds the keys in @p is, one key per line, each with weight
+   * @p bytes_per_key.
+   *
+   * Empty lines are ignored.
+   */
+  void ReadKeys(std::istream& is, std::int64_t bytes_per_key = 1);
+
+  /**
+   * Adds the keys in the file at @p path, one key per line.
+   *
+   * @return a `kNotFound` error if the file cannot be opened.
+   */
+  Status ReadKeysFromFile(std::string const& path,
+                          std::int64_t bytes_per_key = 1);
+
+  /**
+   * Adds the result of `Table::SampleRows()` to the sample.
+   *
+   * Each sample represents the range of keys since the previous sample, and
+   * its weight is the difference in `offset_bytes`.
+   */
+  void AddSamples(std::vector<RowKeySample> const& samples);
+
+  /// The number of distinct keys in the sample.
+  std::size_t key_count() const { return keys_.size(); }
+
+  /// The total weight of the keys in the sample.
+  std::int64_t total_weight() const { return total_weight_; }
+
+  /**
+   * Computes the split points to divide the sample into @p tablet_count
+   * ranges of roughly equal weight.
+   *
+   * The result is sorted, contains no duplicates, and has at most
+   * `tablet_count - 1` elements. It may have fewer elements if the sample is
+   * too small or some keys are much heavier than others.
+   */
+  std::vector<std::string> Plan(std::size_t tablet_count) const;
+
+  /**
+   * Computes the split points so each range holds about @p bytes_per_tablet.
+   *
+   * Returns an empty vector if @p bytes_per_tablet is not positive.
+   */
+  std::vector<std::string> PlanByTabletSize(
+      std::int64_t bytes_per_tablet) const;
+
+ private:
+  std::map<std::string, std::int64_t> keys_;
+  std::int64_t total_weight_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_SPLIT_PLANNER_H
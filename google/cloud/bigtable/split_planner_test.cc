@@ -0,0 +1,115 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/split_planner.h"
+#include <gmock/gmock.h>
+#include <cstdio>
+#include <sstream>
+
+namespace bigtable = google::cloud::bigtable;
+using bigtable::SplitPlanner;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+namespace {
+std::string MakeKey(int i) {
+  char buf[16];
+  std::snprintf(buf, sizeof(buf), "key-%03d", i);
+  return buf;
+}
+}  // namespace
+
+TEST(SplitPlannerTest, EmptySample) {
+  SplitPlanner planner;
+  EXPECT_EQ(0U, planner.key_count());
+  EXPECT_THAT(planner.Plan(4), IsEmpty());
+}
+
+TEST(SplitPlannerTest, UniformKeys) {
+  SplitPlanner planner;
+  for (int i = 0; i != 100; ++i) planner.AddKey(MakeKey(i));
+  EXPECT_EQ(100U, planner.key_count());
+  EXPECT_EQ(100, planner.total_weight());
+  EXPECT_THAT(planner.Plan(0), IsEmpty());
+  EXPECT_THAT(planner.Plan(1), IsEmpty());
+  EXPECT_THAT(planner.Plan(2), ElementsAre("key-050"));
+  EXPECT_THAT(planner.Plan(4), ElementsAre("key-025", "key-050", "key-075"));
+}
+
+TEST(SplitPlannerTest, MoreTabletsThanKeys) {
+  SplitPlanner planner;
+  planner.AddKey("a");
+  planner.AddKey("b");
+  planner.AddKey("c");
+  EXPECT_THAT(planner.Plan(10), ElementsAre("b", "c"));
+}
+
+TEST(SplitPlannerTest, DuplicateKeysAccumulate) {
+  SplitPlanner planner;
+  planner.AddKey("a");
+  planner.AddKey("a", 3);
+  planner.AddKey("b", -5);
+  EXPECT_EQ(2U, planner.key_count());
+  EXPECT_EQ(4, planner.total_weight());
+}
+
+TEST(SplitPlannerTest, WeightedKeys) {
+  SplitPlanner planner;
+  planner.AddKey("a", 10);
+  planner.AddKey("b", 10);
+  planner.AddKey("c", 10);
+  planner.AddKey("d", 30);
+  planner.AddKey("e", 60);
+  // The targets are 40 and 80, the closest splits are at 30 and 60.
+  EXPECT_THAT(planner.Plan(3), ElementsAre("d", "e"));
+  // A single heavy key covers several targets, but is split only once.
+  EXPECT_THAT(planner.Plan(6), ElementsAre("c", "d", "e"));
+}
+
+TEST(SplitPlannerTest, ReadKeys) {
+  SplitPlanner planner;
+  std::istringstream is("c\n\na\r\nb\n");
+  planner.ReadKeys(is, 100);
+  EXPECT_EQ(3U, planner.key_count());
+  EXPECT_EQ(300, planner.total_weight());
+  EXPECT_THAT(planner.Plan(3), ElementsAre("b", "c"));
+}
+
+TEST(SplitPlannerTest, ReadKeysFromMissingFile) {
+  SplitPlanner planner;
+  auto status = planner.ReadKeysFromFile("/nonexistent/split-planner-keys");
+  EXPECT_EQ(google::cloud::StatusCode::kNotFound, status.code());
+  EXPECT_EQ(0U, planner.key_count());
+}
+
+TEST(SplitPlannerTest, AddSamples) {
+  SplitPlanner planner;
+  // The last sample, with an empty key, represents the end of the table.
+  planner.AddSamples({{"b", 100}, {"c", 200}, {"d", 300}, {"", 400}});
+  EXPECT_EQ(400, planner.total_weight());
+  EXPECT_THAT(planner.Plan(4), ElementsAre("b", "c", "d"));
+  EXPECT_THAT(planner.Plan(2), ElementsAre("c"));
+}
+
+TEST(SplitPlannerTest, PlanByTabletSize) {
+  SplitPlanner planner;
+  for (int i = 0; i != 100; ++i) planner.AddKey(MakeKey(i), 10);
+  EXPECT_THAT(planner.PlanByTabletSize(0), IsEmpty());
+  EXPECT_THAT(planner.PlanByTabletSize(2000), IsEmpty());
+  EXPECT_THAT(planner.PlanByTabletSize(250),
+              ElementsAre("key-025", "key-050", "key-075"));
+  // Round up, the last tablet is smaller than the others.
+  EXPECT_THAT(planner.PlanByTabletSize(300),
+              ElementsAre("key-025", "key-050", "key-075"));
+}
@@ -15,8 +15,11 @@
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/bigtable/internal/async_bulk_apply.h"
 #include "google/cloud/bigtable/internal/bulk_mutator.h"
+#include "google/cloud/bigtable/internal/cell_stream_parser.h"
+#include "google/cloud/bigtable/internal/row_key_regex_planner.h"
 #include "google/cloud/bigtable/internal/unary_client_utils.h"
 #include "google/cloud/grpc_error_delegate.h"
+#include "google/cloud/internal/async_callback_rpc.h"
 #include "google/cloud/internal/async_retry_unary_rpc.h"
 #include <thread>
 #include <type_traits>
@@ -58,6 +61,54 @@ Row TransformReadModifyWriteRowResponse(Response& response) {
   return Row(std::move(*row.mutable_key()), std::move(cells));
 }
 
+/**
+ * Adapt a `DataClient` callback API wrapper to the asynchronous retry loop.
+ *
+ * The retry loop calls this functor for each attempt, the returned future is
+ * satisfied by gRPC directly, without any completion queue operations.
+ */
+template <typename Request, typename Response>
+class CallbackUnaryCall {
+ public:
+  using MemberFunction = void (DataClient::*)(
+      grpc::ClientContext*, Request const*, Response*,
+      std::function<void(grpc::Status)>);
+
+  CallbackUnaryCall(std::shared_ptr<DataClient> client,
+                    MetadataUpdatePolicy metadata_update_policy,
+                    MemberFunction call)
+      : client_(std::move(client)),
+        metadata_update_policy_(std::move(metadata_update_policy)),
+        call_(call) {}
+
+  future<StatusOr<Response>> operator()(
+      std::unique_ptr<grpc::ClientContext> context,
+      Request const& request) const {
+    metadata_update_policy_.Setup(*context);
+    return google::cloud::internal::MakeCallbackUnaryRpc<Response>(
+        [this](grpc::ClientContext* context, Request const* request,
+               Response* response, std::function<void(grpc::Status)> cb) {
+          (client_.get()->*call_)(context, request, response, std::move(cb));
+        },
+        request, std::move(context));
+  }
+
+ private:
+  std::shared_ptr<DataClient> client_;
+  MetadataUpdatePolicy metadata_update_policy_;
+  MemberFunction call_;
+};
+
+template <typename Request, typename Response>
+CallbackUnaryCall<Request, Response> MakeCallbackUnaryCall(
+    std::shared_ptr<DataClient> client,
+    MetadataUpdatePolicy metadata_update_policy,
+    void (DataClient::*call)(grpc::ClientContext*, Request const*, Response*,
+                             std::function<void(grpc::Status)>)) {
+  return CallbackUnaryCall<Request, Response>(
+      std::move(client), std::move(metadata_update_policy), call);
+}
+
 }  // namespace
 
 using ClientUtils = bigtable::internal::UnaryClientUtils<DataClient>;
@@ -126,18 +177,29 @@ future<Status> Table::AsyncApply(SingleRowMutation mut, CompletionQueue& cq) {
 
   auto client = client_;
   auto metadata_update_policy = clone_metadata_update_policy();
-  return google::cloud::internal::StartRetryAsyncUnaryRpc(
-             cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
-             is_idempotent,
-             [client, metadata_update_policy](
-                 grpc::ClientContext* context,
-                 google::bigtable::v2::MutateRowRequest const& request,
-                 grpc::CompletionQueue* cq) {
-               metadata_update_policy.Setup(*context);
-               return client->AsyncMutateRow(context, request, cq);
-             },
-             std::move(request))
-      .then([](future<StatusOr<google::bigtable::v2::MutateRowResponse>> r) {
+  future<StatusOr<google::bigtable::v2::MutateRowResponse>> result;
+  if (client->UseCallbackApi()) {
+    result = google::cloud::internal::StartRetryAsyncUnaryRpc(
+        cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+        is_idempotent,
+        MakeCallbackUnaryCall(client, std::move(metadata_update_policy),
+                              &DataClient::CallbackMutateRow),
+        std::move(request));
+  } else {
+    result = google::cloud::internal::StartRetryAsyncUnaryRpc(
+        cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+        is_idempotent,
+        [client, metadata_update_policy](
+            grpc::ClientContext* context,
+            google::bigtable::v2::MutateRowRequest const& request,
+            grpc::CompletionQueue* cq) {
+          metadata_update_policy.Setup(*context);
+          return client->AsyncMutateRow(context, request, cq);
+        },
+        std::move(request));
+  }
+  return result.then(
+      [](future<StatusOr<google::bigtable::v2::MutateRowResponse>> r) {
         return r.get().status();
       });
 }
@@ -178,7 +240,19 @@ future<std::vector<FailedMutation>> Table::AsyncBulkApply(BulkMutation mut,
       app_profile_id_, table_name(), std::move(mut));
 }
 
+future<std::vector<FailedMutation>> Table::AsyncBulkApply(
+    BulkMutation mut, CompletionQueue& cq,
+    std::function<void(int, google::cloud::Status const&)> on_mutation_done) {
+  auto mutation_policy = clone_idempotent_mutation_policy();
+  return internal::AsyncRetryBulkApply::Create(
+      cq, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+      *mutation_policy, clone_metadata_update_policy(), client_,
+      app_profile_id_, table_name(), std::move(mut),
+      std::move(on_mutation_done));
+}
+
 RowReader Table::ReadRows(RowSet row_set, Filter filter) {
+  row_set = PlanRowSet(std::move(row_set), filter);
   return RowReader(client_, app_profile_id_, table_name_, std::move(row_set),
                    RowReader::NO_ROWS_LIMIT, std::move(filter),
                    clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
@@ -189,6 +263,7 @@ RowReader Table::ReadRows(RowSet row_set, Filter filter) {
 
 RowReader Table::ReadRows(RowSet row_set, std::int64_t rows_limit,
                           Filter filter) {
+  row_set = PlanRowSet(std::move(row_set), filter);
   return RowReader(client_, app_profile_id_, table_name_, std::move(row_set),
                    rows_limit, std::move(filter), clone_rpc_retry_policy(),
                    clone_rpc_backoff_policy(), metadata_update_policy_,
@@ -196,6 +271,11 @@ RowReader Table::ReadRows(RowSet row_set, std::int64_t rows_limit,
                        bigtable::internal::ReadRowsParserFactory>());
 }
 
+RowSet Table::PlanRowSet(RowSet row_set, Filter const& filter) const {
+  if (!row_key_regex_planning_) return row_set;
+  return internal::NarrowRowSetByRowKeyRegex(row_set, filter);
+}
+
 StatusOr<std::pair<bool, Row>> Table::ReadRow(std::string row_key,
                                               Filter filter) {
   RowSet row_set(std::move(row_key));
@@ -218,6 +298,86 @@ StatusOr<std::pair<bool, Row>> Table::ReadRow(std::string row_key,
   return result;
 }
 
+Status Table::StreamRows(RowSet row_set, Filter filter,
+                         CellStreamHandler& handler) {
+  return StreamRows(std::move(row_set), RowReader::NO_ROWS_LIMIT,
+                    std::move(filter), handler);
+}
+
+Status Table::StreamRows(RowSet row_set, std::int64_t rows_limit,
+                         Filter filter, CellStreamHandler& handler) {
+  if (rows_limit < 0) {
+    return Status(StatusCode::kInvalidArgument,
+                  "StreamRows() rows_limit cannot be negative");
+  }
+  row_set = PlanRowSet(std::move(row_set), filter);
+  auto rpc_policy = clone_rpc_retry_policy();
+  auto backoff_policy = clone_rpc_backoff_policy();
+
+  btproto::ReadRowsRequest request;
+  SetCommonTableOperationRequest<btproto::ReadRowsRequest>(
+      request, app_profile_id_, table_name_);
+  *request.mutable_filter() = std::move(filter).as_proto();
+
+  std::int64_t rows_count = 0;
+  while (true) {
+    auto row_set_proto = row_set.as_proto();
+    request.mutable_rows()->Swap(&row_set_proto);
+    if (rows_limit != RowReader::NO_ROWS_LIMIT) {
+      request.set_rows_limit(rows_limit - rows_count);
+    }
+
+    grpc::ClientContext client_context;
+    rpc_policy->Setup(client_context);
+    backoff_policy->Setup(client_context);
+    metadata_update_policy_.Setup(client_context);
+    auto stream = client_->ReadRows(&client_context, request);
+
+    internal::CellStreamParser parser(handler);
+    grpc::Status status;
+    btproto::ReadRowsResponse response;
+    while (status.ok() && !parser.stopped() && stream->Read(&response)) {
+      for (auto& chunk : *response.mutable_chunks()) {
+        parser.HandleChunk(std::move(chunk), status);
+        if (!status.ok() || parser.stopped()) break;
+      }
+    }
+    if (!status.ok() || parser.stopped()) {
+      // Cancel the request and drain any data left unread.
+      client_context.TryCancel();
+      while (stream->Read(&response)) {
+      }
+      (void)stream->Finish();  // ignore errors
+    } else {
+      status = stream->Finish();
+      if (status.ok()) parser.HandleEndOfStream(status);
+    }
+    rows_count += parser.committed_rows();
+    if (status.ok() || parser.stopped()) return Status{};
+
+    // The cells of the row in progress will be delivered again, tell the
+    // handler to discard them.
+    parser.AbandonRow();
+
+    // As in `RowReader`, there is no need to retry if we already have all the
+    // rows requested.
+    if (rows_limit != RowReader::NO_ROWS_LIMIT && rows_limit <= rows_count) {
+      return Status{};
+    }
+    if (!parser.last_committed_row_key().empty()) {
+      row_set = row_set.Intersect(
+          RowRange::Open(parser.last_committed_row_key(), ""));
+    }
+    if (row_set.IsEmpty()) return Status{};
+
+    if (!rpc_policy->OnFailure(status)) {
+      return MakeStatusFromRpcError(status);
+    }
+    auto delay = backoff_policy->OnCompletion(status);
+    std::this_thread::sleep_for(delay);
+  }
+}
+
 StatusOr<MutationBranch> Table::CheckAndMutateRow(
     std::string row_key, Filter filter, std::vector<Mutation> true_mutations,
     std::vector<Mutation> false_mutations) {
@@ -266,19 +426,30 @@ future<StatusOr<MutationBranch>> Table::AsyncCheckAndMutateRow(
 
   auto client = client_;
   auto metadata_update_policy = clone_metadata_update_policy();
-  return google::cloud::internal::StartRetryAsyncUnaryRpc(
-             cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
-             is_idempotent,
-             [client, metadata_update_policy](
-                 grpc::ClientContext* context,
-                 btproto::CheckAndMutateRowRequest const& request,
-                 grpc::CompletionQueue* cq) {
-               metadata_update_policy.Setup(*context);
-               return client->AsyncCheckAndMutateRow(context, request, cq);
-             },
-             std::move(request))
-      .then([](future<StatusOr<btproto::CheckAndMutateRowResponse>> f)
-                -> StatusOr<MutationBranch> {
+  future<StatusOr<btproto::CheckAndMutateRowResponse>> result;
+  if (client->UseCallbackApi()) {
+    result = google::cloud::internal::StartRetryAsyncUnaryRpc(
+        cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+        is_idempotent,
+        MakeCallbackUnaryCall(client, std::move(metadata_update_policy),
+                              &DataClient::CallbackCheckAndMutateRow),
+        std::move(request));
+  } else {
+    result = google::cloud::internal::StartRetryAsyncUnaryRpc(
+        cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+        is_idempotent,
+        [client, metadata_update_policy](
+            grpc::ClientContext* context,
+            btproto::CheckAndMutateRowRequest const& request,
+            grpc::CompletionQueue* cq) {
+          metadata_update_policy.Setup(*context);
+          return client->AsyncCheckAndMutateRow(context, request, cq);
+        },
+        std::move(request));
+  }
+  return result.then(
+      [](future<StatusOr<btproto::CheckAndMutateRowResponse>> f)
+          -> StatusOr<MutationBranch> {
         auto response = f.get();
         if (!response) {
           return response.status();
@@ -362,25 +533,36 @@ future<StatusOr<Row>> Table::AsyncReadModifyWriteRowImpl(
 
   auto client = client_;
   auto metadata_update_policy = clone_metadata_update_policy();
-  return google::cloud::internal::StartRetryAsyncUnaryRpc(
-             cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
-             /*is_idempotent=*/false,
-             [client, metadata_update_policy](
-                 grpc::ClientContext* context,
-                 btproto::ReadModifyWriteRowRequest const& request,
-                 grpc::CompletionQueue* cq) {
-               metadata_update_policy.Setup(*context);
-               return client->AsyncReadModifyWriteRow(context, request, cq);
-             },
-             std::move(request))
-      .then([](future<StatusOr<btproto::ReadModifyWriteRowResponse>> fut)
-                -> StatusOr<Row> {
-        auto result = fut.get();
-        if (!result) {
-          return result.status();
+  future<StatusOr<btproto::ReadModifyWriteRowResponse>> result;
+  if (client->UseCallbackApi()) {
+    result = google::cloud::internal::StartRetryAsyncUnaryRpc(
+        cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+        /*is_idempotent=*/false,
+        MakeCallbackUnaryCall(client, std::move(metadata_update_policy),
+                              &DataClient::CallbackReadModifyWriteRow),
+        std::move(request));
+  } else {
+    result = google::cloud::internal::StartRetryAsyncUnaryRpc(
+        cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+        /*is_idempotent=*/false,
+        [client, metadata_update_policy](
+            grpc::ClientContext* context,
+            btproto::ReadModifyWriteRowRequest const& request,
+            grpc::CompletionQueue* cq) {
+          metadata_update_policy.Setup(*context);
+          return client->AsyncReadModifyWriteRow(context, request, cq);
+        },
+        std::move(request));
+  }
+  return result.then(
+      [](future<StatusOr<btproto::ReadModifyWriteRowResponse>> fut)
+          -> StatusOr<Row> {
+        auto response = fut.get();
+        if (!response) {
+          return response.status();
         }
         return TransformReadModifyWriteRowResponse<
-            btproto::ReadModifyWriteRowResponse>(*result);
+            btproto::ReadModifyWriteRowResponse>(*response);
       });
 }
 
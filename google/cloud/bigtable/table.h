@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_TABLE_H
 
 #include "google/cloud/bigtable/async_row_reader.h"
+#include "google/cloud/bigtable/cell_stream_handler.h"
 #include "google/cloud/bigtable/completion_queue.h"
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/filters.h"
@@ -352,6 +353,25 @@ class Table {
   std::string const& instance_id() const { return client_->instance_id(); }
   std::string const& table_id() const { return table_id_; }
 
+  /**
+   * Use the row key regular expressions in filters to narrow row scans.
+   *
+   * When enabled, `ReadRows()` and `AsyncReadRows()` extract the literal
+   * prefixes from any `Filter::RowKeysRegex()` that all the returned rows must
+   * satisfy (the filter itself, or an element of a `Filter::Chain()`), and
+   * only scan the ranges in the `RowSet` matching those prefixes. For example,
+   * a `Filter::RowKeysRegex("user#123#.*")` filter only scans the rows
+   * starting with `user#123#`. The filter is still sent to the server, so the
+   * results are the same, but the server reads fewer rows.
+   *
+   * This is disabled by default.
+   */
+  bool row_key_regex_planning() const { return row_key_regex_planning_; }
+  Table& set_row_key_regex_planning(bool enabled) {
+    row_key_regex_planning_ = enabled;
+    return *this;
+  }
+
   /**
    * Attempts to apply the mutation to a row.
    *
@@ -444,6 +464,44 @@ class Table {
   future<std::vector<FailedMutation>> AsyncBulkApply(BulkMutation mut,
                                                      CompletionQueue& cq);
 
+  /**
+   * Makes asynchronous attempts to apply mutations to multiple rows, reporting
+   * the result of each mutation as soon as it is known.
+   *
+   * The returned future is only satisfied once all the mutations succeed or
+   * fail permanently, a few slow retries can delay it. Applications that want
+   * to acknowledge each mutation as soon as it is committed can use this
+   * overload: @p on_mutation_done is called with the index of each mutation in
+   * @p mut and its final status (an OK status on success) as soon as it is
+   * known. The calls are made serially, and all of them happen before the
+   * returned future is satisfied. By default they are made from a thread
+   * blocked in `cq.Run()`. If the client was created with
+   * `ClientOptions::set_use_callback_api(true)`, they are made from the gRPC
+   * callback threads instead, so @p on_mutation_done should not block. The
+   * future is satisfied with all the permanent failures, as in the other
+   * overload.
+   *
+   * @warning This is an early version of the asynchronous APIs for Cloud
+   *     Bigtable. These APIs might be changed in backward-incompatible ways. It
+   *     is not subject to any SLA or deprecation policy.
+   *
+   * @param mut the mutations, note that this function takes
+   *     ownership (and then discards) the data in the mutation.
+   * @param cq the completion queue that will execute the asynchronous calls,
+   *     the application must ensure that one or more threads are blocked on
+   *     `cq.Run()`.
+   * @param on_mutation_done called once for each mutation in @p mut, with its
+   *     original index and final status.
+   *
+   * @par Idempotency
+   * This operation is idempotent if the provided mutations are idempotent. Note
+   * that `google::cloud::bigtable::SetCell()` without an explicit timestamp is
+   * **not** an idempotent operation.
+   */
+  future<std::vector<FailedMutation>> AsyncBulkApply(
+      BulkMutation mut, CompletionQueue& cq,
+      std::function<void(int, google::cloud::Status const&)> on_mutation_done);
+
   /**
    * Reads a set of rows from the table.
    *
@@ -494,6 +552,46 @@ class Table {
    */
   StatusOr<std::pair<bool, Row>> ReadRow(std::string row_key, Filter filter);
 
+  /**
+   * Reads a set of rows, delivering each cell to @p handler as it arrives.
+   *
+   * Unlike `ReadRows()`, this function does not accumulate the cells of a row
+   * before handing them to the application. Use it to read rows that are too
+   * large to fit in memory, e.g., rows with millions of cells or with very
+   * large values. The function blocks until all the rows are delivered, the
+   * handler stops the scan, or the retry policy is exhausted.
+   *
+   * If the stream is interrupted, the row in progress is reset via
+   * `CellStreamHandler::OnRowReset()` and the scan resumes after the last
+   * committed row.
+   *
+   * @param row_set the rows to read from.
+   * @param filter is applied on the server-side to data in the rows.
+   * @param handler receives the cells and the row boundaries.
+   *
+   * @par Idempotency
+   * This is a read-only operation and therefore it is always idempotent.
+   */
+  Status StreamRows(RowSet row_set, Filter filter, CellStreamHandler& handler);
+
+  /**
+   * Reads a limited set of rows, delivering each cell to @p handler.
+   *
+   * @param row_set the rows to read from.
+   * @param rows_limit the maximum number of rows to read. Cannot be a negative
+   *     number or zero. Use `StreamRows(RowSet, Filter, CellStreamHandler&)`
+   *     to read all matching rows.
+   * @param filter is applied on the server-side to data in the rows.
+   * @param handler receives the cells and the row boundaries.
+   * @return `kInvalidArgument` if @p rows_limit is negative, without contacting
+   *     the service.
+   *
+   * @par Idempotency
+   * This is a read-only operation and therefore it is always idempotent.
+   */
+  Status StreamRows(RowSet row_set, std::int64_t rows_limit, Filter filter,
+                    CellStreamHandler& handler);
+
   /**
    * Atomic test-and-set for a row using filter expressions.
    *
@@ -680,6 +778,7 @@ class Table {
   template <typename RowFunctor, typename FinishFunctor>
   void AsyncReadRows(CompletionQueue& cq, RowFunctor on_row,
                      FinishFunctor on_finish, RowSet row_set, Filter filter) {
+    row_set = PlanRowSet(std::move(row_set), filter);
     AsyncRowReader<RowFunctor, FinishFunctor>::Create(
         cq, client_, app_profile_id_, table_name_, std::move(on_row),
         std::move(on_finish), std::move(row_set),
@@ -725,6 +824,7 @@ class Table {
   void AsyncReadRows(CompletionQueue& cq, RowFunctor on_row,
                      FinishFunctor on_finish, RowSet row_set,
                      std::int64_t rows_limit, Filter filter) {
+    row_set = PlanRowSet(std::move(row_set), filter);
     AsyncRowReader<RowFunctor, FinishFunctor>::Create(
         cq, client_, app_profile_id_, table_name_, std::move(on_row),
         std::move(on_finish), std::move(row_set), rows_limit, std::move(filter),
@@ -803,6 +903,9 @@ class Table {
     return idempotent_mutation_policy_->clone();
   }
 
+  /// Narrow @p row_set using @p filter, if enabled.
+  RowSet PlanRowSet(RowSet row_set, Filter const& filter) const;
+
   //@{
   /// @name Helper functions to implement constructors with changed policies.
   void ChangePolicy(RPCRetryPolicy const& policy) {
@@ -834,6 +937,7 @@ class Table {
   std::shared_ptr<RPCBackoffPolicy const> rpc_backoff_policy_prototype_;
   MetadataUpdatePolicy metadata_update_policy_;
   std::shared_ptr<IdempotentMutationPolicy> idempotent_mutation_policy_;
+  bool row_key_regex_planning_ = false;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
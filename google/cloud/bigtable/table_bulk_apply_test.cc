@@ -18,6 +18,7 @@
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include "google/cloud/testing_util/chrono_literals.h"
+#include "google/cloud/testing_util/mock_completion_queue.h"
 
 namespace btproto = google::bigtable::v2;
 namespace bigtable = google::cloud::bigtable;
@@ -28,7 +29,33 @@ namespace bt = google::cloud::bigtable;
 /// Define types and functions used in the tests.
 namespace {
 class TableBulkApplyTest : public bigtable::testing::TableTestFixture {};
+using bigtable::testing::MockClientAsyncReaderInterface;
 using bigtable::testing::MockMutateRowsReader;
+using google::cloud::testing_util::MockCompletionQueue;
+
+/// Create a mock async reader returning @p response and then finishing.
+std::unique_ptr<MockClientAsyncReaderInterface<btproto::MutateRowsResponse>>
+MakeAsyncReader(btproto::MutateRowsResponse const& response) {
+  auto reader = google::cloud::internal::make_unique<
+      MockClientAsyncReaderInterface<btproto::MutateRowsResponse>>();
+  EXPECT_CALL(*reader, StartCall(_)).Times(1);
+  EXPECT_CALL(*reader, Read(_, _))
+      .WillOnce(Invoke([response](btproto::MutateRowsResponse* r, void*) {
+        *r = response;
+      }))
+      .WillOnce(Invoke([](btproto::MutateRowsResponse*, void*) {}));
+  EXPECT_CALL(*reader, Finish(_, _))
+      .WillOnce(Invoke(
+          [](grpc::Status* status, void*) { *status = grpc::Status::OK; }));
+  return reader;
+}
+
+void AddEntry(btproto::MutateRowsResponse& response, int index,
+              grpc::StatusCode code) {
+  auto& e = *response.add_entries();
+  e.set_index(index);
+  e.mutable_status()->set_code(code);
+}
 }  // anonymous namespace
 
 /// @test Verify that Table::BulkApply() works in the easy case.
@@ -295,3 +322,72 @@ TEST_F(TableBulkApplyTest, FailedRPC) {
   EXPECT_EQ(google::cloud::StatusCode::kFailedPrecondition,
             failures.front().status().code());
 }
+
+/// @test Verify that Table::AsyncBulkApply() reports each mutation as soon as
+/// its final status is known.
+TEST_F(TableBulkApplyTest, AsyncReportsEachMutation) {
+  using google::cloud::StatusCode;
+  auto cq_impl = std::make_shared<MockCompletionQueue>();
+  bt::CompletionQueue cq(cq_impl);
+
+  btproto::MutateRowsResponse r1;
+  AddEntry(r1, 0, grpc::StatusCode::OK);
+  AddEntry(r1, 1, grpc::StatusCode::UNAVAILABLE);
+  AddEntry(r1, 2, grpc::StatusCode::PERMISSION_DENIED);
+  btproto::MutateRowsResponse r2;
+  AddEntry(r2, 0, grpc::StatusCode::OK);
+
+  EXPECT_CALL(*client_, UseCallbackApi()).WillRepeatedly(Return(false));
+  EXPECT_CALL(*client_, PrepareAsyncMutateRows(_, _, _))
+      .WillOnce(Invoke([&r1](grpc::ClientContext*,
+                             btproto::MutateRowsRequest const& request,
+                             grpc::CompletionQueue*) {
+        EXPECT_EQ(3, request.entries_size());
+        return MakeAsyncReader(r1);
+      }))
+      .WillOnce(Invoke([&r2](grpc::ClientContext*,
+                             btproto::MutateRowsRequest const& request,
+                             grpc::CompletionQueue*) {
+        EXPECT_EQ(1, request.entries_size());
+        EXPECT_EQ("bar", request.entries(0).row_key());
+        return MakeAsyncReader(r2);
+      }));
+
+  std::vector<std::pair<int, StatusCode>> done;
+  auto future = table_.AsyncBulkApply(
+      bt::BulkMutation(
+          bt::SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "a")}),
+          bt::SingleRowMutation("bar", {bt::SetCell("fam", "col", 0_ms, "b")}),
+          bt::SingleRowMutation("baz",
+                                {bt::SetCell("fam", "col", 0_ms, "c")})),
+      cq, [&done](int index, google::cloud::Status const& status) {
+        done.emplace_back(index, status.code());
+      });
+
+  // Start the first stream and read its only response.
+  cq_impl->SimulateCompletion(true);
+  cq_impl->SimulateCompletion(true);
+  // The mutations with a final status are reported before the stream closes.
+  EXPECT_THAT(done,
+              ElementsAre(Pair(0, StatusCode::kOk),
+                          Pair(2, StatusCode::kPermissionDenied)));
+  EXPECT_EQ(std::future_status::timeout, future.wait_for(0_ms));
+
+  // Finish the first stream, that starts the second one, then run it.
+  cq_impl->SimulateCompletion(false);
+  cq_impl->SimulateCompletion(true);
+  cq_impl->SimulateCompletion(true);
+  cq_impl->SimulateCompletion(true);
+  cq_impl->SimulateCompletion(false);
+  cq_impl->SimulateCompletion(true);
+
+  EXPECT_THAT(done,
+              ElementsAre(Pair(0, StatusCode::kOk),
+                          Pair(2, StatusCode::kPermissionDenied),
+                          Pair(1, StatusCode::kOk)));
+  auto failures = future.get();
+  ASSERT_EQ(1UL, failures.size());
+  EXPECT_EQ(2, failures.front().original_index());
+  EXPECT_EQ(StatusCode::kPermissionDenied,
+            failures.front().status().code());
+}
@@ -18,6 +18,7 @@
 #include "google/cloud/testing_util/assert_ok.h"
 
 namespace bigtable = google::cloud::bigtable;
+namespace btproto = google::bigtable::v2;
 using testing::_;
 using testing::DoAll;
 using testing::Invoke;
@@ -147,3 +148,29 @@ TEST_F(TableReadRowsTest, ReadRowsThrowsWhenTooManyErrors) {
   ++it;
   ASSERT_EQ(reader.end(), it);
 }
+
+TEST_F(TableReadRowsTest, ReadRowsWithRowKeyRegexPlanning) {
+  auto stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke([stream](grpc::ClientContext* context,
+                                btproto::ReadRowsRequest const& r) {
+        EXPECT_EQ(0, r.rows().row_keys_size());
+        EXPECT_EQ(1, r.rows().row_ranges_size());
+        for (auto const& range : r.rows().row_ranges()) {
+          EXPECT_EQ("user#123#", range.start_key_closed());
+          EXPECT_EQ("user#123$", range.end_key_open());
+        }
+        // The filter is sent unchanged.
+        EXPECT_EQ("user#123#.*", r.filter().row_key_regex_filter());
+        return stream->MakeMockReturner()(context, r);
+      }));
+
+  EXPECT_FALSE(table_.row_key_regex_planning());
+  table_.set_row_key_regex_planning(true);
+  EXPECT_TRUE(table_.row_key_regex_planning());
+  auto reader = table_.ReadRows(bigtable::RowSet(),
+                                bigtable::Filter::RowKeysRegex("user#123#.*"));
+  EXPECT_EQ(reader.begin(), reader.end());
+}
@@ -0,0 +1,225 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/testing/mock_read_rows_reader.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/assert_ok.h"
+
+namespace bigtable = google::cloud::bigtable;
+namespace btproto = google::bigtable::v2;
+using testing::_;
+using testing::DoAll;
+using testing::Invoke;
+using testing::Return;
+using testing::SetArgPointee;
+
+/// Define helper types and functions for this test.
+namespace {
+class TableStreamRowsTest : public bigtable::testing::TableTestFixture {};
+using bigtable::testing::MockReadRowsReader;
+
+/// Record the handler callbacks as strings, to simplify the assertions.
+class RecordingHandler : public bigtable::CellStreamHandler {
+ public:
+  void OnCellStart(bigtable::CellHeader header) override {
+    events.push_back("start " + header.row_key + " " + header.family_name +
+                     ":" + header.column_qualifier);
+  }
+  void OnCellValue(bigtable::CellValueType value) override {
+    events.push_back("value " + value);
+  }
+  void OnCellEnd() override { events.emplace_back("end"); }
+  bool OnRowCommit(bigtable::RowKeyType const& row_key) override {
+    events.push_back("commit " + row_key);
+    return !stop_after_commit;
+  }
+  void OnRowReset(bigtable::RowKeyType const& row_key) override {
+    events.push_back("reset " + row_key);
+  }
+
+  std::vector<std::string> events;
+  bool stop_after_commit = false;
+};
+}  // anonymous namespace
+
+TEST_F(TableStreamRowsTest, DeliversSplitCells) {
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "val"
+        value_size: 6
+      }
+      chunks {
+        value: "ue1"
+        commit_row: true
+      }
+      )");
+
+  auto stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*stream, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(response), Return(true)))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(stream->MakeMockReturner()));
+
+  RecordingHandler handler;
+  ASSERT_STATUS_OK(table_.StreamRows(
+      bigtable::RowSet(), bigtable::Filter::PassAllFilter(), handler));
+  EXPECT_EQ(std::vector<std::string>({"start r1 fam:qual", "value val",
+                                      "value ue1", "end", "commit r1"}),
+            handler.events);
+}
+
+TEST_F(TableStreamRowsTest, ResetsPartialRowOnRetry) {
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+      chunks {
+        row_key: "r2"
+        family_name { value: "fam" }
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: false
+      }
+      )");
+  auto response_retry = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r2"
+        family_name { value: "fam" }
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+      )");
+
+  auto stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto stream_retry =
+      new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(stream->MakeMockReturner()))
+      .WillOnce(Invoke([stream_retry](grpc::ClientContext* context,
+                                      btproto::ReadRowsRequest const& r) {
+        // The retry must start after the last committed row.
+        EXPECT_EQ(1, r.rows().row_ranges_size());
+        for (auto const& range : r.rows().row_ranges()) {
+          EXPECT_EQ("r1", range.start_key_open());
+        }
+        return stream_retry->MakeMockReturner()(context, r);
+      }));
+
+  EXPECT_CALL(*stream, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(response), Return(true)))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish())
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again")));
+  EXPECT_CALL(*stream_retry, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(response_retry), Return(true)))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*stream_retry, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  RecordingHandler handler;
+  ASSERT_STATUS_OK(table_.StreamRows(
+      bigtable::RowSet(), bigtable::Filter::PassAllFilter(), handler));
+  EXPECT_EQ(std::vector<std::string>(
+                {"start r1 fam:qual", "value value", "end", "commit r1",
+                 "start r2 fam:qual", "value value", "end", "reset r2",
+                 "start r2 fam:qual", "value value", "end", "commit r2"}),
+            handler.events);
+}
+
+TEST_F(TableStreamRowsTest, HandlerCanStopTheScan) {
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+      chunks {
+        row_key: "r2"
+        family_name { value: "fam" }
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+      )");
+
+  auto stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*stream, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(response), Return(true)))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish())
+      .WillOnce(Return(grpc::Status(grpc::StatusCode::CANCELLED, "")));
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(stream->MakeMockReturner()));
+
+  RecordingHandler handler;
+  handler.stop_after_commit = true;
+  ASSERT_STATUS_OK(table_.StreamRows(
+      bigtable::RowSet(), bigtable::Filter::PassAllFilter(), handler));
+  EXPECT_EQ(std::vector<std::string>(
+                {"start r1 fam:qual", "value value", "end", "commit r1"}),
+            handler.events);
+}
+
+TEST_F(TableStreamRowsTest, TooManyErrors) {
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillRepeatedly(testing::WithoutArgs(testing::Invoke([] {
+        auto stream =
+            new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+        EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+        EXPECT_CALL(*stream, Finish())
+            .WillOnce(
+                Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "broken")));
+        return stream->AsUniqueMocked();
+      })));
+
+  auto table = bigtable::Table(
+      client_, "table_id", bigtable::LimitedErrorCountRetryPolicy(3),
+      bigtable::ExponentialBackoffPolicy(std::chrono::seconds(0),
+                                         std::chrono::seconds(0)),
+      bigtable::SafeIdempotentMutationPolicy());
+  RecordingHandler handler;
+  auto status = table.StreamRows(bigtable::RowSet(),
+                                 bigtable::Filter::PassAllFilter(), handler);
+  EXPECT_EQ(google::cloud::StatusCode::kUnavailable, status.code());
+  EXPECT_TRUE(handler.events.empty());
+}
+
+TEST_F(TableStreamRowsTest, NegativeRowsLimit) {
+  EXPECT_CALL(*client_, ReadRows(_, _)).Times(0);
+
+  RecordingHandler handler;
+  auto status = table_.StreamRows(bigtable::RowSet(), -1,
+                                  bigtable::Filter::PassAllFilter(), handler);
+  EXPECT_EQ(google::cloud::StatusCode::kInvalidArgument, status.code());
+  EXPECT_TRUE(handler.events.empty());
+}
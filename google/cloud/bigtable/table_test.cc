@@ -217,3 +217,25 @@ TEST_F(ValidContextMdAsyncTest, AsyncReadModifyWriteRow) {
       bigtable::ReadModifyWriteRule::IncrementAmount("fam", "counter", 1),
       bigtable::ReadModifyWriteRule::AppendValue("fam", "list", ";element")));
 }
+
+TEST_F(ValidContextMdAsyncTest, AsyncApplyCallbackApi) {
+  using ::testing::_;
+  EXPECT_CALL(*client_, UseCallbackApi())
+      .WillRepeatedly(::testing::Return(true));
+  EXPECT_CALL(*client_, CallbackMutateRow(_, _, _, _))
+      .WillOnce(::testing::Invoke(
+          [](grpc::ClientContext* context, bt::MutateRowRequest const* r,
+             bt::MutateRowResponse*,
+             std::function<void(grpc::Status)> const& on_done) {
+            EXPECT_NE(nullptr, context);
+            EXPECT_EQ(
+                "projects/the-project/instances/the-instance/tables/the-table",
+                r->table_name());
+            on_done(grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh-oh"));
+          }));
+  auto res = table_->AsyncApply(
+      bigtable::SingleRowMutation("row_key", bigtable::DeleteFromRow()), cq_);
+  // The callback API does not use the completion queue.
+  EXPECT_TRUE(cq_impl_->empty());
+  EXPECT_EQ(google::cloud::StatusCode::kPermissionDenied, res.get().code());
+}
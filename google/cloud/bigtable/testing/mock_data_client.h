@@ -112,6 +112,33 @@ class MockDataClient : public bigtable::DataClient {
                    grpc::ClientContext*,
                    const google::bigtable::v2::MutateRowsRequest&,
                    grpc::CompletionQueue*));
+
+  MOCK_CONST_METHOD0(UseCallbackApi, bool());
+  MOCK_METHOD4(CallbackMutateRow,
+               void(grpc::ClientContext*,
+                    google::bigtable::v2::MutateRowRequest const*,
+                    google::bigtable::v2::MutateRowResponse*,
+                    std::function<void(grpc::Status)>));
+  MOCK_METHOD4(CallbackCheckAndMutateRow,
+               void(grpc::ClientContext*,
+                    google::bigtable::v2::CheckAndMutateRowRequest const*,
+                    google::bigtable::v2::CheckAndMutateRowResponse*,
+                    std::function<void(grpc::Status)>));
+  MOCK_METHOD4(CallbackReadModifyWriteRow,
+               void(grpc::ClientContext*,
+                    google::bigtable::v2::ReadModifyWriteRowRequest const*,
+                    google::bigtable::v2::ReadModifyWriteRowResponse*,
+                    std::function<void(grpc::Status)>));
+  MOCK_METHOD3(CallbackReadRows,
+               void(grpc::ClientContext*,
+                    google::bigtable::v2::ReadRowsRequest const*,
+                    google::cloud::internal::ClientReadReactor<
+                        google::bigtable::v2::ReadRowsResponse>*));
+  MOCK_METHOD3(CallbackMutateRows,
+               void(grpc::ClientContext*,
+                    google::bigtable::v2::MutateRowsRequest const*,
+                    google::cloud::internal::ClientReadReactor<
+                        google::bigtable::v2::MutateRowsResponse>*));
 };
 
 }  // namespace testing
@@ -20,45 +20,35 @@ namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace {
 /**
- * Wrap a gRPC timer into an `AsyncOperation`.
+ * Wrap a timer into an `AsyncOperation`.
  *
  * Applications (or more likely, other components in the client library) will
- * associate timers with a completion queue. gRPC timers require applications to
- * create a unique `grpc::Alarm` object for each timer, and then to associate
- * them with the completion queue using a `void*` tag.
+ * associate timers with a completion queue. Creating a `grpc::Alarm` for each
+ * timer is expensive when there are many timers, so the timers are kept in a
+ * timing wheel, owned by the completion queue, that shares a single alarm.
  *
  * This class collaborates with our wrapper for `CompletionQueue` to associate
- * a `future<AsyncTimerResult>` for each timer. This class takes care of
- * allocating the `grpc::Alarm`, creating a unique `void*` associated with the
- * timer, and satisfying the future when the timer expires.
+ * a `future<AsyncTimerResult>` for each timer. This class holds the timing
+ * wheel entry, and satisfies the future when the timer expires.
  *
  * Note that this class is an implementation detail, hidden from the application
  * developers.
  */
 class AsyncTimerFuture : public internal::AsyncGrpcOperation {
  public:
-  explicit AsyncTimerFuture(std::unique_ptr<grpc::Alarm> alarm)
+  AsyncTimerFuture(internal::CompletionQueueImpl* cq,
+                   std::chrono::system_clock::time_point deadline)
       : promise_(/*cancellation_callback=*/[this] { Cancel(); }),
-        alarm_(std::move(alarm)) {}
+        cq_(cq),
+        deadline_(deadline) {}
 
   future<StatusOr<std::chrono::system_clock::time_point>> GetFuture() {
     return promise_.get_future();
   }
 
-  void Set(grpc::CompletionQueue& cq,
-           std::chrono::system_clock::time_point deadline, void* tag) {
-    deadline_ = deadline;
+  internal::TimingWheel::Timer& timer() { return timer_; }
 
-    if (alarm_) {
-      alarm_->Set(&cq, deadline, tag);
-    }
-  }
-
-  void Cancel() override {
-    if (alarm_) {
-      alarm_->Cancel();
-    }
-  }
+  void Cancel() override { cq_->CancelTimer(timer_); }
 
  private:
   bool Notify(bool ok) override {
@@ -71,9 +61,9 @@ class AsyncTimerFuture : public internal::AsyncGrpcOperation {
   }
 
   promise<StatusOr<std::chrono::system_clock::time_point>> promise_;
+  internal::CompletionQueueImpl* cq_;
   std::chrono::system_clock::time_point deadline_;
-  /// Holds the underlying handle. It might be a nullptr in tests.
-  std::unique_ptr<grpc::Alarm> alarm_;
+  internal::TimingWheel::Timer timer_;
 };
 
 }  // namespace
@@ -89,10 +79,11 @@ void CompletionQueue::CancelAll() { impl_->CancelAll(); }
 google::cloud::future<StatusOr<std::chrono::system_clock::time_point>>
 CompletionQueue::MakeDeadlineTimer(
     std::chrono::system_clock::time_point deadline) {
-  auto op = std::make_shared<AsyncTimerFuture>(impl_->CreateAlarm());
-  impl_->StartOperation(
-      op, [&](void* tag) { op->Set(impl_->cq(), deadline, tag); });
-  return op->GetFuture();
+  auto op = std::make_shared<AsyncTimerFuture>(impl_.get(), deadline);
+  auto f = op->GetFuture();
+  auto& timer = op->timer();
+  impl_->StartTimer(std::move(op), timer, deadline);
+  return f;
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_NS
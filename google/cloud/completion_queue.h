@@ -81,7 +81,7 @@ class CompletionQueue {
   template <typename Rep, typename Period>
   future<StatusOr<std::chrono::system_clock::time_point>> MakeRelativeTimer(
       std::chrono::duration<Rep, Period> duration) {
-    return MakeDeadlineTimer(std::chrono::system_clock::now() + duration);
+    return MakeDeadlineTimer(impl_->Now() + duration);
   }
 
   /**
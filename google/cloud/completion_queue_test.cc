@@ -21,6 +21,8 @@
 #include <chrono>
 #include <memory>
 #include <thread>
+#include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -268,6 +270,70 @@ TEST(CompletionQueueTest, MakeStreamingReadRpc) {
   runner.join();
 }
 
+TEST(CompletionQueueTest, MakeStreamingReadRpcReusesOperation) {
+  auto mock_cq = std::make_shared<MockCompletionQueue>();
+  CompletionQueue cq(mock_cq);
+
+  // All the `Read()` calls, including those discarding results after the
+  // handler returns `false`, use the same tag and response buffer.
+  std::vector<std::pair<btproto::ReadRowsResponse*, void*>> reads;
+  auto mock_reader = google::cloud::internal::make_unique<MockRowReader>();
+  EXPECT_CALL(*mock_reader, StartCall(_)).Times(1);
+  EXPECT_CALL(*mock_reader, Read(_, _))
+      .Times(5)
+      .WillRepeatedly([&reads](btproto::ReadRowsResponse* r, void* tag) {
+        reads.emplace_back(r, tag);
+      });
+  EXPECT_CALL(*mock_reader, Finish(_, _)).Times(1);
+
+  MockClient mock_client;
+  EXPECT_CALL(mock_client, AsyncReadRows(_, _, _))
+      .WillOnce([&mock_reader](grpc::ClientContext*,
+                               btproto::ReadRowsRequest const&,
+                               grpc::CompletionQueue*) {
+        return std::unique_ptr<
+            grpc::ClientAsyncReaderInterface<btproto::ReadRowsResponse>>(
+            mock_reader.release());
+      });
+
+  std::thread runner([&cq] { cq.Run(); });
+
+  int on_read_counter = 0;
+  int on_finish_counter = 0;
+  (void)cq.MakeStreamingReadRpc(
+      [&mock_client](grpc::ClientContext* context,
+                     btproto::ReadRowsRequest const& request,
+                     grpc::CompletionQueue* cq) {
+        return mock_client.AsyncReadRows(context, request, cq);
+      },
+      btproto::ReadRowsRequest{},
+      google::cloud::internal::make_unique<grpc::ClientContext>(),
+      [&on_read_counter](btproto::ReadRowsResponse const&) {
+        return make_ready_future(++on_read_counter < 3);
+      },
+      [&on_finish_counter](Status const&) { ++on_finish_counter; });
+
+  // Simulate the OnStart() completion and three Read() completions, the last
+  // one stops the loop.
+  for (int i = 0; i != 4; ++i) mock_cq->SimulateCompletion(true);
+  EXPECT_EQ(3, on_read_counter);
+  // Simulate a discarded Read() and then a Read() returning false.
+  mock_cq->SimulateCompletion(true);
+  mock_cq->SimulateCompletion(false);
+  EXPECT_EQ(3, on_read_counter);
+  EXPECT_EQ(0, on_finish_counter);
+
+  // Simulate the Finish() call completing asynchronously
+  mock_cq->SimulateCompletion(false);
+  EXPECT_EQ(1, on_finish_counter);
+
+  ASSERT_EQ(5U, reads.size());
+  for (auto const& r : reads) EXPECT_EQ(reads.front(), r);
+
+  cq.Shutdown();
+  runner.join();
+}
+
 TEST(CompletionQueueTest, MakeRpcsAfterShutdown) {
   using ms = std::chrono::milliseconds;
 
@@ -419,6 +485,53 @@ TEST(CompletionQueueTest, CancelTimerContinuation) {
   t.join();
 }
 
+/// @test Verify that many concurrent timers expire, in any order.
+TEST(CompletionQueueTest, ManyTimers) {
+  CompletionQueue cq;
+  std::thread t([&cq] { cq.Run(); });
+
+  auto constexpr kTimerCount = 10000;
+  std::vector<TimerFuture> timers;
+  std::vector<std::chrono::system_clock::time_point> deadlines;
+  auto const start = std::chrono::system_clock::now();
+  for (int i = 0; i != kTimerCount; ++i) {
+    deadlines.push_back(start + std::chrono::milliseconds(i % 50));
+    timers.push_back(cq.MakeDeadlineTimer(deadlines.back()));
+  }
+  // Cancel one timer in the middle of the wheel.
+  timers[kTimerCount / 2 + 1].cancel();
+  for (int i = 0; i != kTimerCount; ++i) {
+    auto result = timers[i].get();
+    if (i == kTimerCount / 2 + 1 && !result) {
+      EXPECT_EQ(StatusCode::kCancelled, result.status().code());
+      continue;
+    }
+    ASSERT_STATUS_OK(result);
+    EXPECT_EQ(deadlines[i], *result);
+  }
+  EXPECT_LE(deadlines.back(), std::chrono::system_clock::now());
+
+  cq.Shutdown();
+  t.join();
+}
+
+/// @test Verify that a short timer is not delayed by a longer timer.
+TEST(CompletionQueueTest, ShortTimerAfterLongTimer) {
+  CompletionQueue cq;
+  std::thread t([&cq] { cq.Run(); });
+
+  auto long_timer = cq.MakeRelativeTimer(std::chrono::hours(1));
+  auto short_timer = cq.MakeRelativeTimer(std::chrono::milliseconds(1));
+  ASSERT_STATUS_OK(short_timer.get());
+  EXPECT_EQ(std::future_status::timeout,
+            long_timer.wait_for(std::chrono::milliseconds(0)));
+
+  long_timer.cancel();
+  EXPECT_EQ(StatusCode::kCancelled, long_timer.get().status().code());
+  cq.Shutdown();
+  t.join();
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
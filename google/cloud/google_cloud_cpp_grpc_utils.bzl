@@ -26,11 +26,14 @@ google_cloud_cpp_grpc_utils_hdrs = [
     "grpc_utils/completion_queue.h",
     "grpc_utils/grpc_error_delegate.h",
     "grpc_utils/version.h",
+    "internal/async_callback_rpc.h",
+    "internal/async_pagination_range.h",
     "internal/async_read_stream_impl.h",
     "internal/async_retry_unary_rpc.h",
     "internal/background_threads_impl.h",
     "internal/completion_queue_impl.h",
     "internal/pagination_range.h",
+    "internal/timing_wheel.h",
 ]
 
 google_cloud_cpp_grpc_utils_srcs = [
@@ -39,4 +42,5 @@ google_cloud_cpp_grpc_utils_srcs = [
     "grpc_error_delegate.cc",
     "internal/background_threads_impl.cc",
     "internal/completion_queue_impl.cc",
+    "internal/timing_wheel.cc",
 ]
@@ -0,0 +1,240 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_CALLBACK_RPC_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_CALLBACK_RPC_H
+
+#include "google/cloud/future.h"
+#include "google/cloud/grpc_error_delegate.h"
+#include "google/cloud/internal/invoke_result.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/support/client_callback.h>
+#include <memory>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * The reactor base class for streaming read RPCs using the gRPC callback API.
+ *
+ * The callback API graduated from `grpc::experimental` in later gRPC releases,
+ * this alias (and `CallbackStub()`) hide the difference.
+ */
+#ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+template <typename Response>
+using ClientReadReactor = ::grpc::ClientReadReactor<Response>;
+#else
+template <typename Response>
+using ClientReadReactor = ::grpc::experimental::ClientReadReactor<Response>;
+#endif  // GRPC_CALLBACK_API_NONEXPERIMENTAL
+
+/// Returns the callback API interface of a gRPC-generated @p stub.
+template <typename Stub>
+auto CallbackStub(Stub& stub)
+#ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+    -> decltype(stub.async()) {
+  return stub.async();
+}
+#else
+    -> decltype(stub.experimental_async()) {
+  return stub.experimental_async();
+}
+#endif  // GRPC_CALLBACK_API_NONEXPERIMENTAL
+
+/**
+ * Make an asynchronous unary RPC using the gRPC callback API.
+ *
+ * Unlike `CompletionQueue::MakeUnaryRpc()` the RPC does not need a thread
+ * blocked on a `grpc::CompletionQueue`, the result is delivered from a thread
+ * owned by gRPC. Applications should not block in any continuations attached
+ * to the returned future.
+ *
+ * @param async_call a callable with the form:
+ *     @code
+ *     void(grpc::ClientContext*, Request const*, Response*,
+ *          std::function<void(grpc::Status)>)
+ *     @endcode
+ *     this is typically a wrapper around one of the member functions in the
+ *     gRPC-generated `experimental_async()` (or `async()`) interface.
+ * @param request the request, it must remain valid until the returned future
+ *     is satisfied.
+ * @param context the client context to control the RPC.
+ *
+ * @tparam Response the type of the response.
+ */
+template <typename Response, typename AsyncCallType, typename Request>
+future<StatusOr<Response>> MakeCallbackUnaryRpc(
+    AsyncCallType&& async_call, Request const& request,
+    std::unique_ptr<grpc::ClientContext> context) {
+  struct State {
+    std::unique_ptr<grpc::ClientContext> context;
+    Response response;
+    promise<StatusOr<Response>> result;
+  };
+  auto state = std::make_shared<State>();
+  state->context = std::move(context);
+  auto f = state->result.get_future();
+  async_call(state->context.get(), &request, &state->response,
+             [state](grpc::Status const& status) {
+               if (!status.ok()) {
+                 state->result.set_value(MakeStatusFromRpcError(status));
+                 return;
+               }
+               state->result.set_value(std::move(state->response));
+             });
+  return f;
+}
+
+/**
+ * Read responses from a streaming read RPC using the gRPC callback API.
+ *
+ * This class has the same contract as `AsyncReadStreamImpl`: it invokes the
+ * `on_read` handler for each response, stopping if the handler returns
+ * `false`, and calls `on_finish` with the final status of the stream. The
+ * difference is that there are no completion queue operations, gRPC calls
+ * the reactor from its own threads.
+ *
+ * Objects of this class delete themselves once the stream is done, they must
+ * be created via `Start()`.
+ *
+ * @tparam Request the type of the request.
+ * @tparam Response the type of the responses in the streaming read RPC.
+ * @tparam OnReadHandler the type of the user-provided callable to handle Read
+ *     responses.
+ * @tparam OnFinishHandler the type of the user-provided callback to handle
+ *     the final status.
+ */
+template <typename Request, typename Response, typename OnReadHandler,
+          typename OnFinishHandler>
+class AsyncReadStreamReactor final : public ClientReadReactor<Response> {
+ public:
+  /**
+   * Start the streaming read RPC and its read loop.
+   *
+   * @param async_call a callable with the form:
+   *     @code
+   *     void(grpc::ClientContext*, Request const*,
+   *          ClientReadReactor<Response>*)
+   *     @endcode
+   *     this is typically a wrapper around one of the member functions in the
+   *     gRPC-generated `experimental_async()` (or `async()`) interface.
+   * @param request the request parameter for the streaming read RPC, the
+   *     reactor keeps a copy.
+   * @param context the client context to control the streaming read RPC.
+   * @param on_read the handler for a successful `Read()` result.
+   * @param on_finish the handler for the final status of the stream.
+   */
+  template <typename AsyncCallType>
+  static void Start(AsyncCallType&& async_call, Request request,
+                    std::unique_ptr<grpc::ClientContext> context,
+                    OnReadHandler&& on_read, OnFinishHandler&& on_finish) {
+    auto* self = new AsyncReadStreamReactor(
+        std::move(request), std::move(context),
+        std::forward<OnReadHandler>(on_read),
+        std::forward<OnFinishHandler>(on_finish));
+    async_call(self->context_.get(), &self->request_, self);
+    // The hold keeps the RPC (and this object) alive while the `on_read`
+    // handler is running, it is released once the loop stops reading.
+    self->AddHold();
+    self->StartRead(&self->response_);
+    self->StartCall();
+  }
+
+  void OnReadDone(bool ok) override {
+    if (!ok) {
+      this->RemoveHold();
+      return;
+    }
+    auto continue_reading = on_read_(std::move(response_));
+    if (continue_reading.is_ready()) {
+      OnReadHandled(continue_reading.get());
+      return;
+    }
+    continue_reading.then(
+        [this](future<bool> result) { OnReadHandled(result.get()); });
+  }
+
+  void OnDone(grpc::Status const& status) override {
+    on_finish_(MakeStatusFromRpcError(status));
+    delete this;
+  }
+
+ private:
+  AsyncReadStreamReactor(Request request,
+                         std::unique_ptr<grpc::ClientContext> context,
+                         OnReadHandler&& on_read, OnFinishHandler&& on_finish)
+      : request_(std::move(request)),
+        context_(std::move(context)),
+        on_read_(std::forward<OnReadHandler>(on_read)),
+        on_finish_(std::forward<OnFinishHandler>(on_finish)) {}
+
+  /// Continue or stop the loop based on the result of the `on_read` handler.
+  void OnReadHandled(bool continue_reading) {
+    if (!continue_reading) {
+      // Unlike the completion queue based streams there is no need to drain
+      // the pending messages, gRPC discards them once the hold is released.
+      context_->TryCancel();
+      this->RemoveHold();
+      return;
+    }
+    this->StartRead(&response_);
+  }
+
+  Request request_;
+  std::unique_ptr<grpc::ClientContext> context_;
+  Response response_;
+  typename std::decay<OnReadHandler>::type on_read_;
+  typename std::decay<OnFinishHandler>::type on_finish_;
+};
+
+/**
+ * Start a streaming read RPC using the gRPC callback API.
+ *
+ * This is the callback API analogue of `CompletionQueue::MakeStreamingReadRpc`.
+ * The handlers are called from threads owned by gRPC, they should not block.
+ *
+ * @tparam Response the type of the responses.
+ */
+template <
+    typename Response, typename AsyncCallType, typename Request,
+    typename OnReadHandler, typename OnFinishHandler,
+    typename std::enable_if<
+        std::is_same<future<bool>, google::cloud::internal::invoke_result_t<
+                                       OnReadHandler, Response>>::value,
+        int>::type on_read_returns_future_bool = 0,
+    typename std::enable_if<
+        google::cloud::internal::is_invocable<OnFinishHandler, Status>::value,
+        int>::type on_finish_is_invocable_with_status = 0>
+void MakeCallbackStreamingReadRpc(AsyncCallType&& async_call,
+                                  Request const& request,
+                                  std::unique_ptr<grpc::ClientContext> context,
+                                  OnReadHandler&& on_read,
+                                  OnFinishHandler&& on_finish) {
+  using Reactor = AsyncReadStreamReactor<Request, Response, OnReadHandler,
+                                         OnFinishHandler>;
+  Reactor::Start(std::forward<AsyncCallType>(async_call), request,
+                 std::move(context), std::forward<OnReadHandler>(on_read),
+                 std::forward<OnFinishHandler>(on_finish));
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_CALLBACK_RPC_H
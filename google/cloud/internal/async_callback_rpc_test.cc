@@ -0,0 +1,214 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/async_callback_rpc.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <gmock/gmock.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+namespace btproto = ::google::bigtable::v2;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+#ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+template <typename Response>
+using ClientCallbackReader = ::grpc::ClientCallbackReader<Response>;
+#else
+template <typename Response>
+using ClientCallbackReader =
+    ::grpc::experimental::ClientCallbackReader<Response>;
+#endif  // GRPC_CALLBACK_API_NONEXPERIMENTAL
+
+/**
+ * A fake for the gRPC side of a callback-based streaming read.
+ *
+ * The tests drive the reactor directly, simulating the callbacks that gRPC
+ * would make.
+ */
+class FakeReader : public ClientCallbackReader<btproto::ReadRowsResponse> {
+ public:
+  void Bind(ClientReadReactor<btproto::ReadRowsResponse>* reactor) {
+    reactor_ = reactor;
+    BindReactor(reactor);
+  }
+
+  void StartCall() override { started_ = true; }
+  void Read(btproto::ReadRowsResponse* response) override {
+    ++reads_;
+    response_ = response;
+  }
+  void AddHold(int holds) override { holds_ += holds; }
+  void RemoveHold() override { --holds_; }
+
+  /// Simulate a successful `Read()` returning a response with @p key.
+  void SimulateRead(std::string const& key) {
+    ASSERT_NE(nullptr, response_);
+    auto* r = response_;
+    response_ = nullptr;
+    r->add_chunks()->set_row_key(key);
+    reactor_->OnReadDone(true);
+  }
+
+  ClientReadReactor<btproto::ReadRowsResponse>* reactor_ = nullptr;
+  btproto::ReadRowsResponse* response_ = nullptr;
+  bool started_ = false;
+  int reads_ = 0;
+  int holds_ = 0;
+};
+
+TEST(AsyncCallbackRpcTest, UnaryRpc) {
+  std::function<void(grpc::Status)> on_done;
+  btproto::MutateRowResponse* response = nullptr;
+
+  btproto::MutateRowRequest request;
+  request.set_table_name("test-table");
+  auto fut = MakeCallbackUnaryRpc<btproto::MutateRowResponse>(
+      [&](grpc::ClientContext*, btproto::MutateRowRequest const* r,
+          btproto::MutateRowResponse* rsp,
+          std::function<void(grpc::Status)> cb) {
+        EXPECT_EQ("test-table", r->table_name());
+        response = rsp;
+        on_done = std::move(cb);
+      },
+      request, make_unique<grpc::ClientContext>());
+
+  ASSERT_TRUE(on_done);
+  EXPECT_NE(nullptr, response);
+  EXPECT_FALSE(fut.is_ready());
+  on_done(grpc::Status::OK);
+  ASSERT_TRUE(fut.is_ready());
+  EXPECT_STATUS_OK(fut.get());
+}
+
+TEST(AsyncCallbackRpcTest, UnaryRpcError) {
+  btproto::MutateRowRequest request;
+  auto fut = MakeCallbackUnaryRpc<btproto::MutateRowResponse>(
+      [](grpc::ClientContext*, btproto::MutateRowRequest const*,
+         btproto::MutateRowResponse*, std::function<void(grpc::Status)> cb) {
+        cb(grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again"));
+      },
+      request, make_unique<grpc::ClientContext>());
+
+  ASSERT_TRUE(fut.is_ready());
+  auto result = fut.get();
+  EXPECT_EQ(StatusCode::kUnavailable, result.status().code());
+  EXPECT_THAT(result.status().message(), HasSubstr("try-again"));
+}
+
+TEST(AsyncCallbackRpcTest, StreamingReadAll) {
+  FakeReader reader;
+  std::vector<std::string> keys;
+  Status final_status(StatusCode::kUnknown, "not called");
+
+  btproto::ReadRowsRequest request;
+  request.set_table_name("test-table");
+  MakeCallbackStreamingReadRpc<btproto::ReadRowsResponse>(
+      [&](grpc::ClientContext*, btproto::ReadRowsRequest const* r,
+          ClientReadReactor<btproto::ReadRowsResponse>* reactor) {
+        EXPECT_EQ("test-table", r->table_name());
+        reader.Bind(reactor);
+      },
+      request, make_unique<grpc::ClientContext>(),
+      [&keys](btproto::ReadRowsResponse r) {
+        for (auto const& c : r.chunks()) keys.push_back(c.row_key());
+        return make_ready_future(true);
+      },
+      [&final_status](Status s) { final_status = std::move(s); });
+
+  EXPECT_TRUE(reader.started_);
+  EXPECT_EQ(1, reader.holds_);
+  reader.SimulateRead("k0");
+  reader.SimulateRead("k1");
+  reader.SimulateRead("k2");
+  EXPECT_EQ(4, reader.reads_);
+  // Each response is delivered once, the buffer does not accumulate chunks.
+  EXPECT_THAT(keys, ElementsAre("k0", "k1", "k2"));
+
+  reader.reactor_->OnReadDone(false);
+  EXPECT_EQ(0, reader.holds_);
+  reader.reactor_->OnDone(grpc::Status::OK);
+  EXPECT_STATUS_OK(final_status);
+}
+
+TEST(AsyncCallbackRpcTest, StreamingStopReading) {
+  FakeReader reader;
+  int count = 0;
+  Status final_status(StatusCode::kUnknown, "not called");
+
+  btproto::ReadRowsRequest request;
+  MakeCallbackStreamingReadRpc<btproto::ReadRowsResponse>(
+      [&](grpc::ClientContext*, btproto::ReadRowsRequest const*,
+          ClientReadReactor<btproto::ReadRowsResponse>* reactor) {
+        reader.Bind(reactor);
+      },
+      request, make_unique<grpc::ClientContext>(),
+      [&count](btproto::ReadRowsResponse) {
+        return make_ready_future(++count < 2);
+      },
+      [&final_status](Status s) { final_status = std::move(s); });
+
+  reader.SimulateRead("k0");
+  reader.SimulateRead("k1");
+  // Returning `false` releases the hold without starting a new `Read()`.
+  EXPECT_EQ(2, reader.reads_);
+  EXPECT_EQ(0, reader.holds_);
+  reader.reactor_->OnDone(grpc::Status(grpc::StatusCode::CANCELLED, "gone"));
+  EXPECT_EQ(StatusCode::kCancelled, final_status.code());
+}
+
+TEST(AsyncCallbackRpcTest, StreamingDeferredOnRead) {
+  FakeReader reader;
+  promise<bool> continue_reading;
+  Status final_status(StatusCode::kUnknown, "not called");
+
+  btproto::ReadRowsRequest request;
+  MakeCallbackStreamingReadRpc<btproto::ReadRowsResponse>(
+      [&](grpc::ClientContext*, btproto::ReadRowsRequest const*,
+          ClientReadReactor<btproto::ReadRowsResponse>* reactor) {
+        reader.Bind(reactor);
+      },
+      request, make_unique<grpc::ClientContext>(),
+      [&continue_reading](btproto::ReadRowsResponse) {
+        return continue_reading.get_future();
+      },
+      [&final_status](Status s) { final_status = std::move(s); });
+
+  reader.SimulateRead("k0");
+  // The next `Read()` waits until the handler's future is satisfied.
+  EXPECT_EQ(1, reader.reads_);
+  EXPECT_EQ(1, reader.holds_);
+  continue_reading.set_value(true);
+  EXPECT_EQ(2, reader.reads_);
+
+  reader.reactor_->OnReadDone(false);
+  EXPECT_EQ(0, reader.holds_);
+  reader.reactor_->OnDone(grpc::Status::OK);
+  EXPECT_STATUS_OK(final_status);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
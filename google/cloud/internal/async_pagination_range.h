@@ -0,0 +1,191 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_PAGINATION_RANGE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_PAGINATION_RANGE_H
+
+#include "google/cloud/future.h"
+#include "google/cloud/optional.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * Adapt pagination APIs to asynchronous streams of pages or items.
+ *
+ * This is the asynchronous counterpart of `PaginationRange`. Instead of
+ * blocking the calling thread to fetch each page, the range uses a `loader`
+ * that returns a `future<StatusOr<Response>>`, typically created with one of
+ * the `CompletionQueue::MakeUnaryRpc()` helpers. The application consumes the
+ * range one page (`NextPage()`) or one item (`Next()`) at a time. Both
+ * functions return a future that is satisfied with:
+ * - An error, if the RPC to fetch a page failed. The range is then exhausted.
+ * - An empty `optional<>`, if the range is exhausted.
+ * - The next page or item otherwise.
+ *
+ * If `prefetch` is set the range starts loading the next page as soon as the
+ * current page is received, so the latency to fetch each page overlaps with the
+ * application processing the previous page.
+ *
+ * @note This class is not thread-safe: the application must wait for the
+ *     future returned by `Next()` or `NextPage()` to be satisfied before
+ *     calling either function again. Copies of the range share their state.
+ *
+ * @tparam T the type of the items, typically a proto describing the resources
+ * @tparam Request the type of the request object for the `List` RPC.
+ * @tparam Response the type of the response object for the `List` RPC.
+ */
+template <typename T, typename Request, typename Response>
+class AsyncPaginationRange {
+ public:
+  using PageResult = StatusOr<optional<std::vector<T>>>;
+  using ItemResult = StatusOr<optional<T>>;
+
+  /**
+   * Create a new range to asynchronously paginate over some elements.
+   *
+   * @param request the first request to start the iteration, the library may
+   *    initialize this request with any filtering constraints.
+   * @param loader starts the RPC request to fetch a new page of items.
+   * @param get_items extracts the items from the response using native C++
+   *     types (as opposed to the proto types used in `Response`).
+   * @param prefetch if true, start fetching the next page as soon as the
+   *     current page is received.
+   */
+  AsyncPaginationRange(
+      Request request,
+      std::function<future<StatusOr<Response>>(Request const& r)> loader,
+      std::function<std::vector<T>(Response r)> get_items,
+      bool prefetch = false)
+      : state_(std::make_shared<State>(std::move(request), std::move(loader),
+                                       std::move(get_items), prefetch)) {}
+
+  /**
+   * Fetch the next page.
+   *
+   * If some items of the current page have not been returned by `Next()` they
+   * are returned as a (possibly short) page, without making any RPCs. Note that
+   * pages may be empty even if the range is not exhausted.
+   */
+  future<PageResult> NextPage() { return State::NextPage(state_); }
+
+  /// Fetch the next item, loading a new page if needed.
+  future<ItemResult> Next() { return State::Next(state_); }
+
+ private:
+  struct State {
+    State(Request r,
+          std::function<future<StatusOr<Response>>(Request const&)> l,
+          std::function<std::vector<T>(Response)> g, bool p)
+        : request(std::move(r)),
+          loader(std::move(l)),
+          get_items(std::move(g)),
+          prefetch(p) {}
+
+    static future<PageResult> NextPage(std::shared_ptr<State> s) {
+      if (s->next_item != s->items.size()) {
+        std::vector<T> page(
+            std::make_move_iterator(s->items.begin() + s->next_item),
+            std::make_move_iterator(s->items.end()));
+        s->items.clear();
+        s->next_item = 0;
+        return make_ready_future(
+            PageResult(optional<std::vector<T>>(std::move(page))));
+      }
+      if (s->on_last_page) {
+        return make_ready_future(PageResult(optional<std::vector<T>>{}));
+      }
+      auto f = s->has_prefetched ? std::move(s->prefetched) : s->Load();
+      s->has_prefetched = false;
+      return f.then([s](future<StatusOr<Response>> g) {
+        return s->OnPage(g.get());
+      });
+    }
+
+    static future<ItemResult> Next(std::shared_ptr<State> s) {
+      if (s->next_item != s->items.size()) {
+        return make_ready_future(
+            ItemResult(optional<T>(std::move(s->items[s->next_item++]))));
+      }
+      if (s->on_last_page) {
+        return make_ready_future(ItemResult(optional<T>{}));
+      }
+      return NextPage(s).then([s](future<PageResult> f) {
+        auto page = f.get();
+        if (!page) {
+          return make_ready_future(ItemResult(std::move(page).status()));
+        }
+        if (!page->has_value()) {
+          return make_ready_future(ItemResult(optional<T>{}));
+        }
+        // Pages may be empty, `Next()` loads more pages as needed.
+        s->items = std::move(**page);
+        s->next_item = 0;
+        return Next(std::move(s));
+      });
+    }
+
+    future<StatusOr<Response>> Load() {
+      request.set_page_token(std::move(next_page_token));
+      next_page_token.clear();
+      return loader(request);
+    }
+
+    PageResult OnPage(StatusOr<Response> response) {
+      if (!response) {
+        on_last_page = true;
+        return std::move(response).status();
+      }
+      next_page_token = std::move(*response->mutable_next_page_token());
+      on_last_page = next_page_token.empty();
+      auto page = get_items(*std::move(response));
+      if (!on_last_page && prefetch) {
+        prefetched = Load();
+        has_prefetched = true;
+      }
+      return optional<std::vector<T>>(std::move(page));
+    }
+
+    Request request;
+    std::function<future<StatusOr<Response>>(Request const&)> loader;
+    std::function<std::vector<T>(Response)> get_items;
+    bool const prefetch;
+    std::string next_page_token;
+    bool on_last_page = false;
+    future<StatusOr<Response>> prefetched;
+    bool has_prefetched = false;
+    std::vector<T> items;
+    std::size_t next_item = 0;
+  };
+
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_PAGINATION_RANGE_H
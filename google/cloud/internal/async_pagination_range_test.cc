@@ -0,0 +1,234 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/async_pagination_range.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <google/bigtable/admin/v2/bigtable_instance_admin.grpc.pb.h>
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::Invoke;
+using ItemType = ::google::bigtable::admin::v2::AppProfile;
+using Request = ::google::bigtable::admin::v2::ListAppProfilesRequest;
+using Response = ::google::bigtable::admin::v2::ListAppProfilesResponse;
+using TestedRange = AsyncPaginationRange<ItemType, Request, Response>;
+
+class MockRpc {
+ public:
+  MOCK_METHOD1(Loader, future<StatusOr<Response>>(Request const&));
+};
+
+std::vector<ItemType> GetItems(Response const& response) {
+  return std::vector<ItemType>(response.app_profiles().begin(),
+                               response.app_profiles().end());
+}
+
+Response MakeResponse(std::string token,
+                      std::vector<std::string> const& names) {
+  Response response;
+  response.set_next_page_token(std::move(token));
+  for (auto const& n : names) response.add_app_profiles()->set_name(n);
+  return response;
+}
+
+future<StatusOr<Response>> ReadyResponse(Response response) {
+  return make_ready_future(StatusOr<Response>(std::move(response)));
+}
+
+std::vector<std::string> DrainItems(TestedRange& range, Status& status) {
+  std::vector<std::string> names;
+  for (;;) {
+    auto item = range.Next().get();
+    if (!item) {
+      status = std::move(item).status();
+      break;
+    }
+    if (!item->has_value()) break;
+    names.push_back((*item)->name());
+  }
+  return names;
+}
+
+TEST(AsyncPaginationRange, Empty) {
+  MockRpc mock;
+  EXPECT_CALL(mock, Loader(_)).WillOnce(Invoke([](Request const& request) {
+    EXPECT_TRUE(request.page_token().empty());
+    return ReadyResponse(MakeResponse("", {}));
+  }));
+
+  TestedRange range(
+      Request{}, [&](Request const& r) { return mock.Loader(r); }, GetItems);
+  auto item = range.Next().get();
+  ASSERT_STATUS_OK(item);
+  EXPECT_FALSE(item->has_value());
+  // Once exhausted the range does not make any more RPCs.
+  item = range.Next().get();
+  ASSERT_STATUS_OK(item);
+  EXPECT_FALSE(item->has_value());
+}
+
+TEST(AsyncPaginationRange, TwoPagesWithEmptyPage) {
+  MockRpc mock;
+  EXPECT_CALL(mock, Loader(_))
+      .WillOnce(Invoke([](Request const& request) {
+        EXPECT_TRUE(request.page_token().empty());
+        return ReadyResponse(MakeResponse("t1", {"p1", "p2"}));
+      }))
+      .WillOnce(Invoke([](Request const& request) {
+        EXPECT_EQ("t1", request.page_token());
+        return ReadyResponse(MakeResponse("t2", {}));
+      }))
+      .WillOnce(Invoke([](Request const& request) {
+        EXPECT_EQ("t2", request.page_token());
+        return ReadyResponse(MakeResponse("", {"p3", "p4"}));
+      }));
+
+  TestedRange range(
+      Request{}, [&](Request const& r) { return mock.Loader(r); }, GetItems);
+  Status status;
+  auto names = DrainItems(range, status);
+  EXPECT_STATUS_OK(status);
+  EXPECT_THAT(names, ElementsAre("p1", "p2", "p3", "p4"));
+}
+
+TEST(AsyncPaginationRange, TwoPagesWithError) {
+  MockRpc mock;
+  EXPECT_CALL(mock, Loader(_))
+      .WillOnce(Invoke([](Request const&) {
+        return ReadyResponse(MakeResponse("t1", {"p1", "p2"}));
+      }))
+      .WillOnce(Invoke([](Request const& request) {
+        EXPECT_EQ("t1", request.page_token());
+        return make_ready_future(
+            StatusOr<Response>(Status(StatusCode::kAborted, "bad-luck")));
+      }));
+
+  TestedRange range(
+      Request{}, [&](Request const& r) { return mock.Loader(r); }, GetItems);
+  Status status;
+  auto names = DrainItems(range, status);
+  EXPECT_EQ(StatusCode::kAborted, status.code());
+  EXPECT_THAT(status.message(), HasSubstr("bad-luck"));
+  EXPECT_THAT(names, ElementsAre("p1", "p2"));
+
+  // After an error the range is exhausted.
+  auto item = range.Next().get();
+  ASSERT_STATUS_OK(item);
+  EXPECT_FALSE(item->has_value());
+}
+
+TEST(AsyncPaginationRange, Pages) {
+  MockRpc mock;
+  EXPECT_CALL(mock, Loader(_))
+      .WillOnce(Invoke([](Request const&) {
+        return ReadyResponse(MakeResponse("t1", {"p1", "p2", "p3"}));
+      }))
+      .WillOnce(Invoke([](Request const& request) {
+        EXPECT_EQ("t1", request.page_token());
+        return ReadyResponse(MakeResponse("", {"p4"}));
+      }));
+
+  TestedRange range(
+      Request{}, [&](Request const& r) { return mock.Loader(r); }, GetItems);
+  // Consume one item, the rest of the first page is returned by NextPage().
+  auto item = range.Next().get();
+  ASSERT_STATUS_OK(item);
+  ASSERT_TRUE(item->has_value());
+  EXPECT_EQ("p1", (*item)->name());
+
+  std::vector<std::vector<std::string>> pages;
+  for (;;) {
+    auto page = range.NextPage().get();
+    ASSERT_STATUS_OK(page);
+    if (!page->has_value()) break;
+    std::vector<std::string> names;
+    for (auto const& p : **page) names.push_back(p.name());
+    pages.push_back(std::move(names));
+  }
+  EXPECT_THAT(pages, ElementsAre(ElementsAre("p2", "p3"), ElementsAre("p4")));
+}
+
+TEST(AsyncPaginationRange, NoPrefetch) {
+  MockRpc mock;
+  promise<StatusOr<Response>> p1;
+  EXPECT_CALL(mock, Loader(_)).WillOnce(Invoke([&](Request const&) {
+    return p1.get_future();
+  }));
+
+  TestedRange range(
+      Request{}, [&](Request const& r) { return mock.Loader(r); }, GetItems);
+  auto page = range.NextPage();
+  EXPECT_EQ(std::future_status::timeout,
+            page.wait_for(std::chrono::seconds(0)));
+  p1.set_value(MakeResponse("t1", {"p1"}));
+  ASSERT_STATUS_OK(page.get());
+  // Without prefetching the second page is only requested on demand.
+  ::testing::Mock::VerifyAndClearExpectations(&mock);
+  EXPECT_CALL(mock, Loader(_)).WillOnce(Invoke([](Request const& request) {
+    EXPECT_EQ("t1", request.page_token());
+    return ReadyResponse(MakeResponse("", {"p2"}));
+  }));
+  auto second = range.NextPage().get();
+  ASSERT_STATUS_OK(second);
+  ASSERT_TRUE(second->has_value());
+  EXPECT_EQ(1, (*second)->size());
+}
+
+TEST(AsyncPaginationRange, Prefetch) {
+  MockRpc mock;
+  promise<StatusOr<Response>> p2;
+  EXPECT_CALL(mock, Loader(_))
+      .WillOnce(Invoke([](Request const&) {
+        return ReadyResponse(MakeResponse("t1", {"p1"}));
+      }))
+      .WillOnce(Invoke([&](Request const& request) {
+        EXPECT_EQ("t1", request.page_token());
+        return p2.get_future();
+      }));
+
+  TestedRange range(
+      Request{}, [&](Request const& r) { return mock.Loader(r); }, GetItems,
+      /*prefetch=*/true);
+  auto first = range.NextPage().get();
+  ASSERT_STATUS_OK(first);
+  // The second page is already being loaded, both calls happened already.
+  ::testing::Mock::VerifyAndClearExpectations(&mock);
+
+  auto second = range.NextPage();
+  EXPECT_EQ(std::future_status::timeout,
+            second.wait_for(std::chrono::seconds(0)));
+  p2.set_value(MakeResponse("", {"p2", "p3"}));
+  auto page = second.get();
+  ASSERT_STATUS_OK(page);
+  ASSERT_TRUE(page->has_value());
+  EXPECT_EQ(2, (*page)->size());
+
+  auto end = range.NextPage().get();
+  ASSERT_STATUS_OK(end);
+  EXPECT_FALSE(end->has_value());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
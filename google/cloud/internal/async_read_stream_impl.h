@@ -180,54 +180,85 @@ class AsyncReadStreamImpl
     Read();
   }
 
-  /// Start a `Read()` request.
-  void Read() {
-    // An adapter to call `OnRead()` via the completion queue.
-    class NotifyRead final : public AsyncGrpcOperation {
-     public:
-      explicit NotifyRead(std::shared_ptr<AsyncReadStreamImpl> c)
-          : control_(std::move(c)) {}
-
-      Response response;
-
-     private:
-      void Cancel() override {}  // LCOV_EXCL_LINE
-      bool Notify(bool ok) override {
+  /**
+   * An adapter to call `OnRead()` or `OnDiscard()` via the completion queue.
+   *
+   * A single object is used for all the `Read()` calls in the stream, it
+   * remains registered with the completion queue until a `Read()` fails. The
+   * response buffer is also reused.
+   */
+  class NotifyRead final : public AsyncGrpcOperation {
+   public:
+    explicit NotifyRead(std::shared_ptr<AsyncReadStreamImpl> c)
+        : control_(std::move(c)) {}
+
+    Response response;
+
+   private:
+    void Cancel() override {}  // LCOV_EXCL_LINE
+    bool Notify(bool ok) override {
+      if (control_->discarding_) {
+        control_->OnDiscard(ok);
+      } else {
         control_->OnRead(ok, std::move(response));
-        return true;
       }
-      std::shared_ptr<AsyncReadStreamImpl> control_;
-    };
+      // Once a `Read()` fails there are no more results in the stream, this
+      // operation is completed and can be released.
+      return !ok;
+    }
+    std::shared_ptr<AsyncReadStreamImpl> control_;
+  };
 
-    auto callback = std::make_shared<NotifyRead>(this->shared_from_this());
-    auto response = &callback->response;
-    cq_->StartOperation(std::move(callback),
-                        [&](void* tag) { reader_->Read(response, tag); });
+  /// Start a `Read()` request.
+  void Read() {
+    if (read_op_ == nullptr) {
+      auto callback = std::make_shared<NotifyRead>(this->shared_from_this());
+      read_op_ = callback.get();
+      auto response = &callback->response;
+      cq_->StartOperation(std::move(callback),
+                          [&](void* tag) { reader_->Read(response, tag); });
+      return;
+    }
+    auto response = &read_op_->response;
+    cq_->ContinueOperation(*read_op_,
+                           [&](void* tag) { reader_->Read(response, tag); });
   }
 
   /// Handle the result of a `Read()` call.
   void OnRead(bool ok, Response response) {
     if (!ok) {
+      read_op_ = nullptr;
       Finish();
       return;
     }
 
     auto continue_reading = on_read_(std::move(response));
+    if (continue_reading.is_ready()) {
+      // Most handlers return a satisfied future, skip the continuation (and
+      // its allocation) in that case.
+      OnReadHandled(continue_reading.get());
+      return;
+    }
     auto self = this->shared_from_this();
     continue_reading.then([self](future<bool> result) {
-      if (!result.get()) {
-        // Cancel the stream, this is what the user meant by returning `false`.
-        self->Cancel();
-        // Start discarding messages, gRPC requires that any pending messages
-        // are read before calling Finish(). So we need to read until the first
-        // message that returns ok==false.
-        self->Discard();
-        return;
-      }
-      self->Read();
+      self->OnReadHandled(result.get());
     });
   }
 
+  /// Continue or stop the loop based on the result of the `on_read` handler.
+  void OnReadHandled(bool continue_reading) {
+    if (!continue_reading) {
+      // Cancel the stream, this is what the user meant by returning `false`.
+      Cancel();
+      // Start discarding messages, gRPC requires that any pending messages
+      // are read before calling Finish(). So we need to read until the first
+      // message that returns ok==false.
+      Discard();
+      return;
+    }
+    Read();
+  }
+
   /// Start a Finish() request on the underlying read stream.
   void Finish() {
     // An adapter to call `OnFinish()` via the completion queue.
@@ -268,32 +299,14 @@ class AsyncReadStreamImpl
    * `Finish()`.
    */
   void Discard() {
-    // An adapter to call `OnDiscard()` via the completion queue.
-    class NotifyDiscard final : public AsyncGrpcOperation {
-     public:
-      explicit NotifyDiscard(std::shared_ptr<AsyncReadStreamImpl> c)
-          : control_(std::move(c)) {}
-
-      Response response;
-
-     private:
-      void Cancel() override {}  // LCOV_EXCL_LINE
-      bool Notify(bool ok) override {
-        control_->OnDiscard(ok, std::move(response));
-        return true;
-      }
-      std::shared_ptr<AsyncReadStreamImpl> control_;
-    };
-
-    auto callback = std::make_shared<NotifyDiscard>(this->shared_from_this());
-    auto response = &callback->response;
-    cq_->StartOperation(std::move(callback),
-                        [&](void* tag) { reader_->Read(response, tag); });
+    discarding_ = true;
+    Read();
   }
 
   /// Handle the result of a Discard() call.
-  void OnDiscard(bool ok, Response) {
+  void OnDiscard(bool ok) {
     if (!ok) {
+      read_op_ = nullptr;
       Finish();
       return;
     }
@@ -309,6 +322,10 @@ class AsyncReadStreamImpl
   std::unique_ptr<grpc::ClientContext> context_;
   std::shared_ptr<CompletionQueueImpl> cq_;
   std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> reader_;
+  // The operation used for all `Read()` calls, it is owned by the completion
+  // queue and keeps this object alive while the stream has results.
+  NotifyRead* read_op_ = nullptr;
+  bool discarding_ = false;
 };
 
 /**
@@ -26,6 +26,57 @@ namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
 
+/**
+ * Determine if @p AsyncCallType completes the RPC without a completion queue.
+ *
+ * Most asynchronous calls start the RPC on a `grpc::CompletionQueue` and
+ * return a `grpc::ClientAsyncResponseReaderInterface<Response>`. Some calls,
+ * such as those using the gRPC callback API, have the form:
+ *
+ * @code
+ *   future<StatusOr<Response>>(
+ *       std::unique_ptr<grpc::ClientContext>,
+ *       RequestType const&
+ *   );
+ * @endcode
+ *
+ * and deliver the result directly, without a completion queue thread. The
+ * request remains valid until the returned future is satisfied.
+ */
+template <typename AsyncCallType, typename RequestType>
+using IsDirectAsyncCall =
+    google::cloud::internal::is_invocable<AsyncCallType,
+                                          std::unique_ptr<grpc::ClientContext>,
+                                          RequestType const&>;
+
+/// A meta function to extract `T` from `future<StatusOr<T>>`.
+template <typename T>
+struct FutureStatusOrUnwrap {};
+
+/// A meta function to extract `T` from `future<StatusOr<T>>`.
+template <typename T>
+struct FutureStatusOrUnwrap<future<StatusOr<T>>> {
+  using type = T;
+};
+
+/**
+ * A meta function to determine the `Response` type of an asynchronous call.
+ *
+ * This works for callables that use a completion queue, and for callables that
+ * satisfy `IsDirectAsyncCall`.
+ */
+template <typename AsyncCallType, typename RequestType,
+          bool = IsDirectAsyncCall<AsyncCallType, RequestType>::value>
+struct RetryAsyncCallResponseType
+    : public AsyncCallResponseType<AsyncCallType, RequestType> {};
+
+/// The specialization for callables that satisfy `IsDirectAsyncCall`.
+template <typename AsyncCallType, typename RequestType>
+struct RetryAsyncCallResponseType<AsyncCallType, RequestType, true>
+    : public FutureStatusOrUnwrap<google::cloud::internal::invoke_result_t<
+          AsyncCallType, std::unique_ptr<grpc::ClientContext>,
+          RequestType const&>> {};
+
 /**
  * Make an asynchronous unary RPC with retries.
  *
@@ -56,7 +107,7 @@ class RetryAsyncUnaryRpc {
   /// @name Convenience aliases for the RPC request and response types.
   using Request = RequestType;
   using Response =
-      typename AsyncCallResponseType<AsyncCallType, RequestType>::type;
+      typename RetryAsyncCallResponseType<AsyncCallType, RequestType>::type;
   //@}
 
   /**
@@ -147,12 +198,28 @@ class RetryAsyncUnaryRpc {
     auto context =
         ::google::cloud::internal::make_unique<grpc::ClientContext>();
 
-    cq.MakeUnaryRpc(self->async_call_, self->request_, std::move(context))
+    StartAttempt(*self, cq, std::move(context),
+                 IsDirectAsyncCall<AsyncCallType, Request>{})
         .then([self, cq](future<StatusOr<Response>> fut) {
           self->OnCompletion(self, cq, fut.get());
         });
   }
 
+  /// Start an attempt using the completion queue.
+  static future<StatusOr<Response>> StartAttempt(
+      RetryAsyncUnaryRpc& self, CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context, std::false_type) {
+    return cq.MakeUnaryRpc(self.async_call_, self.request_,
+                           std::move(context));
+  }
+
+  /// Start an attempt that completes without the completion queue.
+  static future<StatusOr<Response>> StartAttempt(
+      RetryAsyncUnaryRpc& self, CompletionQueue&,
+      std::unique_ptr<grpc::ClientContext> context, std::true_type) {
+    return self.async_call_(std::move(context), self.request_);
+  }
+
   /// Generate an error message
   Status DetailedStatus(char const* context, Status const& status) {
     std::string full_message = location_;
@@ -202,9 +269,11 @@ template <typename RPCBackoffPolicy, typename RPCRetryPolicy,
           typename std::enable_if<
               google::cloud::internal::is_invocable<
                   async_call_t, grpc::ClientContext*, request_t const&,
-                  grpc::CompletionQueue*>::value,
+                  grpc::CompletionQueue*>::value ||
+                  IsDirectAsyncCall<async_call_t, request_t>::value,
               int>::type = 0>
-future<StatusOr<typename AsyncCallResponseType<async_call_t, request_t>::type>>
+future<StatusOr<
+    typename RetryAsyncCallResponseType<async_call_t, request_t>::type>>
 StartRetryAsyncUnaryRpc(CompletionQueue cq, char const* location,
                         std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
                         std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
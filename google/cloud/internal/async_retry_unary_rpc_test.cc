@@ -372,6 +372,48 @@ TEST(AsyncRetryUnaryRpcTest, TransientOnNonIdempotent) {
   EXPECT_THAT(result.status().message(), HasSubstr("maybe-try-again"));
 }
 
+TEST(AsyncRetryUnaryRpcTest, DirectCallRetries) {
+  using namespace google::cloud::testing_util::chrono_literals;
+
+  auto impl = std::make_shared<MockCompletionQueue>();
+  CompletionQueue cq(impl);
+
+  btadmin::GetTableRequest request;
+  request.set_name("fake/table/name/request");
+
+  // Calls that do not use the completion queue, such as those using the gRPC
+  // callback API, return a future directly. Only the backoff timers use the
+  // completion queue.
+  int count = 0;
+  auto fut = StartRetryAsyncUnaryRpc(
+      cq, __func__, RpcLimitedErrorCountRetryPolicy(3).clone(),
+      RpcExponentialBackoffPolicy(10_us, 40_us, 2.0).clone(),
+      /*is_idempotent=*/true,
+      [&count](std::unique_ptr<grpc::ClientContext> context,
+               btadmin::GetTableRequest const& request) {
+        EXPECT_NE(nullptr, context);
+        EXPECT_EQ("fake/table/name/request", request.name());
+        if (++count == 1) {
+          return make_ready_future(StatusOr<btadmin::Table>(
+              Status(StatusCode::kUnavailable, "try-again")));
+        }
+        btadmin::Table table;
+        table.set_name("fake/table/name/response");
+        return make_ready_future(make_status_or(std::move(table)));
+      },
+      request);
+
+  EXPECT_EQ(1, impl->size());  // simulate the timer completing
+  impl->SimulateCompletion(true);
+  EXPECT_TRUE(impl->empty());
+
+  EXPECT_EQ(2, count);
+  EXPECT_EQ(std::future_status::ready, fut.wait_for(0_us));
+  auto result = fut.get();
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ("fake/table/name/response", result->name());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
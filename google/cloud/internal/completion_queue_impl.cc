@@ -40,6 +40,10 @@ void CompletionQueueImpl::Run() {
       google::cloud::internal::ThrowRuntimeError(
           "unexpected status from AsyncNext()");
     }
+    if (tag == TimersTag()) {
+      OnTimersAlarm();
+      continue;
+    }
     auto op = FindOperation(tag);
     if (op->Notify(ok)) {
       ForgetOperation(tag);
@@ -51,6 +55,21 @@ void CompletionQueueImpl::Shutdown() {
   {
     std::lock_guard<std::mutex> lk(mu_);
     shutdown_ = true;
+    // The shared alarm cannot be re-armed after `cq_.Shutdown()`, so give each
+    // pending timer its own alarm. The timers still expire at their deadline,
+    // just like any other pending operation.
+    std::vector<TimingWheel::Timer*> pending;
+    timers_.ExtractAll(pending);
+    for (auto* timer : pending) {
+      auto alarm = CreateAlarm();
+      if (!alarm) continue;
+      alarm->Set(&cq_, timer->deadline(), timer->tag);
+      shutdown_alarms_.emplace(timer->tag, std::move(alarm));
+    }
+    if (timers_alarm_ && !timers_alarm_cancelled_) {
+      timers_alarm_cancelled_ = true;
+      timers_alarm_->Cancel();
+    }
   }
   cq_.Shutdown();
 }
@@ -73,6 +92,111 @@ std::unique_ptr<grpc::Alarm> CompletionQueueImpl::CreateAlarm() const {
   return google::cloud::internal::make_unique<grpc::Alarm>();
 }
 
+void CompletionQueueImpl::StartTimer(
+    std::shared_ptr<AsyncGrpcOperation> op, TimingWheel::Timer& timer,
+    std::chrono::system_clock::time_point deadline) {
+  void* tag = op.get();
+  std::unique_lock<std::mutex> lk(mu_);
+  if (shutdown_) {
+    lk.unlock();
+    op->Notify(/*ok=*/false);
+    return;
+  }
+  auto ins = pending_ops_.emplace(reinterpret_cast<std::intptr_t>(tag),
+                                  std::move(op));
+  if (!ins.second) {
+    google::cloud::internal::ThrowRuntimeError(
+        "assertion failure: insertion should succeed");
+  }
+  timer.tag = tag;
+  timers_.Insert(timer, deadline);
+  UpdateTimersAlarm(lk);
+}
+
+void CompletionQueueImpl::CancelTimer(TimingWheel::Timer& timer) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (!timers_.Cancel(timer)) {
+    // The timer already expired, or it has its own alarm after `Shutdown()`.
+    auto loc = shutdown_alarms_.find(timer.tag);
+    if (loc != shutdown_alarms_.end()) loc->second->Cancel();
+    return;
+  }
+  // Deliver the cancellation from the completion queue, like a cancelled
+  // `grpc::Alarm` would. Without an alarm (e.g. in tests that simulate the
+  // completion queue) there is nothing to deliver it.
+  cancelled_timers_.push_back(timer.tag);
+  if (!UpdateTimersAlarm(lk) && !manual_timers_) cancelled_timers_.pop_back();
+}
+
+void CompletionQueueImpl::UseManualTimers() {
+  std::lock_guard<std::mutex> lk(mu_);
+  manual_timers_ = true;
+}
+
+optional<std::chrono::system_clock::time_point>
+CompletionQueueImpl::NextTimerWakeup() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (!cancelled_timers_.empty()) return Now();
+  return timers_.NextWakeup();
+}
+
+bool CompletionQueueImpl::UpdateTimersAlarm(
+    std::unique_lock<std::mutex> const&) {
+  if (shutdown_) return timers_alarm_ != nullptr;
+  if (manual_timers_) return false;
+  auto wakeup = cancelled_timers_.empty()
+                    ? timers_.NextWakeup()
+                    : optional<std::chrono::system_clock::time_point>(Now());
+  if (!wakeup) return timers_alarm_ != nullptr;
+  if (timers_alarm_) {
+    // A `grpc::Alarm` cannot be reset, cancel it to wake up earlier. The
+    // alarm is armed again, with the new deadline, in `OnTimersAlarm()`.
+    if (!timers_alarm_cancelled_ && *wakeup < timers_wakeup_) {
+      timers_alarm_cancelled_ = true;
+      timers_alarm_->Cancel();
+    }
+    return true;
+  }
+  timers_alarm_ = CreateAlarm();
+  if (!timers_alarm_) return false;
+  timers_wakeup_ = *wakeup;
+  timers_alarm_->Set(&cq_, *wakeup, TimersTag());
+  return true;
+}
+
+void CompletionQueueImpl::OnTimersAlarm() {
+  std::vector<std::shared_ptr<AsyncGrpcOperation>> expired;
+  std::vector<std::shared_ptr<AsyncGrpcOperation>> cancelled;
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    timers_alarm_.reset();
+    timers_alarm_cancelled_ = false;
+    auto extract = [this](void* tag) {
+      auto loc = pending_ops_.find(reinterpret_cast<std::intptr_t>(tag));
+      if (loc == pending_ops_.end()) {
+        return std::shared_ptr<AsyncGrpcOperation>{};
+      }
+      auto op = std::move(loc->second);
+      pending_ops_.erase(loc);
+      return op;
+    };
+    std::vector<TimingWheel::Timer*> timers;
+    timers_.Advance(Now(), timers);
+    for (auto* timer : timers) {
+      auto op = extract(timer->tag);
+      if (op) expired.push_back(std::move(op));
+    }
+    for (auto* tag : cancelled_timers_) {
+      auto op = extract(tag);
+      if (op) cancelled.push_back(std::move(op));
+    }
+    cancelled_timers_.clear();
+    UpdateTimersAlarm(lk);
+  }
+  for (auto& op : expired) op->Notify(/*ok=*/true);
+  for (auto& op : cancelled) op->Notify(/*ok=*/false);
+}
+
 std::shared_ptr<AsyncGrpcOperation> CompletionQueueImpl::FindOperation(
     void* tag) {
   std::lock_guard<std::mutex> lk(mu_);
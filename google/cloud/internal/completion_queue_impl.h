@@ -20,13 +20,17 @@
 #include "google/cloud/grpc_error_delegate.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/internal/throw_delegate.h"
+#include "google/cloud/internal/timing_wheel.h"
+#include "google/cloud/optional.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
 #include <grpcpp/alarm.h>
 #include <grpcpp/support/async_stream.h>
 #include <grpcpp/support/async_unary_call.h>
+#include <chrono>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -229,7 +233,8 @@ using AsyncCallResponseType = AsyncCallResponseTypeUnwrap<
  */
 class CompletionQueueImpl {
  public:
-  CompletionQueueImpl() : cq_(), shutdown_(false) {}
+  CompletionQueueImpl()
+      : cq_(), shutdown_(false), timers_(std::chrono::system_clock::now()) {}
   virtual ~CompletionQueueImpl() = default;
 
   /// Run the event loop until Shutdown() is called.
@@ -244,6 +249,30 @@ class CompletionQueueImpl {
   /// Create a new alarm object.
   virtual std::unique_ptr<grpc::Alarm> CreateAlarm() const;
 
+  /// The current time, simulations override this to use a virtual clock.
+  virtual std::chrono::system_clock::time_point Now() const {
+    return std::chrono::system_clock::now();
+  }
+
+  /**
+   * Atomically add a new timer operation and start it.
+   *
+   * The operation is registered like any other operation, but instead of
+   * using a `grpc::Alarm` for each timer, all the timers are kept in a timing
+   * wheel that shares a single alarm. `op` is notified with `ok == true` once
+   * @p deadline expires, or with `ok == false` if the timer is cancelled.
+   *
+   * @param op the operation to notify, it must contain @p timer.
+   * @param timer the timing wheel entry for @p op.
+   * @param deadline when should the timer expire.
+   */
+  void StartTimer(std::shared_ptr<AsyncGrpcOperation> op,
+                  TimingWheel::Timer& timer,
+                  std::chrono::system_clock::time_point deadline);
+
+  /// Cancel a timer created with `StartTimer()`.
+  void CancelTimer(TimingWheel::Timer& timer);
+
   /// The underlying gRPC completion queue.
   grpc::CompletionQueue& cq() { return cq_; }
 
@@ -272,6 +301,32 @@ class CompletionQueueImpl {
         "assertion failure: insertion should succeed");
   }
 
+  /**
+   * Start another step of an operation that is already registered.
+   *
+   * Long-lived operations, such as the reads in a streaming RPC, return
+   * `false` from `Notify()` to remain registered and then reuse the same
+   * object (and tag) for each step. This avoids allocating a new operation and
+   * updating the map of pending operations for every step.
+   *
+   * If the completion queue is shutdown the operation is notified with
+   * `ok == false` instead of starting the step.
+   */
+  template <typename Callable,
+            typename std::enable_if<
+                google::cloud::internal::is_invocable<Callable, void*>::value,
+                int>::type = 0>
+  void ContinueOperation(AsyncGrpcOperation& op, Callable&& start) {
+    void* tag = &op;
+    std::unique_lock<std::mutex> lk(mu_);
+    if (shutdown_) {
+      lk.unlock();
+      if (op.Notify(/*ok=*/false)) ForgetOperation(tag);
+      return;
+    }
+    start(tag);
+  }
+
  protected:
   /// Return the asynchronous operation associated with @p tag.
   std::shared_ptr<AsyncGrpcOperation> FindOperation(void* tag);
@@ -296,12 +351,54 @@ class CompletionQueueImpl {
     return pending_ops_.size();
   }
 
+  /**
+   * Expire the timers only when `ExpireTimers()` is called.
+   *
+   * Simulations using a virtual clock call this before creating any timers,
+   * and then call `ExpireTimers()` as their clock reaches `NextTimerWakeup()`.
+   * No `grpc::Alarm` is created for the timers.
+   */
+  void UseManualTimers();
+
+  /// The timers expire at multiples of their resolution after this time.
+  std::chrono::system_clock::time_point TimersOrigin() const {
+    return timers_.origin();
+  }
+
+  /// The next time at which `ExpireTimers()` should be called, if any.
+  optional<std::chrono::system_clock::time_point> NextTimerWakeup() const;
+
+  /// Notify all the timers that expired or were cancelled.
+  void ExpireTimers() { OnTimersAlarm(); }
+
  private:
+  /// The tag used by the alarm for the timing wheel.
+  void* TimersTag() { return &timers_; }
+
+  /// Arm (or re-arm) the alarm for the timing wheel, if needed.
+  bool UpdateTimersAlarm(std::unique_lock<std::mutex> const&);
+
+  /// Expire the timers in the timing wheel, called when its alarm fires.
+  void OnTimersAlarm();
+
   grpc::CompletionQueue cq_;
   mutable std::mutex mu_;
   bool shutdown_;  // GUARDED_BY(mu_)
   std::unordered_map<std::intptr_t, std::shared_ptr<AsyncGrpcOperation>>
       pending_ops_;  // GUARDED_BY(mu_)
+
+  TimingWheel timers_;  // GUARDED_BY(mu_)
+  // The alarm shared by all the timers, it is not null while it is pending.
+  std::unique_ptr<grpc::Alarm> timers_alarm_;             // GUARDED_BY(mu_)
+  std::chrono::system_clock::time_point timers_wakeup_;  // GUARDED_BY(mu_)
+  bool timers_alarm_cancelled_ = false;                  // GUARDED_BY(mu_)
+  bool manual_timers_ = false;                           // GUARDED_BY(mu_)
+  // Timers cancelled since the last time the alarm fired.
+  std::vector<void*> cancelled_timers_;  // GUARDED_BY(mu_)
+  // After `Shutdown()` the alarm cannot be re-armed, pending timers use an
+  // alarm each, as they cannot be multiplexed.
+  std::unordered_map<void*, std::unique_ptr<grpc::Alarm>>
+      shutdown_alarms_;  // GUARDED_BY(mu_)
 };
 
 }  // namespace internal
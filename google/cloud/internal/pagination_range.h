@@ -17,7 +17,7 @@
 
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
-#include <google/protobuf/util/message_differencer.h>
+#include <cstddef>
 #include <functional>
 #include <iterator>
 #include <string>
@@ -44,7 +44,7 @@ class PaginationIterator {
   using reference = value_type&;
   //@}
 
-  PaginationIterator() : owner_(nullptr) {}
+  PaginationIterator() : owner_(nullptr), position_(0) {}
 
   PaginationIterator& operator++() {
     *this = owner_->GetNext();
@@ -80,16 +80,10 @@ class PaginationIterator {
     if (lhs.owner_ == nullptr) {
       return true;
     }
-    // Iterators on the same stream are equal if they point to the same object.
-    if (lhs.value_.ok() && rhs.value_.ok()) {
-      return google::protobuf::util::MessageDifferencer::Equals(*lhs.value_,
-                                                                *rhs.value_);
-    }
-    // If one is an error and the other is not then they must be different,
-    // because only one iterator per range can have an error status. For the
-    // same reason, if both have an error they both are pointing to the same
-    // element.
-    return lhs.value_.ok() == rhs.value_.ok();
+    // Iterators on the same stream are equal if they point to the same
+    // position in the stream. Each call to `GetNext()` returns a new position,
+    // including the (single) error, so there is no need to compare values.
+    return lhs.position_ == rhs.position_;
   }
 
   friend bool operator!=(PaginationIterator const& lhs,
@@ -97,10 +91,11 @@ class PaginationIterator {
     return !(lhs == rhs);
   }
 
-  PaginationIterator(Range* owner, value_type value)
-      : owner_(owner), value_(std::move(value)) {}
+  PaginationIterator(Range* owner, std::size_t position, value_type value)
+      : owner_(owner), position_(position), value_(std::move(value)) {}
 
   Range* owner_;
+  std::size_t position_;
   value_type value_;
 };
 
@@ -135,7 +130,8 @@ class PaginationRange {
       : request_(std::move(request)),
         next_page_loader_(std::move(loader)),
         get_items_(std::move(get_items)),
-        on_last_page_(false) {
+        on_last_page_(false),
+        position_(0) {
     current_ = current_page_.begin();
   }
 
@@ -172,7 +168,7 @@ class PaginationRange {
         "Cannot iterating past the end of ListObjectReader");
     if (current_page_.end() == current_) {
       if (on_last_page_) {
-        return iterator(nullptr, kPastTheEndError);
+        return iterator(nullptr, 0, kPastTheEndError);
       }
       request_.set_page_token(std::move(next_page_token_));
       auto response = next_page_loader_(request_);
@@ -181,7 +177,7 @@ class PaginationRange {
         current_page_.clear();
         on_last_page_ = true;
         current_ = current_page_.begin();
-        return iterator(this, std::move(response).status());
+        return iterator(this, ++position_, std::move(response).status());
       }
       next_page_token_ = std::move(*response->mutable_next_page_token());
       current_page_ = get_items_(*std::move(response));
@@ -190,10 +186,10 @@ class PaginationRange {
         on_last_page_ = true;
       }
       if (current_page_.end() == current_) {
-        return iterator(nullptr, kPastTheEndError);
+        return iterator(nullptr, 0, kPastTheEndError);
       }
     }
-    return iterator(this, std::move(*current_++));
+    return iterator(this, ++position_, std::move(*current_++));
   }
 
  private:
@@ -204,6 +200,7 @@ class PaginationRange {
   typename std::vector<T>::iterator current_;
   std::string next_page_token_;
   bool on_last_page_;
+  std::size_t position_;
 };
 
 }  // namespace internal
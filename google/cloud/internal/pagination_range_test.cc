@@ -178,6 +178,30 @@ TEST(RangeFromPagination, IteratorCoverage) {
   EXPECT_TRUE(i1 == range.end());
 }
 
+TEST(RangeFromPagination, IteratorsWithEqualValues) {
+  MockRpc mock;
+  EXPECT_CALL(mock, Loader(_)).WillOnce(Invoke([](Request const&) {
+    Response response;
+    response.clear_next_page_token();
+    response.add_app_profiles()->set_name("p1");
+    response.add_app_profiles()->set_name("p1");
+    return response;
+  }));
+
+  TestedRange range(
+      Request{}, [&](Request const& r) { return mock.Loader(r); }, GetItems);
+  auto i0 = range.begin();
+  auto i1 = i0;
+  ++i1;
+  ASSERT_FALSE(i1 == range.end());
+  // Iterators pointing to different elements with the same value are
+  // different.
+  EXPECT_FALSE(i0 == i1);
+  EXPECT_EQ((*i0)->name(), (*i1)->name());
+  ++i1;
+  EXPECT_TRUE(i1 == range.end());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
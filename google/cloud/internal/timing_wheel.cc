@@ -0,0 +1,223 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/timing_wheel.h"
+#include <algorithm>
+#include <limits>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+int constexpr TimingWheel::kUnlinked;
+int constexpr TimingWheel::kBits;
+int constexpr TimingWheel::kSlots;
+int constexpr TimingWheel::kLevels;
+int constexpr TimingWheel::kOverflowSlot;
+int constexpr TimingWheel::kDueSlot;
+int constexpr TimingWheel::kSlotCount;
+
+namespace {
+std::int64_t constexpr kNever = (std::numeric_limits<std::int64_t>::max)();
+
+/// The index of the lowest bit set in @p bits, which must not be zero.
+int LowestBitSet(std::uint64_t bits) {
+  int n = 0;
+  while ((bits & 0xFF) == 0) {
+    bits >>= 8;
+    n += 8;
+  }
+  while ((bits & 1) == 0) {
+    bits >>= 1;
+    ++n;
+  }
+  return n;
+}
+
+/// The number of bits needed to represent @p value.
+int BitLength(std::uint64_t value) {
+  int n = 0;
+  while (value != 0) {
+    value >>= 1;
+    ++n;
+  }
+  return n;
+}
+}  // namespace
+
+TimingWheel::TimingWheel(TimePoint origin, std::chrono::microseconds resolution)
+    : origin_(origin), resolution_(resolution) {}
+
+void TimingWheel::Insert(Timer& timer, TimePoint deadline) {
+  timer.deadline_ = deadline;
+  timer.expiration_ = ToTickCeil(deadline);
+  Place(timer);
+  ++size_;
+}
+
+bool TimingWheel::Cancel(Timer& timer) {
+  if (!timer.linked()) return false;
+  Unlink(timer);
+  --size_;
+  return true;
+}
+
+void TimingWheel::Advance(TimePoint now, std::vector<Timer*>& expired) {
+  auto const target = ToTickFloor(now);
+  auto const initial = expired.size();
+  Drain(kDueSlot, expired);
+  for (auto next = NextEventTick(); next <= target; next = NextEventTick()) {
+    current_ = next;
+    // Cascade from the top, so timers moving down more than one level are
+    // examined again in the lower levels.
+    auto constexpr kTopMask = (std::int64_t{1} << (kBits * kLevels)) - 1;
+    if ((current_ & kTopMask) == 0) Cascade(kOverflowSlot);
+    for (int level = kLevels - 1; level != 0; --level) {
+      auto const mask = (std::int64_t{1} << (kBits * level)) - 1;
+      if ((current_ & mask) != 0) continue;
+      auto const digit = (current_ >> (kBits * level)) & (kSlots - 1);
+      Cascade(level * kSlots + static_cast<int>(digit));
+    }
+    Drain(static_cast<int>(current_ & (kSlots - 1)), expired);
+    Drain(kDueSlot, expired);
+  }
+  if (target > current_) current_ = target;
+  size_ -= expired.size() - initial;
+}
+
+void TimingWheel::ExtractAll(std::vector<Timer*>& timers) {
+  for (int slot = 0; slot != kSlotCount; ++slot) Drain(slot, timers);
+  size_ = 0;
+}
+
+optional<TimingWheel::TimePoint> TimingWheel::NextWakeup() const {
+  if (empty()) return {};
+  if (heads_[kDueSlot] != nullptr) return FromTick(current_);
+  return FromTick(NextEventTick());
+}
+
+std::int64_t TimingWheel::ToTickCeil(TimePoint tp) const {
+  auto const d = std::chrono::duration_cast<std::chrono::microseconds>(
+      tp - origin_);
+  auto ticks = d / resolution_;
+  if (d % resolution_ > std::chrono::microseconds(0)) ++ticks;
+  return ticks;
+}
+
+std::int64_t TimingWheel::ToTickFloor(TimePoint tp) const {
+  auto const d = std::chrono::duration_cast<std::chrono::microseconds>(
+      tp - origin_);
+  auto ticks = d / resolution_;
+  if (d % resolution_ < std::chrono::microseconds(0)) --ticks;
+  return ticks;
+}
+
+TimingWheel::TimePoint TimingWheel::FromTick(std::int64_t tick) const {
+  return origin_ + std::chrono::duration_cast<Clock::duration>(resolution_ *
+                                                               tick);
+}
+
+void TimingWheel::Place(Timer& timer) {
+  if (timer.expiration_ <= current_) {
+    Link(timer, kDueSlot);
+    return;
+  }
+  // The level is determined by the most significant group of bits where the
+  // expiration and the current tick differ. Lower levels share all the higher
+  // bits with the current tick, so they expire before the next cascade.
+  auto const diff = static_cast<std::uint64_t>(timer.expiration_ ^ current_);
+  auto const level = (BitLength(diff) - 1) / kBits;
+  if (level >= kLevels) {
+    Link(timer, kOverflowSlot);
+    return;
+  }
+  auto const digit = (timer.expiration_ >> (kBits * level)) & (kSlots - 1);
+  Link(timer, level * kSlots + static_cast<int>(digit));
+}
+
+void TimingWheel::Link(Timer& timer, int slot) {
+  auto*& head = heads_[slot];
+  timer.prev_ = nullptr;
+  timer.next_ = head;
+  if (head != nullptr) head->prev_ = &timer;
+  head = &timer;
+  timer.slot_ = slot;
+  if (slot < kOverflowSlot) {
+    occupied_[slot / kSlots] |= std::uint64_t{1} << (slot % kSlots);
+  }
+}
+
+void TimingWheel::Unlink(Timer& timer) {
+  auto const slot = timer.slot_;
+  if (timer.prev_ != nullptr) {
+    timer.prev_->next_ = timer.next_;
+  } else {
+    heads_[slot] = timer.next_;
+  }
+  if (timer.next_ != nullptr) timer.next_->prev_ = timer.prev_;
+  timer.prev_ = nullptr;
+  timer.next_ = nullptr;
+  timer.slot_ = kUnlinked;
+  if (slot < kOverflowSlot && heads_[slot] == nullptr) {
+    occupied_[slot / kSlots] &= ~(std::uint64_t{1} << (slot % kSlots));
+  }
+}
+
+void TimingWheel::Cascade(int slot) {
+  auto* timer = heads_[slot];
+  if (timer == nullptr) return;
+  heads_[slot] = nullptr;
+  if (slot < kOverflowSlot) {
+    occupied_[slot / kSlots] &= ~(std::uint64_t{1} << (slot % kSlots));
+  }
+  while (timer != nullptr) {
+    auto* next = timer->next_;
+    Place(*timer);
+    timer = next;
+  }
+}
+
+void TimingWheel::Drain(int slot, std::vector<Timer*>& out) {
+  while (heads_[slot] != nullptr) {
+    auto* timer = heads_[slot];
+    Unlink(*timer);
+    out.push_back(timer);
+  }
+}
+
+std::int64_t TimingWheel::NextEventTick() const {
+  auto result = kNever;
+  for (int level = 0; level != kLevels; ++level) {
+    auto const shift = kBits * level;
+    auto const digit = static_cast<int>((current_ >> shift) & (kSlots - 1));
+    if (digit == kSlots - 1) continue;
+    auto const pending = occupied_[level] & (~std::uint64_t{0} << (digit + 1));
+    if (pending == 0) continue;
+    auto const prefix = (current_ >> (shift + kBits)) << (shift + kBits);
+    auto const tick =
+        prefix | (static_cast<std::int64_t>(LowestBitSet(pending)) << shift);
+    result = (std::min)(result, tick);
+  }
+  if (heads_[kOverflowSlot] != nullptr) {
+    auto const shift = kBits * kLevels;
+    result = (std::min)(result, ((current_ >> shift) + 1) << shift);
+  }
+  return result;
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
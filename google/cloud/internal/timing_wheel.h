@@ -0,0 +1,143 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_TIMING_WHEEL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_TIMING_WHEEL_H
+
+#include "google/cloud/optional.h"
+#include "google/cloud/version.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * A hierarchical timing wheel.
+ *
+ * Multiplexes many timers onto a single clock source. Timers are intrusive
+ * list nodes, owned by the caller, so inserting and cancelling a timer are
+ * O(1) and never allocate. The wheel has `kLevels` levels of 64 slots each,
+ * every level covers 64 times the range of the level below. Timers are
+ * placed in the lowest level that can hold them, and move ("cascade") to
+ * lower levels as the wheel advances. Timers beyond the range of the top
+ * level are kept in an overflow list, and are re-examined each time the top
+ * level completes a rotation.
+ *
+ * With the default 1ms resolution the wheel covers about 4.6 hours before
+ * using the overflow list.
+ *
+ * This class is not thread-safe, the caller must provide any locking.
+ */
+class TimingWheel {
+ public:
+  using Clock = std::chrono::system_clock;
+  using TimePoint = Clock::time_point;
+
+  /// An intrusive timer, the wheel only keeps pointers to these objects.
+  class Timer {
+   public:
+    Timer() = default;
+    Timer(Timer const&) = delete;
+    Timer& operator=(Timer const&) = delete;
+
+    /// An opaque value for the owner of the wheel.
+    void* tag = nullptr;
+
+    /// The deadline requested in `TimingWheel::Insert()`.
+    TimePoint deadline() const { return deadline_; }
+
+    /// Returns true if the timer is in a wheel.
+    bool linked() const { return slot_ != kUnlinked; }
+
+   private:
+    friend class TimingWheel;
+    Timer* prev_ = nullptr;
+    Timer* next_ = nullptr;
+    TimePoint deadline_;
+    std::int64_t expiration_ = 0;
+    int slot_ = kUnlinked;
+  };
+
+  explicit TimingWheel(TimePoint origin, std::chrono::microseconds resolution =
+                                             std::chrono::milliseconds(1));
+
+  TimingWheel(TimingWheel const&) = delete;
+  TimingWheel& operator=(TimingWheel const&) = delete;
+
+  /// The time corresponding to the first tick of the wheel.
+  TimePoint origin() const { return origin_; }
+
+  /// Add @p timer to the wheel, it must not be linked already.
+  void Insert(Timer& timer, TimePoint deadline);
+
+  /// Remove @p timer from the wheel, returns false if it was not linked.
+  bool Cancel(Timer& timer);
+
+  /// Advance the wheel to @p now, appending the expired timers to @p expired.
+  void Advance(TimePoint now, std::vector<Timer*>& expired);
+
+  /// Remove all the timers, appending them to @p timers.
+  void ExtractAll(std::vector<Timer*>& timers);
+
+  /**
+   * The next time at which `Advance()` may need to run.
+   *
+   * Returns an unset optional if the wheel is empty. The value may be earlier
+   * than the deadline of any timer, for example, when timers need to cascade
+   * to a lower level, but it is never later.
+   */
+  optional<TimePoint> NextWakeup() const;
+
+  bool empty() const { return size_ == 0; }
+  std::size_t size() const { return size_; }
+
+ private:
+  static int constexpr kUnlinked = -1;
+  static int constexpr kBits = 6;
+  static int constexpr kSlots = 1 << kBits;
+  static int constexpr kLevels = 4;
+  static int constexpr kOverflowSlot = kLevels * kSlots;
+  static int constexpr kDueSlot = kOverflowSlot + 1;
+  static int constexpr kSlotCount = kDueSlot + 1;
+
+  std::int64_t ToTickCeil(TimePoint tp) const;
+  std::int64_t ToTickFloor(TimePoint tp) const;
+  TimePoint FromTick(std::int64_t tick) const;
+
+  void Place(Timer& timer);
+  void Link(Timer& timer, int slot);
+  void Unlink(Timer& timer);
+  void Cascade(int slot);
+  void Drain(int slot, std::vector<Timer*>& out);
+  std::int64_t NextEventTick() const;
+
+  TimePoint origin_;
+  std::chrono::microseconds resolution_;
+  std::int64_t current_ = 0;
+  std::size_t size_ = 0;
+  std::array<std::uint64_t, kLevels> occupied_{};
+  std::array<Timer*, kSlotCount> heads_{};
+};
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_TIMING_WHEEL_H
@@ -0,0 +1,201 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/timing_wheel.h"
+#include "google/cloud/internal/random.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ms = std::chrono::milliseconds;
+using Timer = TimingWheel::Timer;
+
+std::vector<void*> Tags(std::vector<Timer*> const& timers) {
+  std::vector<void*> tags;
+  for (auto* t : timers) tags.push_back(t->tag);
+  return tags;
+}
+
+TEST(TimingWheelTest, Empty) {
+  auto const origin = std::chrono::system_clock::now();
+  TimingWheel wheel(origin);
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_FALSE(wheel.NextWakeup().has_value());
+  std::vector<Timer*> expired;
+  wheel.Advance(origin + std::chrono::hours(24), expired);
+  EXPECT_THAT(expired, IsEmpty());
+}
+
+TEST(TimingWheelTest, ExpiresInOrder) {
+  auto const origin = std::chrono::system_clock::now();
+  TimingWheel wheel(origin);
+  Timer t1;
+  Timer t2;
+  Timer t3;
+  t1.tag = &t1;
+  t2.tag = &t2;
+  t3.tag = &t3;
+  wheel.Insert(t3, origin + ms(300));
+  wheel.Insert(t1, origin + ms(10));
+  wheel.Insert(t2, origin + ms(100));
+  EXPECT_EQ(3, wheel.size());
+  EXPECT_EQ(origin + ms(10), *wheel.NextWakeup());
+
+  std::vector<Timer*> expired;
+  wheel.Advance(origin + ms(9), expired);
+  EXPECT_THAT(expired, IsEmpty());
+  wheel.Advance(origin + ms(10), expired);
+  EXPECT_THAT(Tags(expired), ElementsAre(&t1));
+  EXPECT_FALSE(t1.linked());
+
+  expired.clear();
+  wheel.Advance(origin + ms(200), expired);
+  EXPECT_THAT(Tags(expired), ElementsAre(&t2));
+  EXPECT_LE(*wheel.NextWakeup(), origin + ms(300));
+
+  expired.clear();
+  wheel.Advance(origin + ms(1000), expired);
+  EXPECT_THAT(Tags(expired), ElementsAre(&t3));
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimingWheelTest, PastDeadlinesAreDue) {
+  auto const origin = std::chrono::system_clock::now();
+  TimingWheel wheel(origin);
+  Timer t;
+  t.tag = &t;
+  wheel.Insert(t, origin - ms(10));
+  EXPECT_EQ(origin, *wheel.NextWakeup());
+  std::vector<Timer*> expired;
+  wheel.Advance(origin, expired);
+  EXPECT_THAT(Tags(expired), ElementsAre(&t));
+}
+
+TEST(TimingWheelTest, Cancel) {
+  auto const origin = std::chrono::system_clock::now();
+  TimingWheel wheel(origin);
+  Timer t1;
+  Timer t2;
+  t1.tag = &t1;
+  t2.tag = &t2;
+  wheel.Insert(t1, origin + ms(5));
+  wheel.Insert(t2, origin + ms(5));
+  EXPECT_TRUE(wheel.Cancel(t1));
+  EXPECT_FALSE(wheel.Cancel(t1));
+  EXPECT_EQ(1, wheel.size());
+
+  std::vector<Timer*> expired;
+  wheel.Advance(origin + ms(5), expired);
+  EXPECT_THAT(Tags(expired), ElementsAre(&t2));
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimingWheelTest, Overflow) {
+  auto const origin = std::chrono::system_clock::now();
+  TimingWheel wheel(origin);
+  Timer t;
+  t.tag = &t;
+  auto const deadline = origin + std::chrono::hours(30);
+  wheel.Insert(t, deadline);
+
+  std::vector<Timer*> expired;
+  wheel.Advance(deadline - ms(1), expired);
+  EXPECT_THAT(expired, IsEmpty());
+  EXPECT_LE(*wheel.NextWakeup(), deadline);
+  wheel.Advance(deadline, expired);
+  EXPECT_THAT(Tags(expired), ElementsAre(&t));
+}
+
+TEST(TimingWheelTest, ExtractAll) {
+  auto const origin = std::chrono::system_clock::now();
+  TimingWheel wheel(origin);
+  Timer t1;
+  Timer t2;
+  wheel.Insert(t1, origin + ms(1));
+  wheel.Insert(t2, origin + std::chrono::hours(100));
+  std::vector<Timer*> all;
+  wheel.ExtractAll(all);
+  EXPECT_EQ(2, all.size());
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_FALSE(t1.linked());
+  EXPECT_FALSE(t2.linked());
+}
+
+/// @test Compare against a simple model with many random timers.
+TEST(TimingWheelTest, RandomTimers) {
+  auto generator = MakeDefaultPRNG();
+  auto const origin = std::chrono::system_clock::now();
+  TimingWheel wheel(origin);
+
+  auto constexpr kTimerCount = 10000;
+  std::vector<std::unique_ptr<Timer>> timers;
+  using Model = std::multimap<std::chrono::system_clock::time_point, Timer*>;
+  Model model;
+  std::uniform_int_distribution<std::int64_t> delay(0, 20000000);
+  for (int i = 0; i != kTimerCount; ++i) {
+    timers.push_back(std::unique_ptr<Timer>(new Timer));
+    auto* t = timers.back().get();
+    t->tag = t;
+    auto const deadline = origin + ms(delay(generator));
+    wheel.Insert(*t, deadline);
+    model.emplace(deadline, t);
+  }
+  // Cancel every tenth timer.
+  for (int i = 0; i < kTimerCount; i += 10) {
+    auto* t = timers[i].get();
+    auto r = model.equal_range(t->deadline());
+    model.erase(std::find_if(r.first, r.second,
+                             [t](Model::value_type const& kv) {
+                               return kv.second == t;
+                             }));
+    EXPECT_TRUE(wheel.Cancel(*t));
+  }
+
+  std::uniform_int_distribution<std::int64_t> step(1, 100000);
+  auto now = origin;
+  while (!model.empty()) {
+    auto const wakeup = wheel.NextWakeup();
+    ASSERT_TRUE(wakeup.has_value());
+    // The wakeup time is never later than the next deadline.
+    ASSERT_LE(*wakeup, model.begin()->first);
+    now += ms(step(generator));
+    std::vector<Timer*> expired;
+    wheel.Advance(now, expired);
+    std::vector<Timer*> expected;
+    while (!model.empty() && model.begin()->first <= now) {
+      expected.push_back(model.begin()->second);
+      model.erase(model.begin());
+    }
+    std::sort(expired.begin(), expired.end());
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(expected, expired);
+    ASSERT_EQ(model.size(), wheel.size());
+  }
+  EXPECT_TRUE(wheel.empty());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
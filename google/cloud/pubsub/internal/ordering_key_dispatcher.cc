@@ -0,0 +1,101 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/ordering_key_dispatcher.h"
+#include <algorithm>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+OrderingKeyDispatcher::OrderingKeyDispatcher(Executor executor,
+                                             Options options)
+    : executor_(std::move(executor)), options_(options), active_(0) {
+  options_.max_active_keys =
+      (std::max)(options_.max_active_keys, std::size_t{1});
+  options_.max_messages_per_turn =
+      (std::max)(options_.max_messages_per_turn, std::size_t{1});
+}
+
+void OrderingKeyDispatcher::Dispatch(std::string const& key,
+                                     std::function<void()> work) {
+  if (key.empty()) {
+    executor_(std::move(work));
+    return;
+  }
+  std::unique_lock<std::mutex> lk(mu_);
+  auto& queue = queues_[key];
+  queue.push_back(std::move(work));
+  // If the key already had work it is either running or waiting, and it will
+  // pick up the new work in due course.
+  if (queue.size() != 1) return;
+  waiting_.push_back(key);
+  StartWaitingKeys(std::move(lk));
+}
+
+std::size_t OrderingKeyDispatcher::active_keys() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return active_;
+}
+
+std::size_t OrderingKeyDispatcher::pending_keys() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return queues_.size();
+}
+
+void OrderingKeyDispatcher::Drain(std::string const& key) {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (std::size_t i = 0; i != options_.max_messages_per_turn; ++i) {
+    // Leave the (moved-from) work in the queue while it runs, so new work for
+    // this key does not schedule the key again.
+    auto work = std::move(queues_.find(key)->second.front());
+    lk.unlock();
+    work();
+    lk.lock();
+    auto q = queues_.find(key);
+    q->second.pop_front();
+    if (q->second.empty()) {
+      queues_.erase(q);
+      --active_;
+      StartWaitingKeys(std::move(lk));
+      return;
+    }
+  }
+  // This key has more work, yield to any other waiting keys.
+  --active_;
+  waiting_.push_back(key);
+  StartWaitingKeys(std::move(lk));
+}
+
+void OrderingKeyDispatcher::StartWaitingKeys(std::unique_lock<std::mutex> lk) {
+  std::vector<std::string> keys;
+  while (active_ < options_.max_active_keys && !waiting_.empty()) {
+    ++active_;
+    keys.push_back(std::move(waiting_.front()));
+    waiting_.pop_front();
+  }
+  lk.unlock();
+  if (keys.empty()) return;
+  auto self = shared_from_this();
+  for (auto& k : keys) {
+    executor_([self, k] { self->Drain(k); });
+  }
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,101 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ORDERING_KEY_DISPATCHER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ORDERING_KEY_DISPATCHER_H
+
+#include "google/cloud/pubsub/version.h"
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * Runs subscriber callbacks in order for each ordering key, and concurrently
+ * across keys.
+ *
+ * Messages with the same ordering key must be delivered to the application
+ * callback one at a time, in the order received. Messages with different keys
+ * have no such constraint. This class keeps a serial queue for each key with
+ * pending work, and schedules the queues on a shared executor (typically a
+ * thread pool running a `CompletionQueue`), so ordered subscriptions with many
+ * keys can use all the threads in the pool.
+ *
+ * - At most `max_active_keys` keys run at the same time, other keys with
+ *   pending work wait in a FIFO queue.
+ * - A key runs at most `max_messages_per_turn` callbacks before yielding its
+ *   slot to the next waiting key, so busy keys cannot starve the others.
+ * - Work with an empty ordering key has no ordering constraints, it is sent to
+ *   the executor immediately.
+ */
+class OrderingKeyDispatcher
+    : public std::enable_shared_from_this<OrderingKeyDispatcher> {
+ public:
+  /// Schedules a function to run in some thread.
+  using Executor = std::function<void(std::function<void()>)>;
+
+  struct Options {
+    std::size_t max_active_keys = 16;
+    std::size_t max_messages_per_turn = 8;
+  };
+
+  static std::shared_ptr<OrderingKeyDispatcher> Create(Executor executor,
+                                                       Options options) {
+    return std::shared_ptr<OrderingKeyDispatcher>(
+        new OrderingKeyDispatcher(std::move(executor), options));
+  }
+
+  /// Queue @p work to run after any work previously queued for @p key.
+  void Dispatch(std::string const& key, std::function<void()> work);
+
+  /// The number of keys currently running on the executor.
+  std::size_t active_keys() const;
+
+  /// The number of keys with running or queued work.
+  std::size_t pending_keys() const;
+
+ private:
+  OrderingKeyDispatcher(Executor executor, Options options);
+
+  /// Run up to `max_messages_per_turn` callbacks for @p key.
+  void Drain(std::string const& key);
+
+  /// Start as many waiting keys as allowed, releases @p lk.
+  void StartWaitingKeys(std::unique_lock<std::mutex> lk);
+
+  Executor executor_;
+  Options options_;
+
+  mutable std::mutex mu_;
+  /// The queued work for each key with pending work.
+  std::unordered_map<std::string, std::deque<std::function<void()>>> queues_;
+  /// Keys with pending work not currently running, in order of arrival.
+  std::deque<std::string> waiting_;
+  std::size_t active_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ORDERING_KEY_DISPATCHER_H
@@ -0,0 +1,246 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/ordering_key_dispatcher.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using ::testing::ElementsAre;
+
+/// An executor that runs the scheduled functions only when the test says so.
+class ManualExecutor {
+ public:
+  OrderingKeyDispatcher::Executor executor() {
+    return [this](std::function<void()> f) { tasks_.push_back(std::move(f)); };
+  }
+  std::size_t size() const { return tasks_.size(); }
+  void RunOne() {
+    auto f = std::move(tasks_.front());
+    tasks_.pop_front();
+    f();
+  }
+  void RunAll() {
+    while (!tasks_.empty()) RunOne();
+  }
+
+ private:
+  std::deque<std::function<void()>> tasks_;
+};
+
+OrderingKeyDispatcher::Options MakeOptions(std::size_t max_active_keys,
+                                           std::size_t max_messages_per_turn) {
+  OrderingKeyDispatcher::Options options;
+  options.max_active_keys = max_active_keys;
+  options.max_messages_per_turn = max_messages_per_turn;
+  return options;
+}
+
+TEST(OrderingKeyDispatcher, SameKeyRunsInOrder) {
+  ManualExecutor executor;
+  auto tested =
+      OrderingKeyDispatcher::Create(executor.executor(), MakeOptions(4, 8));
+  std::vector<std::string> log;
+  for (auto const* m : {"m1", "m2", "m3"}) {
+    tested->Dispatch("k", [&log, m] { log.emplace_back(m); });
+  }
+  // Only one task for the key, the messages run serially.
+  EXPECT_EQ(1, executor.size());
+  EXPECT_EQ(1, tested->active_keys());
+  EXPECT_EQ(1, tested->pending_keys());
+  executor.RunAll();
+  EXPECT_THAT(log, ElementsAre("m1", "m2", "m3"));
+  EXPECT_EQ(0, tested->active_keys());
+  EXPECT_EQ(0, tested->pending_keys());
+}
+
+TEST(OrderingKeyDispatcher, DifferentKeysRunConcurrently) {
+  ManualExecutor executor;
+  auto tested =
+      OrderingKeyDispatcher::Create(executor.executor(), MakeOptions(4, 8));
+  std::vector<std::string> log;
+  tested->Dispatch("a", [&log] { log.emplace_back("a1"); });
+  tested->Dispatch("b", [&log] { log.emplace_back("b1"); });
+  tested->Dispatch("a", [&log] { log.emplace_back("a2"); });
+  EXPECT_EQ(2, executor.size());
+  EXPECT_EQ(2, tested->active_keys());
+  executor.RunAll();
+  EXPECT_THAT(log, ElementsAre("a1", "a2", "b1"));
+}
+
+TEST(OrderingKeyDispatcher, EmptyKeyIsNotOrdered) {
+  ManualExecutor executor;
+  auto tested =
+      OrderingKeyDispatcher::Create(executor.executor(), MakeOptions(1, 8));
+  int count = 0;
+  for (int i = 0; i != 3; ++i) tested->Dispatch("", [&count] { ++count; });
+  EXPECT_EQ(3, executor.size());
+  EXPECT_EQ(0, tested->pending_keys());
+  executor.RunAll();
+  EXPECT_EQ(3, count);
+}
+
+TEST(OrderingKeyDispatcher, ActiveKeysAreBounded) {
+  ManualExecutor executor;
+  auto tested =
+      OrderingKeyDispatcher::Create(executor.executor(), MakeOptions(2, 8));
+  std::vector<std::string> log;
+  for (auto const* k : {"a", "b", "c"}) {
+    tested->Dispatch(k, [&log, k] { log.emplace_back(k); });
+  }
+  EXPECT_EQ(2, executor.size());
+  EXPECT_EQ(2, tested->active_keys());
+  EXPECT_EQ(3, tested->pending_keys());
+
+  // Finishing one key starts the waiting key.
+  executor.RunOne();
+  EXPECT_EQ(2, executor.size());
+  EXPECT_EQ(2, tested->active_keys());
+  executor.RunAll();
+  EXPECT_THAT(log, ElementsAre("a", "b", "c"));
+}
+
+TEST(OrderingKeyDispatcher, BusyKeysYield) {
+  ManualExecutor executor;
+  auto tested =
+      OrderingKeyDispatcher::Create(executor.executor(), MakeOptions(1, 2));
+  std::vector<std::string> log;
+  for (auto const* m : {"a1", "a2", "a3", "a4", "a5"}) {
+    tested->Dispatch("a", [&log, m] { log.emplace_back(m); });
+  }
+  tested->Dispatch("b", [&log] { log.emplace_back("b1"); });
+  executor.RunAll();
+  EXPECT_THAT(log, ElementsAre("a1", "a2", "b1", "a3", "a4", "a5"));
+}
+
+TEST(OrderingKeyDispatcher, WorkAddedWhileRunning) {
+  ManualExecutor executor;
+  auto tested =
+      OrderingKeyDispatcher::Create(executor.executor(), MakeOptions(4, 8));
+  std::vector<std::string> log;
+  tested->Dispatch("k", [&] {
+    log.emplace_back("m1");
+    tested->Dispatch("k", [&log] { log.emplace_back("m2"); });
+    // The key is running, it must not be scheduled again.
+    EXPECT_EQ(0, executor.size());
+  });
+  executor.RunAll();
+  EXPECT_THAT(log, ElementsAre("m1", "m2"));
+  EXPECT_EQ(0, tested->pending_keys());
+}
+
+/// A simple thread pool to verify the class works with concurrent executors.
+class ThreadPool {
+ public:
+  explicit ThreadPool(int count) {
+    for (int i = 0; i != count; ++i) {
+      threads_.emplace_back([this] { Loop(); });
+    }
+  }
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      shutdown_ = true;
+    }
+    cv_.notify_all();
+    for (auto& t : threads_) t.join();
+  }
+
+  OrderingKeyDispatcher::Executor executor() {
+    return [this](std::function<void()> f) {
+      {
+        std::lock_guard<std::mutex> lk(mu_);
+        tasks_.push_back(std::move(f));
+      }
+      cv_.notify_one();
+    };
+  }
+
+ private:
+  void Loop() {
+    std::unique_lock<std::mutex> lk(mu_);
+    for (;;) {
+      cv_.wait(lk, [this] { return shutdown_ || !tasks_.empty(); });
+      if (tasks_.empty()) return;
+      auto f = std::move(tasks_.front());
+      tasks_.pop_front();
+      lk.unlock();
+      f();
+      lk.lock();
+    }
+  }
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool shutdown_ = false;
+  std::vector<std::thread> threads_;
+};
+
+TEST(OrderingKeyDispatcher, ConcurrentExecutor) {
+  int const key_count = 32;
+  int const message_count = 200;
+  std::mutex mu;
+  std::condition_variable cv;
+  std::map<std::string, std::vector<int>> received;
+  int total = 0;
+  int running = 0;
+  int max_running = 0;
+  {
+    ThreadPool pool(8);
+    auto tested =
+        OrderingKeyDispatcher::Create(pool.executor(), MakeOptions(4, 3));
+    for (int m = 0; m != message_count; ++m) {
+      for (int k = 0; k != key_count; ++k) {
+        auto key = "key-" + std::to_string(k);
+        tested->Dispatch(key, [&, key, m] {
+          {
+            std::lock_guard<std::mutex> lk(mu);
+            max_running = (std::max)(max_running, ++running);
+          }
+          std::this_thread::yield();
+          std::lock_guard<std::mutex> lk(mu);
+          --running;
+          received[key].push_back(m);
+          if (++total == key_count * message_count) cv.notify_one();
+        });
+      }
+    }
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&] { return total == key_count * message_count; });
+  }
+  EXPECT_LE(max_running, 4);
+  ASSERT_EQ(key_count, received.size());
+  for (auto const& kv : received) {
+    std::vector<int> expected(message_count);
+    for (int i = 0; i != message_count; ++i) expected[i] = i;
+    EXPECT_EQ(expected, kv.second) << "key=" << kv.first;
+  }
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -21,6 +21,7 @@ pubsub_client_hdrs = [
     "create_subscription_builder.h",
     "create_topic_builder.h",
     "internal/build_info.h",
+    "internal/ordering_key_dispatcher.h",
     "internal/publisher_stub.h",
     "internal/subscriber_stub.h",
     "internal/user_agent_prefix.h",
@@ -36,6 +37,7 @@ pubsub_client_hdrs = [
 
 pubsub_client_srcs = [
     "connection_options.cc",
+    "internal/ordering_key_dispatcher.cc",
     "internal/publisher_stub.cc",
     "internal/subscriber_stub.cc",
     "internal/user_agent_prefix.cc",
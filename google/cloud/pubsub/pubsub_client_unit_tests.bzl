@@ -19,6 +19,7 @@
 pubsub_client_unit_tests = [
     "create_subscription_builder_test.cc",
     "create_topic_builder_test.cc",
+    "internal/ordering_key_dispatcher_test.cc",
     "internal/user_agent_prefix_test.cc",
     "subscription_test.cc",
     "topic_test.cc",
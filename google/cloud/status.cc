@@ -71,6 +71,64 @@ std::ostream& operator<<(std::ostream& os, StatusCode code) {
   return os << StatusCodeToString(code);
 }
 
+Status::Status(StatusCode status_code, std::string message) : impl_(nullptr) {
+  if (message.empty()) {
+    if (status_code == StatusCode::kOk) return;
+    auto const* shared = Shared(status_code);
+    if (shared->code == status_code) {
+      impl_ = shared;
+      return;
+    }
+  }
+  impl_ = new Impl{status_code, std::move(message), false};
+}
+
+Status& Status::operator=(Status const& rhs) {
+  if (this == &rhs) return *this;
+  auto const* tmp = Clone(rhs.impl_);
+  Release(impl_);
+  impl_ = tmp;
+  return *this;
+}
+
+Status& Status::operator=(Status&& rhs) noexcept {
+  if (this == &rhs) return *this;
+  Release(impl_);
+  impl_ = rhs.impl_;
+  rhs.impl_ = MovedFrom(impl_);
+  return *this;
+}
+
+Status::Impl const* Status::Clone(Impl const* impl) {
+  if (impl == nullptr || impl->shared) return impl;
+  return new Impl{impl->code, impl->message, false};
+}
+
+Status::Impl const* Status::Shared(StatusCode code) noexcept {
+  // One immutable payload per well-known code, intentionally leaked so they
+  // remain valid during static destruction.
+  auto constexpr kCount = static_cast<int>(StatusCode::kUnauthenticated) + 1;
+  static Impl const* const kShared = [] {
+    auto* p = new Impl[kCount];
+    for (int i = 0; i != kCount; ++i) {
+      p[i] = Impl{static_cast<StatusCode>(i), std::string{}, true};
+    }
+    return p;
+  }();
+  auto const index = static_cast<int>(code);
+  // Unexpected codes are only shared by moved-from objects, where all that
+  // matters is that they are not "ok". The constructor allocates for them.
+  if (index <= 0 || index >= kCount) {
+    return &kShared[static_cast<int>(StatusCode::kUnknown)];
+  }
+  return &kShared[index];
+}
+
+std::string const& Status::EmptyMessage() noexcept {
+  static auto const* const kEmpty = new std::string;
+  return *kEmpty;
+}
+
 RuntimeStatusError::RuntimeStatusError(Status status)
     : std::runtime_error(StatusWhat(status)), status_(std::move(status)) {}
 
@@ -17,6 +17,7 @@
 
 #include "google/cloud/version.h"
 #include <iostream>
+#include <string>
 #include <tuple>
 
 namespace google {
@@ -59,22 +60,55 @@ std::ostream& operator<<(std::ostream& os, StatusCode code);
  *
  * This class is modeled after `grpc::Status`, it contains the status code and
  * error message (if applicable) from a JSON request.
+ *
+ * A successful `Status` is a single null pointer, the code and message are
+ * stored in a separately allocated payload only on failure. Errors without a
+ * message share immutable, pre-allocated payloads and do not allocate.
  */
 class Status {
  public:
-  Status() : code_(StatusCode::kOk) {}
+  Status() noexcept : impl_(nullptr) {}
+
+  explicit Status(StatusCode status_code, std::string message);
 
-  explicit Status(StatusCode status_code, std::string message)
-      : code_(status_code), message_(std::move(message)) {}
+  Status(Status const& rhs) : impl_(Clone(rhs.impl_)) {}
+  Status(Status&& rhs) noexcept : impl_(rhs.impl_) {
+    rhs.impl_ = MovedFrom(impl_);
+  }
+  Status& operator=(Status const& rhs);
+  Status& operator=(Status&& rhs) noexcept;
+  ~Status() { Release(impl_); }
 
-  bool ok() const { return code_ == StatusCode::kOk; }
+  bool ok() const { return impl_ == nullptr || impl_->code == StatusCode::kOk; }
 
-  StatusCode code() const { return code_; }
-  std::string const& message() const { return message_; }
+  StatusCode code() const {
+    return impl_ == nullptr ? StatusCode::kOk : impl_->code;
+  }
+  std::string const& message() const {
+    return impl_ == nullptr ? EmptyMessage() : impl_->message;
+  }
 
  private:
-  StatusCode code_;
-  std::string message_;
+  struct Impl {
+    StatusCode code;
+    std::string message;
+    bool shared;
+  };
+
+  static Impl const* Clone(Impl const* impl);
+  static Impl const* Shared(StatusCode code) noexcept;
+  // Moved-from objects keep their code (but not the message), as they did
+  // when `Status` stored both inline. `StatusOr<T>` depends on this.
+  static Impl const* MovedFrom(Impl const* impl) noexcept {
+    if (impl == nullptr || impl->code == StatusCode::kOk) return nullptr;
+    return Shared(impl->code);
+  }
+  static void Release(Impl const* impl) {
+    if (impl != nullptr && !impl->shared) delete impl;
+  }
+  static std::string const& EmptyMessage() noexcept;
+
+  Impl const* impl_;
 };
 
 inline std::ostream& operator<<(std::ostream& os, Status const& rhs) {
@@ -51,6 +51,62 @@ TEST(Status, StatusCodeToString) {
             StatusCodeToString(static_cast<StatusCode>(42)));
 }
 
+TEST(Status, OkIsPointerSized) {
+  EXPECT_EQ(sizeof(void*), sizeof(Status));
+  Status status;
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ(StatusCode::kOk, status.code());
+  EXPECT_EQ("", status.message());
+}
+
+TEST(Status, CopyAndMove) {
+  Status const error(StatusCode::kNotFound, "not found");
+  Status copy = error;
+  EXPECT_EQ(error, copy);
+
+  Status moved = std::move(copy);
+  EXPECT_EQ(error, moved);
+  // Moved-from errors are still errors, `StatusOr<T>` depends on this.
+  EXPECT_FALSE(copy.ok());  // NOLINT(bugprone-use-after-move)
+
+  Status assigned;
+  assigned = moved;
+  EXPECT_EQ(error, assigned);
+  assigned = Status();
+  EXPECT_TRUE(assigned.ok());
+  assigned = std::move(moved);
+  EXPECT_EQ(error, assigned);
+  EXPECT_FALSE(moved.ok());  // NOLINT(bugprone-use-after-move)
+
+  Status const& alias = assigned;
+  assigned = alias;
+  EXPECT_EQ(error, assigned);
+}
+
+TEST(Status, NoMessage) {
+  Status a(StatusCode::kUnavailable, "");
+  Status b(StatusCode::kUnavailable, "");
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(StatusCode::kUnavailable, a.code());
+  EXPECT_EQ("", a.message());
+  EXPECT_NE(a, Status(StatusCode::kUnavailable, "try again"));
+
+  Status unexpected(static_cast<StatusCode>(42), "");
+  EXPECT_FALSE(unexpected.ok());
+  EXPECT_EQ(static_cast<StatusCode>(42), unexpected.code());
+
+  EXPECT_EQ(Status(), Status(StatusCode::kOk, ""));
+}
+
+TEST(Status, OkWithMessage) {
+  Status status(StatusCode::kOk, "fine");
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ("fine", status.message());
+  Status moved = std::move(status);
+  EXPECT_TRUE(moved.ok());
+  EXPECT_TRUE(status.ok());  // NOLINT(bugprone-use-after-move)
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
@@ -0,0 +1,63 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/bandwidth_limiter.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+using Clock = internal::TokenBucket::Clock;
+
+BandwidthLimiter::BandwidthLimiter(std::int64_t upload_bytes_per_second,
+                                   std::int64_t download_bytes_per_second)
+    : upload_(upload_bytes_per_second, Clock::now()),
+      download_(download_bytes_per_second, Clock::now()) {}
+
+std::int64_t BandwidthLimiter::upload_bytes_per_second() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return upload_.rate();
+}
+
+void BandwidthLimiter::set_upload_bytes_per_second(std::int64_t v) {
+  std::lock_guard<std::mutex> lk(mu_);
+  upload_.SetRate(v, Clock::now());
+}
+
+std::int64_t BandwidthLimiter::download_bytes_per_second() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return download_.rate();
+}
+
+void BandwidthLimiter::set_download_bytes_per_second(std::int64_t v) {
+  std::lock_guard<std::mutex> lk(mu_);
+  download_.SetRate(v, Clock::now());
+}
+
+std::chrono::microseconds BandwidthLimiter::ReserveUpload(std::size_t bytes) {
+  std::lock_guard<std::mutex> lk(mu_);
+  return upload_.Reserve(static_cast<std::int64_t>(bytes), Clock::now());
+}
+
+std::chrono::microseconds BandwidthLimiter::ReserveDownload(
+    std::size_t bytes) {
+  std::lock_guard<std::mutex> lk(mu_);
+  return download_.Reserve(static_cast<std::int64_t>(bytes), Clock::now());
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,88 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BANDWIDTH_LIMITER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BANDWIDTH_LIMITER_H
+
+#include "google/cloud/storage/internal/token_bucket.h"
+#include "google/cloud/storage/version.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * Limits the bandwidth used by uploads and downloads.
+ *
+ * Applications that run bulk transfers (e.g. `Client::UploadFile()` or
+ * `Client::DownloadToFile()`) next to latency sensitive workloads may want to
+ * cap the bandwidth used by the transfers. Configure a `BandwidthLimiter` via
+ * `ClientOptions::set_bandwidth_limiter()`; the same object can be shared by
+ * multiple `Client` objects, in which case they share the budget.
+ *
+ * The limits for uploads and downloads are independent, and they can be
+ * changed at any time, for example to throttle transfers during peak hours. A
+ * limit of 0 disables throttling in that direction.
+ *
+ * @par Example
+ * @code
+ * // Limit uploads to 50MiB/s and downloads to 100MiB/s.
+ * auto limiter = std::make_shared<gcs::BandwidthLimiter>(50 * 1024 * 1024,
+ *                                                        100 * 1024 * 1024);
+ * auto options = gcs::ClientOptions::CreateDefaultClientOptions();
+ * if (!options) throw std::runtime_error(options.status().message());
+ * gcs::Client client(options->set_bandwidth_limiter(limiter));
+ * // ... later, lift the download limit:
+ * limiter->set_download_bytes_per_second(0);
+ * @endcode
+ */
+class BandwidthLimiter {
+ public:
+  explicit BandwidthLimiter(std::int64_t upload_bytes_per_second = 0,
+                            std::int64_t download_bytes_per_second = 0);
+
+  std::int64_t upload_bytes_per_second() const;
+  void set_upload_bytes_per_second(std::int64_t v);
+
+  std::int64_t download_bytes_per_second() const;
+  void set_download_bytes_per_second(std::int64_t v);
+
+  //@{
+  /**
+   * @name Reserve bandwidth for a transfer.
+   *
+   * The library calls these functions as data is sent or received. They return
+   * how long the transfer should wait before sending (or receiving) more data.
+   * Applications do not need to call them directly.
+   */
+  std::chrono::microseconds ReserveUpload(std::size_t bytes);
+  std::chrono::microseconds ReserveDownload(std::size_t bytes);
+  //@}
+
+ private:
+  mutable std::mutex mu_;
+  internal::TokenBucket upload_;
+  internal::TokenBucket download_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BANDWIDTH_LIMITER_H
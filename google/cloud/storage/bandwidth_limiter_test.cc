@@ -0,0 +1,60 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/bandwidth_limiter.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::std::chrono::microseconds;
+
+TEST(BandwidthLimiterTest, DefaultIsUnlimited) {
+  BandwidthLimiter tested;
+  EXPECT_EQ(0, tested.upload_bytes_per_second());
+  EXPECT_EQ(0, tested.download_bytes_per_second());
+  EXPECT_EQ(microseconds(0), tested.ReserveUpload(1024 * 1024 * 1024));
+  EXPECT_EQ(microseconds(0), tested.ReserveDownload(1024 * 1024 * 1024));
+}
+
+TEST(BandwidthLimiterTest, IndependentBudgets) {
+  BandwidthLimiter tested(1024, 0);
+  EXPECT_EQ(1024, tested.upload_bytes_per_second());
+  EXPECT_EQ(0, tested.download_bytes_per_second());
+  EXPECT_EQ(microseconds(0), tested.ReserveUpload(1024));
+  EXPECT_LT(microseconds(0), tested.ReserveUpload(1024));
+  EXPECT_EQ(microseconds(0), tested.ReserveDownload(1024 * 1024));
+}
+
+TEST(BandwidthLimiterTest, ChangeLimits) {
+  BandwidthLimiter tested;
+  tested.set_upload_bytes_per_second(2048);
+  tested.set_download_bytes_per_second(4096);
+  EXPECT_EQ(2048, tested.upload_bytes_per_second());
+  EXPECT_EQ(4096, tested.download_bytes_per_second());
+  // After changing the limit the bucket starts empty, and needs to refill.
+  EXPECT_LT(microseconds(0), tested.ReserveDownload(4096));
+
+  tested.set_download_bytes_per_second(0);
+  EXPECT_EQ(microseconds(0), tested.ReserveDownload(1024 * 1024));
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,65 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_ALLOCATION_COUNTERS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_ALLOCATION_COUNTERS_H
+
+#include <cstdint>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage_benchmarks {
+/**
+ * Counters for memory allocations and copies.
+ *
+ * Programs linking this library use a replacement for the global `operator
+ * new`, which counts the allocations made by each thread, as well as the
+ * total for the process. Use the per-thread counters to attribute the
+ * allocations to specific operations in multi-threaded benchmarks.
+ *
+ * `bytes_copied` counts the copies in the upload and download paths of the
+ * storage library. It is always zero unless the library was configured with
+ * the `GOOGLE_CLOUD_CPP_STORAGE_ENABLE_COPY_ACCOUNTING` option.
+ */
+struct AllocationCounters {
+  std::uint64_t allocations;
+  std::uint64_t bytes_allocated;
+  std::uint64_t bytes_copied;
+};
+
+/// Return the current value of the counters for the whole process.
+AllocationCounters CurrentAllocationCounters();
+
+/// Return the current value of the counters for the calling thread.
+AllocationCounters CurrentThreadAllocationCounters();
+
+/// Return the difference between two snapshots of the counters.
+AllocationCounters operator-(AllocationCounters const& lhs,
+                             AllocationCounters const& rhs);
+
+/**
+ * Format @p counters as comment lines, averaged over @p operations.
+ *
+ * The benchmarks report these values as comments (starting with `#`) to keep
+ * their output easy to import as CSV.
+ */
+std::string FormatAllocationCounters(AllocationCounters const& counters,
+                                     std::uint64_t operations);
+
+}  // namespace storage_benchmarks
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_ALLOCATION_COUNTERS_H
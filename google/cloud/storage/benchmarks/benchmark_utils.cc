@@ -166,12 +166,15 @@ void SimpleTimer::Start() {
 #if GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
   (void)getrusage(rusage_who(), &start_usage_);
 #endif  // GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
+  start_counters_ = CurrentThreadAllocationCounters();
   start_ = std::chrono::steady_clock::now();
 }
 
 void SimpleTimer::Stop() {
   using namespace std::chrono;
   elapsed_time_ = duration_cast<microseconds>(steady_clock::now() - start_);
+  allocation_counters_ = CurrentThreadAllocationCounters() - start_counters_;
+  std::ostringstream os;
 
 #if GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
   auto as_usec = [](timeval const& tv) {
@@ -199,7 +202,6 @@ void SimpleTimer::Stop() {
   now.ru_nvcsw -= start_usage_.ru_nvcsw;
   now.ru_nivcsw -= start_usage_.ru_nivcsw;
 
-  std::ostringstream os;
   os << "# user time                    =" << utime.count() << " us\n"
      << "# system time                  =" << stime.count() << " us\n"
      << "# CPU fraction                 =" << cpu_fraction << "\n"
@@ -217,8 +219,9 @@ void SimpleTimer::Stop() {
      << "# signals received             =" << now.ru_nsignals << "\n"
      << "# voluntary context switches   =" << now.ru_nvcsw << "\n"
      << "# involuntary context switches =" << now.ru_nivcsw << "\n";
-  annotations_ = std::move(os).str();
 #endif  // GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
+  os << FormatAllocationCounters(allocation_counters_, 1);
+  annotations_ = std::move(os).str();
 }
 
 bool SimpleTimer::SupportPerThreadUsage() {
@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_BENCHMARK_UTILS_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_BENCHMARK_UTILS_H
 
+#include "google/cloud/storage/benchmarks/allocation_counters.h"
 #include "google/cloud/storage/client.h"
 #include "google/cloud/storage/testing/random_names.h"
 #include "google/cloud/internal/random.h"
@@ -92,6 +93,9 @@ class SimpleTimer {
    */
   std::chrono::microseconds elapsed_time() const { return elapsed_time_; }
   std::chrono::microseconds cpu_time() const { return cpu_time_; }
+  AllocationCounters const& allocation_counters() const {
+    return allocation_counters_;
+  }
   std::string const& annotations() const { return annotations_; }
   //@}
 
@@ -101,6 +105,8 @@ class SimpleTimer {
   std::chrono::steady_clock::time_point start_;
   std::chrono::microseconds elapsed_time_;
   std::chrono::microseconds cpu_time_;
+  AllocationCounters start_counters_;
+  AllocationCounters allocation_counters_;
 #if GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
   struct rusage start_usage_;
 #endif  // GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
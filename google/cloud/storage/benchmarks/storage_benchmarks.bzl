@@ -17,10 +17,12 @@
 """Automatically generated source lists for storage_benchmarks - DO NOT EDIT."""
 
 storage_benchmarks_hdrs = [
+    "allocation_counters.h",
     "benchmark_utils.h",
     "bounded_queue.h",
 ]
 
 storage_benchmarks_srcs = [
+    "allocation_counters.cc",
     "benchmark_utils.cc",
 ]
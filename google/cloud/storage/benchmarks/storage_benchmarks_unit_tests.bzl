@@ -17,6 +17,7 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 storage_benchmarks_unit_tests = [
+    "allocation_counters_test.cc",
     "benchmark_parser_test.cc",
     "benchmark_make_random_test.cc",
     "benchmark_parse_args_test.cc",
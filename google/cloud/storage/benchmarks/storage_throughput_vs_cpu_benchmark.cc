@@ -18,6 +18,8 @@
 #include "google/cloud/internal/format_time_point.h"
 #include "google/cloud/internal/getenv.h"
 #include "google/cloud/internal/random.h"
+#include <atomic>
+#include <functional>
 #include <future>
 #include <iomanip>
 #include <sstream>
@@ -109,7 +111,8 @@ struct IterationResult {
 };
 using TestResults = std::vector<IterationResult>;
 
-TestResults RunThread(Options const& options, std::string const& bucket_name);
+TestResults RunThread(Options const& options, std::string const& bucket_name,
+                      std::atomic<std::uint64_t>& operation_count);
 void PrintResults(TestResults const& results);
 
 google::cloud::StatusOr<Options> ParseArgs(int argc, char* argv[]);
@@ -179,14 +182,19 @@ int main(int argc, char* argv[]) {
   // Make this immediately visible in the console, helps with debugging.
   std::cout << std::flush;
 
+  auto const start_counters = gcs_bm::CurrentAllocationCounters();
+  std::atomic<std::uint64_t> operation_count{0};
   std::vector<std::future<TestResults>> tasks;
   for (int i = 0; i != options->thread_count; ++i) {
-    tasks.emplace_back(
-        std::async(std::launch::async, RunThread, *options, bucket_name));
+    tasks.emplace_back(std::async(std::launch::async, RunThread, *options,
+                                  bucket_name, std::ref(operation_count)));
   }
   for (auto& f : tasks) {
     PrintResults(f.get());
   }
+  std::cout << gcs_bm::FormatAllocationCounters(
+      gcs_bm::CurrentAllocationCounters() - start_counters,
+      operation_count.load());
 
   gcs_bm::DeleteAllObjects(client, bucket_name, options->thread_count);
   auto status = client.DeleteBucket(bucket_name);
@@ -242,7 +250,8 @@ void PrintResults(TestResults const& results) {
   std::cout << std::flush;
 }
 
-TestResults RunThread(Options const& options, std::string const& bucket_name) {
+TestResults RunThread(Options const& options, std::string const& bucket_name,
+                      std::atomic<std::uint64_t>& operation_count) {
   google::cloud::internal::DefaultPRNG generator =
       google::cloud::internal::MakeDefaultPRNG();
   auto contents =
@@ -312,6 +321,7 @@ TestResults RunThread(Options const& options, std::string const& bucket_name) {
         OP_UPLOAD, object_size, chunk_size, download_buffer_size, enable_crc,
         enable_md5, timer.elapsed_time(), timer.cpu_time(),
         object_metadata.status().code(), progress.GetAccumulatedProgress()});
+    ++operation_count;
 
     if (!object_metadata) {
       continue;
@@ -334,6 +344,7 @@ TestResults RunThread(Options const& options, std::string const& bucket_name) {
         OP_DOWNLOAD, object_size, chunk_size, upload_buffer_size, enable_crc,
         enable_md5, timer.elapsed_time(), timer.cpu_time(),
         reader.status().code(), progress.GetAccumulatedProgress()});
+    ++operation_count;
 
     auto status =
         client.DeleteObject(object_metadata->bucket(), object_metadata->name(),
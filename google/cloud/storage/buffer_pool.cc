@@ -0,0 +1,253 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/buffer_pool.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include <algorithm>
+#include <cerrno>
+#include <mutex>
+#include <system_error>
+#include <vector>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif  // __linux__
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+
+std::size_t constexpr BufferPool::kMinSlabSize;
+std::size_t constexpr BufferPool::kMaxSlabSize;
+std::size_t constexpr BufferPool::kDefaultMaxPooledBytes;
+
+namespace internal {
+namespace {
+// Transparent huge pages are only useful for slabs of at least this size.
+std::size_t constexpr kHugePageSize = 2 * 1024 * 1024;
+
+bool UseHugePages(bool use_huge_pages, std::size_t capacity) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  return use_huge_pages && capacity >= kHugePageSize;
+#else
+  (void)use_huge_pages;
+  (void)capacity;
+  return false;
+#endif  // __linux__ && MADV_HUGEPAGE
+}
+
+char* AllocateSlab(std::size_t capacity, bool use_huge_pages) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (UseHugePages(use_huge_pages, capacity)) {
+    void* p = mmap(nullptr, capacity, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+      google::cloud::internal::ThrowSystemError(
+          std::error_code(errno, std::generic_category()),
+          "BufferPool: cannot allocate slab with mmap()");
+    }
+    // This is only a hint, the slab is usable even if the kernel ignores it.
+    (void)madvise(p, capacity, MADV_HUGEPAGE);
+    return static_cast<char*>(p);
+  }
+#endif  // __linux__ && MADV_HUGEPAGE
+  (void)use_huge_pages;
+  return new char[capacity];
+}
+
+void FreeSlab(char* data, std::size_t capacity, bool use_huge_pages) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (UseHugePages(use_huge_pages, capacity)) {
+    (void)munmap(data, capacity);
+    return;
+  }
+#endif  // __linux__ && MADV_HUGEPAGE
+  (void)capacity;
+  (void)use_huge_pages;
+  delete[] data;
+}
+
+/// Returns the free list index for slabs of @p capacity bytes.
+std::size_t SizeClass(std::size_t capacity) {
+  std::size_t index = 0;
+  for (auto s = BufferPool::kMinSlabSize; s < capacity; s *= 2) ++index;
+  return index;
+}
+
+std::size_t SlabCapacity(std::size_t size) {
+  if (size > BufferPool::kMaxSlabSize) return size;
+  auto capacity = BufferPool::kMinSlabSize;
+  while (capacity < size) capacity *= 2;
+  return capacity;
+}
+}  // namespace
+
+class BufferPoolState {
+ public:
+  BufferPoolState(std::size_t max_pooled_bytes, bool use_huge_pages)
+      : max_pooled_bytes_(max_pooled_bytes),
+        use_huge_pages_(use_huge_pages),
+        free_lists_(SizeClass(BufferPool::kMaxSlabSize) + 1),
+        stats_{} {}
+
+  ~BufferPoolState() { Trim(); }
+
+  std::size_t max_pooled_bytes() const { return max_pooled_bytes_; }
+  bool use_huge_pages() const { return use_huge_pages_; }
+
+  BufferPoolStats stats() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return stats_;
+  }
+
+  char* Take(std::size_t capacity) {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      stats_.outstanding_bytes += capacity;
+      stats_.peak_outstanding_bytes = (std::max)(
+          stats_.peak_outstanding_bytes, stats_.outstanding_bytes);
+      if (capacity <= BufferPool::kMaxSlabSize) {
+        auto& list = free_lists_[SizeClass(capacity)];
+        if (!list.empty()) {
+          auto* data = list.back();
+          list.pop_back();
+          stats_.pooled_bytes -= capacity;
+          ++stats_.hit_count;
+          return data;
+        }
+      }
+      ++stats_.miss_count;
+    }
+    return AllocateSlab(capacity, use_huge_pages_);
+  }
+
+  void Return(char* data, std::size_t capacity) {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      stats_.outstanding_bytes -= capacity;
+      if (capacity <= BufferPool::kMaxSlabSize) {
+        if (stats_.pooled_bytes + capacity <= max_pooled_bytes_) {
+          free_lists_[SizeClass(capacity)].push_back(data);
+          stats_.pooled_bytes += capacity;
+          return;
+        }
+        ++stats_.discard_count;
+      }
+    }
+    FreeSlab(data, capacity, use_huge_pages_);
+  }
+
+  void Trim() {
+    std::vector<std::vector<char*>> lists(free_lists_.size());
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      lists.swap(free_lists_);
+      stats_.pooled_bytes = 0;
+    }
+    auto capacity = BufferPool::kMinSlabSize;
+    for (auto const& list : lists) {
+      for (auto* data : list) FreeSlab(data, capacity, use_huge_pages_);
+      capacity *= 2;
+    }
+  }
+
+ private:
+  std::size_t const max_pooled_bytes_;
+  bool const use_huge_pages_;
+  mutable std::mutex mu_;
+  std::vector<std::vector<char*>> free_lists_;
+  BufferPoolStats stats_;
+};
+
+PooledBuffer::PooledBuffer(std::size_t size)
+    : data_(size == 0 ? nullptr : new char[size]),
+      size_(size),
+      capacity_(size) {}
+
+PooledBuffer::PooledBuffer(std::shared_ptr<BufferPoolState> pool, char* data,
+                           std::size_t size, std::size_t capacity)
+    : pool_(std::move(pool)), data_(data), size_(size), capacity_(capacity) {}
+
+PooledBuffer::~PooledBuffer() { Release(); }
+
+PooledBuffer::PooledBuffer(PooledBuffer&& rhs) noexcept
+    : pool_(std::move(rhs.pool_)),
+      data_(rhs.data_),
+      size_(rhs.size_),
+      capacity_(rhs.capacity_) {
+  rhs.data_ = nullptr;
+  rhs.size_ = 0;
+  rhs.capacity_ = 0;
+}
+
+PooledBuffer& PooledBuffer::operator=(PooledBuffer&& rhs) noexcept {
+  if (this == &rhs) return *this;
+  Release();
+  pool_ = std::move(rhs.pool_);
+  data_ = rhs.data_;
+  size_ = rhs.size_;
+  capacity_ = rhs.capacity_;
+  rhs.data_ = nullptr;
+  rhs.size_ = 0;
+  rhs.capacity_ = 0;
+  return *this;
+}
+
+void PooledBuffer::Release() {
+  if (data_ != nullptr) {
+    if (pool_) {
+      pool_->Return(data_, capacity_);
+    } else {
+      delete[] data_;
+    }
+  }
+  pool_.reset();
+  data_ = nullptr;
+  size_ = 0;
+  capacity_ = 0;
+}
+
+PooledBuffer AcquireBuffer(std::shared_ptr<BufferPool> const& pool,
+                           std::size_t size) {
+  if (pool) return pool->Acquire(size);
+  return PooledBuffer(size);
+}
+
+}  // namespace internal
+
+BufferPool::BufferPool(std::size_t max_pooled_bytes, bool use_huge_pages)
+    : state_(std::make_shared<internal::BufferPoolState>(max_pooled_bytes,
+                                                         use_huge_pages)) {}
+
+std::size_t BufferPool::max_pooled_bytes() const {
+  return state_->max_pooled_bytes();
+}
+
+bool BufferPool::use_huge_pages() const { return state_->use_huge_pages(); }
+
+BufferPoolStats BufferPool::stats() const { return state_->stats(); }
+
+void BufferPool::Trim() { state_->Trim(); }
+
+internal::PooledBuffer BufferPool::Acquire(std::size_t size) {
+  if (size == 0) return internal::PooledBuffer();
+  auto capacity = internal::SlabCapacity(size);
+  auto* data = state_->Take(capacity);
+  return internal::PooledBuffer(state_, data, size, capacity);
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,153 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BUFFER_POOL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BUFFER_POOL_H
+
+#include "google/cloud/storage/version.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+class BufferPool;
+
+namespace internal {
+class BufferPoolState;
+
+/**
+ * A transfer buffer, borrowed from a `BufferPool` or allocated on its own.
+ *
+ * The buffer is returned to its pool (or released) when this object is
+ * destroyed. The contents of a newly acquired buffer are unspecified.
+ */
+class PooledBuffer {
+ public:
+  PooledBuffer() = default;
+  /// Allocate a buffer of @p size bytes that is not part of any pool.
+  explicit PooledBuffer(std::size_t size);
+  ~PooledBuffer();
+
+  PooledBuffer(PooledBuffer&& rhs) noexcept;
+  PooledBuffer& operator=(PooledBuffer&& rhs) noexcept;
+  PooledBuffer(PooledBuffer const&) = delete;
+  PooledBuffer& operator=(PooledBuffer const&) = delete;
+
+  char* data() { return data_; }
+  char const* data() const { return data_; }
+  /// The number of bytes requested when the buffer was acquired.
+  std::size_t size() const { return size_; }
+  /// The size of the underlying slab, always >= `size()`.
+  std::size_t capacity() const { return capacity_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  friend class storage::BufferPool;
+  PooledBuffer(std::shared_ptr<BufferPoolState> pool, char* data,
+               std::size_t size, std::size_t capacity);
+  void Release();
+
+  std::shared_ptr<BufferPoolState> pool_;
+  char* data_ = nullptr;
+  std::size_t size_ = 0;
+  std::size_t capacity_ = 0;
+};
+
+/// Acquire a buffer from @p pool, or allocate a standalone buffer if null.
+PooledBuffer AcquireBuffer(std::shared_ptr<BufferPool> const& pool,
+                           std::size_t size);
+}  // namespace internal
+
+/// Usage metrics for a `BufferPool`.
+struct BufferPoolStats {
+  /// The total size of the slabs currently borrowed by streams.
+  std::size_t outstanding_bytes;
+  /// The highest value of `outstanding_bytes` since the pool was created.
+  std::size_t peak_outstanding_bytes;
+  /// The total size of the idle slabs kept by the pool.
+  std::size_t pooled_bytes;
+  /// The number of requests satisfied with an idle slab.
+  std::uint64_t hit_count;
+  /// The number of requests that required a new allocation.
+  std::uint64_t miss_count;
+  /// The number of returned slabs released because the pool was full.
+  std::uint64_t discard_count;
+};
+
+/**
+ * Share transfer buffers across the upload and download streams of a client.
+ *
+ * By default each `ObjectReadStream`, `ObjectWriteStream`, and download
+ * allocates its own buffers. Applications with thousands of concurrent streams
+ * may prefer to borrow these buffers from a pool, which reduces heap
+ * fragmentation and makes the memory usage more predictable. Configure a pool
+ * via `ClientOptions::set_buffer_pool()`; the same pool can be shared by
+ * multiple `Client` objects.
+ *
+ * Buffers are allocated in size classes (powers of two between
+ * `kMinSlabSize` and `kMaxSlabSize`), larger buffers are never pooled. At
+ * most `max_pooled_bytes` of idle slabs are kept, slabs returned when the pool
+ * is full are released. On Linux the pool can ask the kernel to back large
+ * slabs with transparent huge pages, reducing page faults and TLB misses.
+ *
+ * @par Example
+ * @code
+ * // Keep up to 256MiB of idle buffers.
+ * auto pool = std::make_shared<gcs::BufferPool>(256 * 1024 * 1024);
+ * auto options = gcs::ClientOptions::CreateDefaultClientOptions();
+ * if (!options) throw std::runtime_error(options.status().message());
+ * gcs::Client client(options->set_buffer_pool(pool));
+ * // ... later, examine the pool usage:
+ * std::cout << "pool hits: " << pool->stats().hit_count << "\n";
+ * @endcode
+ */
+class BufferPool {
+ public:
+  static std::size_t constexpr kMinSlabSize = 4 * 1024;
+  static std::size_t constexpr kMaxSlabSize = 64 * 1024 * 1024;
+  static std::size_t constexpr kDefaultMaxPooledBytes = 128 * 1024 * 1024;
+
+  explicit BufferPool(std::size_t max_pooled_bytes = kDefaultMaxPooledBytes,
+                      bool use_huge_pages = false);
+
+  std::size_t max_pooled_bytes() const;
+  bool use_huge_pages() const;
+
+  /// Return the current usage metrics.
+  BufferPoolStats stats() const;
+
+  /// Release all the idle slabs.
+  void Trim();
+
+  /**
+   * Borrow a buffer of at least @p size bytes.
+   *
+   * The library calls this function to allocate stream buffers. Applications
+   * do not need to call it directly.
+   */
+  internal::PooledBuffer Acquire(std::size_t size);
+
+ private:
+  std::shared_ptr<internal::BufferPoolState> state_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BUFFER_POOL_H
@@ -0,0 +1,162 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/buffer_pool.h"
+#include <gmock/gmock.h>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using internal::PooledBuffer;
+
+TEST(BufferPoolTest, StandaloneBuffer) {
+  PooledBuffer buffer(1000);
+  ASSERT_NE(nullptr, buffer.data());
+  EXPECT_EQ(1000, buffer.size());
+  EXPECT_EQ(1000, buffer.capacity());
+  std::memset(buffer.data(), 'a', buffer.size());
+
+  PooledBuffer moved = std::move(buffer);
+  EXPECT_EQ(1000, moved.size());
+  EXPECT_TRUE(buffer.empty());  // NOLINT(bugprone-use-after-move)
+
+  auto unpooled = internal::AcquireBuffer(nullptr, 10);
+  EXPECT_EQ(10, unpooled.size());
+}
+
+TEST(BufferPoolTest, SizeClasses) {
+  BufferPool pool;
+  auto b0 = pool.Acquire(1);
+  EXPECT_EQ(1, b0.size());
+  EXPECT_EQ(BufferPool::kMinSlabSize, b0.capacity());
+  auto b1 = pool.Acquire(BufferPool::kMinSlabSize + 1);
+  EXPECT_EQ(2 * BufferPool::kMinSlabSize, b1.capacity());
+  auto b2 = pool.Acquire(256 * 1024);
+  EXPECT_EQ(256 * 1024, b2.capacity());
+
+  auto empty = pool.Acquire(0);
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(nullptr, empty.data());
+
+  auto stats = pool.stats();
+  EXPECT_EQ(BufferPool::kMinSlabSize * 3 + 256 * 1024,
+            stats.outstanding_bytes);
+  EXPECT_EQ(0, stats.pooled_bytes);
+  EXPECT_EQ(0, stats.hit_count);
+  EXPECT_EQ(3, stats.miss_count);
+}
+
+TEST(BufferPoolTest, ReusesSlabs) {
+  BufferPool pool;
+  char* data;
+  {
+    auto buffer = pool.Acquire(100 * 1024);
+    data = buffer.data();
+  }
+  auto stats = pool.stats();
+  EXPECT_EQ(0, stats.outstanding_bytes);
+  EXPECT_EQ(128 * 1024, stats.pooled_bytes);
+  EXPECT_EQ(128 * 1024, stats.peak_outstanding_bytes);
+
+  // A request in the same size class reuses the slab.
+  auto buffer = pool.Acquire(128 * 1024);
+  EXPECT_EQ(data, buffer.data());
+  stats = pool.stats();
+  EXPECT_EQ(1, stats.hit_count);
+  EXPECT_EQ(1, stats.miss_count);
+  EXPECT_EQ(0, stats.pooled_bytes);
+
+  // A request in a different size class does not.
+  auto other = pool.Acquire(64 * 1024);
+  EXPECT_NE(data, other.data());
+  EXPECT_EQ(2, pool.stats().miss_count);
+}
+
+TEST(BufferPoolTest, CapsPooledBytes) {
+  BufferPool pool(3 * BufferPool::kMinSlabSize);
+  std::vector<PooledBuffer> buffers;
+  for (int i = 0; i != 5; ++i) buffers.push_back(pool.Acquire(1));
+  EXPECT_EQ(5 * BufferPool::kMinSlabSize, pool.stats().outstanding_bytes);
+  buffers.clear();
+
+  auto stats = pool.stats();
+  EXPECT_EQ(0, stats.outstanding_bytes);
+  EXPECT_EQ(3 * BufferPool::kMinSlabSize, stats.pooled_bytes);
+  EXPECT_EQ(2, stats.discard_count);
+
+  pool.Trim();
+  EXPECT_EQ(0, pool.stats().pooled_bytes);
+}
+
+TEST(BufferPoolTest, LargeBuffersAreNotPooled) {
+  BufferPool pool(4 * BufferPool::kMaxSlabSize);
+  {
+    auto buffer = pool.Acquire(BufferPool::kMaxSlabSize + 1);
+    EXPECT_EQ(BufferPool::kMaxSlabSize + 1, buffer.capacity());
+    EXPECT_EQ(BufferPool::kMaxSlabSize + 1, pool.stats().outstanding_bytes);
+  }
+  auto stats = pool.stats();
+  EXPECT_EQ(0, stats.outstanding_bytes);
+  EXPECT_EQ(0, stats.pooled_bytes);
+  EXPECT_EQ(0, stats.discard_count);
+}
+
+TEST(BufferPoolTest, HugePages) {
+  BufferPool pool(BufferPool::kDefaultMaxPooledBytes, /*use_huge_pages=*/true);
+  EXPECT_TRUE(pool.use_huge_pages());
+  for (auto size : {std::size_t(1024), std::size_t(4 * 1024 * 1024)}) {
+    auto buffer = pool.Acquire(size);
+    ASSERT_NE(nullptr, buffer.data());
+    std::memset(buffer.data(), 'x', buffer.size());
+  }
+  EXPECT_EQ(4 * 1024 * 1024 + BufferPool::kMinSlabSize,
+            pool.stats().pooled_bytes);
+}
+
+TEST(BufferPoolTest, BuffersOutliveThePool) {
+  PooledBuffer buffer;
+  {
+    BufferPool pool;
+    buffer = pool.Acquire(1024);
+  }
+  std::memset(buffer.data(), 'x', buffer.size());
+}
+
+TEST(BufferPoolTest, Concurrent) {
+  BufferPool pool(1024 * 1024);
+  auto worker = [&pool] {
+    for (int i = 0; i != 1000; ++i) {
+      auto buffer = pool.Acquire(1024 * (1 + i % 64));
+      buffer.data()[0] = 'a';
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 0; i != 4; ++i) threads.emplace_back(worker);
+  for (auto& t : threads) t.join();
+  auto stats = pool.stats();
+  EXPECT_EQ(0, stats.outstanding_bytes);
+  EXPECT_EQ(4000, stats.hit_count + stats.miss_count);
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -15,12 +15,17 @@
 #include "google/cloud/storage/client.h"
 #include "google/cloud/storage/internal/curl_client.h"
 #include "google/cloud/storage/internal/curl_handle.h"
+#include "google/cloud/storage/internal/download_checkpoint.h"
 #include "google/cloud/storage/internal/openssl_util.h"
+#include "google/cloud/storage/internal/sha256_hash.h"
 #include "google/cloud/storage/oauth2/service_account_credentials.h"
+#include "google/cloud/internal/big_endian.h"
 #include "google/cloud/internal/filesystem.h"
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/log.h"
+#include <crc32c/crc32c.h>
 #include <openssl/md5.h>
+#include <cstdio>
 #include <fstream>
 #include <thread>
 
@@ -58,7 +63,8 @@ ObjectReadStream Client::ReadObjectImpl(
   }
   auto stream = ObjectReadStream(
       google::cloud::internal::make_unique<internal::ObjectReadStreambuf>(
-          request, *std::move(source)));
+          request, *std::move(source),
+          raw_client_->client_options().buffer_pool()));
   (void)stream.peek();
 #if !GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
   // Without exceptions the streambuf cannot report errors, so we have to
@@ -89,7 +95,8 @@ ObjectWriteStream Client::WriteObjectImpl(
       google::cloud::internal::make_unique<internal::ObjectWriteStreambuf>(
           *std::move(session),
           raw_client_->client_options().upload_buffer_size(),
-          internal::CreateHashValidator(request)));
+          internal::CreateHashValidator(request),
+          raw_client_->client_options().buffer_pool()));
 }
 
 bool Client::UseSimpleUpload(std::string const& file_name) const {
@@ -208,6 +215,10 @@ Status Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
     return Status(status.code(), std::move(msg).str());
   };
 
+  if (request.HasOption<CheckpointDownload>()) {
+    return DownloadFileCheckpointImpl(request, file_name);
+  }
+
   auto stream = ReadObjectImpl(request);
   if (!stream.status().ok()) {
     return report_error(__func__, "cannot open download source object",
@@ -222,10 +233,11 @@ Status Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
         Status(StatusCode::kInvalidArgument, "ofstream::open()"));
   }
 
-  std::string buffer;
-  buffer.resize(raw_client_->client_options().download_buffer_size(), '\0');
+  auto const& options = raw_client_->client_options();
+  auto buffer = internal::AcquireBuffer(options.buffer_pool(),
+                                        options.download_buffer_size());
   do {
-    stream.read(&buffer[0], buffer.size());
+    stream.read(buffer.data(), buffer.size());
     os.write(buffer.data(), stream.gcount());
   } while (os.good() && stream.good());
   os.close();
@@ -240,6 +252,177 @@ Status Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
   return Status();
 }
 
+Status Client::DownloadFileCheckpointImpl(
+    internal::ReadObjectRangeRequest const& request,
+    std::string const& file_name) {
+  auto report_error = [&request, file_name](char const* func, char const* what,
+                                            Status const& status) {
+    std::ostringstream msg;
+    msg << func << "(" << request << ", " << file_name << "): " << what
+        << " - status.message=" << status.message();
+    return Status(status.code(), std::move(msg).str());
+  };
+
+  auto const interval = request.GetOption<CheckpointDownload>().value();
+  if (interval <= 0 || request.RequiresRangeHeader()) {
+    return report_error(
+        __func__, "invalid options for a checkpointed download",
+        Status(StatusCode::kInvalidArgument,
+               "CheckpointDownload requires a positive interval and cannot be"
+               " combined with ReadFromOffset, ReadRange, or ReadLast"));
+  }
+
+  // The metadata pins the generation for all the (possibly resumed) reads, and
+  // provides the checksum to verify the full object.
+  internal::GetObjectMetadataRequest metadata_request(request.bucket_name(),
+                                                      request.object_name());
+  if (request.HasOption<Generation>()) {
+    metadata_request.set_option(request.GetOption<Generation>());
+  }
+  if (request.HasOption<IfGenerationMatch>()) {
+    metadata_request.set_option(request.GetOption<IfGenerationMatch>());
+  }
+  if (request.HasOption<IfGenerationNotMatch>()) {
+    metadata_request.set_option(request.GetOption<IfGenerationNotMatch>());
+  }
+  if (request.HasOption<IfMetagenerationMatch>()) {
+    metadata_request.set_option(request.GetOption<IfMetagenerationMatch>());
+  }
+  if (request.HasOption<IfMetagenerationNotMatch>()) {
+    metadata_request.set_option(request.GetOption<IfMetagenerationNotMatch>());
+  }
+  if (request.HasOption<UserProject>()) {
+    metadata_request.set_option(request.GetOption<UserProject>());
+  }
+  auto metadata = raw_client_->GetObjectMetadata(metadata_request);
+  if (!metadata) {
+    return report_error(__func__, "cannot get download source metadata",
+                        metadata.status());
+  }
+
+  // Resume from the last checkpoint only if it matches the object generation
+  // and the temporary file has all the data it claims.
+  auto const temp_name = internal::DownloadTemporaryFileName(file_name);
+  internal::DownloadCheckpoint checkpoint{request.bucket_name(),
+                                          request.object_name(),
+                                          metadata->generation(), 0, 0};
+  auto saved = internal::ReadDownloadCheckpoint(file_name);
+  if (saved && saved->bucket_name == checkpoint.bucket_name &&
+      saved->object_name == checkpoint.object_name &&
+      saved->generation == checkpoint.generation &&
+      static_cast<std::uint64_t>(saved->offset) <= metadata->size()) {
+    std::error_code ec;
+    auto const size = google::cloud::internal::file_size(temp_name, ec);
+    if (!ec && size >= static_cast<std::uintmax_t>(saved->offset)) {
+      checkpoint = *std::move(saved);
+    }
+  }
+
+  // Any data past the checkpoint is overwritten, the object (and therefore the
+  // final file) is at least as large as the data saved before.
+  std::fstream os;
+  if (checkpoint.offset == 0) {
+    os.open(temp_name, std::ios::binary | std::ios::out | std::ios::trunc);
+  } else {
+    os.open(temp_name, std::ios::binary | std::ios::in | std::ios::out);
+    os.seekp(checkpoint.offset);
+  }
+  if (!os.is_open() || !os.good()) {
+    return report_error(
+        __func__, "cannot open download temporary file",
+        Status(StatusCode::kInvalidArgument, "fstream::open()"));
+  }
+
+  auto save_checkpoint = [&] {
+    os.flush();
+    if (!os.good()) {
+      return Status(StatusCode::kUnknown, "fstream::flush()");
+    }
+    return internal::WriteDownloadCheckpoint(file_name, checkpoint);
+  };
+
+  // After a crash between the last checkpoint and the rename there is no data
+  // left to read, and GCS rejects a read starting at the end of the object.
+  if (static_cast<std::uint64_t>(checkpoint.offset) < metadata->size()) {
+    auto read_request = request;
+    read_request.set_option(Generation(checkpoint.generation));
+    if (checkpoint.offset != 0) {
+      read_request.set_option(ReadFromOffset(checkpoint.offset));
+    }
+    auto stream = ReadObjectImpl(read_request);
+    if (!stream.status().ok()) {
+      return report_error(__func__, "cannot open download source object",
+                          stream.status());
+    }
+
+    auto const& options = raw_client_->client_options();
+    auto buffer = internal::AcquireBuffer(options.buffer_pool(),
+                                          options.download_buffer_size());
+    auto last_checkpoint = checkpoint.offset;
+    do {
+      stream.read(buffer.data(), buffer.size());
+      auto const n = stream.gcount();
+      os.write(buffer.data(), n);
+      if (!os.good()) break;
+      checkpoint.crc32c =
+          crc32c::Extend(checkpoint.crc32c,
+                         reinterpret_cast<std::uint8_t const*>(buffer.data()),
+                         static_cast<std::size_t>(n));
+      checkpoint.offset += n;
+      if (checkpoint.offset - last_checkpoint < interval) continue;
+      auto status = save_checkpoint();
+      if (!status.ok()) {
+        return report_error(__func__, "cannot save download checkpoint",
+                            status);
+      }
+      last_checkpoint = checkpoint.offset;
+    } while (stream.good());
+    if (!os.good()) {
+      return report_error(__func__, "cannot write download temporary file",
+                          Status(StatusCode::kUnknown, "fstream::write()"));
+    }
+    if (!stream.status().ok()) {
+      // Save the progress so the next attempt can resume from here.
+      (void)save_checkpoint();
+      return report_error(__func__, "error reading download source object",
+                          stream.status());
+    }
+  }
+  os.close();
+  if (!os.good()) {
+    return report_error(__func__, "cannot close download temporary file",
+                        Status(StatusCode::kUnknown, "fstream::close()"));
+  }
+
+  // The data cannot be trusted if the checksum does not match, start over on
+  // the next attempt.
+  auto const computed = internal::Base64Encode(
+      google::cloud::internal::EncodeBigEndian(checkpoint.crc32c));
+  if (static_cast<std::uint64_t>(checkpoint.offset) != metadata->size() ||
+      (!metadata->crc32c().empty() && metadata->crc32c() != computed)) {
+    internal::RemoveDownloadCheckpoint(file_name);
+    std::remove(temp_name.c_str());
+    std::ostringstream msg;
+    msg << "size=" << checkpoint.offset << ", crc32c=" << computed
+        << ", expected size=" << metadata->size()
+        << ", expected crc32c=" << metadata->crc32c();
+    return report_error(__func__, "checksum mismatch in downloaded data",
+                        Status(StatusCode::kDataLoss, std::move(msg).str()));
+  }
+
+  if (std::rename(temp_name.c_str(), file_name.c_str()) != 0) {
+    // Some platforms cannot rename over an existing file.
+    std::remove(file_name.c_str());
+    if (std::rename(temp_name.c_str(), file_name.c_str()) != 0) {
+      return report_error(
+          __func__, "cannot rename download temporary file",
+          Status(StatusCode::kUnknown, "rename(" + temp_name + ")"));
+    }
+  }
+  internal::RemoveDownloadCheckpoint(file_name);
+  return Status();
+}
+
 std::string Client::SigningEmail(SigningAccount const& signing_account) {
   if (signing_account.has_value()) {
     return signing_account.value();
@@ -301,23 +484,37 @@ StatusOr<std::string> Client::SignUrlV4(internal::V4SignUrlRequest request) {
     return valid;
   }
   request.AddMissingRequiredHeaders();
-  SigningAccount const& signing_account = request.signing_account();
-  auto signing_email = SigningEmail(signing_account);
 
-  auto string_to_sign = request.StringToSign(signing_email);
-  auto signed_blob = SignBlobImpl(signing_account, string_to_sign);
-  if (!signed_blob) {
-    return signed_blob.status();
+  std::string client_id;
+  std::string signature;
+  if (request.signing_hmac_key().has_value()) {
+    // HMAC keys are signed locally, with a (cached) key derived from the
+    // secret, there is no need to use the service account credentials.
+    auto const& hmac_key = request.signing_hmac_key().value();
+    client_id = hmac_key.first;
+    auto signing_key = hmac_signing_keys_->SigningKey(
+        hmac_key.first, hmac_key.second, request.timestamp());
+    signature = internal::HexEncode(
+        internal::HmacSha256(signing_key, request.StringToSign(client_id)));
+  } else {
+    SigningAccount const& signing_account = request.signing_account();
+    client_id = SigningEmail(signing_account);
+
+    auto string_to_sign = request.StringToSign(client_id);
+    auto signed_blob = SignBlobImpl(signing_account, string_to_sign);
+    if (!signed_blob) {
+      return signed_blob.status();
+    }
+    signature = internal::HexEncode(signed_blob->signed_blob);
   }
 
-  std::string signature = internal::HexEncode(signed_blob->signed_blob);
   internal::CurlHandle curl;
   std::ostringstream os;
   os << request.HostnameWithBucket();
   for (auto& part : request.ObjectNameParts()) {
     os << '/' << curl.MakeEscapedString(part).get();
   }
-  os << "?" << request.CanonicalQueryString(signing_email)
+  os << "?" << request.CanonicalQueryString(client_id)
      << "&X-Goog-Signature=" << signature;
 
   return std::move(os).str();
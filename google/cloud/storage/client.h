@@ -30,6 +30,7 @@
 #include "google/cloud/storage/oauth2/google_credentials.h"
 #include "google/cloud/storage/object_rewriter.h"
 #include "google/cloud/storage/object_stream.h"
+#include "google/cloud/storage/request_priority.h"
 #include "google/cloud/storage/retry_policy.h"
 #include "google/cloud/storage/upload_options.h"
 #include "google/cloud/storage/version.h"
@@ -899,6 +900,39 @@ class Client {
     return raw_client_->InsertObjectMedia(request);
   }
 
+  /**
+   * Creates an object given its name and a shared, immutable buffer.
+   *
+   * This overload avoids copying the contents when the application needs to
+   * keep them after the upload. The buffer is shared, not copied, by the
+   * request and all its retry attempts.
+   *
+   * @param bucket_name the name of the bucket that will contain the object.
+   * @param object_name the name of the object to be created.
+   * @param contents the contents (media) for the new object. A null pointer
+   *     creates an empty object.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `ContentEncoding`,
+   *     `ContentType`, `Crc32cChecksumValue`, `DisableCrc32cChecksum`,
+   *     `DisableMD5Hash`, `EncryptionKey`, `IfGenerationMatch`,
+   *     `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, `KmsKeyName`, `MD5HashValue`,
+   *     `PredefinedAcl`, `Projection`, `UserProject`, and `WithObjectMetadata`.
+   *
+   * @par Idempotency
+   * This operation is only idempotent if restricted by pre-conditions, in this
+   * case, `IfGenerationMatch`.
+   */
+  template <typename... Options>
+  StatusOr<ObjectMetadata> InsertObject(
+      std::string const& bucket_name, std::string const& object_name,
+      std::shared_ptr<std::string const> contents, Options&&... options) {
+    internal::InsertObjectMediaRequest request(bucket_name, object_name,
+                                               std::move(contents));
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return raw_client_->InsertObjectMedia(request);
+  }
+
   /**
    * Copies an existing object.
    *
@@ -1184,13 +1218,16 @@ class Client {
    *   Valid types for this operation include `IfGenerationMatch`,
    *   `IfGenerationNotMatch`, `IfMetagenerationMatch`,
    *   `IfMetagenerationNotMatch`, `Generation`, `ReadFromOffset`, `ReadRange`,
-   *   and `UserProject`.
+   *   `CheckpointDownload`, and `UserProject`.
    *
    * @par Idempotency
    * This is a read-only operation and is always idempotent.
    *
    * @par Example
    * @snippet storage_object_file_transfer_samples.cc download file
+   *
+   * @par Example: resume the download after the process stops
+   * @snippet storage_object_file_transfer_samples.cc download file checkpoint
    */
   template <typename... Options>
   Status DownloadToFile(std::string const& bucket_name,
@@ -2721,9 +2758,14 @@ class Client {
    * @param options a list of optional parameters for the signed URL, this
    *     include: `SignedUrlTimestamp`, `SignedUrlDuration`, `MD5HashValue`,
    *     `ContentType`, `SigningAccount`, `SigningAccountDelegates`,
-   *     `AddExtensionHeaderOption`, `AddQueryParameterOption`, and
-   *     `AddSubResourceOption`. Note that only the last `AddSubResourceOption`
-   *     option has any effect.
+   *     `SigningHmacKey`, `AddExtensionHeaderOption`,
+   *     `AddQueryParameterOption`, and `AddSubResourceOption`. Note that only
+   *     the last `AddSubResourceOption` option has any effect.
+   *
+   * @note With the `SigningHmacKey` option the URL is signed locally using
+   *     the `GOOG4-HMAC-SHA256` algorithm. This is much cheaper than signing
+   *     with a service account key, and the derived signing keys are cached
+   *     (and shared with any copies of this `Client`).
    *
    * @par Helper Functions
    *
@@ -3070,6 +3112,10 @@ class Client {
   Status DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
                           std::string const& file_name);
 
+  Status DownloadFileCheckpointImpl(
+      internal::ReadObjectRangeRequest const& request,
+      std::string const& file_name);
+
   /// Determine the email used to sign a blob.
   std::string SigningEmail(SigningAccount const& signing_account);
 
@@ -3093,6 +3139,8 @@ class Client {
       internal::PolicyDocumentV4Request request);
 
   std::shared_ptr<internal::RawClient> raw_client_;
+  std::shared_ptr<internal::V4HmacSigningKeyCache> hmac_signing_keys_ =
+      std::make_shared<internal::V4HmacSigningKeyCache>();
 
   friend class internal::NonResumableParallelUploadState;
   friend class internal::ResumableParallelUploadState;
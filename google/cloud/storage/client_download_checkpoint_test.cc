@@ -0,0 +1,255 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/download_checkpoint.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/storage/testing/temp_file.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <crc32c/crc32c.h>
+#include <gmock/gmock.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::Return;
+using ::testing::ReturnRef;
+
+std::string const kContents = "0123456789abcdefghijklmnopqrstuvwxyz";
+std::int64_t constexpr kGeneration = 1234;
+// Each simulated read returns at most this many bytes, so the download needs
+// several reads and may checkpoint between them.
+std::size_t constexpr kReadSize = 8;
+
+std::uint32_t Crc32c(std::string const& data) {
+  return crc32c::Extend(
+      0, reinterpret_cast<std::uint8_t const*>(data.data()), data.size());
+}
+
+ObjectMetadata MakeMetadata(std::string const& contents,
+                            std::int64_t generation) {
+  internal::nl::json json{
+      {"bucket", "test-bucket"},
+      {"name", "test-object"},
+      {"generation", generation},
+      {"size", std::to_string(contents.size())},
+      {"crc32c", ComputeCrc32cChecksum(contents)},
+  };
+  return internal::ObjectMetadataParser::FromJson(json).value();
+}
+
+/// Return a source producing @p contents, failing after @p fail_after bytes.
+std::unique_ptr<internal::ObjectReadSource> MakeSource(
+    std::string contents, std::size_t fail_after = std::string::npos) {
+  auto offset = std::make_shared<std::size_t>(0);
+  std::unique_ptr<testing::MockObjectReadSource> source(
+      new testing::MockObjectReadSource);
+  EXPECT_CALL(*source, IsOpen()).WillRepeatedly([offset, contents] {
+    return *offset < contents.size();
+  });
+  EXPECT_CALL(*source, Close())
+      .WillRepeatedly(Return(internal::HttpResponse{200, {}, {}}));
+  EXPECT_CALL(*source, Read(_, _))
+      .WillRepeatedly([offset, contents, fail_after](char* buf, std::size_t n)
+                          -> StatusOr<internal::ReadSourceResult> {
+        if (*offset >= fail_after) return PermanentError();
+        auto const l = (std::min)({n, kReadSize, contents.size() - *offset});
+        std::memcpy(buf, contents.data() + *offset, l);
+        *offset += l;
+        return internal::ReadSourceResult{l,
+                                          internal::HttpResponse{200, {}, {}}};
+      });
+  return std::unique_ptr<internal::ObjectReadSource>(std::move(source));
+}
+
+std::string ReadFile(std::string const& file_name) {
+  std::ifstream is(file_name, std::ios::binary);
+  return std::string{std::istreambuf_iterator<char>{is}, {}};
+}
+
+bool FileExists(std::string const& file_name) {
+  return std::ifstream(file_name).is_open();
+}
+
+class DownloadToFileCheckpointTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    client_options.SetDownloadBufferSize(kReadSize);
+    mock = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*mock, client_options())
+        .WillRepeatedly(ReturnRef(client_options));
+    client.reset(new Client{std::shared_ptr<internal::RawClient>(mock),
+                            Client::NoDecorations{}});
+  }
+  void TearDown() override {
+    internal::RemoveDownloadCheckpoint(file.name());
+    std::remove(internal::DownloadTemporaryFileName(file.name()).c_str());
+    client.reset();
+    mock.reset();
+  }
+
+  std::shared_ptr<testing::MockClient> mock;
+  std::unique_ptr<Client> client;
+  ClientOptions client_options =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+  testing::TempFile file{""};
+};
+
+TEST_F(DownloadToFileCheckpointTest, Fresh) {
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(MakeMetadata(kContents, kGeneration)));
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillOnce([](internal::ReadObjectRangeRequest const& request) {
+        EXPECT_EQ(kGeneration, request.GetOption<Generation>().value());
+        EXPECT_FALSE(request.HasOption<ReadFromOffset>());
+        return make_status_or(MakeSource(kContents));
+      });
+
+  auto status = client->DownloadToFile("test-bucket", "test-object",
+                                       file.name(), CheckpointDownload(16));
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(kContents, ReadFile(file.name()));
+  EXPECT_FALSE(FileExists(internal::DownloadCheckpointFileName(file.name())));
+  EXPECT_FALSE(FileExists(internal::DownloadTemporaryFileName(file.name())));
+}
+
+TEST_F(DownloadToFileCheckpointTest, InterruptedThenResumed) {
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillRepeatedly(Return(MakeMetadata(kContents, kGeneration)));
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillOnce([](internal::ReadObjectRangeRequest const&) {
+        return make_status_or(MakeSource(kContents, 2 * kReadSize));
+      })
+      .WillOnce([](internal::ReadObjectRangeRequest const& request) {
+        EXPECT_EQ(kGeneration, request.GetOption<Generation>().value());
+        EXPECT_EQ(2 * kReadSize, request.GetOption<ReadFromOffset>().value());
+        return make_status_or(MakeSource(kContents.substr(2 * kReadSize)));
+      });
+
+  auto status = client->DownloadToFile("test-bucket", "test-object",
+                                       file.name(), CheckpointDownload(1));
+  EXPECT_EQ(PermanentError().code(), status.code());
+  auto checkpoint = internal::ReadDownloadCheckpoint(file.name());
+  ASSERT_STATUS_OK(checkpoint);
+  EXPECT_EQ(kGeneration, checkpoint->generation);
+  EXPECT_EQ(2 * kReadSize, checkpoint->offset);
+  EXPECT_EQ(Crc32c(kContents.substr(0, 2 * kReadSize)), checkpoint->crc32c);
+
+  status = client->DownloadToFile("test-bucket", "test-object", file.name(),
+                                  CheckpointDownload(1));
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(kContents, ReadFile(file.name()));
+  EXPECT_FALSE(FileExists(internal::DownloadCheckpointFileName(file.name())));
+}
+
+TEST_F(DownloadToFileCheckpointTest, CompleteBeforeRename) {
+  std::ofstream(internal::DownloadTemporaryFileName(file.name()),
+                std::ios::binary)
+      << kContents;
+  ASSERT_STATUS_OK(internal::WriteDownloadCheckpoint(
+      file.name(),
+      internal::DownloadCheckpoint{
+          "test-bucket", "test-object", kGeneration,
+          static_cast<std::int64_t>(kContents.size()), Crc32c(kContents)}));
+
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(MakeMetadata(kContents, kGeneration)));
+  EXPECT_CALL(*mock, ReadObject(_)).Times(0);
+
+  auto status = client->DownloadToFile("test-bucket", "test-object",
+                                       file.name(), CheckpointDownload(16));
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(kContents, ReadFile(file.name()));
+}
+
+TEST_F(DownloadToFileCheckpointTest, NewGenerationRestarts) {
+  std::ofstream(internal::DownloadTemporaryFileName(file.name()),
+                std::ios::binary)
+      << "stale data";
+  ASSERT_STATUS_OK(internal::WriteDownloadCheckpoint(
+      file.name(), internal::DownloadCheckpoint{"test-bucket", "test-object",
+                                                kGeneration - 1, 5,
+                                                Crc32c("stale")}));
+
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(MakeMetadata(kContents, kGeneration)));
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillOnce([](internal::ReadObjectRangeRequest const& request) {
+        EXPECT_EQ(kGeneration, request.GetOption<Generation>().value());
+        EXPECT_FALSE(request.HasOption<ReadFromOffset>());
+        return make_status_or(MakeSource(kContents));
+      });
+
+  auto status = client->DownloadToFile("test-bucket", "test-object",
+                                       file.name(), CheckpointDownload(16));
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(kContents, ReadFile(file.name()));
+}
+
+TEST_F(DownloadToFileCheckpointTest, ChecksumMismatch) {
+  auto metadata = MakeMetadata(kContents, kGeneration);
+  EXPECT_CALL(*mock, GetObjectMetadata(_)).WillOnce(Return(metadata));
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillOnce([](internal::ReadObjectRangeRequest const&) {
+        auto corrupted = kContents;
+        corrupted[3] = '*';
+        return make_status_or(MakeSource(corrupted));
+      });
+
+  auto status = client->DownloadToFile("test-bucket", "test-object",
+                                       file.name(), CheckpointDownload(1));
+  EXPECT_EQ(StatusCode::kDataLoss, status.code());
+  EXPECT_FALSE(FileExists(internal::DownloadCheckpointFileName(file.name())));
+  EXPECT_FALSE(FileExists(internal::DownloadTemporaryFileName(file.name())));
+}
+
+TEST_F(DownloadToFileCheckpointTest, MetadataError) {
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(PermanentError())));
+  EXPECT_CALL(*mock, ReadObject(_)).Times(0);
+
+  auto status = client->DownloadToFile("test-bucket", "test-object",
+                                       file.name(), CheckpointDownload(16));
+  EXPECT_EQ(PermanentError().code(), status.code());
+}
+
+TEST_F(DownloadToFileCheckpointTest, InvalidOptions) {
+  EXPECT_CALL(*mock, GetObjectMetadata(_)).Times(0);
+  EXPECT_CALL(*mock, ReadObject(_)).Times(0);
+
+  auto status =
+      client->DownloadToFile("test-bucket", "test-object", file.name(),
+                             CheckpointDownload(16), ReadFromOffset(10));
+  EXPECT_EQ(StatusCode::kInvalidArgument, status.code());
+  status = client->DownloadToFile("test-bucket", "test-object", file.name(),
+                                  CheckpointDownload(0));
+  EXPECT_EQ(StatusCode::kInvalidArgument, status.code());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
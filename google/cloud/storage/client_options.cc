@@ -44,6 +44,10 @@ std::size_t DefaultConnectionPoolSize() {
   return 4 * nthreads;
 }
 
+std::size_t DefaultHighPriorityConnectionPoolSize() {
+  return DefaultConnectionPoolSize() / 4;
+}
+
 // This magic number was obtained by experimentation summarized in #2657
 #ifndef GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_UPLOAD_BUFFER_SIZE
 #define GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_UPLOAD_BUFFER_SIZE (8 * 1024 * 1024)
@@ -84,6 +88,8 @@ ClientOptions::ClientOptions(std::shared_ptr<oauth2::Credentials> credentials,
       enable_http_tracing_(false),
       enable_raw_client_tracing_(false),
       connection_pool_size_(DefaultConnectionPoolSize()),
+      high_priority_connection_pool_size_(
+          DefaultHighPriorityConnectionPoolSize()),
       download_buffer_size_(
           GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_DOWNLOAD_BUFFER_SIZE),
       upload_buffer_size_(GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_UPLOAD_BUFFER_SIZE),
@@ -15,8 +15,13 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_CLIENT_OPTIONS_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_CLIENT_OPTIONS_H
 
+#include "google/cloud/storage/bandwidth_limiter.h"
+#include "google/cloud/storage/buffer_pool.h"
 #include "google/cloud/storage/oauth2/credentials.h"
 #include "google/cloud/storage/version.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <memory>
 
 namespace google {
@@ -121,6 +126,48 @@ class ClientOptions {
     return *this;
   }
 
+  /**
+   * Control what fraction of the calls are traced.
+   *
+   * When tracing is enabled the client logs the request and response for this
+   * fraction of the calls, the value is clamped to `[0.0, 1.0]`. Calls that
+   * fail, or take longer than `tracing_slow_request_threshold()`, are always
+   * logged. The default is `1.0`, that is, all the calls are traced.
+   */
+  double tracing_sample_rate() const { return tracing_sample_rate_; }
+  ClientOptions& set_tracing_sample_rate(double v) {
+    tracing_sample_rate_ = (std::max)(0.0, (std::min)(1.0, v));
+    return *this;
+  }
+
+  /**
+   * Truncate the traced requests and responses to this many bytes.
+   *
+   * Large payloads, such as `InsertObjectMedia()` requests, can dominate the
+   * cost of tracing. The default is `0`, which disables truncation.
+   */
+  std::size_t tracing_max_payload_size() const {
+    return tracing_max_payload_size_;
+  }
+  ClientOptions& set_tracing_max_payload_size(std::size_t v) {
+    tracing_max_payload_size_ = v;
+    return *this;
+  }
+
+  /**
+   * Always trace calls that take longer than this threshold.
+   *
+   * The default is `0`, which disables this feature.
+   */
+  std::chrono::milliseconds tracing_slow_request_threshold() const {
+    return tracing_slow_request_threshold_;
+  }
+  ClientOptions& set_tracing_slow_request_threshold(
+      std::chrono::milliseconds v) {
+    tracing_slow_request_threshold_ = v;
+    return *this;
+  }
+
   std::string const& project_id() const { return project_id_; }
   ClientOptions& set_project_id(std::string v) {
     project_id_ = std::move(v);
@@ -133,6 +180,23 @@ class ClientOptions {
     return *this;
   }
 
+  /**
+   * Control the number of connections reserved for high priority requests.
+   *
+   * Requests using the `RequestPriority` option with
+   * `RequestPriorityClass::kHigh` use a separate pool of connections, so they
+   * never compete with large transfers for the connections in the main pool.
+   * Setting this value to 0 disables the separate pool, and all requests share
+   * the main pool.
+   */
+  std::size_t high_priority_connection_pool_size() const {
+    return high_priority_connection_pool_size_;
+  }
+  ClientOptions& set_high_priority_connection_pool_size(std::size_t size) {
+    high_priority_connection_pool_size_ = size;
+    return *this;
+  }
+
   std::size_t download_buffer_size() const { return download_buffer_size_; }
   ClientOptions& SetDownloadBufferSize(std::size_t size);
 
@@ -214,6 +278,37 @@ class ClientOptions {
   }
   //@}
 
+  //@{
+  /**
+   * Control the bandwidth used by uploads and downloads.
+   *
+   * By default the library does not limit the bandwidth used by transfers. If
+   * set, all the uploads and downloads for this client are shaped by the
+   * limiter. The same limiter can be shared by multiple clients, and its limits
+   * can be changed while the transfers are running.
+   */
+  std::shared_ptr<BandwidthLimiter> bandwidth_limiter() const {
+    return bandwidth_limiter_;
+  }
+  ClientOptions& set_bandwidth_limiter(std::shared_ptr<BandwidthLimiter> v) {
+    bandwidth_limiter_ = std::move(v);
+    return *this;
+  }
+
+  /**
+   * Borrow the upload and download buffers from a pool.
+   *
+   * By default each stream allocates its own buffers. If set, the streams for
+   * this client borrow their buffers from the pool, and return them when the
+   * stream is closed. The same pool can be shared by multiple clients.
+   */
+  std::shared_ptr<BufferPool> buffer_pool() const { return buffer_pool_; }
+  ClientOptions& set_buffer_pool(std::shared_ptr<BufferPool> v) {
+    buffer_pool_ = std::move(v);
+    return *this;
+  }
+  //@}
+
  private:
   void SetupFromEnvironment();
 
@@ -224,8 +319,12 @@ class ClientOptions {
   std::string version_;
   bool enable_http_tracing_;
   bool enable_raw_client_tracing_;
+  double tracing_sample_rate_ = 1.0;
+  std::size_t tracing_max_payload_size_ = 0;
+  std::chrono::milliseconds tracing_slow_request_threshold_{0};
   std::string project_id_;
   std::size_t connection_pool_size_;
+  std::size_t high_priority_connection_pool_size_;
   std::size_t download_buffer_size_;
   std::size_t upload_buffer_size_;
   std::string user_agent_prefix_;
@@ -235,6 +334,8 @@ class ClientOptions {
   std::size_t maximum_socket_recv_size_ = 0;
   std::size_t maximum_socket_send_size_ = 0;
   std::chrono::seconds download_stall_timeout_;
+  std::shared_ptr<BandwidthLimiter> bandwidth_limiter_;
+  std::shared_ptr<BufferPool> buffer_pool_;
   ChannelOptions channel_options_;
 };
 }  // namespace STORAGE_CLIENT_NS
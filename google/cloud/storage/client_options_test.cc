@@ -188,6 +188,49 @@ TEST_F(ClientOptionsTest, SetMaximumDownloadStall) {
   EXPECT_EQ(60, client_options.download_stall_timeout().count());
 }
 
+TEST_F(ClientOptionsTest, SetHighPriorityConnectionPoolSize) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  client_options.set_high_priority_connection_pool_size(2);
+  EXPECT_EQ(2, client_options.high_priority_connection_pool_size());
+  client_options.set_high_priority_connection_pool_size(0);
+  EXPECT_EQ(0, client_options.high_priority_connection_pool_size());
+}
+
+TEST_F(ClientOptionsTest, SetBandwidthLimiter) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_FALSE(client_options.bandwidth_limiter());
+  auto limiter = std::make_shared<BandwidthLimiter>(1024, 2048);
+  client_options.set_bandwidth_limiter(limiter);
+  EXPECT_EQ(limiter.get(), client_options.bandwidth_limiter().get());
+}
+
+TEST_F(ClientOptionsTest, SetBufferPool) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_FALSE(client_options.buffer_pool());
+  auto pool = std::make_shared<BufferPool>(1024 * 1024);
+  client_options.set_buffer_pool(pool);
+  EXPECT_EQ(pool.get(), client_options.buffer_pool().get());
+}
+
+TEST_F(ClientOptionsTest, SetTracingSampling) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_EQ(1.0, client_options.tracing_sample_rate());
+  EXPECT_EQ(0, client_options.tracing_max_payload_size());
+  EXPECT_EQ(0, client_options.tracing_slow_request_threshold().count());
+
+  client_options.set_tracing_sample_rate(0.25)
+      .set_tracing_max_payload_size(1024)
+      .set_tracing_slow_request_threshold(std::chrono::milliseconds(500));
+  EXPECT_EQ(0.25, client_options.tracing_sample_rate());
+  EXPECT_EQ(1024, client_options.tracing_max_payload_size());
+  EXPECT_EQ(500, client_options.tracing_slow_request_threshold().count());
+
+  client_options.set_tracing_sample_rate(2.0);
+  EXPECT_EQ(1.0, client_options.tracing_sample_rate());
+  client_options.set_tracing_sample_rate(-1.0);
+  EXPECT_EQ(0.0, client_options.tracing_sample_rate());
+}
+
 }  // namespace
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -258,6 +258,38 @@ TEST_F(CreateSignedUrlTest, V4SignPut) {
   EXPECT_EQ(expected, *actual);
 }
 
+/// @test Verify that CreateV4SignedUrl() signs locally with HMAC keys.
+TEST_F(CreateSignedUrlTest, V4SignHmacKey) {
+  // The client uses anonymous credentials, and the SignBlob API must not be
+  // called, the HMAC key is all that is needed to sign the URL.
+  EXPECT_CALL(*mock, SignBlob(_)).Times(0);
+
+  std::string const date = "2019-02-01T09:00:00Z";
+  auto const valid_for = std::chrono::seconds(10);
+  auto actual = client->CreateV4SignedUrl(
+      "GET", "test-bucket", "test-object",
+      SignedUrlTimestamp(google::cloud::internal::ParseRfc3339(date)),
+      SignedUrlDuration(valid_for),
+      AddExtensionHeader("host", "storage.googleapis.com"),
+      SigningHmacKey("GOOG1EXAMPLEACCESSID", "test-secret"));
+  ASSERT_STATUS_OK(actual);
+
+  // The signature was computed using Python's `hmac` module, following the
+  // algorithm described in:
+  //   https://cloud.google.com/storage/docs/authentication/signatures
+  std::string expected =
+      "https://storage.googleapis.com/test-bucket/test-object"
+      "?X-Goog-Algorithm=GOOG4-HMAC-SHA256"
+      "&X-Goog-Credential=GOOG1EXAMPLEACCESSID"
+      "%2F20190201%2Fauto%2Fstorage%2Fgoog4_request"
+      "&X-Goog-Date=20190201T090000Z"
+      "&X-Goog-Expires=10"
+      "&X-Goog-SignedHeaders=host"
+      "&X-Goog-Signature="
+      "39155e372fa6ebc806ff97ca134c7235e0bc44930782af8f88e4a3ad91c9d322";
+  EXPECT_EQ(expected, *actual);
+}
+
 /// @test Verify that CreateV4SignedUrl() uses the SignBlob API when needed.
 TEST_F(CreateSignedUrlTest, V4SignRemote) {
   auto creds = oauth2::CreateServiceAccountCredentialsFromJsonContents(
@@ -71,6 +71,39 @@ struct ReadLast : public internal::ComplexOption<ReadLast, std::int64_t> {
   static char const* name() { return "read-last"; }
 };
 
+/**
+ * Make `Client::DownloadToFile()` resumable after the process stops.
+ *
+ * With this option the object is downloaded to a temporary file (the
+ * destination name with a `.partial` suffix), and every `interval` bytes the
+ * download saves a checkpoint (in a file with a `.checkpoint` suffix). The
+ * checkpoint contains the object generation, the number of bytes saved, and
+ * the CRC32C checksum of those bytes. If the process stops, calling
+ * `DownloadToFile()` again with this option resumes the download from the
+ * last checkpoint, as long as the object generation has not changed.
+ *
+ * Once all the data is received the CRC32C checksum of the full object is
+ * compared against the object metadata, and the temporary file is renamed to
+ * the destination.
+ *
+ * This option cannot be combined with `ReadFromOffset`, `ReadRange`, or
+ * `ReadLast`. It has no effect in `Client::ReadObject()`.
+ */
+struct CheckpointDownload
+    : public internal::ComplexOption<CheckpointDownload, std::int64_t> {
+  // 64 MiB keeps the checkpoint overhead negligible and limits the data
+  // downloaded again after a restart.
+  static std::int64_t constexpr kDefaultInterval = 64 * 1024 * 1024L;
+
+  CheckpointDownload() = default;
+  explicit CheckpointDownload(std::int64_t interval)
+      : ComplexOption(interval) {}
+  static CheckpointDownload Enabled() {
+    return CheckpointDownload(kDefaultInterval);
+  }
+  static char const* name() { return "checkpoint-download"; }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
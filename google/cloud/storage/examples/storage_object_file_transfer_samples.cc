@@ -104,6 +104,25 @@ void DownloadFile(google::cloud::storage::Client client,
   (std::move(client), argv.at(0), argv.at(1), argv.at(2));
 }
 
+void DownloadFileCheckpoint(google::cloud::storage::Client client,
+                            std::vector<std::string> const& argv) {
+  //! [download file checkpoint]
+  namespace gcs = google::cloud::storage;
+  [](gcs::Client client, std::string bucket_name, std::string object_name,
+     std::string file_name) {
+    // If this process stops before the download completes, running it again
+    // resumes the download from the last checkpoint.
+    google::cloud::Status status =
+        client.DownloadToFile(bucket_name, object_name, file_name,
+                              gcs::CheckpointDownload::Enabled());
+    if (!status.ok()) throw std::runtime_error(status.message());
+
+    std::cout << "Downloaded " << object_name << " to " << file_name << "\n";
+  }
+  //! [download file checkpoint]
+  (std::move(client), argv.at(0), argv.at(1), argv.at(2));
+}
+
 std::string MakeRandomFilename(
     google::cloud::internal::DefaultPRNG& generator) {
   auto constexpr kMaxBasenameLength = 28;
@@ -152,6 +171,9 @@ culpa qui officia deserunt mollit anim id est laborum.
   std::cout << "\nRunning the DownloadFile() example" << std::endl;
   DownloadFile(client, {bucket_name, object_name, filename_1});
 
+  std::cout << "\nRunning the DownloadFileCheckpoint() example" << std::endl;
+  DownloadFileCheckpoint(client, {bucket_name, object_name, filename_1});
+
   std::cout << "\nDeleting uploaded object" << std::endl;
   (void)client.DeleteObject(bucket_name, object_name);
 
@@ -195,6 +217,10 @@ int main(int argc, char* argv[]) {
       examples::CreateCommandEntry(
           "download-file", {"<bucket-name>", "<object-name>", "<filename>"},
           DownloadFile),
+      examples::CreateCommandEntry(
+          "download-file-checkpoint",
+          {"<bucket-name>", "<object-name>", "<filename>"},
+          DownloadFileCheckpoint),
       {"auto", RunAll},
   });
   return example.Run(argc, argv);
@@ -17,6 +17,7 @@
 #include "google/cloud/internal/big_endian.h"
 #include <crc32c/crc32c.h>
 #include <openssl/md5.h>
+#include <algorithm>
 #include <cstring>
 
 namespace google {
@@ -40,6 +41,38 @@ std::string ComputeCrc32cChecksum(std::string const& payload) {
   return internal::Base64Encode(hash);
 }
 
+namespace internal {
+HashValues ComputeHashes(std::string const& payload, bool compute_md5,
+                         bool compute_crc32c) {
+  // Small enough to stay in the L2 cache between the two hash functions.
+  std::size_t constexpr kBlockSize = 64 * 1024;
+  MD5_CTX md5;
+  MD5_Init(&md5);
+  std::uint32_t crc32c = 0;
+  for (std::size_t offset = 0; offset < payload.size(); offset += kBlockSize) {
+    auto const n = (std::min)(kBlockSize, payload.size() - offset);
+    auto const* block = payload.data() + offset;
+    if (compute_md5) MD5_Update(&md5, block, n);
+    if (compute_crc32c) {
+      crc32c = crc32c::Extend(
+          crc32c, reinterpret_cast<std::uint8_t const*>(block), n);
+    }
+  }
+
+  HashValues result;
+  if (compute_md5) {
+    std::string hash(MD5_DIGEST_LENGTH, ' ');
+    MD5_Final(reinterpret_cast<unsigned char*>(&hash[0]), &md5);
+    result.md5 = Base64Encode(hash);
+  }
+  if (compute_crc32c) {
+    result.crc32c =
+        Base64Encode(google::cloud::internal::EncodeBigEndian(crc32c));
+  }
+  return result;
+}
+}  // namespace internal
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
@@ -106,6 +106,24 @@ struct DisableCrc32cChecksum
   static char const* name() { return "disable-crc32c-checksum"; }
 };
 
+namespace internal {
+/// The MD5 hash and CRC32C checksum of a payload, in the format used by GCS.
+struct HashValues {
+  std::string md5;
+  std::string crc32c;
+};
+
+/**
+ * Compute the requested hashes of @p payload in a single pass.
+ *
+ * The payload is processed in blocks small enough to remain in the CPU cache,
+ * and each block is fed to both hash functions, so large payloads are read
+ * from memory only once. Hashes that are not requested are left empty.
+ */
+HashValues ComputeHashes(std::string const& payload, bool compute_md5,
+                         bool compute_crc32c);
+}  // namespace internal
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
@@ -53,6 +53,32 @@ TEST(ComputeCrc32cChecksumTest, Simple) {
   EXPECT_EQ("ImIEBA==", actual);
 }
 
+TEST(ComputeHashesTest, MatchesIndividualHashes) {
+  // Use a payload larger than the internal block size.
+  std::string payload;
+  for (int i = 0; i != 20000; ++i) {
+    payload += "The quick brown fox jumps over the lazy dog " +
+               std::to_string(i) + "\n";
+  }
+  auto actual = internal::ComputeHashes(payload, true, true);
+  EXPECT_EQ(ComputeMD5Hash(payload), actual.md5);
+  EXPECT_EQ(ComputeCrc32cChecksum(payload), actual.crc32c);
+
+  actual = internal::ComputeHashes(payload, false, true);
+  EXPECT_EQ("", actual.md5);
+  EXPECT_EQ(ComputeCrc32cChecksum(payload), actual.crc32c);
+
+  actual = internal::ComputeHashes(payload, true, false);
+  EXPECT_EQ(ComputeMD5Hash(payload), actual.md5);
+  EXPECT_EQ("", actual.crc32c);
+}
+
+TEST(ComputeHashesTest, Empty) {
+  auto actual = internal::ComputeHashes("", true, true);
+  EXPECT_EQ("1B2M2Y8AsgTpgAmY7PhCfg==", actual.md5);
+  EXPECT_EQ("AAAAAA==", actual.crc32c);
+}
+
 }  // namespace
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -0,0 +1,70 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_COPY_ACCOUNTING_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_COPY_ACCOUNTING_H
+
+#include "google/cloud/storage/version.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Count the bytes copied in the upload and download hot paths.
+ *
+ * This is intended for benchmarks, it is disabled by default because it adds
+ * an atomic operation to each copy. Enable it with the
+ * `GOOGLE_CLOUD_CPP_STORAGE_ENABLE_COPY_ACCOUNTING` CMake option, or with
+ * `--define=storage_enable_copy_accounting=true` in Bazel. Both define the
+ * macro for the library and for any code using it, defining it by hand for
+ * only some translation units violates the ODR.
+ */
+#ifndef GOOGLE_CLOUD_CPP_STORAGE_ENABLE_COPY_ACCOUNTING
+#define GOOGLE_CLOUD_CPP_STORAGE_ENABLE_COPY_ACCOUNTING 0
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_ENABLE_COPY_ACCOUNTING
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/// Return true if the library was compiled with copy accounting.
+constexpr bool CopyAccountingEnabled() {
+  return GOOGLE_CLOUD_CPP_STORAGE_ENABLE_COPY_ACCOUNTING != 0;
+}
+
+/// The total number of bytes copied by the instrumented code paths.
+std::atomic<std::uint64_t>& BytesCopiedCounter();
+
+/// The number of bytes copied by the instrumented code paths in this thread.
+std::uint64_t& ThreadBytesCopiedCounter();
+
+/// Record a copy of @p count bytes, a no-op unless copy accounting is enabled.
+inline void RecordBytesCopied(std::size_t count) {
+#if GOOGLE_CLOUD_CPP_STORAGE_ENABLE_COPY_ACCOUNTING
+  BytesCopiedCounter().fetch_add(count, std::memory_order_relaxed);
+  ThreadBytesCopiedCounter() += count;
+#else
+  (void)count;
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_ENABLE_COPY_ACCOUNTING
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_COPY_ACCOUNTING_H
@@ -32,13 +32,18 @@ namespace internal {
 namespace {
 
 std::shared_ptr<CurlHandleFactory> CreateHandleFactory(
-    ClientOptions const& options) {
-  if (options.connection_pool_size() == 0) {
+    ClientOptions const& options, std::size_t pool_size) {
+  if (pool_size == 0) {
     return std::make_shared<DefaultCurlHandleFactory>(
         options.channel_options());
   }
-  return std::make_shared<PooledCurlHandleFactory>(
-      options.connection_pool_size(), options.channel_options());
+  return std::make_shared<PooledCurlHandleFactory>(pool_size,
+                                                   options.channel_options());
+}
+
+std::shared_ptr<CurlHandleFactory> CreateHandleFactory(
+    ClientOptions const& options) {
+  return CreateHandleFactory(options, options.connection_pool_size());
 }
 
 std::string UrlEscapeString(std::string const& value) {
@@ -100,6 +105,8 @@ Status CurlClient::SetupBuilderCommon(CurlRequestBuilder& builder,
   }
   builder.SetMethod(method)
       .ApplyClientOptions(options_)
+      .SetLoggingEnabled(options_.enable_http_tracing() &&
+                         http_sampler_.Sample())
       .AddHeader(auth_header.value())
       .AddHeader("x-goog-api-client: " + x_goog_api_client());
   return Status();
@@ -142,7 +149,8 @@ CurlClient::CreateResumableSessionGeneric(RequestType const& request) {
   }
 
   CurlRequestBuilder builder(
-      upload_endpoint_ + "/b/" + request.bucket_name() + "/o", upload_factory_);
+      upload_endpoint_ + "/b/" + request.bucket_name() + "/o",
+      SelectFactory(request, upload_factory_));
   auto status = SetupBuilderCommon(builder, "POST");
   if (!status.ok()) {
     return status;
@@ -229,10 +237,19 @@ CurlClient::CreateResumableSessionGeneric(RequestType const& request) {
 CurlClient::CurlClient(ClientOptions options)
     : options_(std::move(options)),
       generator_(google::cloud::internal::MakeDefaultPRNG()),
+      http_sampler_(options_),
       storage_factory_(CreateHandleFactory(options_)),
       upload_factory_(CreateHandleFactory(options_)),
       xml_upload_factory_(CreateHandleFactory(options_)),
       xml_download_factory_(CreateHandleFactory(options_)) {
+  if (options_.high_priority_connection_pool_size() != 0) {
+    // If the application disabled connection pooling, the high priority
+    // requests do not pool connections either.
+    high_priority_factory_ = CreateHandleFactory(
+        options_, options_.connection_pool_size() == 0
+                      ? 0
+                      : options_.high_priority_connection_pool_size());
+  }
   storage_endpoint_ = options_.endpoint() + "/storage/" + options_.version();
   upload_endpoint_ =
       options_.endpoint() + "/upload/storage/" + options_.version();
@@ -254,7 +271,8 @@ CurlClient::CurlClient(ClientOptions options)
 
 StatusOr<ResumableUploadResponse> CurlClient::UploadChunk(
     UploadChunkRequest const& request) {
-  CurlRequestBuilder builder(request.upload_session_url(), upload_factory_);
+  CurlRequestBuilder builder(request.upload_session_url(),
+                             SelectFactory(request, upload_factory_));
   auto status = SetupBuilder(builder, request, "PUT");
   if (!status.ok()) {
     return status;
@@ -276,7 +294,8 @@ StatusOr<ResumableUploadResponse> CurlClient::UploadChunk(
 
 StatusOr<ResumableUploadResponse> CurlClient::QueryResumableUpload(
     QueryResumableUploadRequest const& request) {
-  CurlRequestBuilder builder(request.upload_session_url(), upload_factory_);
+  CurlRequestBuilder builder(request.upload_session_url(),
+                             SelectFactory(request, upload_factory_));
   auto status = SetupBuilder(builder, request, "PUT");
   if (!status.ok()) {
     return status;
@@ -297,7 +316,8 @@ StatusOr<ResumableUploadResponse> CurlClient::QueryResumableUpload(
 
 StatusOr<ListBucketsResponse> CurlClient::ListBuckets(
     ListBucketsRequest const& request) {
-  CurlRequestBuilder builder(storage_endpoint_ + "/b", storage_factory_);
+  CurlRequestBuilder builder(storage_endpoint_ + "/b",
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -310,7 +330,8 @@ StatusOr<ListBucketsResponse> CurlClient::ListBuckets(
 StatusOr<BucketMetadata> CurlClient::CreateBucket(
     CreateBucketRequest const& request) {
   // Assume the bucket name is validated by the caller.
-  CurlRequestBuilder builder(storage_endpoint_ + "/b", storage_factory_);
+  CurlRequestBuilder builder(storage_endpoint_ + "/b",
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "POST");
   if (!status.ok()) {
     return status;
@@ -325,7 +346,7 @@ StatusOr<BucketMetadata> CurlClient::GetBucketMetadata(
     GetBucketMetadataRequest const& request) {
   // Assume the bucket name is validated by the caller.
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name(),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -338,7 +359,7 @@ StatusOr<EmptyResponse> CurlClient::DeleteBucket(
     DeleteBucketRequest const& request) {
   // Assume the bucket name is validated by the caller.
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name(),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "DELETE");
   if (!status.ok()) {
     return status;
@@ -350,7 +371,8 @@ StatusOr<BucketMetadata> CurlClient::UpdateBucket(
     UpdateBucketRequest const& request) {
   // Assume the bucket name is validated by the caller.
   CurlRequestBuilder builder(
-      storage_endpoint_ + "/b/" + request.metadata().name(), storage_factory_);
+      storage_endpoint_ + "/b/" + request.metadata().name(),
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "PUT");
   if (!status.ok()) {
     return status;
@@ -364,7 +386,7 @@ StatusOr<BucketMetadata> CurlClient::PatchBucket(
     PatchBucketRequest const& request) {
   // Assume the bucket name is validated by the caller.
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket(),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "PATCH");
   if (!status.ok()) {
     return status;
@@ -378,7 +400,7 @@ StatusOr<IamPolicy> CurlClient::GetBucketIamPolicy(
     GetBucketIamPolicyRequest const& request) {
   CurlRequestBuilder builder(
       storage_endpoint_ + "/b/" + request.bucket_name() + "/iam",
-      storage_factory_);
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -397,7 +419,7 @@ StatusOr<NativeIamPolicy> CurlClient::GetNativeBucketIamPolicy(
     GetBucketIamPolicyRequest const& request) {
   CurlRequestBuilder builder(
       storage_endpoint_ + "/b/" + request.bucket_name() + "/iam",
-      storage_factory_);
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -416,7 +438,7 @@ StatusOr<IamPolicy> CurlClient::SetBucketIamPolicy(
     SetBucketIamPolicyRequest const& request) {
   CurlRequestBuilder builder(
       storage_endpoint_ + "/b/" + request.bucket_name() + "/iam",
-      storage_factory_);
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "PUT");
   if (!status.ok()) {
     return status;
@@ -436,7 +458,7 @@ StatusOr<NativeIamPolicy> CurlClient::SetNativeBucketIamPolicy(
     SetNativeBucketIamPolicyRequest const& request) {
   CurlRequestBuilder builder(
       storage_endpoint_ + "/b/" + request.bucket_name() + "/iam",
-      storage_factory_);
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "PUT");
   if (!status.ok()) {
     return status;
@@ -456,7 +478,7 @@ StatusOr<TestBucketIamPermissionsResponse> CurlClient::TestBucketIamPermissions(
     TestBucketIamPermissionsRequest const& request) {
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/iam/testPermissions",
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -478,7 +500,7 @@ StatusOr<BucketMetadata> CurlClient::LockBucketRetentionPolicy(
     LockBucketRetentionPolicyRequest const& request) {
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/lockRetentionPolicy",
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "POST");
   if (!status.ok()) {
     return status;
@@ -524,7 +546,7 @@ StatusOr<ObjectMetadata> CurlClient::CopyObject(
           UrlEscapeString(request.source_object()) + "/copyTo/b/" +
           request.destination_bucket() + "/o/" +
           UrlEscapeString(request.destination_object()),
-      storage_factory_);
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "POST");
   if (!status.ok()) {
     return status;
@@ -544,7 +566,7 @@ StatusOr<ObjectMetadata> CurlClient::GetObjectMetadata(
     GetObjectMetadataRequest const& request) {
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/o/" + UrlEscapeString(request.object_name()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -563,7 +585,7 @@ StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObject(
   // Assume the bucket name is validated by the caller.
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/o/" + UrlEscapeString(request.object_name()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -585,7 +607,7 @@ StatusOr<ListObjectsResponse> CurlClient::ListObjects(
   // Assume the bucket name is validated by the caller.
   CurlRequestBuilder builder(
       storage_endpoint_ + "/b/" + request.bucket_name() + "/o",
-      storage_factory_);
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -600,7 +622,7 @@ StatusOr<EmptyResponse> CurlClient::DeleteObject(
   // Assume the bucket name is validated by the caller.
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/o/" + UrlEscapeString(request.object_name()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "DELETE");
   if (!status.ok()) {
     return status;
@@ -612,7 +634,7 @@ StatusOr<ObjectMetadata> CurlClient::UpdateObject(
     UpdateObjectRequest const& request) {
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/o/" + UrlEscapeString(request.object_name()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "PUT");
   if (!status.ok()) {
     return status;
@@ -626,7 +648,7 @@ StatusOr<ObjectMetadata> CurlClient::PatchObject(
     PatchObjectRequest const& request) {
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/o/" + UrlEscapeString(request.object_name()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "PATCH");
   if (!status.ok()) {
     return status;
@@ -641,7 +663,7 @@ StatusOr<ObjectMetadata> CurlClient::ComposeObject(
   CurlRequestBuilder builder(
       storage_endpoint_ + "/b/" + request.bucket_name() + "/o/" +
           UrlEscapeString(request.object_name()) + "/compose",
-      storage_factory_);
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "POST");
   if (!status.ok()) {
     return status;
@@ -658,7 +680,7 @@ StatusOr<RewriteObjectResponse> CurlClient::RewriteObject(
           UrlEscapeString(request.source_object()) + "/rewriteTo/b/" +
           request.destination_bucket() + "/o/" +
           UrlEscapeString(request.destination_object()),
-      storage_factory_);
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "POST");
   if (!status.ok()) {
     return status;
@@ -706,7 +728,7 @@ StatusOr<ListBucketAclResponse> CurlClient::ListBucketAcl(
     ListBucketAclRequest const& request) {
   CurlRequestBuilder builder(
       storage_endpoint_ + "/b/" + request.bucket_name() + "/acl",
-      storage_factory_);
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -725,7 +747,7 @@ StatusOr<BucketAccessControl> CurlClient::GetBucketAcl(
     GetBucketAclRequest const& request) {
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/acl/" + UrlEscapeString(request.entity()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -738,7 +760,7 @@ StatusOr<BucketAccessControl> CurlClient::CreateBucketAcl(
     CreateBucketAclRequest const& request) {
   CurlRequestBuilder builder(
       storage_endpoint_ + "/b/" + request.bucket_name() + "/acl",
-      storage_factory_);
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "POST");
   if (!status.ok()) {
     return status;
@@ -755,7 +777,7 @@ StatusOr<EmptyResponse> CurlClient::DeleteBucketAcl(
     DeleteBucketAclRequest const& request) {
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/acl/" + UrlEscapeString(request.entity()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "DELETE");
   if (!status.ok()) {
     return status;
@@ -767,7 +789,7 @@ StatusOr<BucketAccessControl> CurlClient::UpdateBucketAcl(
     UpdateBucketAclRequest const& request) {
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/acl/" + UrlEscapeString(request.entity()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "PUT");
   if (!status.ok()) {
     return status;
@@ -784,7 +806,7 @@ StatusOr<BucketAccessControl> CurlClient::PatchBucketAcl(
     PatchBucketAclRequest const& request) {
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/acl/" + UrlEscapeString(request.entity()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "PATCH");
   if (!status.ok()) {
     return status;
@@ -800,7 +822,7 @@ StatusOr<ListObjectAclResponse> CurlClient::ListObjectAcl(
   CurlRequestBuilder builder(
       storage_endpoint_ + "/b/" + request.bucket_name() + "/o/" +
           UrlEscapeString(request.object_name()) + "/acl",
-      storage_factory_);
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -814,7 +836,7 @@ StatusOr<ObjectAccessControl> CurlClient::CreateObjectAcl(
   CurlRequestBuilder builder(
       storage_endpoint_ + "/b/" + request.bucket_name() + "/o/" +
           UrlEscapeString(request.object_name()) + "/acl",
-      storage_factory_);
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "POST");
   if (!status.ok()) {
     return status;
@@ -833,7 +855,7 @@ StatusOr<EmptyResponse> CurlClient::DeleteObjectAcl(
                                  "/o/" +
                                  UrlEscapeString(request.object_name()) +
                                  "/acl/" + UrlEscapeString(request.entity()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "DELETE");
   if (!status.ok()) {
     return status;
@@ -847,7 +869,7 @@ StatusOr<ObjectAccessControl> CurlClient::GetObjectAcl(
                                  "/o/" +
                                  UrlEscapeString(request.object_name()) +
                                  "/acl/" + UrlEscapeString(request.entity()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -862,7 +884,7 @@ StatusOr<ObjectAccessControl> CurlClient::UpdateObjectAcl(
                                  "/o/" +
                                  UrlEscapeString(request.object_name()) +
                                  "/acl/" + UrlEscapeString(request.entity()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "PUT");
   if (!status.ok()) {
     return status;
@@ -881,7 +903,7 @@ StatusOr<ObjectAccessControl> CurlClient::PatchObjectAcl(
                                  "/o/" +
                                  UrlEscapeString(request.object_name()) +
                                  "/acl/" + UrlEscapeString(request.entity()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "PATCH");
   if (!status.ok()) {
     return status;
@@ -896,7 +918,7 @@ StatusOr<ListDefaultObjectAclResponse> CurlClient::ListDefaultObjectAcl(
   // Assume the bucket name is validated by the caller.
   CurlRequestBuilder builder(
       storage_endpoint_ + "/b/" + request.bucket_name() + "/defaultObjectAcl",
-      storage_factory_);
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -909,7 +931,7 @@ StatusOr<ObjectAccessControl> CurlClient::CreateDefaultObjectAcl(
     CreateDefaultObjectAclRequest const& request) {
   CurlRequestBuilder builder(
       storage_endpoint_ + "/b/" + request.bucket_name() + "/defaultObjectAcl",
-      storage_factory_);
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "POST");
   if (!status.ok()) {
     return status;
@@ -927,7 +949,7 @@ StatusOr<EmptyResponse> CurlClient::DeleteDefaultObjectAcl(
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/defaultObjectAcl/" +
                                  UrlEscapeString(request.entity()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "DELETE");
   if (!status.ok()) {
     return status;
@@ -940,7 +962,7 @@ StatusOr<ObjectAccessControl> CurlClient::GetDefaultObjectAcl(
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/defaultObjectAcl/" +
                                  UrlEscapeString(request.entity()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -954,7 +976,7 @@ StatusOr<ObjectAccessControl> CurlClient::UpdateDefaultObjectAcl(
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/defaultObjectAcl/" +
                                  UrlEscapeString(request.entity()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "PUT");
   if (!status.ok()) {
     return status;
@@ -972,7 +994,7 @@ StatusOr<ObjectAccessControl> CurlClient::PatchDefaultObjectAcl(
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/defaultObjectAcl/" +
                                  UrlEscapeString(request.entity()),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "PATCH");
   if (!status.ok()) {
     return status;
@@ -986,7 +1008,7 @@ StatusOr<ServiceAccount> CurlClient::GetServiceAccount(
     GetProjectServiceAccountRequest const& request) {
   CurlRequestBuilder builder(storage_endpoint_ + "/projects/" +
                                  request.project_id() + "/serviceAccount",
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -999,7 +1021,7 @@ StatusOr<ListHmacKeysResponse> CurlClient::ListHmacKeys(
     ListHmacKeysRequest const& request) {
   CurlRequestBuilder builder(
       storage_endpoint_ + "/projects/" + request.project_id() + "/hmacKeys",
-      storage_factory_);
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -1012,7 +1034,7 @@ StatusOr<CreateHmacKeyResponse> CurlClient::CreateHmacKey(
     CreateHmacKeyRequest const& request) {
   CurlRequestBuilder builder(
       storage_endpoint_ + "/projects/" + request.project_id() + "/hmacKeys",
-      storage_factory_);
+      SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "POST");
   if (!status.ok()) {
     return status;
@@ -1028,7 +1050,7 @@ StatusOr<EmptyResponse> CurlClient::DeleteHmacKey(
   CurlRequestBuilder builder(storage_endpoint_ + "/projects/" +
                                  request.project_id() + "/hmacKeys/" +
                                  request.access_id(),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "DELETE");
   if (!status.ok()) {
     return status;
@@ -1041,7 +1063,7 @@ StatusOr<HmacKeyMetadata> CurlClient::GetHmacKey(
   CurlRequestBuilder builder(storage_endpoint_ + "/projects/" +
                                  request.project_id() + "/hmacKeys/" +
                                  request.access_id(),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -1055,7 +1077,7 @@ StatusOr<HmacKeyMetadata> CurlClient::UpdateHmacKey(
   CurlRequestBuilder builder(storage_endpoint_ + "/projects/" +
                                  request.project_id() + "/hmacKeys/" +
                                  request.access_id(),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "PUT");
   if (!status.ok()) {
     return status;
@@ -1096,7 +1118,7 @@ StatusOr<ListNotificationsResponse> CurlClient::ListNotifications(
   // Assume the bucket name is validated by the caller.
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/notificationConfigs",
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -1109,7 +1131,7 @@ StatusOr<NotificationMetadata> CurlClient::CreateNotification(
     CreateNotificationRequest const& request) {
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/notificationConfigs",
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "POST");
   if (!status.ok()) {
     return status;
@@ -1124,7 +1146,7 @@ StatusOr<NotificationMetadata> CurlClient::GetNotification(
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/notificationConfigs/" +
                                  request.notification_id(),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "GET");
   if (!status.ok()) {
     return status;
@@ -1138,7 +1160,7 @@ StatusOr<EmptyResponse> CurlClient::DeleteNotification(
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                                  "/notificationConfigs/" +
                                  request.notification_id(),
-                             storage_factory_);
+                             SelectFactory(request, storage_factory_));
   auto status = SetupBuilder(builder, request, "DELETE");
   if (!status.ok()) {
     return status;
@@ -1151,7 +1173,7 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaXml(
   CurlRequestBuilder builder(xml_upload_endpoint_ + "/" +
                                  request.bucket_name() + "/" +
                                  UrlEscapeString(request.object_name()),
-                             xml_upload_factory_);
+                             SelectFactory(request, xml_upload_factory_));
   auto status = SetupBuilderCommon(builder, "PUT");
   if (!status.ok()) {
     return status;
@@ -1187,18 +1209,23 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaXml(
     builder.AddHeader("x-goog-encryption-kms-key-name: " +
                       request.GetOption<KmsKeyName>().value());
   }
+  auto const compute_md5 = !request.HasOption<MD5HashValue>() &&
+                           !request.HasOption<DisableMD5Hash>();
+  auto const compute_crc32c = !request.HasOption<Crc32cChecksumValue>() &&
+                              !request.HasOption<DisableCrc32cChecksum>();
+  auto const hashes =
+      ComputeHashes(request.contents(), compute_md5, compute_crc32c);
   if (request.HasOption<MD5HashValue>()) {
     builder.AddHeader("x-goog-hash: md5=" +
                       request.GetOption<MD5HashValue>().value());
-  } else if (!request.HasOption<DisableMD5Hash>()) {
-    builder.AddHeader("x-goog-hash: md5=" + ComputeMD5Hash(request.contents()));
+  } else if (compute_md5) {
+    builder.AddHeader("x-goog-hash: md5=" + hashes.md5);
   }
   if (request.HasOption<Crc32cChecksumValue>()) {
     builder.AddHeader("x-goog-hash: crc32c=" +
                       request.GetOption<Crc32cChecksumValue>().value());
-  } else if (!request.HasOption<DisableCrc32cChecksum>()) {
-    builder.AddHeader("x-goog-hash: crc32c=" +
-                      ComputeCrc32cChecksum(request.contents()));
+  } else if (compute_crc32c) {
+    builder.AddHeader("x-goog-hash: crc32c=" + hashes.crc32c);
   }
   if (request.HasOption<PredefinedAcl>()) {
     builder.AddHeader("x-goog-acl: " +
@@ -1214,6 +1241,7 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaXml(
   builder.AddOption(request.GetOption<CustomHeader>());
   builder.AddOption(request.GetOption<IfMatchEtag>());
   builder.AddOption(request.GetOption<IfNoneMatchEtag>());
+  builder.AddOption(request.GetOption<RequestPriority>());
   // QuotaUser cannot be set, checked by the caller.
   // UserIp cannot be set, checked by the caller.
 
@@ -1237,7 +1265,7 @@ StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObjectXml(
   CurlRequestBuilder builder(xml_download_endpoint_ + "/" +
                                  request.bucket_name() + "/" +
                                  UrlEscapeString(request.object_name()),
-                             xml_download_factory_);
+                             SelectFactory(request, xml_download_factory_));
   auto status = SetupBuilderCommon(builder, "GET");
   if (!status.ok()) {
     return status;
@@ -1271,6 +1299,7 @@ StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObjectXml(
   builder.AddOption(request.GetOption<CustomHeader>());
   builder.AddOption(request.GetOption<IfMatchEtag>());
   builder.AddOption(request.GetOption<IfNoneMatchEtag>());
+  builder.AddOption(request.GetOption<RequestPriority>());
   // QuotaUser cannot be set, checked by the caller.
   // UserIp cannot be set, checked by the caller.
 
@@ -1292,7 +1321,8 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaMultipart(
   // This function is structured as follows:
   // 1. Create a request object, as we often do.
   CurlRequestBuilder builder(
-      upload_endpoint_ + "/b/" + request.bucket_name() + "/o", upload_factory_);
+      upload_endpoint_ + "/b/" + request.bucket_name() + "/o",
+      SelectFactory(request, upload_factory_));
   auto status = SetupBuilder(builder, request, "POST");
   if (!status.ok()) {
     return status;
@@ -1304,36 +1334,37 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaMultipart(
   builder.AddQueryParameter("uploadType", "multipart");
   builder.AddQueryParameter("name", request.object_name());
 
-  // 3. Perform a streaming upload because computing the size upfront is more
-  //    complicated than it is worth.
-  std::ostringstream writer;
-
+  // 3. Compute any missing hashes, in a single pass over the contents.
   nl::json metadata = nl::json::object();
   if (request.HasOption<WithObjectMetadata>()) {
     metadata = ObjectMetadataJsonForInsert(
         request.GetOption<WithObjectMetadata>().value());
   }
+  auto const hashes = ComputeHashes(request.contents(),
+                                    !request.HasOption<MD5HashValue>(),
+                                    !request.HasOption<Crc32cChecksumValue>());
   if (request.HasOption<MD5HashValue>()) {
     metadata["md5Hash"] = request.GetOption<MD5HashValue>().value();
   } else {
-    metadata["md5Hash"] = ComputeMD5Hash(request.contents());
+    metadata["md5Hash"] = hashes.md5;
   }
 
   if (request.HasOption<Crc32cChecksumValue>()) {
     metadata["crc32c"] = request.GetOption<Crc32cChecksumValue>().value();
   } else {
-    metadata["crc32c"] = ComputeCrc32cChecksum(request.contents());
+    metadata["crc32c"] = hashes.crc32c;
   }
 
   std::string crlf = "\r\n";
   std::string marker = "--" + boundary;
 
   // 4. Format the first part, including the separators and the headers.
+  std::ostringstream writer;
   writer << marker << crlf << "content-type: application/json; charset=UTF-8"
          << crlf << crlf << metadata.dump() << crlf << marker << crlf;
 
-  // 5. Format the second part, which includes all the contents and a final
-  //    separator.
+  // 5. Format the headers for the second part, the contents are sent as-is,
+  //    followed by a final separator.
   if (request.HasOption<ContentType>()) {
     writer << "content-type: " << request.GetOption<ContentType>().value()
            << crlf;
@@ -1343,13 +1374,22 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaMultipart(
   } else {
     writer << "content-type: application/octet-stream" << crlf;
   }
-  writer << crlf << request.contents() << crlf << marker << "--" << crlf;
+  writer << crlf;
+  auto const header = std::move(writer).str();
+  auto const trailer = crlf + marker + "--" + crlf;
 
-  // 6. Return the results as usual.
-  auto contents = std::move(writer).str();
-  builder.AddHeader("Content-Length: " + std::to_string(contents.size()));
+  // 6. Send the parts as a list of buffers, this avoids copying the contents,
+  //    which are often large, into a single string.
+  auto const& contents = request.contents();
+  builder.AddHeader("Content-Length: " +
+                    std::to_string(header.size() + contents.size() +
+                                   trailer.size()));
   return CheckedFromString<ObjectMetadataParser>(
-      builder.BuildRequest().MakeRequest(contents));
+      builder.BuildRequest().MakeUploadRequest({
+          ConstBuffer{header.data(), header.size()},
+          ConstBuffer{contents.data(), contents.size()},
+          ConstBuffer{trailer.data(), trailer.size()},
+      }));
 }
 
 std::string CurlClient::PickBoundary(std::string const& text_to_avoid) {
@@ -1374,7 +1414,8 @@ std::string CurlClient::PickBoundary(std::string const& text_to_avoid) {
 StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaSimple(
     InsertObjectMediaRequest const& request) {
   CurlRequestBuilder builder(
-      upload_endpoint_ + "/b/" + request.bucket_name() + "/o", upload_factory_);
+      upload_endpoint_ + "/b/" + request.bucket_name() + "/o",
+      SelectFactory(request, upload_factory_));
   auto status = SetupBuilder(builder, request, "POST");
   if (!status.ok()) {
     return status;
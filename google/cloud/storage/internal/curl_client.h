@@ -18,7 +18,9 @@
 #include "google/cloud/storage/internal/curl_handle_factory.h"
 #include "google/cloud/storage/internal/raw_client.h"
 #include "google/cloud/storage/internal/resumable_upload_session.h"
+#include "google/cloud/storage/internal/trace_sampler.h"
 #include "google/cloud/storage/oauth2/credentials.h"
+#include "google/cloud/storage/request_priority.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/internal/random.h"
 #include <mutex>
@@ -212,6 +214,21 @@ class CurlClient : public RawClient,
   StatusOr<std::unique_ptr<ResumableUploadSession>>
   CreateResumableSessionGeneric(RequestType const& request);
 
+  /// Returns the handle factory for @p request, high priority requests use a
+  /// separate pool.
+  template <typename Request>
+  std::shared_ptr<CurlHandleFactory> const& SelectFactory(
+      Request const& request,
+      std::shared_ptr<CurlHandleFactory> const& factory) const {
+    if (high_priority_factory_ &&
+        request.template HasOption<RequestPriority>() &&
+        request.template GetOption<RequestPriority>().value() ==
+            RequestPriorityClass::kHigh) {
+      return high_priority_factory_;
+    }
+    return factory;
+  }
+
   ClientOptions options_;
   std::string storage_endpoint_;
   std::string upload_endpoint_;
@@ -221,11 +238,13 @@ class CurlClient : public RawClient,
 
   std::mutex mu_;
   google::cloud::internal::DefaultPRNG generator_;  // GUARDED_BY(mu_);
+  TraceSampler http_sampler_;
 
   std::shared_ptr<CurlHandleFactory> storage_factory_;
   std::shared_ptr<CurlHandleFactory> upload_factory_;
   std::shared_ptr<CurlHandleFactory> xml_upload_factory_;
   std::shared_ptr<CurlHandleFactory> xml_download_factory_;
+  std::shared_ptr<CurlHandleFactory> high_priority_factory_;
 };
 
 }  // namespace internal
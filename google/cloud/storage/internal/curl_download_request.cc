@@ -14,6 +14,7 @@
 
 #include "google/cloud/storage/internal/curl_download_request.h"
 #include "google/cloud/storage/internal/binary_data_as_debug_string.h"
+#include "google/cloud/storage/internal/copy_accounting.h"
 #include "google/cloud/storage/internal/curl_wrappers.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include "google/cloud/log.h"
@@ -52,13 +53,13 @@ extern "C" std::size_t CurlDownloadRequestHeader(char* contents,
                  << ", spill_.size()=" << spill_.size()                     \
                  << ", spill_offset_=" << spill_offset_                     \
                  << ", closing=" << closing_ << ", closed=" << curl_closed_ \
-                 << ", paused=" << paused_ << ", in_multi=" << in_multi_
+                 << ", paused=" << paused_ << ", throttled=" << throttled_  \
+                 << ", in_multi=" << in_multi_
 
 CurlDownloadRequest::CurlDownloadRequest()
     : headers_(nullptr, &curl_slist_free_all),
       download_stall_timeout_(0),
-      multi_(nullptr, &curl_multi_cleanup),
-      spill_(CURL_MAX_WRITE_SIZE) {}
+      multi_(nullptr, &curl_multi_cleanup) {}
 
 template <typename Predicate>
 Status CurlDownloadRequest::Wait(Predicate predicate) {
@@ -69,6 +70,10 @@ Status CurlDownloadRequest::Wait(Predicate predicate) {
   while (!predicate()) {
     handle_.FlushDebug(__func__);
     TRACE_STATE() << ", repeats=" << repeats;
+    if (throttled_) {
+      auto status = Unthrottle();
+      if (!status.ok()) return status;
+    }
     auto running_handles = PerformWork();
     if (!running_handles.ok()) {
       return std::move(running_handles).status();
@@ -96,6 +101,7 @@ StatusOr<HttpResponse> CurlDownloadRequest::Close() {
 
   (void)handle_.EasyPause(CURLPAUSE_RECV_CONT);
   paused_ = false;
+  throttled_ = false;
   TRACE_STATE();
 
   // Block until that callback is made.
@@ -150,6 +156,14 @@ StatusOr<ReadSourceResult> CurlDownloadRequest::Read(char* buf, std::size_t n) {
   handle_.FlushDebug(__func__);
   TRACE_STATE();
 
+  if (throttled_ && !curl_closed_) {
+    auto status = Unthrottle();
+    if (!status.ok()) {
+      TRACE_STATE() << ", status=" << status;
+      return status;
+    }
+  }
+
 #if CURL_AT_LEAST_VERSION(7, 69, 0)
   if (!curl_closed_ && paused_) {
 #else
@@ -164,8 +178,11 @@ StatusOr<ReadSourceResult> CurlDownloadRequest::Read(char* buf, std::size_t n) {
     TRACE_STATE();
   }
 
+  // A throttled transfer returns any data already received, but waits for the
+  // limiter if there is no data to return.
   auto status = Wait([this] {
-    return curl_closed_ || paused_ || buffer_offset_ >= buffer_size_;
+    return curl_closed_ || (paused_ && (!throttled_ || buffer_offset_ != 0)) ||
+           buffer_offset_ >= buffer_size_;
   });
   if (!status.ok()) {
     return status;
@@ -218,7 +235,7 @@ void CurlDownloadRequest::SetOptions() {
     handle_.SetOption(CURLOPT_POSTFIELDSIZE, payload_.length());
     handle_.SetOption(CURLOPT_POSTFIELDS, payload_.c_str());
   }
-  handle_.EnableLogging(logging_enabled_);
+  handle_.EnableLogging(logging_enabled_, logging_max_size_);
   handle_.SetSocketCallback(socket_options_);
   if (download_stall_timeout_.count() != 0) {
     // Timeout if the download receives less than 1 byte/second (i.e.
@@ -246,10 +263,13 @@ void CurlDownloadRequest::DrainSpillBuffer() {
   std::size_t free = buffer_size_ - buffer_offset_;
   auto copy_count = (std::min)(free, spill_offset_);
   std::memcpy(buffer_ + buffer_offset_, spill_.data(), copy_count);
+  RecordBytesCopied(copy_count);
   buffer_offset_ += copy_count;
-  std::memmove(spill_.data(), spill_.data() + copy_count,
-               spill_.size() - copy_count);
   spill_offset_ -= copy_count;
+  // Only the bytes still in the spill buffer need to move to the front.
+  if (copy_count == 0 || spill_offset_ == 0) return;
+  std::memmove(spill_.data(), spill_.data() + copy_count, spill_offset_);
+  RecordBytesCopied(spill_offset_);
 }
 
 std::size_t CurlDownloadRequest::WriteCallback(void* ptr, std::size_t size,
@@ -269,6 +289,13 @@ std::size_t CurlDownloadRequest::WriteCallback(void* ptr, std::size_t size,
     paused_ = true;
     return CURL_READFUNC_PAUSE;
   }
+  if (bandwidth_limiter_ &&
+      std::chrono::steady_clock::now() < throttled_until_) {
+    TRACE_STATE() << " *** THROTTLING HANDLE ***";
+    paused_ = true;
+    throttled_ = true;
+    return CURL_READFUNC_PAUSE;
+  }
 
   // Use the spill buffer first, if there is any...
   DrainSpillBuffer();
@@ -278,11 +305,18 @@ std::size_t CurlDownloadRequest::WriteCallback(void* ptr, std::size_t size,
     paused_ = true;
     return CURL_READFUNC_PAUSE;
   }
+  if (bandwidth_limiter_) {
+    // Account for the data now, if this puts the limiter in debt the next
+    // callback pauses the handle until the budget is available again.
+    throttled_until_ = std::chrono::steady_clock::now() +
+                       bandwidth_limiter_->ReserveDownload(size * nmemb);
+  }
   TRACE_STATE() << ", n=" << size * nmemb << ", free=" << free;
 
   // Copy the full contents of `ptr` into the application buffer.
   if (size * nmemb < free) {
     std::memcpy(buffer_ + buffer_offset_, ptr, size * nmemb);
+    RecordBytesCopied(size * nmemb);
     buffer_offset_ += size * nmemb;
     TRACE_STATE() << ", n=" << size * nmemb;
     return size * nmemb;
@@ -293,6 +327,7 @@ std::size_t CurlDownloadRequest::WriteCallback(void* ptr, std::size_t size,
   spill_offset_ = size * nmemb - free;
   // The rest goes into the spill buffer.
   std::memcpy(spill_.data(), static_cast<char*>(ptr) + free, spill_offset_);
+  RecordBytesCopied(size * nmemb);
   TRACE_STATE() << ", n=" << size * nmemb << ", free=" << free;
   return size * nmemb;
 }
@@ -303,6 +338,17 @@ std::size_t CurlDownloadRequest::HeaderCallback(char* contents,
   return CurlAppendHeaderData(received_headers_, contents, size * nitems);
 }
 
+Status CurlDownloadRequest::Unthrottle() {
+  TRACE_STATE();
+  std::this_thread::sleep_until(throttled_until_);
+  throttled_ = false;
+  if (!paused_ || curl_closed_) return Status();
+  // Unpausing the handle may invoke `WriteCallback()` immediately, which may
+  // pause (or throttle) the handle again, reset the flags before unpausing.
+  paused_ = false;
+  return handle_.EasyPause(CURLPAUSE_RECV_CONT);
+}
+
 StatusOr<int> CurlDownloadRequest::PerformWork() {
   TRACE_STATE();
   if (!in_multi_) {
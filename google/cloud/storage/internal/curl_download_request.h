@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_DOWNLOAD_REQUEST_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_DOWNLOAD_REQUEST_H
 
+#include "google/cloud/storage/buffer_pool.h"
 #include "google/cloud/storage/internal/curl_request.h"
 #include "google/cloud/storage/internal/http_response.h"
 #include "google/cloud/storage/internal/object_read_source.h"
@@ -102,6 +103,9 @@ class CurlDownloadRequest : public ObjectReadSource {
   /// Use libcurl to wait until the underlying data can perform work.
   Status WaitForHandles(int& repeats);
 
+  /// Wait until the bandwidth limiter allows more data and unpause the handle.
+  Status Unthrottle();
+
   /// Simplify handling of errors in the curl_multi_* API.
   static Status AsStatus(CURLMcode result, char const* where);
 
@@ -111,8 +115,10 @@ class CurlDownloadRequest : public ObjectReadSource {
   std::string user_agent_;
   CurlReceivedHeaders received_headers_;
   bool logging_enabled_ = false;
+  std::size_t logging_max_size_ = 0;
   CurlHandle::SocketOptions socket_options_;
   std::chrono::seconds download_stall_timeout_;
+  std::shared_ptr<BandwidthLimiter> bandwidth_limiter_;
   CurlHandle handle_;
   CurlMulti multi_;
   std::shared_ptr<CurlHandleFactory> factory_;
@@ -141,6 +147,12 @@ class CurlDownloadRequest : public ObjectReadSource {
 
   bool paused_ = false;
 
+  // When the bandwidth limiter requires the transfer to slow down the handle is
+  // paused until `throttled_until_`. Note that `paused_` is also set in this
+  // case.
+  bool throttled_ = false;
+  std::chrono::steady_clock::time_point throttled_until_;
+
   char* buffer_ = nullptr;
   std::size_t buffer_size_ = 0;
   std::size_t buffer_offset_ = 0;
@@ -150,7 +162,7 @@ class CurlDownloadRequest : public ObjectReadSource {
   // less bytes read aborts the download (we do that on a Close(), but in
   // general we do not). The application may have requested less bytes in the
   // call to `Read()`, so we need a place to store the additional bytes.
-  std::vector<char> spill_;
+  PooledBuffer spill_;
   std::size_t spill_offset_ = 0;
 };
 
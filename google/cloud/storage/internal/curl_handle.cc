@@ -33,38 +33,6 @@ using ::google::cloud::storage::internal::BinaryDataAsDebugString;
 
 std::size_t const kMaxDataDebugSize = 48;
 
-extern "C" int CurlHandleDebugCallback(CURL*, curl_infotype type, char* data,
-                                       std::size_t size, void* userptr) {
-  auto debug_buffer = reinterpret_cast<std::string*>(userptr);
-  switch (type) {
-    case CURLINFO_TEXT:
-      *debug_buffer += "== curl(Info): " + std::string(data, size);
-      break;
-    case CURLINFO_HEADER_IN:
-      *debug_buffer += "<< curl(Recv Header): " + std::string(data, size);
-      break;
-    case CURLINFO_HEADER_OUT:
-      *debug_buffer += ">> curl(Send Header): " + std::string(data, size);
-      break;
-    case CURLINFO_DATA_IN:
-      *debug_buffer += ">> curl(Recv Data): size=";
-      *debug_buffer += std::to_string(size) + "\n";
-      *debug_buffer += BinaryDataAsDebugString(data, size, kMaxDataDebugSize);
-      break;
-    case CURLINFO_DATA_OUT:
-      *debug_buffer += ">> curl(Send Data): size=";
-      *debug_buffer += std::to_string(size) + "\n";
-      *debug_buffer += BinaryDataAsDebugString(data, size, kMaxDataDebugSize);
-      break;
-    case CURLINFO_SSL_DATA_IN:
-    case CURLINFO_SSL_DATA_OUT:
-      // Do not print SSL binary data because generally that is not useful.
-    case CURLINFO_END:
-      break;
-  }
-  return 0;
-}
-
 extern "C" int CurlSetSocketOptions(void* userdata, curl_socket_t curlfd,
                                     curlsocktype purpose) {
   auto* options = reinterpret_cast<CurlHandle::SocketOptions*>(userdata);
@@ -116,6 +84,13 @@ extern "C" int CurlSetSocketOptions(void* userdata, curl_socket_t curlfd,
 
 }  // namespace
 
+extern "C" int CurlHandleDebugCallback(CURL*, curl_infotype type, char* data,
+                                       std::size_t size, void* userptr) {
+  auto* handle = reinterpret_cast<CurlHandle*>(userptr);
+  handle->OnDebugData(type, data, size);
+  return 0;
+}
+
 CurlHandle::CurlHandle() : handle_(curl_easy_init(), &curl_easy_cleanup) {
   if (handle_.get() == nullptr) {
     google::cloud::internal::ThrowRuntimeError("Cannot initialize CURL handle");
@@ -135,9 +110,10 @@ void CurlHandle::ResetSocketCallback() {
   SetOption(CURLOPT_SOCKOPTFUNCTION, nullptr);
 }
 
-void CurlHandle::EnableLogging(bool enabled) {
+void CurlHandle::EnableLogging(bool enabled, std::size_t max_size) {
+  debug_max_size_ = max_size;
   if (enabled) {
-    SetOption(CURLOPT_DEBUGDATA, &debug_buffer_);
+    SetOption(CURLOPT_DEBUGDATA, this);
     SetOption(CURLOPT_DEBUGFUNCTION, &CurlHandleDebugCallback);
     SetOption(CURLOPT_VERBOSE, 1L);
   } else {
@@ -149,11 +125,57 @@ void CurlHandle::EnableLogging(bool enabled) {
 
 void CurlHandle::FlushDebug(char const* where) {
   if (!debug_buffer_.empty()) {
+    if (debug_omitted_ != 0) {
+      debug_buffer_ +=
+          "...<truncated " + std::to_string(debug_omitted_) + " bytes>";
+      debug_omitted_ = 0;
+    }
     GCP_LOG(DEBUG) << where << ' ' << debug_buffer_;
     debug_buffer_.clear();
   }
 }
 
+void CurlHandle::OnDebugData(curl_infotype type, char const* data,
+                             std::size_t size) {
+  if (debug_max_size_ != 0 && debug_buffer_.size() >= debug_max_size_) {
+    // Do not format (or keep) data that would be truncated anyway.
+    if (type != CURLINFO_SSL_DATA_IN && type != CURLINFO_SSL_DATA_OUT) {
+      debug_omitted_ += size;
+    }
+    return;
+  }
+  switch (type) {
+    case CURLINFO_TEXT:
+      debug_buffer_ += "== curl(Info): " + std::string(data, size);
+      break;
+    case CURLINFO_HEADER_IN:
+      debug_buffer_ += "<< curl(Recv Header): " + std::string(data, size);
+      break;
+    case CURLINFO_HEADER_OUT:
+      debug_buffer_ += ">> curl(Send Header): " + std::string(data, size);
+      break;
+    case CURLINFO_DATA_IN:
+      debug_buffer_ += ">> curl(Recv Data): size=";
+      debug_buffer_ += std::to_string(size) + "\n";
+      debug_buffer_ += BinaryDataAsDebugString(data, size, kMaxDataDebugSize);
+      break;
+    case CURLINFO_DATA_OUT:
+      debug_buffer_ += ">> curl(Send Data): size=";
+      debug_buffer_ += std::to_string(size) + "\n";
+      debug_buffer_ += BinaryDataAsDebugString(data, size, kMaxDataDebugSize);
+      break;
+    case CURLINFO_SSL_DATA_IN:
+    case CURLINFO_SSL_DATA_OUT:
+      // Do not print SSL binary data because generally that is not useful.
+    case CURLINFO_END:
+      break;
+  }
+  if (debug_max_size_ != 0 && debug_buffer_.size() > debug_max_size_) {
+    debug_omitted_ += debug_buffer_.size() - debug_max_size_;
+    debug_buffer_.resize(debug_max_size_);
+  }
+}
+
 Status CurlHandle::AsStatus(CURLcode e, char const* where) {
   if (e == CURLE_OK) {
     return Status();
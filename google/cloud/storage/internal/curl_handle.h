@@ -26,6 +26,10 @@ namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
+extern "C" int CurlHandleDebugCallback(CURL* handle, curl_infotype type,
+                                       char* data, std::size_t size,
+                                       void* userptr);
+
 /**
  * Wraps CURL* handles in a safer C++ interface.
  *
@@ -92,7 +96,14 @@ class CurlHandle {
     return AsStatus(e, __func__);
   }
 
-  void EnableLogging(bool enabled);
+  /**
+   * Enable (or disable) logging of the request and response.
+   *
+   * If @p max_size is not zero each call to `FlushDebug()` logs at most this
+   * many bytes. The debug data past this limit is discarded as it arrives, only
+   * its size is reported.
+   */
+  void EnableLogging(bool enabled, std::size_t max_size = 0);
 
   /// Flushes any debug data using GCP_LOG().
   void FlushDebug(char const* where);
@@ -106,6 +117,12 @@ class CurlHandle {
   friend class CurlDownloadRequest;
   friend class CurlRequestBuilder;
   friend class CurlHandleFactory;
+  friend int CurlHandleDebugCallback(CURL* handle, curl_infotype type,
+                                     char* data, std::size_t size,
+                                     void* userptr);
+
+  /// Append the debug data reported by libcurl, up to `debug_max_size_` bytes.
+  void OnDebugData(curl_infotype type, char const* data, std::size_t size);
 
   [[noreturn]] static void ThrowSetOptionError(CURLcode e, CURLoption opt,
                                                std::intmax_t param);
@@ -123,6 +140,8 @@ class CurlHandle {
 
   CurlPtr handle_;
   std::string debug_buffer_;
+  std::size_t debug_max_size_ = 0;
+  std::size_t debug_omitted_ = 0;
   SocketOptions socket_options_;
 };
 
@@ -45,6 +45,11 @@ class OverriddenDefaultCurlHandleFactory : public DefaultCurlHandleFactory {
   std::map<int, std::string> set_options_;
 };
 
+// Access the underlying CURL* of a CurlHandle, to verify which pool it goes to.
+struct CurlHandlePeer : public CurlHandleFactory {
+  static CURL* Get(CurlHandle& h) { return GetHandle(h); }
+};
+
 // Version of DefaultCurlHandleFactory that keeps track of what calls have been
 // made to SetCurlStringOption.
 class OverriddenPooledCurlHandleFactory : public PooledCurlHandleFactory {
@@ -111,6 +116,50 @@ TEST(CurlHandleFactoryTest, PooledFactoryChannelOptionsCallsSetOptions) {
   EXPECT_THAT(object_under_test.set_options_, testing::ElementsAre(expected));
 }
 
+TEST(CurlHandleFactoryTest, PooledFactoriesDoNotShareHandles) {
+  // `CurlClient` reserves connections for high priority requests by using a
+  // separate pool, verify the pools never exchange handles.
+  PooledCurlHandleFactory normal(2);
+  PooledCurlHandleFactory high(2);
+
+  CurlHandle normal_handle;
+  CURL* normal_raw = CurlHandlePeer::Get(normal_handle);
+  normal.CleanupHandle(std::move(normal_handle));
+  CurlHandle high_handle;
+  CURL* high_raw = CurlHandlePeer::Get(high_handle);
+  high.CleanupHandle(std::move(high_handle));
+
+  auto from_high = high.CreateHandle();
+  EXPECT_EQ(high_raw, from_high.get());
+  auto from_normal = normal.CreateHandle();
+  EXPECT_EQ(normal_raw, from_normal.get());
+
+  // Both pools are now empty, neither returns the other's handle.
+  auto fresh_high = high.CreateHandle();
+  EXPECT_NE(normal_raw, fresh_high.get());
+  auto fresh_normal = normal.CreateHandle();
+  EXPECT_NE(high_raw, fresh_normal.get());
+}
+
+TEST(CurlHandleFactoryTest, PooledFactoryEvictionKeepsReservedHandles) {
+  PooledCurlHandleFactory normal(1);
+  PooledCurlHandleFactory high(1);
+
+  CurlHandle high_handle;
+  CURL* high_raw = CurlHandlePeer::Get(high_handle);
+  high.CleanupHandle(std::move(high_handle));
+
+  // Releasing more handles than the normal pool holds evicts from that pool
+  // only.
+  for (int i = 0; i != 3; ++i) {
+    CurlHandle h;
+    normal.CleanupHandle(std::move(h));
+  }
+
+  auto from_high = high.CreateHandle();
+  EXPECT_EQ(high_raw, from_high.get());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
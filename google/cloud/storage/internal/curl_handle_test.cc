@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/curl_handle.h"
+#include "google/cloud/log.h"
+#include "google/cloud/testing_util/capture_log_lines_backend.h"
 #include <gmock/gmock.h>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -23,6 +26,7 @@ namespace internal {
 namespace {
 
 using ::testing::HasSubstr;
+using ::testing::Not;
 
 TEST(CurlHandleTest, AsStatus) {
   struct {
@@ -60,6 +64,35 @@ TEST(CurlHandleTest, AsStatus) {
   }
 }
 
+TEST(CurlHandleTest, DebugDataCappedAsItArrives) {
+  auto backend = std::make_shared<testing_util::CaptureLogLinesBackend>();
+  auto id = LogSink::Instance().AddBackend(backend);
+
+  CurlHandle handle;
+  handle.EnableLogging(true, 64);
+  std::string text(100, 'a');
+  for (int i = 0; i != 10; ++i) {
+    CurlHandleDebugCallback(nullptr, CURLINFO_TEXT, &text[0], text.size(),
+                            &handle);
+  }
+  handle.FlushDebug("first");
+  // The omitted bytes are only reported once.
+  CurlHandleDebugCallback(nullptr, CURLINFO_TEXT, &text[0], 10, &handle);
+  handle.FlushDebug("second");
+
+  LogSink::Instance().RemoveBackend(id);
+
+  ASSERT_EQ(2, backend->log_lines.size());
+  auto const& first = backend->log_lines[0];
+  std::string const prefix = "== curl(Info): ";
+  // The first entry is truncated to the limit, the other entries are omitted.
+  auto const omitted = prefix.size() + text.size() - 64 + 9 * text.size();
+  auto const trailer = "...<truncated " + std::to_string(omitted) + " bytes>";
+  EXPECT_THAT(first, HasSubstr(trailer));
+  EXPECT_EQ(std::string("first ").size() + 64 + trailer.size(), first.size());
+  EXPECT_THAT(backend->log_lines[1], Not(HasSubstr("truncated")));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -13,7 +13,11 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/curl_request.h"
+#include "google/cloud/storage/internal/copy_accounting.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -33,7 +37,43 @@ extern "C" size_t CurlRequestOnHeaderData(char* contents, size_t size,
   return request->OnHeaderData(contents, size, nitems);
 }
 
+extern "C" size_t CurlRequestOnReadData(char* ptr, size_t size, size_t nitems,
+                                        void* userdata) {
+  auto* request = reinterpret_cast<CurlRequest*>(userdata);
+  return request->OnReadData(ptr, size, nitems);
+}
+
 StatusOr<HttpResponse> CurlRequest::MakeRequest(std::string const& payload) {
+  if (bandwidth_limiter_ && !payload.empty()) {
+    // Send the payload in chunks, so each chunk can be throttled.
+    return MakeUploadRequest({ConstBuffer{payload.data(), payload.size()}});
+  }
+  SetupHandle();
+  if (!payload.empty()) {
+    handle_.SetOption(CURLOPT_POSTFIELDSIZE, payload.length());
+    handle_.SetOption(CURLOPT_POSTFIELDS, payload.c_str());
+  }
+  return PerformRequest();
+}
+
+StatusOr<HttpResponse> CurlRequest::MakeUploadRequest(
+    ConstBufferSequence payload) {
+  SetupHandle();
+  std::size_t size = 0;
+  for (auto const& b : payload) size += b.size;
+  upload_buffers_ = std::move(payload);
+  upload_index_ = 0;
+  upload_offset_ = 0;
+  handle_.SetOption(CURLOPT_POSTFIELDSIZE, size);
+  handle_.SetOption(CURLOPT_POST, 1L);
+  handle_.SetOption(CURLOPT_READFUNCTION, &CurlRequestOnReadData);
+  handle_.SetOption(CURLOPT_READDATA, this);
+  auto response = PerformRequest();
+  upload_buffers_.clear();
+  return response;
+}
+
+void CurlRequest::SetupHandle() {
   // We get better performance using a slightly larger buffer (128KiB) than the
   // default buffer size set by libcurl (16KiB)
   auto constexpr kDefaultBufferSize = 128 * 1024L;
@@ -46,16 +86,15 @@ StatusOr<HttpResponse> CurlRequest::MakeRequest(std::string const& payload) {
   handle_.SetOption(CURLOPT_NOSIGNAL, 1);
   handle_.SetOption(CURLOPT_UPLOAD, 0L);
   handle_.SetOption(CURLOPT_TCP_KEEPALIVE, 1L);
-  handle_.EnableLogging(logging_enabled_);
+  handle_.EnableLogging(logging_enabled_, logging_max_size_);
   handle_.SetSocketCallback(socket_options_);
   handle_.SetOption(CURLOPT_WRITEFUNCTION, &CurlRequestOnWriteData);
   handle_.SetOption(CURLOPT_WRITEDATA, this);
   handle_.SetOption(CURLOPT_HEADERFUNCTION, &CurlRequestOnHeaderData);
   handle_.SetOption(CURLOPT_HEADERDATA, this);
-  if (!payload.empty()) {
-    handle_.SetOption(CURLOPT_POSTFIELDSIZE, payload.length());
-    handle_.SetOption(CURLOPT_POSTFIELDS, payload.c_str());
-  }
+}
+
+StatusOr<HttpResponse> CurlRequest::PerformRequest() {
   auto status = handle_.EasyPerform();
   if (!status.ok()) {
     return status;
@@ -74,9 +113,38 @@ StatusOr<HttpResponse> CurlRequest::MakeRequest(std::string const& payload) {
 std::size_t CurlRequest::OnWriteData(char* contents, std::size_t size,
                                      std::size_t nmemb) {
   response_payload_.append(contents, size * nmemb);
+  RecordBytesCopied(size * nmemb);
+  if (bandwidth_limiter_) {
+    // This is a blocking transfer, it is simpler (and equivalent) to sleep in
+    // the callback than to pause the handle and unpause it later.
+    std::this_thread::sleep_for(
+        bandwidth_limiter_->ReserveDownload(size * nmemb));
+  }
   return size * nmemb;
 }
 
+std::size_t CurlRequest::OnReadData(char* ptr, std::size_t size,
+                                    std::size_t nitems) {
+  std::size_t n = 0;
+  auto const capacity = size * nitems;
+  while (n < capacity && upload_index_ < upload_buffers_.size()) {
+    auto const& buffer = upload_buffers_[upload_index_];
+    auto const count = (std::min)(capacity - n, buffer.size - upload_offset_);
+    if (count != 0) std::memcpy(ptr + n, buffer.data + upload_offset_, count);
+    RecordBytesCopied(count);
+    n += count;
+    upload_offset_ += count;
+    if (upload_offset_ == buffer.size) {
+      ++upload_index_;
+      upload_offset_ = 0;
+    }
+  }
+  if (bandwidth_limiter_) {
+    std::this_thread::sleep_for(bandwidth_limiter_->ReserveUpload(n));
+  }
+  return n;
+}
+
 std::size_t CurlRequest::OnHeaderData(char* contents, std::size_t size,
                                       std::size_t nitems) {
   return CurlAppendHeaderData(received_headers_, contents, size * nitems);
@@ -15,10 +15,12 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_REQUEST_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_REQUEST_H
 
+#include "google/cloud/storage/bandwidth_limiter.h"
 #include "google/cloud/storage/internal/curl_handle.h"
 #include "google/cloud/storage/internal/curl_handle_factory.h"
 #include "google/cloud/storage/internal/http_response.h"
 #include "google/cloud/storage/version.h"
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -29,6 +31,17 @@ extern "C" size_t CurlRequestOnWriteData(char* ptr, size_t size, size_t nmemb,
                                          void* userdata);
 extern "C" size_t CurlRequestOnHeaderData(char* contents, size_t size,
                                           size_t nitems, void* userdata);
+extern "C" size_t CurlRequestOnReadData(char* ptr, size_t size, size_t nitems,
+                                        void* userdata);
+
+/// A non-owning view of a buffer, used to upload payloads without copies.
+struct ConstBuffer {
+  char const* data;
+  std::size_t size;
+};
+
+/// A list of buffers sent, in order, as a single request payload.
+using ConstBufferSequence = std::vector<ConstBuffer>;
 
 class CurlRequest {
  public:
@@ -49,16 +62,35 @@ class CurlRequest {
    */
   StatusOr<HttpResponse> MakeRequest(std::string const& payload);
 
+  /**
+   * Makes the prepared request, sending the concatenation of @p payload.
+   *
+   * The buffers are sent using a read callback, without copying them into a
+   * single contiguous string. The caller must keep the buffers alive until
+   * this function returns.
+   *
+   * @return The response HTTP error code, the headers and an empty payload.
+   */
+  StatusOr<HttpResponse> MakeUploadRequest(ConstBufferSequence payload);
+
  private:
   friend class CurlRequestBuilder;
   friend size_t CurlRequestOnWriteData(char* ptr, size_t size, size_t nmemb,
                                        void* userdata);
   friend size_t CurlRequestOnHeaderData(char* contents, size_t size,
                                         size_t nitems, void* userdata);
+  friend size_t CurlRequestOnReadData(char* ptr, size_t size, size_t nitems,
+                                      void* userdata);
 
   std::size_t OnWriteData(char* contents, std::size_t size, std::size_t nmemb);
   std::size_t OnHeaderData(char* contents, std::size_t size,
                            std::size_t nitems);
+  std::size_t OnReadData(char* ptr, std::size_t size, std::size_t nitems);
+
+  /// Set the options common to all requests.
+  void SetupHandle();
+  /// Perform the request and collect the response.
+  StatusOr<HttpResponse> PerformRequest();
 
   std::string url_;
   CurlHeaders headers_ = CurlHeaders(nullptr, &curl_slist_free_all);
@@ -66,7 +98,15 @@ class CurlRequest {
   std::string response_payload_;
   CurlReceivedHeaders received_headers_;
   bool logging_enabled_ = false;
+  std::size_t logging_max_size_ = 0;
   CurlHandle::SocketOptions socket_options_;
+  std::shared_ptr<BandwidthLimiter> bandwidth_limiter_;
+  // When the bandwidth is limited, or the payload is a sequence of buffers,
+  // the payload is sent using a read callback, these track the payload and how
+  // much of it has been sent.
+  ConstBufferSequence upload_buffers_;
+  std::size_t upload_index_ = 0;
+  std::size_t upload_offset_ = 0;
   CurlHandle handle_;
   std::shared_ptr<CurlHandleFactory> factory_;
 };
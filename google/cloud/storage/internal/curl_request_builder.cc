@@ -34,6 +34,7 @@ CurlRequestBuilder::CurlRequestBuilder(
       url_(std::move(base_url)),
       query_parameter_separator_("?"),
       logging_enabled_(false),
+      logging_max_size_(0),
       download_stall_timeout_(0) {}
 
 CurlRequest CurlRequestBuilder::BuildRequest() {
@@ -45,7 +46,9 @@ CurlRequest CurlRequestBuilder::BuildRequest() {
   request.handle_ = std::move(handle_);
   request.factory_ = std::move(factory_);
   request.logging_enabled_ = logging_enabled_;
+  request.logging_max_size_ = logging_max_size_;
   request.socket_options_ = socket_options_;
+  request.bandwidth_limiter_ = std::move(bandwidth_limiter_);
   return request;
 }
 
@@ -61,8 +64,13 @@ CurlDownloadRequest CurlRequestBuilder::BuildDownloadRequest(
   request.multi_ = factory_->CreateMultiHandle();
   request.factory_ = factory_;
   request.logging_enabled_ = logging_enabled_;
+  request.logging_max_size_ = logging_max_size_;
   request.socket_options_ = socket_options_;
   request.download_stall_timeout_ = download_stall_timeout_;
+  request.bandwidth_limiter_ = std::move(bandwidth_limiter_);
+  // The spill buffer comes from the pool, if any, otherwise it is allocated
+  // here. Either way it is allocated exactly once.
+  request.spill_ = AcquireBuffer(buffer_pool_, CURL_MAX_WRITE_SIZE);
   request.SetOptions();
   return request;
 }
@@ -71,10 +79,19 @@ CurlRequestBuilder& CurlRequestBuilder::ApplyClientOptions(
     ClientOptions const& options) {
   ValidateBuilderState(__func__);
   logging_enabled_ = options.enable_http_tracing();
+  logging_max_size_ = options.tracing_max_payload_size();
   socket_options_.recv_buffer_size_ = options.maximum_socket_recv_size();
   socket_options_.send_buffer_size_ = options.maximum_socket_send_size();
   user_agent_prefix_ = options.user_agent_prefix() + user_agent_prefix_;
   download_stall_timeout_ = options.download_stall_timeout();
+  bandwidth_limiter_ = options.bandwidth_limiter();
+  buffer_pool_ = options.buffer_pool();
+  return *this;
+}
+
+CurlRequestBuilder& CurlRequestBuilder::SetLoggingEnabled(bool enabled) {
+  ValidateBuilderState(__func__);
+  logging_enabled_ = enabled;
   return *this;
 }
 
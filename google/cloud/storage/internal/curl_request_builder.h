@@ -15,10 +15,12 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_REQUEST_BUILDER_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_REQUEST_BUILDER_H
 
+#include "google/cloud/storage/buffer_pool.h"
 #include "google/cloud/storage/internal/complex_option.h"
 #include "google/cloud/storage/internal/curl_download_request.h"
 #include "google/cloud/storage/internal/curl_handle_factory.h"
 #include "google/cloud/storage/internal/curl_request.h"
+#include "google/cloud/storage/request_priority.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/storage/well_known_headers.h"
 
@@ -121,6 +123,14 @@ class CurlRequestBuilder {
     return *this;
   }
 
+  /// High priority requests are not delayed by the bandwidth limiter.
+  CurlRequestBuilder& AddOption(RequestPriority const& p) {
+    if (p.has_value() && p.value() == RequestPriorityClass::kHigh) {
+      bandwidth_limiter_.reset();
+    }
+    return *this;
+  }
+
   /**
    * Ignore complex options, these are managed explicitly in the requests that
    * use them.
@@ -144,6 +154,9 @@ class CurlRequestBuilder {
   /// Copy interesting configuration parameters from the client options.
   CurlRequestBuilder& ApplyClientOptions(ClientOptions const& options);
 
+  /// Enable (or disable) logging for this request, e.g., if not sampled.
+  CurlRequestBuilder& SetLoggingEnabled(bool enabled);
+
   /// Sets the CURLSH* handle to share resources.
   CurlRequestBuilder& SetCurlShare(CURLSH* share);
 
@@ -173,8 +186,11 @@ class CurlRequestBuilder {
 
   std::string user_agent_prefix_;
   bool logging_enabled_;
+  std::size_t logging_max_size_;
   CurlHandle::SocketOptions socket_options_;
   std::chrono::seconds download_stall_timeout_;
+  std::shared_ptr<BandwidthLimiter> bandwidth_limiter_;
+  std::shared_ptr<BufferPool> buffer_pool_;
 };
 
 }  // namespace internal
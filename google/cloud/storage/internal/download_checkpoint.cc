@@ -0,0 +1,125 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/download_checkpoint.h"
+#include "google/cloud/storage/internal/nljson.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+bool operator==(DownloadCheckpoint const& lhs, DownloadCheckpoint const& rhs) {
+  return lhs.bucket_name == rhs.bucket_name &&
+         lhs.object_name == rhs.object_name &&
+         lhs.generation == rhs.generation && lhs.offset == rhs.offset &&
+         lhs.crc32c == rhs.crc32c;
+}
+
+std::ostream& operator<<(std::ostream& os, DownloadCheckpoint const& rhs) {
+  return os << "DownloadCheckpoint={bucket_name=" << rhs.bucket_name
+            << ", object_name=" << rhs.object_name
+            << ", generation=" << rhs.generation << ", offset=" << rhs.offset
+            << ", crc32c=" << rhs.crc32c << "}";
+}
+
+std::string DownloadTemporaryFileName(std::string const& file_name) {
+  return file_name + ".partial";
+}
+
+std::string DownloadCheckpointFileName(std::string const& file_name) {
+  return file_name + ".checkpoint";
+}
+
+StatusOr<DownloadCheckpoint> ParseDownloadCheckpoint(std::string const& json) {
+  auto const doc = nl::json::parse(json, nullptr, false);
+  auto invalid = [] {
+    return Status(StatusCode::kDataLoss, "invalid download checkpoint");
+  };
+  if (!doc.is_object()) return invalid();
+  for (auto const* field : {"bucket", "object"}) {
+    if (doc.count(field) == 0 || !doc[field].is_string()) return invalid();
+  }
+  for (auto const* field : {"generation", "offset", "crc32c"}) {
+    if (doc.count(field) == 0 || !doc[field].is_number_integer()) {
+      return invalid();
+    }
+  }
+  DownloadCheckpoint result{
+      doc["bucket"].get<std::string>(), doc["object"].get<std::string>(),
+      doc["generation"].get<std::int64_t>(), doc["offset"].get<std::int64_t>(),
+      doc["crc32c"].get<std::uint32_t>()};
+  if (result.offset < 0) return invalid();
+  return result;
+}
+
+std::string DownloadCheckpointToString(DownloadCheckpoint const& checkpoint) {
+  nl::json doc{
+      {"bucket", checkpoint.bucket_name},
+      {"object", checkpoint.object_name},
+      {"generation", checkpoint.generation},
+      {"offset", checkpoint.offset},
+      {"crc32c", checkpoint.crc32c},
+  };
+  return doc.dump();
+}
+
+StatusOr<DownloadCheckpoint> ReadDownloadCheckpoint(
+    std::string const& file_name) {
+  std::ifstream is(DownloadCheckpointFileName(file_name), std::ios::binary);
+  if (!is.is_open()) {
+    return Status(StatusCode::kNotFound, "no download checkpoint");
+  }
+  std::string contents{std::istreambuf_iterator<char>{is}, {}};
+  return ParseDownloadCheckpoint(contents);
+}
+
+Status WriteDownloadCheckpoint(std::string const& file_name,
+                               DownloadCheckpoint const& checkpoint) {
+  auto const path = DownloadCheckpointFileName(file_name);
+  auto const tmp = path + ".tmp";
+  {
+    std::ofstream os(tmp, std::ios::binary | std::ios::trunc);
+    os << DownloadCheckpointToString(checkpoint);
+    os.close();
+    if (!os.good()) {
+      return Status(StatusCode::kUnknown,
+                    "cannot write download checkpoint " + tmp);
+    }
+  }
+  if (std::rename(tmp.c_str(), path.c_str()) == 0) return Status();
+  // Some platforms cannot rename over an existing file. The previous checkpoint
+  // is lost if the process stops right here, the download restarts from zero.
+  std::remove(path.c_str());
+  if (std::rename(tmp.c_str(), path.c_str()) == 0) return Status();
+  return Status(StatusCode::kUnknown,
+                "cannot replace download checkpoint " + path);
+}
+
+void RemoveDownloadCheckpoint(std::string const& file_name) {
+  auto const path = DownloadCheckpointFileName(file_name);
+  std::remove(path.c_str());
+  std::remove((path + ".tmp").c_str());
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
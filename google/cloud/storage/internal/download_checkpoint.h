@@ -0,0 +1,94 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_DOWNLOAD_CHECKPOINT_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_DOWNLOAD_CHECKPOINT_H
+
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * The progress of a `Client::DownloadToFile()` call using `CheckpointDownload`.
+ *
+ * The first `offset` bytes of the object generation are already in the
+ * temporary file, and `crc32c` is the (unmasked) CRC32C checksum of those
+ * bytes. The download resumes from `offset`, extending the checksum, and the
+ * final value is compared against the object metadata.
+ */
+struct DownloadCheckpoint {
+  std::string bucket_name;
+  std::string object_name;
+  std::int64_t generation;
+  std::int64_t offset;
+  std::uint32_t crc32c;
+};
+
+bool operator==(DownloadCheckpoint const& lhs, DownloadCheckpoint const& rhs);
+inline bool operator!=(DownloadCheckpoint const& lhs,
+                       DownloadCheckpoint const& rhs) {
+  return !(lhs == rhs);
+}
+
+std::ostream& operator<<(std::ostream& os, DownloadCheckpoint const& rhs);
+
+/// The name of the file receiving the data until the download completes.
+std::string DownloadTemporaryFileName(std::string const& file_name);
+
+/// The name of the sidecar file containing the `DownloadCheckpoint`.
+std::string DownloadCheckpointFileName(std::string const& file_name);
+
+/// Parse a checkpoint from its JSON representation.
+StatusOr<DownloadCheckpoint> ParseDownloadCheckpoint(std::string const& json);
+
+/// Convert a checkpoint to its JSON representation.
+std::string DownloadCheckpointToString(DownloadCheckpoint const& checkpoint);
+
+/**
+ * Read the checkpoint for @p file_name, if any.
+ *
+ * Returns `kNotFound` if there is no checkpoint, and `kDataLoss` if the
+ * checkpoint cannot be parsed.
+ */
+StatusOr<DownloadCheckpoint> ReadDownloadCheckpoint(
+    std::string const& file_name);
+
+/**
+ * Save @p checkpoint for @p file_name.
+ *
+ * The checkpoint is written to a new file that replaces the previous
+ * checkpoint, so a crash leaves either the old or the new checkpoint intact.
+ */
+Status WriteDownloadCheckpoint(std::string const& file_name,
+                               DownloadCheckpoint const& checkpoint);
+
+/// Remove the checkpoint for @p file_name, ignoring any errors.
+void RemoveDownloadCheckpoint(std::string const& file_name);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_DOWNLOAD_CHECKPOINT_H
@@ -0,0 +1,119 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/download_checkpoint.h"
+#include "google/cloud/storage/testing/temp_file.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <fstream>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::testing::HasSubstr;
+
+DownloadCheckpoint MakeCheckpoint() {
+  return DownloadCheckpoint{"test-bucket", "test-object", 1234,
+                            static_cast<std::int64_t>(5) << 32, 0xDEADBEEF};
+}
+
+TEST(DownloadCheckpointTest, RoundTrip) {
+  auto const expected = MakeCheckpoint();
+  auto actual = ParseDownloadCheckpoint(DownloadCheckpointToString(expected));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(expected, *actual);
+}
+
+TEST(DownloadCheckpointTest, ParseInvalid) {
+  for (std::string const json : {
+           "",
+           "not-json",
+           R"js([])js",
+           R"js({"object": "o", "generation": 1, "offset": 2, "crc32c": 3})js",
+           R"js({"bucket": "b", "object": "o", "offset": 2, "crc32c": 3})js",
+           R"js({"bucket": "b", "object": "o", "generation": 1,
+                 "offset": "2", "crc32c": 3})js",
+           R"js({"bucket": "b", "object": "o", "generation": 1,
+                 "offset": -2, "crc32c": 3})js",
+       }) {
+    auto actual = ParseDownloadCheckpoint(json);
+    ASSERT_FALSE(actual) << "json=" << json;
+    EXPECT_EQ(StatusCode::kDataLoss, actual.status().code());
+  }
+}
+
+TEST(DownloadCheckpointTest, FileNames) {
+  EXPECT_EQ("foo.partial", DownloadTemporaryFileName("foo"));
+  EXPECT_EQ("foo.checkpoint", DownloadCheckpointFileName("foo"));
+}
+
+TEST(DownloadCheckpointTest, WriteAndRead) {
+  testing::TempFile temp("");
+  auto const file_name = temp.name();
+
+  auto missing = ReadDownloadCheckpoint(file_name);
+  ASSERT_FALSE(missing);
+  EXPECT_EQ(StatusCode::kNotFound, missing.status().code());
+
+  auto checkpoint = MakeCheckpoint();
+  ASSERT_STATUS_OK(WriteDownloadCheckpoint(file_name, checkpoint));
+  auto actual = ReadDownloadCheckpoint(file_name);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(checkpoint, *actual);
+
+  // Saving a new checkpoint replaces the previous one.
+  checkpoint.offset += 1024;
+  ASSERT_STATUS_OK(WriteDownloadCheckpoint(file_name, checkpoint));
+  actual = ReadDownloadCheckpoint(file_name);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(checkpoint, *actual);
+
+  RemoveDownloadCheckpoint(file_name);
+  missing = ReadDownloadCheckpoint(file_name);
+  ASSERT_FALSE(missing);
+  EXPECT_EQ(StatusCode::kNotFound, missing.status().code());
+}
+
+TEST(DownloadCheckpointTest, ReadCorrupted) {
+  testing::TempFile temp("");
+  auto const file_name = temp.name();
+  std::ofstream(DownloadCheckpointFileName(file_name)) << "{\"bucket\": ";
+
+  auto actual = ReadDownloadCheckpoint(file_name);
+  ASSERT_FALSE(actual);
+  EXPECT_EQ(StatusCode::kDataLoss, actual.status().code());
+  RemoveDownloadCheckpoint(file_name);
+}
+
+TEST(DownloadCheckpointTest, Printing) {
+  std::ostringstream os;
+  os << MakeCheckpoint();
+  auto const actual = os.str();
+  EXPECT_THAT(actual, HasSubstr("test-bucket"));
+  EXPECT_THAT(actual, HasSubstr("test-object"));
+  EXPECT_THAT(actual, HasSubstr("generation=1234"));
+  EXPECT_THAT(actual, HasSubstr("crc32c=3735928559"));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -15,6 +15,8 @@
 #include "google/cloud/storage/internal/generate_message_boundary.h"
 #include "google/cloud/internal/random.h"
 #include <gmock/gmock.h>
+#include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -83,6 +85,26 @@ TEST(GenerateMessageBoundaryTest, RequiresGrowth) {
   EXPECT_LT(kMatchedStringLength, boundary.size());
 }
 
+TEST(GenerateMessageBoundaryTest, PayloadRepeatsCandidates) {
+  // Return a predictable sequence of strings, so the payload can contain each
+  // candidate the function considers.
+  std::vector<std::string> fragments = {"abcd", "ef", "gh", "ij"};
+  std::size_t next = 0;
+  auto string_generator = [&fragments, &next](int) {
+    return next < fragments.size() ? fragments[next++] : std::string("z");
+  };
+
+  // The longer candidates appear before, after, and at the end of the shorter
+  // ones, including as the very last bytes of the payload.
+  std::string const payload =
+      "abcdefgh--abcd\r\n--abcd--abcdef\r\nabcdabcdefgh";
+  auto boundary =
+      GenerateMessageBoundary(payload, std::move(string_generator), 4, 2);
+  EXPECT_EQ("abcdefghij", boundary);
+  EXPECT_THAT(payload, Not(HasSubstr(boundary)));
+  EXPECT_THAT(payload, Not(HasSubstr("--" + boundary)));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
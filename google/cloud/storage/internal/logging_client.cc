@@ -15,8 +15,10 @@
 #include "google/cloud/storage/internal/logging_client.h"
 #include "google/cloud/storage/internal/logging_resumable_upload_session.h"
 #include "google/cloud/storage/internal/raw_client_wrapper_utils.h"
+#include "google/cloud/storage/internal/trace_sampler.h"
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/log.h"
+#include <chrono>
 
 namespace google {
 namespace cloud {
@@ -31,8 +33,13 @@ using ::google::cloud::storage::internal::raw_client_wrapper_utils::Signature;
 /**
  * Logs the input and results of each `RawClient` operation.
  *
+ * Only the calls selected by @p sampler are logged, but calls that fail or
+ * are slow are always logged, including their request. The request and
+ * response are only formatted when they are logged.
+ *
  * @tparam MemberFunction the signature of the member function.
  * @param client the storage::RawClient object to make the call through.
+ * @param sampler selects the calls to log and truncates the payloads.
  * @param function the pointer to the member function to call.
  * @param request an initialized request parameter for the call.
  * @param error_message include this message in any exception or error log.
@@ -40,15 +47,30 @@ using ::google::cloud::storage::internal::raw_client_wrapper_utils::Signature;
  */
 template <typename MemberFunction>
 static typename Signature<MemberFunction>::ReturnType MakeCall(
-    RawClient& client, MemberFunction function,
+    RawClient& client, TraceSampler& sampler, MemberFunction function,
     typename Signature<MemberFunction>::RequestType const& request,
     char const* context) {
-  GCP_LOG(INFO) << context << "() << " << request;
+  auto const sampled = sampler.Sample();
+  if (sampled) {
+    GCP_LOG(INFO) << context << "() << " << sampler.Format(request);
+  }
+  auto const start = std::chrono::steady_clock::now();
   auto response = (client.*function)(request);
+  auto const latency = std::chrono::steady_clock::now() - start;
+  auto const slow = sampler.IsSlow(latency);
+  if (!sampled && !slow && response.ok()) return response;
+  if (!sampled) {
+    GCP_LOG(INFO) << context << "() << " << sampler.Format(request);
+  }
+  auto const latency_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(latency).count();
   if (response.ok()) {
-    GCP_LOG(INFO) << context << "() >> payload={" << response.value() << "}";
+    GCP_LOG(INFO) << context << "() >> latency=" << latency_ms
+                  << "ms payload={" << sampler.Format(response.value())
+                  << "}";
   } else {
-    GCP_LOG(INFO) << context << "() >> status={" << response.status() << "}";
+    GCP_LOG(INFO) << context << "() >> latency=" << latency_ms
+                  << "ms status={" << response.status() << "}";
   }
   return response;
 }
@@ -57,10 +79,12 @@ static typename Signature<MemberFunction>::ReturnType MakeCall(
  * Calls a `RawClient` operation logging only the input.
  *
  * This is useful when the result is not something you can easily log, such as
- * a pointer of some kind.
+ * a pointer of some kind. As with `MakeCall()`, calls that fail or are slow are
+ * always logged, with their status or latency instead of the result.
  *
  * @tparam MemberFunction the signature of the member function.
  * @param client the storage::RawClient object to make the call through.
+ * @param sampler selects the calls to log and truncates the payloads.
  * @param function the pointer to the member function to call.
  * @param request an initialized request parameter for the call.
  * @param error_message include this message in any exception or error log.
@@ -69,16 +93,35 @@ static typename Signature<MemberFunction>::ReturnType MakeCall(
 template <typename MemberFunction>
 static typename Signature<MemberFunction>::ReturnType MakeCallNoResponseLogging(
     google::cloud::storage::internal::RawClient& client,
-    MemberFunction function,
+    TraceSampler& sampler, MemberFunction function,
     typename Signature<MemberFunction>::RequestType const& request,
     char const* context) {
-  GCP_LOG(INFO) << context << "() << " << request;
-  return (client.*function)(request);
+  auto const sampled = sampler.Sample();
+  if (sampled) {
+    GCP_LOG(INFO) << context << "() << " << sampler.Format(request);
+  }
+  auto const start = std::chrono::steady_clock::now();
+  auto response = (client.*function)(request);
+  auto const latency = std::chrono::steady_clock::now() - start;
+  auto const slow = sampler.IsSlow(latency);
+  if (!slow && response.ok()) return response;
+  if (!sampled) {
+    GCP_LOG(INFO) << context << "() << " << sampler.Format(request);
+  }
+  auto const latency_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(latency).count();
+  if (response.ok()) {
+    GCP_LOG(INFO) << context << "() >> latency=" << latency_ms << "ms";
+  } else {
+    GCP_LOG(INFO) << context << "() >> latency=" << latency_ms
+                  << "ms status={" << response.status() << "}";
+  }
+  return response;
 }
 }  // namespace
 
 LoggingClient::LoggingClient(std::shared_ptr<RawClient> client)
-    : client_(std::move(client)) {}
+    : client_(std::move(client)), sampler_(client_->client_options()) {}
 
 ClientOptions const& LoggingClient::client_options() const {
   return client_->client_options();
@@ -86,124 +129,142 @@ ClientOptions const& LoggingClient::client_options() const {
 
 StatusOr<ListBucketsResponse> LoggingClient::ListBuckets(
     ListBucketsRequest const& request) {
-  return MakeCall(*client_, &RawClient::ListBuckets, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::ListBuckets, request,
+                  __func__);
 }
 
 StatusOr<BucketMetadata> LoggingClient::CreateBucket(
     CreateBucketRequest const& request) {
-  return MakeCall(*client_, &RawClient::CreateBucket, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::CreateBucket, request,
+                  __func__);
 }
 
 StatusOr<BucketMetadata> LoggingClient::GetBucketMetadata(
     GetBucketMetadataRequest const& request) {
-  return MakeCall(*client_, &RawClient::GetBucketMetadata, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::GetBucketMetadata, request,
+                  __func__);
 }
 
 StatusOr<EmptyResponse> LoggingClient::DeleteBucket(
     DeleteBucketRequest const& request) {
-  return MakeCall(*client_, &RawClient::DeleteBucket, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::DeleteBucket, request,
+                  __func__);
 }
 
 StatusOr<BucketMetadata> LoggingClient::UpdateBucket(
     UpdateBucketRequest const& request) {
-  return MakeCall(*client_, &RawClient::UpdateBucket, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::UpdateBucket, request,
+                  __func__);
 }
 
 StatusOr<BucketMetadata> LoggingClient::PatchBucket(
     PatchBucketRequest const& request) {
-  return MakeCall(*client_, &RawClient::PatchBucket, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::PatchBucket, request,
+                  __func__);
 }
 
 StatusOr<IamPolicy> LoggingClient::GetBucketIamPolicy(
     GetBucketIamPolicyRequest const& request) {
-  return MakeCall(*client_, &RawClient::GetBucketIamPolicy, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::GetBucketIamPolicy, request,
+                  __func__);
 }
 
 StatusOr<NativeIamPolicy> LoggingClient::GetNativeBucketIamPolicy(
     GetBucketIamPolicyRequest const& request) {
-  return MakeCall(*client_, &RawClient::GetNativeBucketIamPolicy, request,
-                  __func__);
+  return MakeCall(*client_, sampler_, &RawClient::GetNativeBucketIamPolicy,
+                  request, __func__);
 }
 
 StatusOr<IamPolicy> LoggingClient::SetBucketIamPolicy(
     SetBucketIamPolicyRequest const& request) {
-  return MakeCall(*client_, &RawClient::SetBucketIamPolicy, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::SetBucketIamPolicy, request,
+                  __func__);
 }
 
 StatusOr<NativeIamPolicy> LoggingClient::SetNativeBucketIamPolicy(
     SetNativeBucketIamPolicyRequest const& request) {
-  return MakeCall(*client_, &RawClient::SetNativeBucketIamPolicy, request,
-                  __func__);
+  return MakeCall(*client_, sampler_, &RawClient::SetNativeBucketIamPolicy,
+                  request, __func__);
 }
 
 StatusOr<TestBucketIamPermissionsResponse>
 LoggingClient::TestBucketIamPermissions(
     TestBucketIamPermissionsRequest const& request) {
-  return MakeCall(*client_, &RawClient::TestBucketIamPermissions, request,
-                  __func__);
+  return MakeCall(*client_, sampler_, &RawClient::TestBucketIamPermissions,
+                  request, __func__);
 }
 
 StatusOr<BucketMetadata> LoggingClient::LockBucketRetentionPolicy(
     LockBucketRetentionPolicyRequest const& request) {
-  return MakeCall(*client_, &RawClient::LockBucketRetentionPolicy, request,
-                  __func__);
+  return MakeCall(*client_, sampler_, &RawClient::LockBucketRetentionPolicy,
+                  request, __func__);
 }
 
 StatusOr<ObjectMetadata> LoggingClient::InsertObjectMedia(
     InsertObjectMediaRequest const& request) {
-  return MakeCall(*client_, &RawClient::InsertObjectMedia, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::InsertObjectMedia, request,
+                  __func__);
 }
 
 StatusOr<ObjectMetadata> LoggingClient::CopyObject(
     CopyObjectRequest const& request) {
-  return MakeCall(*client_, &RawClient::CopyObject, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::CopyObject, request,
+                  __func__);
 }
 
 StatusOr<ObjectMetadata> LoggingClient::GetObjectMetadata(
     GetObjectMetadataRequest const& request) {
-  return MakeCall(*client_, &RawClient::GetObjectMetadata, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::GetObjectMetadata, request,
+                  __func__);
 }
 
 StatusOr<std::unique_ptr<ObjectReadSource>> LoggingClient::ReadObject(
     ReadObjectRangeRequest const& request) {
-  return MakeCallNoResponseLogging(*client_, &RawClient::ReadObject, request,
-                                   __func__);
+  return MakeCallNoResponseLogging(*client_, sampler_, &RawClient::ReadObject,
+                                   request, __func__);
 }
 
 StatusOr<ListObjectsResponse> LoggingClient::ListObjects(
     ListObjectsRequest const& request) {
-  return MakeCall(*client_, &RawClient::ListObjects, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::ListObjects, request,
+                  __func__);
 }
 
 StatusOr<EmptyResponse> LoggingClient::DeleteObject(
     DeleteObjectRequest const& request) {
-  return MakeCall(*client_, &RawClient::DeleteObject, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::DeleteObject, request,
+                  __func__);
 }
 
 StatusOr<ObjectMetadata> LoggingClient::UpdateObject(
     UpdateObjectRequest const& request) {
-  return MakeCall(*client_, &RawClient::UpdateObject, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::UpdateObject, request,
+                  __func__);
 }
 
 StatusOr<ObjectMetadata> LoggingClient::PatchObject(
     PatchObjectRequest const& request) {
-  return MakeCall(*client_, &RawClient::PatchObject, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::PatchObject, request,
+                  __func__);
 }
 
 StatusOr<ObjectMetadata> LoggingClient::ComposeObject(
     ComposeObjectRequest const& request) {
-  return MakeCall(*client_, &RawClient::ComposeObject, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::ComposeObject, request,
+                  __func__);
 }
 
 StatusOr<RewriteObjectResponse> LoggingClient::RewriteObject(
     RewriteObjectRequest const& request) {
-  return MakeCall(*client_, &RawClient::RewriteObject, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::RewriteObject, request,
+                  __func__);
 }
 
 StatusOr<std::unique_ptr<ResumableUploadSession>>
 LoggingClient::CreateResumableSession(ResumableUploadRequest const& request) {
   auto result = MakeCallNoResponseLogging(
-      *client_, &RawClient::CreateResumableSession, request, __func__);
+      *client_, sampler_, &RawClient::CreateResumableSession, request,
+      __func__);
   if (!result.ok()) {
     GCP_LOG(INFO) << __func__ << "() >> status={" << result.status() << "}";
     return std::move(result).status();
@@ -216,157 +277,181 @@ LoggingClient::CreateResumableSession(ResumableUploadRequest const& request) {
 StatusOr<std::unique_ptr<ResumableUploadSession>>
 LoggingClient::RestoreResumableSession(std::string const& request) {
   return MakeCallNoResponseLogging(
-      *client_, &RawClient::RestoreResumableSession, request, __func__);
+      *client_, sampler_, &RawClient::RestoreResumableSession, request,
+      __func__);
 }
 
 StatusOr<ListBucketAclResponse> LoggingClient::ListBucketAcl(
     ListBucketAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::ListBucketAcl, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::ListBucketAcl, request,
+                  __func__);
 }
 
 StatusOr<BucketAccessControl> LoggingClient::GetBucketAcl(
     GetBucketAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::GetBucketAcl, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::GetBucketAcl, request,
+                  __func__);
 }
 
 StatusOr<BucketAccessControl> LoggingClient::CreateBucketAcl(
     CreateBucketAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::CreateBucketAcl, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::CreateBucketAcl, request,
+                  __func__);
 }
 
 StatusOr<EmptyResponse> LoggingClient::DeleteBucketAcl(
     DeleteBucketAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::DeleteBucketAcl, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::DeleteBucketAcl, request,
+                  __func__);
 }
 
 StatusOr<BucketAccessControl> LoggingClient::UpdateBucketAcl(
     UpdateBucketAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::UpdateBucketAcl, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::UpdateBucketAcl, request,
+                  __func__);
 }
 
 StatusOr<BucketAccessControl> LoggingClient::PatchBucketAcl(
     PatchBucketAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::PatchBucketAcl, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::PatchBucketAcl, request,
+                  __func__);
 }
 
 StatusOr<ListObjectAclResponse> LoggingClient::ListObjectAcl(
     ListObjectAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::ListObjectAcl, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::ListObjectAcl, request,
+                  __func__);
 }
 
 StatusOr<ObjectAccessControl> LoggingClient::CreateObjectAcl(
     CreateObjectAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::CreateObjectAcl, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::CreateObjectAcl, request,
+                  __func__);
 }
 
 StatusOr<EmptyResponse> LoggingClient::DeleteObjectAcl(
     DeleteObjectAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::DeleteObjectAcl, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::DeleteObjectAcl, request,
+                  __func__);
 }
 
 StatusOr<ObjectAccessControl> LoggingClient::GetObjectAcl(
     GetObjectAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::GetObjectAcl, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::GetObjectAcl, request,
+                  __func__);
 }
 
 StatusOr<ObjectAccessControl> LoggingClient::UpdateObjectAcl(
     UpdateObjectAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::UpdateObjectAcl, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::UpdateObjectAcl, request,
+                  __func__);
 }
 
 StatusOr<ObjectAccessControl> LoggingClient::PatchObjectAcl(
     PatchObjectAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::PatchObjectAcl, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::PatchObjectAcl, request,
+                  __func__);
 }
 
 StatusOr<ListDefaultObjectAclResponse> LoggingClient::ListDefaultObjectAcl(
     ListDefaultObjectAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::ListDefaultObjectAcl, request,
+  return MakeCall(*client_, sampler_, &RawClient::ListDefaultObjectAcl, request,
                   __func__);
 }
 
 StatusOr<ObjectAccessControl> LoggingClient::CreateDefaultObjectAcl(
     CreateDefaultObjectAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::CreateDefaultObjectAcl, request,
-                  __func__);
+  return MakeCall(*client_, sampler_, &RawClient::CreateDefaultObjectAcl,
+                  request, __func__);
 }
 
 StatusOr<EmptyResponse> LoggingClient::DeleteDefaultObjectAcl(
     DeleteDefaultObjectAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::DeleteDefaultObjectAcl, request,
-                  __func__);
+  return MakeCall(*client_, sampler_, &RawClient::DeleteDefaultObjectAcl,
+                  request, __func__);
 }
 
 StatusOr<ObjectAccessControl> LoggingClient::GetDefaultObjectAcl(
     GetDefaultObjectAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::GetDefaultObjectAcl, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::GetDefaultObjectAcl, request,
+                  __func__);
 }
 
 StatusOr<ObjectAccessControl> LoggingClient::UpdateDefaultObjectAcl(
     UpdateDefaultObjectAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::UpdateDefaultObjectAcl, request,
-                  __func__);
+  return MakeCall(*client_, sampler_, &RawClient::UpdateDefaultObjectAcl,
+                  request, __func__);
 }
 
 StatusOr<ObjectAccessControl> LoggingClient::PatchDefaultObjectAcl(
     PatchDefaultObjectAclRequest const& request) {
-  return MakeCall(*client_, &RawClient::PatchDefaultObjectAcl, request,
-                  __func__);
+  return MakeCall(*client_, sampler_, &RawClient::PatchDefaultObjectAcl,
+                  request, __func__);
 }
 
 StatusOr<ServiceAccount> LoggingClient::GetServiceAccount(
     GetProjectServiceAccountRequest const& request) {
-  return MakeCall(*client_, &RawClient::GetServiceAccount, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::GetServiceAccount, request,
+                  __func__);
 }
 
 StatusOr<ListHmacKeysResponse> LoggingClient::ListHmacKeys(
     ListHmacKeysRequest const& request) {
-  return MakeCall(*client_, &RawClient::ListHmacKeys, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::ListHmacKeys, request,
+                  __func__);
 }
 
 StatusOr<CreateHmacKeyResponse> LoggingClient::CreateHmacKey(
     CreateHmacKeyRequest const& request) {
-  return MakeCall(*client_, &RawClient::CreateHmacKey, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::CreateHmacKey, request,
+                  __func__);
 }
 
 StatusOr<EmptyResponse> LoggingClient::DeleteHmacKey(
     DeleteHmacKeyRequest const& request) {
-  return MakeCall(*client_, &RawClient::DeleteHmacKey, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::DeleteHmacKey, request,
+                  __func__);
 }
 
 StatusOr<HmacKeyMetadata> LoggingClient::GetHmacKey(
     GetHmacKeyRequest const& request) {
-  return MakeCall(*client_, &RawClient::GetHmacKey, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::GetHmacKey, request,
+                  __func__);
 }
 
 StatusOr<HmacKeyMetadata> LoggingClient::UpdateHmacKey(
     UpdateHmacKeyRequest const& request) {
-  return MakeCall(*client_, &RawClient::UpdateHmacKey, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::UpdateHmacKey, request,
+                  __func__);
 }
 
 StatusOr<SignBlobResponse> LoggingClient::SignBlob(
     SignBlobRequest const& request) {
-  return MakeCall(*client_, &RawClient::SignBlob, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::SignBlob, request, __func__);
 }
 
 StatusOr<ListNotificationsResponse> LoggingClient::ListNotifications(
     ListNotificationsRequest const& request) {
-  return MakeCall(*client_, &RawClient::ListNotifications, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::ListNotifications, request,
+                  __func__);
 }
 
 StatusOr<NotificationMetadata> LoggingClient::CreateNotification(
     CreateNotificationRequest const& request) {
-  return MakeCall(*client_, &RawClient::CreateNotification, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::CreateNotification, request,
+                  __func__);
 }
 
 StatusOr<NotificationMetadata> LoggingClient::GetNotification(
     GetNotificationRequest const& request) {
-  return MakeCall(*client_, &RawClient::GetNotification, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::GetNotification, request,
+                  __func__);
 }
 
 StatusOr<EmptyResponse> LoggingClient::DeleteNotification(
     DeleteNotificationRequest const& request) {
-  return MakeCall(*client_, &RawClient::DeleteNotification, request, __func__);
+  return MakeCall(*client_, sampler_, &RawClient::DeleteNotification, request,
+                  __func__);
 }
 
 }  // namespace internal
@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_LOGGING_CLIENT_H
 
 #include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/internal/trace_sampler.h"
 #include "google/cloud/storage/version.h"
 
 namespace google {
@@ -25,6 +26,9 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 /**
  * A decorator for `RawClient` that logs each operation.
+ *
+ * The `tracing_*()` settings in `ClientOptions` control which operations are
+ * logged, and how much of each request and response is included.
  */
 class LoggingClient : public RawClient {
  public:
@@ -143,6 +147,7 @@ class LoggingClient : public RawClient {
 
  private:
   std::shared_ptr<RawClient> client_;
+  TraceSampler sampler_;
 };
 
 }  // namespace internal
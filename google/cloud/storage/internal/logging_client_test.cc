@@ -13,10 +13,13 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/logging_client.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
 #include "google/cloud/storage/testing/canonical_errors.h"
 #include "google/cloud/storage/testing/mock_client.h"
 #include "google/cloud/log.h"
 #include <gmock/gmock.h>
+#include <chrono>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -29,7 +32,9 @@ using ::google::cloud::storage::testing::canonical_errors::TransientError;
 using ::testing::_;
 using ::testing::HasSubstr;
 using ::testing::Invoke;
+using ::testing::Not;
 using ::testing::Return;
+using ::testing::ReturnRef;
 
 class MockLogBackend : public google::cloud::LogBackend {
  public:
@@ -54,8 +59,17 @@ class LoggingClientTest : public ::testing::Test {
     log_backend.reset();
   }
 
+  std::shared_ptr<testing::MockClient> MakeMock() {
+    auto mock = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*mock, client_options())
+        .WillRepeatedly(ReturnRef(client_options));
+    return mock;
+  }
+
   std::shared_ptr<MockLogBackend> log_backend = nullptr;
   long log_backend_id = 0;
+  ClientOptions client_options =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
 };
 
 TEST_F(LoggingClientTest, GetBucketMetadata) {
@@ -66,7 +80,7 @@ TEST_F(LoggingClientTest, GetBucketMetadata) {
       "name": "my-bucket"
 })""";
 
-  auto mock = std::make_shared<testing::MockClient>();
+  auto mock = MakeMock();
   EXPECT_CALL(*mock, GetBucketMetadata(_))
       .WillOnce(
           Return(internal::BucketMetadataParser::FromString(text).value()));
@@ -91,7 +105,7 @@ TEST_F(LoggingClientTest, GetBucketMetadata) {
 }
 
 TEST_F(LoggingClientTest, GetBucketMetadataWithError) {
-  auto mock = std::make_shared<testing::MockClient>();
+  auto mock = MakeMock();
   EXPECT_CALL(*mock, GetBucketMetadata(_))
       .WillOnce(Return(StatusOr<BucketMetadata>(TransientError())));
 
@@ -119,7 +133,7 @@ TEST_F(LoggingClientTest, InsertObjectMedia) {
       "name": "baz"
 })""";
 
-  auto mock = std::make_shared<testing::MockClient>();
+  auto mock = MakeMock();
   EXPECT_CALL(*mock, InsertObjectMedia(_))
       .WillOnce(
           Return(internal::ObjectMetadataParser::FromString(text).value()));
@@ -155,7 +169,7 @@ TEST_F(LoggingClientTest, ListObjects) {
           R""({"name": "response-object-o2"})"")
           .value(),
   };
-  auto mock = std::make_shared<testing::MockClient>();
+  auto mock = MakeMock();
   EXPECT_CALL(*mock, ListObjects(_))
       .WillOnce(Return(make_status_or(ListObjectsResponse{"a-token", items})));
 
@@ -180,6 +194,115 @@ TEST_F(LoggingClientTest, ListObjects) {
   client.ListObjects(ListObjectsRequest("my-bucket"));
 }
 
+TEST_F(LoggingClientTest, SampledCalls) {
+  client_options.set_tracing_sample_rate(0.5);
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, GetBucketMetadata(_))
+      .Times(4)
+      .WillRepeatedly(Return(BucketMetadata{}));
+
+  // Only half the calls are logged, each one produces two log lines.
+  EXPECT_CALL(*log_backend, ProcessWithOwnership(_)).Times(4);
+
+  LoggingClient client(mock);
+  for (int i = 0; i != 4; ++i) {
+    client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket"));
+  }
+}
+
+TEST_F(LoggingClientTest, ErrorsAlwaysLogged) {
+  client_options.set_tracing_sample_rate(0.0);
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, GetBucketMetadata(_))
+      .WillOnce(Return(BucketMetadata{}))
+      .WillOnce(Return(StatusOr<BucketMetadata>(TransientError())));
+
+  // Only the failed call is logged, including its request.
+  EXPECT_CALL(*log_backend, ProcessWithOwnership(_))
+      .WillOnce(Invoke([](LogRecord lr) {
+        EXPECT_THAT(lr.message, HasSubstr(" << "));
+        EXPECT_THAT(lr.message, HasSubstr("failing-bucket"));
+      }))
+      .WillOnce(Invoke([](LogRecord lr) {
+        EXPECT_THAT(lr.message, HasSubstr(" >> "));
+        EXPECT_THAT(lr.message, HasSubstr("latency="));
+        EXPECT_THAT(lr.message, HasSubstr("status={"));
+      }));
+
+  LoggingClient client(mock);
+  client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket"));
+  client.GetBucketMetadata(GetBucketMetadataRequest("failing-bucket"));
+}
+
+TEST_F(LoggingClientTest, ErrorsAlwaysLoggedWithoutResponse) {
+  client_options.set_tracing_sample_rate(0.0);
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillOnce(Invoke([](ReadObjectRangeRequest const&) {
+        return StatusOr<std::unique_ptr<ObjectReadSource>>(TransientError());
+      }));
+
+  EXPECT_CALL(*log_backend, ProcessWithOwnership(_))
+      .WillOnce(Invoke([](LogRecord lr) {
+        EXPECT_THAT(lr.message, HasSubstr(" << "));
+        EXPECT_THAT(lr.message, HasSubstr("failing-bucket"));
+      }))
+      .WillOnce(Invoke([](LogRecord lr) {
+        EXPECT_THAT(lr.message, HasSubstr(" >> "));
+        EXPECT_THAT(lr.message, HasSubstr("status={"));
+      }));
+
+  LoggingClient client(mock);
+  client.ReadObject(ReadObjectRangeRequest("failing-bucket", "my-object"));
+}
+
+TEST_F(LoggingClientTest, SlowCallsAlwaysLogged) {
+  client_options.set_tracing_sample_rate(0.0)
+      .set_tracing_slow_request_threshold(std::chrono::milliseconds(10));
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, GetBucketMetadata(_))
+      .WillOnce(Return(BucketMetadata{}))
+      .WillOnce(Invoke([](GetBucketMetadataRequest const&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return make_status_or(BucketMetadata{});
+      }));
+
+  EXPECT_CALL(*log_backend, ProcessWithOwnership(_))
+      .WillOnce(Invoke([](LogRecord lr) {
+        EXPECT_THAT(lr.message, HasSubstr(" << "));
+        EXPECT_THAT(lr.message, HasSubstr("slow-bucket"));
+      }))
+      .WillOnce(Invoke([](LogRecord lr) {
+        EXPECT_THAT(lr.message, HasSubstr(" >> "));
+        EXPECT_THAT(lr.message, HasSubstr("payload={"));
+      }));
+
+  LoggingClient client(mock);
+  client.GetBucketMetadata(GetBucketMetadataRequest("my-bucket"));
+  client.GetBucketMetadata(GetBucketMetadataRequest("slow-bucket"));
+}
+
+TEST_F(LoggingClientTest, TruncatePayload) {
+  client_options.set_tracing_max_payload_size(32);
+  auto mock = MakeMock();
+  EXPECT_CALL(*mock, InsertObjectMedia(_))
+      .WillOnce(Return(ObjectMetadata{}));
+
+  EXPECT_CALL(*log_backend, ProcessWithOwnership(_))
+      .WillOnce(Invoke([](LogRecord lr) {
+        EXPECT_THAT(lr.message, HasSubstr(" << "));
+        EXPECT_THAT(lr.message, HasSubstr("truncated"));
+        EXPECT_THAT(lr.message, Not(HasSubstr(std::string(64, 'x'))));
+      }))
+      .WillOnce(Invoke([](LogRecord lr) {
+        EXPECT_THAT(lr.message, HasSubstr(" >> "));
+      }));
+
+  LoggingClient client(mock);
+  client.InsertObjectMedia(
+      InsertObjectMediaRequest("foo-bar", "baz", std::string(1024, 'x')));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
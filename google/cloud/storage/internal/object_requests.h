@@ -23,6 +23,7 @@
 #include "google/cloud/storage/upload_options.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/storage/well_known_parameters.h"
+#include <memory>
 
 namespace google {
 namespace cloud {
@@ -116,22 +117,44 @@ class InsertObjectMediaRequest
           MD5HashValue, PredefinedAcl, Projection, UserProject,
           WithObjectMetadata> {
  public:
-  InsertObjectMediaRequest() : GenericObjectRequest(), contents_() {}
+  InsertObjectMediaRequest()
+      : GenericObjectRequest(), contents_(std::make_shared<std::string>()) {}
 
   explicit InsertObjectMediaRequest(std::string bucket_name,
                                     std::string object_name,
                                     std::string contents)
       : GenericObjectRequest(std::move(bucket_name), std::move(object_name)),
-        contents_(std::move(contents)) {}
+        contents_(std::make_shared<std::string>(std::move(contents))) {}
+
+  /**
+   * Creates a request that shares @p contents instead of owning a copy.
+   *
+   * The buffer is immutable, so copies of this request, and all the retry
+   * attempts, refer to the same data.
+   */
+  explicit InsertObjectMediaRequest(
+      std::string bucket_name, std::string object_name,
+      std::shared_ptr<std::string const> contents)
+      : GenericObjectRequest(std::move(bucket_name), std::move(object_name)),
+        contents_(contents ? std::move(contents)
+                           : std::make_shared<std::string>()) {}
 
-  std::string const& contents() const { return contents_; }
+  std::string const& contents() const { return *contents_; }
+  std::shared_ptr<std::string const> const& shared_contents() const {
+    return contents_;
+  }
   InsertObjectMediaRequest& set_contents(std::string&& v) {
-    contents_ = std::move(v);
+    contents_ = std::make_shared<std::string>(std::move(v));
+    return *this;
+  }
+  InsertObjectMediaRequest& set_contents(
+      std::shared_ptr<std::string const> v) {
+    contents_ = v ? std::move(v) : std::make_shared<std::string>();
     return *this;
   }
 
  private:
-  std::string contents_;
+  std::shared_ptr<std::string const> contents_;
 };
 
 std::ostream& operator<<(std::ostream& os, InsertObjectMediaRequest const& r);
@@ -179,7 +202,7 @@ class ReadObjectRangeRequest
           ReadObjectRangeRequest, DisableCrc32cChecksum, DisableMD5Hash,
           EncryptionKey, Generation, IfGenerationMatch, IfGenerationNotMatch,
           IfMetagenerationMatch, IfMetagenerationNotMatch, ReadFromOffset,
-          ReadRange, ReadLast, UserProject> {
+          ReadRange, ReadLast, UserProject, CheckpointDownload> {
  public:
   using GenericObjectRequest::GenericObjectRequest;
 
@@ -167,6 +167,21 @@ TEST(ObjectRequestsTest, InsertObjectMediaUpdateContents) {
   EXPECT_EQ("new contents", request.contents());
 }
 
+TEST(ObjectRequestsTest, InsertObjectMediaSharedContents) {
+  auto contents = std::make_shared<std::string const>("object contents");
+  InsertObjectMediaRequest request("my-bucket", "my-object", contents);
+  EXPECT_EQ("object contents", request.contents());
+  EXPECT_EQ(contents.get(), &request.contents());
+
+  InsertObjectMediaRequest copy = request;
+  EXPECT_EQ(contents.get(), &copy.contents());
+
+  request.set_contents(std::shared_ptr<std::string const>{});
+  EXPECT_EQ("", request.contents());
+  request.set_contents(contents);
+  EXPECT_EQ(contents, request.shared_contents());
+}
+
 TEST(ObjectRequestsTest, Copy) {
   CopyObjectRequest request("source-bucket", "source-object", "my-bucket",
                             "my-object");
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/object_streambuf.h"
+#include "google/cloud/storage/internal/copy_accounting.h"
 #include "google/cloud/storage/internal/object_requests.h"
 #include "google/cloud/storage/object_stream.h"
 #include "google/cloud/log.h"
@@ -25,8 +26,9 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 ObjectReadStreambuf::ObjectReadStreambuf(
     ReadObjectRangeRequest const& request,
-    std::unique_ptr<ObjectReadSource> source)
-    : source_(std::move(source)) {
+    std::unique_ptr<ObjectReadSource> source,
+    std::shared_ptr<BufferPool> buffer_pool)
+    : source_(std::move(source)), buffer_pool_(std::move(buffer_pool)) {
   hash_validator_ = CreateHashValidator(request);
 }
 
@@ -57,7 +59,9 @@ StatusOr<ObjectReadStreambuf::int_type> ObjectReadStreambuf::Peek() {
   }
 
   auto constexpr kInitialPeekRead = 128 * 1024;
-  current_ios_buffer_.resize(kInitialPeekRead);
+  if (current_ios_buffer_.size() < kInitialPeekRead) {
+    current_ios_buffer_ = AcquireBuffer(buffer_pool_, kInitialPeekRead);
+  }
   std::size_t n = current_ios_buffer_.size();
   StatusOr<ReadSourceResult> read_result =
       source_->Read(current_ios_buffer_.data(), n);
@@ -65,7 +69,7 @@ StatusOr<ObjectReadStreambuf::int_type> ObjectReadStreambuf::Peek() {
     return std::move(read_result).status();
   }
   // assert(n <= current_ios_buffer_.size())
-  current_ios_buffer_.resize(read_result->bytes_received);
+  n = read_result->bytes_received;
 
   for (auto const& kv : read_result->response.headers) {
     hash_validator_->ProcessHeader(kv.first, kv.second);
@@ -75,10 +79,10 @@ StatusOr<ObjectReadStreambuf::int_type> ObjectReadStreambuf::Peek() {
     return AsStatus(read_result->response);
   }
 
-  if (!current_ios_buffer_.empty()) {
+  if (n != 0) {
     char* data = current_ios_buffer_.data();
-    hash_validator_->Update(data, current_ios_buffer_.size());
-    setg(data, data, data + current_ios_buffer_.size());
+    hash_validator_->Update(data, n);
+    setg(data, data, data + n);
     return traits_type::to_int_type(*data);
   }
 
@@ -171,6 +175,7 @@ std::streamsize ObjectReadStreambuf::xsgetn(char* s, std::streamsize count) {
   // read more in that case:
   auto from_internal = (std::min)(count, in_avail());
   std::memcpy(s, gptr(), static_cast<std::size_t>(from_internal));
+  RecordBytesCopied(static_cast<std::size_t>(from_internal));
   gbump(static_cast<int>(from_internal));
   offset += from_internal;
   if (offset >= count) {
@@ -228,21 +233,22 @@ ObjectReadStreambuf::int_type ObjectReadStreambuf::ReportError(Status status) {
 }
 
 void ObjectReadStreambuf::SetEmptyRegion() {
-  current_ios_buffer_.clear();
-  current_ios_buffer_.push_back('\0');
-  char* data = &current_ios_buffer_[0];
+  // The download is done, return the buffer so other streams can use it.
+  current_ios_buffer_ = PooledBuffer();
+  char* data = &empty_region_;
   setg(data, data + 1, data + 1);
 }
 
 ObjectWriteStreambuf::ObjectWriteStreambuf(
     std::unique_ptr<ResumableUploadSession> upload_session,
-    std::size_t max_buffer_size, std::unique_ptr<HashValidator> hash_validator)
+    std::size_t max_buffer_size, std::unique_ptr<HashValidator> hash_validator,
+    std::shared_ptr<BufferPool> const& buffer_pool)
     : upload_session_(std::move(upload_session)),
       max_buffer_size_(UploadChunkRequest::RoundUpToQuantum(max_buffer_size)),
       hash_validator_(std::move(hash_validator)),
       last_response_(ResumableUploadResponse{
           {}, 0, {}, ResumableUploadResponse::kInProgress, {}}) {
-  current_ios_buffer_.resize(max_buffer_size_);
+  current_ios_buffer_ = AcquireBuffer(buffer_pool, max_buffer_size_);
   auto pbeg = current_ios_buffer_.data();
   auto pend = pbeg + current_ios_buffer_.size();
   setp(pbeg, pend);
@@ -289,6 +295,7 @@ std::streamsize ObjectWriteStreambuf::xsputn(char const* s,
     std::streamsize bytes_to_copy =
         std::min(count - bytes_copied, remaining_buffer_size);
     std::copy(s, s + bytes_to_copy, pptr());
+    RecordBytesCopied(static_cast<std::size_t>(bytes_to_copy));
     pbump(static_cast<int>(bytes_to_copy));
     bytes_copied += bytes_to_copy;
     s += bytes_to_copy;
@@ -347,10 +354,10 @@ StatusOr<ResumableUploadResponse> ObjectWriteStreambuf::FlushFinal() {
     // error.
     return last_response_;
   }
-  // Reset the iostream put area with valid pointers, but empty.
-  current_ios_buffer_.resize(1);
-  auto pbeg = current_ios_buffer_.data();
-  setp(pbeg, pbeg);
+  // Reset the iostream put area, and return the buffer so other streams can
+  // use it.
+  setp(nullptr, nullptr);
+  current_ios_buffer_ = PooledBuffer();
 
   upload_session_.reset();
 
@@ -377,6 +384,7 @@ StatusOr<ResumableUploadResponse> ObjectWriteStreambuf::Flush() {
   hash_validator_->Update(pbase(), chunk_size);
   StatusOr<ResumableUploadResponse> result;
   std::string to_send(pbase(), chunk_size);
+  RecordBytesCopied(chunk_size);
   last_response_ = upload_session_->UploadChunk(to_send);
   if (!last_response_) {
     return last_response_;
@@ -400,6 +408,8 @@ StatusOr<ResumableUploadResponse> ObjectWriteStreambuf::Flush() {
     return Status(StatusCode::kAborted, error_message.str());
   }
   std::copy(pbase() + bytes_uploaded, epptr(), pbase());
+  RecordBytesCopied(static_cast<std::size_t>(epptr() - pbase()) -
+                    static_cast<std::size_t>(bytes_uploaded));
   setp(pbase(), epptr());
   pbump(static_cast<int>(actual_size - bytes_uploaded));
   return last_response_;
@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_STREAMBUF_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_STREAMBUF_H
 
+#include "google/cloud/storage/buffer_pool.h"
 #include "google/cloud/storage/internal/hash_validator.h"
 #include "google/cloud/storage/internal/http_response.h"
 #include "google/cloud/storage/internal/object_read_source.h"
@@ -42,7 +43,8 @@ namespace internal {
 class ObjectReadStreambuf : public std::basic_streambuf<char> {
  public:
   ObjectReadStreambuf(ReadObjectRangeRequest const& request,
-                      std::unique_ptr<ObjectReadSource> source);
+                      std::unique_ptr<ObjectReadSource> source,
+                      std::shared_ptr<BufferPool> buffer_pool = {});
 
   /// Create a streambuf in a permanent error status.
   ObjectReadStreambuf(ReadObjectRangeRequest const& request, Status status);
@@ -76,7 +78,9 @@ class ObjectReadStreambuf : public std::basic_streambuf<char> {
   std::streamsize xsgetn(char* s, std::streamsize count) override;
 
   std::unique_ptr<ObjectReadSource> source_;
-  std::vector<char> current_ios_buffer_;
+  std::shared_ptr<BufferPool> buffer_pool_;
+  PooledBuffer current_ios_buffer_;
+  char empty_region_ = '\0';
   std::unique_ptr<HashValidator> hash_validator_;
   HashValidator::Result hash_validator_result_;
   Status status_;
@@ -96,7 +100,8 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
 
   ObjectWriteStreambuf(std::unique_ptr<ResumableUploadSession> upload_session,
                        std::size_t max_buffer_size,
-                       std::unique_ptr<HashValidator> hash_validator);
+                       std::unique_ptr<HashValidator> hash_validator,
+                       std::shared_ptr<BufferPool> const& buffer_pool = {});
 
   ~ObjectWriteStreambuf() override = default;
 
@@ -142,7 +147,7 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
 
   std::unique_ptr<ResumableUploadSession> upload_session_;
 
-  std::vector<char> current_ios_buffer_;
+  PooledBuffer current_ios_buffer_;
   std::size_t max_buffer_size_;
 
   std::unique_ptr<HashValidator> hash_validator_;
@@ -14,6 +14,7 @@
 
 #include "google/cloud/storage/internal/sha256_hash.h"
 #include <openssl/evp.h>
+#include <openssl/hmac.h>
 #include <openssl/sha.h>
 #include <array>
 
@@ -39,6 +40,18 @@ std::vector<std::uint8_t> Sha256Hash(Byte const* data, std::size_t count) {
   // exists it must be large enough to fit an `unsigned char`.
   return {hash.begin(), hash.end()};
 }
+
+template <typename Byte,
+          typename std::enable_if<sizeof(Byte) == 1, int>::type = 0>
+std::vector<std::uint8_t> HmacSha256(Byte const* key, std::size_t key_size,
+                                     std::string const& str) {
+  std::array<unsigned char, EVP_MAX_MD_SIZE> hash{};
+  unsigned int size = 0;
+  HMAC(EVP_sha256(), key, static_cast<int>(key_size),
+       reinterpret_cast<unsigned char const*>(str.data()), str.size(),
+       hash.data(), &size);
+  return {hash.begin(), hash.begin() + size};
+}
 }  // namespace
 
 std::vector<std::uint8_t> Sha256Hash(std::string const& str) {
@@ -49,6 +62,16 @@ std::vector<std::uint8_t> Sha256Hash(std::vector<std::uint8_t> const& bytes) {
   return Sha256Hash(bytes.data(), bytes.size());
 }
 
+std::vector<std::uint8_t> HmacSha256(std::string const& key,
+                                     std::string const& str) {
+  return HmacSha256(key.data(), key.size(), str);
+}
+
+std::vector<std::uint8_t> HmacSha256(std::vector<std::uint8_t> const& key,
+                                     std::string const& str) {
+  return HmacSha256(key.data(), key.size(), str);
+}
+
 std::string HexEncode(std::vector<std::uint8_t> const& bytes) {
   std::string result;
   std::array<char, sizeof("ff")> buf{};
@@ -32,6 +32,14 @@ std::vector<std::uint8_t> Sha256Hash(std::string const& str);
 /// Return the SHA256 hash (as raw bytes) of @p bytes.
 std::vector<std::uint8_t> Sha256Hash(std::vector<std::uint8_t> const& bytes);
 
+/// Return the HMAC-SHA256 (as raw bytes) of @p str using @p key.
+std::vector<std::uint8_t> HmacSha256(std::string const& key,
+                                     std::string const& str);
+
+/// Return the HMAC-SHA256 (as raw bytes) of @p str using @p key.
+std::vector<std::uint8_t> HmacSha256(std::vector<std::uint8_t> const& key,
+                                     std::string const& str);
+
 /// Return @p bytes encoded as a lowercase hexadecimal string.
 std::string HexEncode(std::vector<std::uint8_t> const& bytes);
 
@@ -47,6 +47,18 @@ TEST(Sha256Hash, Simple) {
       HexEncode(Sha256Hash("The quick brown fox jumps over the lazy dog"));
 }
 
+TEST(Sha256Hash, HmacSimple) {
+  // The magic string was obtained using:
+  //   /bin/echo -n 'The quick brown fox jumps over the lazy dog' |
+  //       openssl dgst -sha256 -hmac key
+  std::string expected =
+      "f7bc83f430538424b13298e6aa6fb143ef4d59a14946175997479dbc2d1a3cd8";
+  std::string const payload = "The quick brown fox jumps over the lazy dog";
+  EXPECT_EQ(expected, HexEncode(HmacSha256("key", payload)));
+  std::vector<std::uint8_t> key{'k', 'e', 'y'};
+  EXPECT_EQ(expected, HexEncode(HmacSha256(key, payload)));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
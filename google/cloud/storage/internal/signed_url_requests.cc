@@ -25,6 +25,12 @@ namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
+namespace {
+// The V4 signed URLs always use the same region and service in their scope.
+char const kV4SignedUrlRegion[] = "auto";
+char const kV4SignedUrlService[] = "storage";
+char const kV4SignedUrlRequestType[] = "goog4_request";
+}  // namespace
 
 void SignUrlRequestCommon::SetOption(AddExtensionHeaderOption const& o) {
   if (!o.has_value()) {
@@ -201,7 +207,7 @@ std::string V4SignUrlRequest::CanonicalRequest(
 }
 
 std::string V4SignUrlRequest::StringToSign(std::string const& client_id) const {
-  return "GOOG4-RSA-SHA256\n" +
+  return Algorithm() + "\n" +
          google::cloud::internal::FormatV4SignedUrlTimestamp(timestamp_) +
          "\n" + Scope() + "\n" + CanonicalRequestHash(client_id);
 }
@@ -212,6 +218,11 @@ Status V4SignUrlRequest::Validate() {
                   "VirtualHostname and BucketBoundHostname cannot be specified "
                   "simultaneously");
   }
+  if (signing_hmac_key_.has_value() && signing_account().has_value()) {
+    return Status(StatusCode::kInvalidArgument,
+                  "SigningHmacKey and SigningAccount cannot be specified "
+                  "simultaneously");
+  }
   auto const& headers = common_request_.extension_headers();
   auto host_it = headers.find("host");
   if (host_it == headers.end()) {
@@ -262,15 +273,21 @@ std::string V4SignUrlRequest::CanonicalRequestHash(
   return HexEncode(Sha256Hash(CanonicalRequest(client_id)));
 }
 
+std::string V4SignUrlRequest::Algorithm() const {
+  return signing_hmac_key_.has_value() ? "GOOG4-HMAC-SHA256"
+                                       : "GOOG4-RSA-SHA256";
+}
+
 std::string V4SignUrlRequest::Scope() const {
-  return google::cloud::internal::FormatV4SignedUrlScope(timestamp_) +
-         "/auto/storage/goog4_request";
+  return google::cloud::internal::FormatV4SignedUrlScope(timestamp_) + "/" +
+         kV4SignedUrlRegion + "/" + kV4SignedUrlService + "/" +
+         kV4SignedUrlRequestType;
 }
 
 std::multimap<std::string, std::string>
 V4SignUrlRequest::CanonicalQueryParameters(std::string const& client_id) const {
   return {
-      {"X-Goog-Algorithm", "GOOG4-RSA-SHA256"},
+      {"X-Goog-Algorithm", Algorithm()},
       {"X-Goog-Credential", client_id + "/" + Scope()},
       {"X-Goog-Date",
        google::cloud::internal::FormatV4SignedUrlTimestamp(timestamp_)},
@@ -321,6 +338,31 @@ std::ostream& operator<<(std::ostream& os, V4SignUrlRequest const& r) {
             << r.StringToSign("placeholder-client-id") << "}";
 }
 
+std::vector<std::uint8_t> V4HmacSigningKey(std::string const& secret,
+                                           std::string const& date,
+                                           std::string const& region,
+                                           std::string const& service) {
+  auto key = HmacSha256("GOOG4" + secret, date);
+  key = HmacSha256(key, region);
+  key = HmacSha256(key, service);
+  return HmacSha256(key, kV4SignedUrlRequestType);
+}
+
+std::vector<std::uint8_t> V4HmacSigningKeyCache::SigningKey(
+    std::string const& access_id, std::string const& secret,
+    std::chrono::system_clock::time_point timestamp) {
+  auto date = google::cloud::internal::FormatV4SignedUrlScope(timestamp);
+  std::lock_guard<std::mutex> lk(mu_);
+  auto& entry = entries_[access_id];
+  if (entry.key.empty() || entry.scope != date || entry.secret != secret) {
+    entry.key = V4HmacSigningKey(secret, date, kV4SignedUrlRegion,
+                                 kV4SignedUrlService);
+    entry.scope = std::move(date);
+    entry.secret = secret;
+  }
+  return entry.key;
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
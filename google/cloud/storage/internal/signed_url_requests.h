@@ -20,8 +20,12 @@
 #include "google/cloud/storage/signed_url_options.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/storage/well_known_parameters.h"
+#include <chrono>
+#include <cstdint>
 #include <iosfwd>
 #include <map>
+#include <mutex>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -224,6 +228,7 @@ class V4SignUrlRequest {
   SigningAccountDelegates const& signing_account_delegates() const {
     return common_request_.signing_account_delegates();
   }
+  SigningHmacKey const& signing_hmac_key() const { return signing_hmac_key_; }
 
   std::chrono::system_clock::time_point timestamp() const { return timestamp_; }
   std::chrono::seconds expires() const { return expires_; }
@@ -294,6 +299,8 @@ class V4SignUrlRequest {
     common_request_.SetOption(o);
   }
 
+  void SetOption(SigningHmacKey const& o) { signing_hmac_key_ = o; }
+
   void SetOption(VirtualHostname const& hostname);
 
   void SetOption(BucketBoundHostname const& o);
@@ -302,6 +309,9 @@ class V4SignUrlRequest {
 
   std::string CanonicalRequestHash(std::string const& client_id) const;
 
+  /// The signing algorithm, which depends on the type of key used to sign.
+  std::string Algorithm() const;
+
   std::string Scope() const;
 
   std::multimap<std::string, std::string> CanonicalQueryParameters(
@@ -324,10 +334,50 @@ class V4SignUrlRequest {
   std::chrono::seconds expires_;
   bool virtual_host_name_;
   optional<std::string> domain_named_bucket_;
+  SigningHmacKey signing_hmac_key_;
 };
 
 std::ostream& operator<<(std::ostream& os, V4SignUrlRequest const& r);
 
+/**
+ * Derives the `GOOG4-HMAC-SHA256` signing key for a V4 signed URL.
+ *
+ * The signing key depends only on the HMAC secret and the date, region, and
+ * service in the credential scope, so it can be reused for all the URLs signed
+ * on the same day.
+ */
+std::vector<std::uint8_t> V4HmacSigningKey(std::string const& secret,
+                                           std::string const& date,
+                                           std::string const& region,
+                                           std::string const& service);
+
+/**
+ * Caches the derived `GOOG4-HMAC-SHA256` signing keys.
+ *
+ * Deriving the signing key requires four HMAC-SHA256 operations, this class
+ * keeps the most recent key for each HMAC access id, and only derives a new key
+ * when the scope (date, region, or service) or the secret change.
+ */
+class V4HmacSigningKeyCache {
+ public:
+  V4HmacSigningKeyCache() = default;
+
+  /// Returns the signing key to sign requests with @p timestamp.
+  std::vector<std::uint8_t> SigningKey(
+      std::string const& access_id, std::string const& secret,
+      std::chrono::system_clock::time_point timestamp);
+
+ private:
+  struct Entry {
+    std::string secret;
+    std::string scope;
+    std::vector<std::uint8_t> key;
+  };
+
+  std::mutex mu_;
+  std::map<std::string, Entry> entries_;
+};
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/signed_url_requests.h"
+#include "google/cloud/storage/internal/sha256_hash.h"
 #include "google/cloud/internal/format_time_point.h"
 #include "google/cloud/internal/parse_rfc3339.h"
 #include "google/cloud/testing_util/assert_ok.h"
@@ -635,6 +636,62 @@ TEST(V4SignedUrlRequests, BucketBoundHostnameReset) {
   EXPECT_EQ(expected, actual);
 }
 
+TEST(V4SignedUrlRequests, HmacKeyCanonicalQueryString) {
+  V4SignUrlRequest request("GET", "test-bucket", "test-object");
+  std::string const date = "2019-02-01T09:00:00Z";
+  auto const valid_for = std::chrono::seconds(10);
+  request.set_multiple_options(
+      SignedUrlTimestamp(google::cloud::internal::ParseRfc3339(date)),
+      SignedUrlDuration(valid_for),
+      SigningHmacKey("test-access-id", "test-secret"));
+  ASSERT_TRUE(request.signing_hmac_key().has_value());
+  EXPECT_EQ("test-access-id", request.signing_hmac_key().value().first);
+  EXPECT_EQ("test-secret", request.signing_hmac_key().value().second);
+
+  std::string expected =
+      "X-Goog-Algorithm=GOOG4-HMAC-SHA256"
+      "&X-Goog-Credential=test-access-id"
+      "%2F20190201%2Fauto%2Fstorage%2Fgoog4_request"
+      "&X-Goog-Date=20190201T090000Z"
+      "&X-Goog-Expires=10&X-Goog-SignedHeaders=";
+  EXPECT_EQ(expected, request.CanonicalQueryString("test-access-id"));
+  EXPECT_THAT(request.StringToSign("test-access-id"),
+              ::testing::StartsWith("GOOG4-HMAC-SHA256\n"));
+}
+
+TEST(V4SignedUrlRequests, HmacKeyAndSigningAccount) {
+  V4SignUrlRequest request("GET", "test-bucket", "test-object");
+  request.set_multiple_options(
+      SigningHmacKey("test-access-id", "test-secret"),
+      SigningAccount("another-account@example.com"));
+  EXPECT_EQ(StatusCode::kInvalidArgument, request.Validate().code());
+}
+
+TEST(V4SignedUrlRequests, HmacSigningKey) {
+  // The magic string was obtained using Python's `hmac` module, following the
+  // key derivation described in:
+  //   https://cloud.google.com/storage/docs/authentication/signatures
+  EXPECT_EQ("8482c200c3fe872e5712049e076509acb095093ccee465b21753ce4e4c9316f6",
+            HexEncode(V4HmacSigningKey("test-secret", "20190201", "auto",
+                                       "storage")));
+}
+
+TEST(V4SignedUrlRequests, HmacSigningKeyCache) {
+  V4HmacSigningKeyCache cache;
+  auto const day1 =
+      google::cloud::internal::ParseRfc3339("2019-02-01T09:00:00Z");
+  auto const day2 =
+      google::cloud::internal::ParseRfc3339("2019-02-02T09:00:00Z");
+  auto const k1 = cache.SigningKey("test-access-id", "test-secret", day1);
+  EXPECT_EQ("8482c200c3fe872e5712049e076509acb095093ccee465b21753ce4e4c9316f6",
+            HexEncode(k1));
+  EXPECT_EQ(k1, cache.SigningKey("test-access-id", "test-secret",
+                                 day1 + std::chrono::hours(1)));
+  EXPECT_EQ("3fb7ac29e7a0c0ff2a773a36d9e4cfd2824c269dc5e93ca6cfebe8662f16c486",
+            HexEncode(cache.SigningKey("test-access-id", "test-secret", day2)));
+  EXPECT_NE(k1, cache.SigningKey("test-access-id", "rotated-secret", day1));
+}
+
 TEST(DefaultCtorsWork, Trivial) {
   EXPECT_FALSE(ExpirationTime().has_value());
   EXPECT_FALSE(AddExtensionHeaderOption().has_value());
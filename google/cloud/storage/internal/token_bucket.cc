@@ -0,0 +1,58 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/token_bucket.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+TokenBucket::TokenBucket(std::int64_t rate, Clock::time_point now)
+    : rate_((std::max)(rate, std::int64_t{0})),
+      tokens_(static_cast<double>(rate_)),
+      last_refill_(now) {}
+
+void TokenBucket::SetRate(std::int64_t rate, Clock::time_point now) {
+  Refill(now);
+  rate_ = (std::max)(rate, std::int64_t{0});
+  tokens_ = (std::min)(tokens_, static_cast<double>(rate_));
+}
+
+std::chrono::microseconds TokenBucket::Reserve(std::int64_t tokens,
+                                               Clock::time_point now) {
+  if (rate_ == 0) return std::chrono::microseconds(0);
+  Refill(now);
+  tokens_ -= static_cast<double>(tokens);
+  if (tokens_ >= 0) return std::chrono::microseconds(0);
+  auto const seconds = -tokens_ / static_cast<double>(rate_);
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::duration<double>(seconds));
+}
+
+void TokenBucket::Refill(Clock::time_point now) {
+  if (now <= last_refill_) return;
+  auto const elapsed = std::chrono::duration<double>(now - last_refill_);
+  last_refill_ = now;
+  tokens_ = (std::min)(static_cast<double>(rate_),
+                       tokens_ + elapsed.count() * static_cast<double>(rate_));
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,74 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_TOKEN_BUCKET_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_TOKEN_BUCKET_H
+
+#include "google/cloud/storage/version.h"
+#include <chrono>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A simple token bucket to shape the bandwidth used by transfers.
+ *
+ * The bucket is refilled at `rate` tokens (bytes) per second, and holds at most
+ * one second worth of tokens. Callers reserve tokens *before* (or as) they
+ * transfer data; the bucket may go into debt, in which case `Reserve()` returns
+ * how long the caller should wait before transferring more data.
+ *
+ * A rate of 0 disables the bucket, i.e., all reservations succeed immediately.
+ *
+ * This class is not thread-safe, the caller must provide any synchronization.
+ * The current time is always passed as a parameter, which makes the class easy
+ * to test.
+ */
+class TokenBucket {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit TokenBucket(std::int64_t rate, Clock::time_point now);
+
+  std::int64_t rate() const { return rate_; }
+
+  /// Change the refill rate, the tokens accumulated so far are preserved.
+  void SetRate(std::int64_t rate, Clock::time_point now);
+
+  /**
+   * Consume @p tokens from the bucket.
+   *
+   * @return how long the caller should wait before consuming more tokens, zero
+   *     if the bucket is not in debt.
+   */
+  std::chrono::microseconds Reserve(std::int64_t tokens, Clock::time_point now);
+
+ private:
+  void Refill(Clock::time_point now);
+
+  std::int64_t rate_;
+  double tokens_;
+  Clock::time_point last_refill_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_TOKEN_BUCKET_H
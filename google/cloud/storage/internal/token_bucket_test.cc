@@ -0,0 +1,83 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/token_bucket.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::std::chrono::microseconds;
+using ::std::chrono::milliseconds;
+
+TEST(TokenBucketTest, Disabled) {
+  auto const now = TokenBucket::Clock::now();
+  TokenBucket tested(0, now);
+  EXPECT_EQ(0, tested.rate());
+  EXPECT_EQ(microseconds(0), tested.Reserve(1024 * 1024, now));
+  EXPECT_EQ(microseconds(0), tested.Reserve(1024 * 1024, now));
+}
+
+TEST(TokenBucketTest, StartsFull) {
+  auto const now = TokenBucket::Clock::now();
+  TokenBucket tested(1000, now);
+  EXPECT_EQ(microseconds(0), tested.Reserve(600, now));
+  EXPECT_EQ(microseconds(0), tested.Reserve(400, now));
+  // The bucket is now empty, 500 tokens take 500ms to refill.
+  EXPECT_EQ(milliseconds(500), tested.Reserve(500, now));
+}
+
+TEST(TokenBucketTest, Refill) {
+  auto const now = TokenBucket::Clock::now();
+  TokenBucket tested(1000, now);
+  EXPECT_EQ(microseconds(0), tested.Reserve(1000, now));
+  EXPECT_EQ(microseconds(0), tested.Reserve(250, now + milliseconds(250)));
+  EXPECT_EQ(milliseconds(100), tested.Reserve(100, now + milliseconds(250)));
+  // The debt must be repaid before more tokens are available.
+  EXPECT_EQ(microseconds(0), tested.Reserve(100, now + milliseconds(450)));
+}
+
+TEST(TokenBucketTest, BurstIsCapped) {
+  auto const now = TokenBucket::Clock::now();
+  TokenBucket tested(1000, now);
+  // Even after a long idle period the bucket holds at most one second worth of
+  // tokens.
+  auto const later = now + std::chrono::hours(1);
+  EXPECT_EQ(microseconds(0), tested.Reserve(1000, later));
+  EXPECT_EQ(milliseconds(1000), tested.Reserve(1000, later));
+}
+
+TEST(TokenBucketTest, SetRate) {
+  auto const now = TokenBucket::Clock::now();
+  TokenBucket tested(1000, now);
+  EXPECT_EQ(microseconds(0), tested.Reserve(1000, now));
+  tested.SetRate(2000, now);
+  EXPECT_EQ(2000, tested.rate());
+  EXPECT_EQ(milliseconds(500), tested.Reserve(1000, now));
+
+  tested.SetRate(0, now);
+  EXPECT_EQ(0, tested.rate());
+  EXPECT_EQ(microseconds(0), tested.Reserve(1000, now));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
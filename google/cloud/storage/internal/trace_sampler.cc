@@ -0,0 +1,65 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/trace_sampler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+std::uint64_t constexpr TraceSampler::kRateScale;
+
+TraceSampler::TraceSampler(ClientOptions const& options)
+    : TraceSampler(options.tracing_sample_rate(),
+                   options.tracing_max_payload_size(),
+                   options.tracing_slow_request_threshold()) {}
+
+TraceSampler::TraceSampler(double sample_rate, std::size_t max_payload_size,
+                           std::chrono::milliseconds slow_request_threshold)
+    : scaled_rate_(static_cast<std::uint64_t>(
+          std::llround((std::max)(0.0, (std::min)(1.0, sample_rate)) *
+                       static_cast<double>(kRateScale)))),
+      max_payload_size_(max_payload_size),
+      slow_request_threshold_(slow_request_threshold),
+      calls_(0) {}
+
+bool TraceSampler::Sample() {
+  if (scaled_rate_ == kRateScale) return true;
+  if (scaled_rate_ == 0) return false;
+  // Call `n` is sampled if `floor((n + 1) * rate) > floor(n * rate)`, this
+  // spreads the sampled calls evenly. The pattern repeats every `kRateScale`
+  // calls, so the computation cannot overflow.
+  auto const n = calls_.fetch_add(1) % kRateScale;
+  return (n + 1) * scaled_rate_ / kRateScale > n * scaled_rate_ / kRateScale;
+}
+
+std::string TraceSampler::Truncate(std::string payload) const {
+  if (max_payload_size_ == 0 || payload.size() <= max_payload_size_) {
+    return payload;
+  }
+  auto const omitted = payload.size() - max_payload_size_;
+  payload.resize(max_payload_size_);
+  payload += "...<truncated " + std::to_string(omitted) + " bytes>";
+  return payload;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
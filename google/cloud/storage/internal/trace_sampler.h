@@ -0,0 +1,80 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_TRACE_SAMPLER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_TRACE_SAMPLER_H
+
+#include "google/cloud/storage/client_options.h"
+#include "google/cloud/storage/version.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Decide which calls are traced, and how much of each call is logged.
+ *
+ * The sampling is deterministic: with a sample rate of `0.25` exactly one in
+ * every four calls is sampled. This avoids any locking or random number
+ * generation in the hot path. This class is thread-safe.
+ */
+class TraceSampler {
+ public:
+  explicit TraceSampler(ClientOptions const& options);
+  TraceSampler(double sample_rate, std::size_t max_payload_size,
+               std::chrono::milliseconds slow_request_threshold);
+
+  /// Return true if the next call should be traced.
+  bool Sample();
+
+  /// Return true if a call taking @p latency should always be traced.
+  bool IsSlow(std::chrono::steady_clock::duration latency) const {
+    return slow_request_threshold_.count() != 0 &&
+           latency >= slow_request_threshold_;
+  }
+
+  /// Truncate @p payload to the maximum payload size.
+  std::string Truncate(std::string payload) const;
+
+  /// Format @p value using its `operator<<` and truncate the result.
+  template <typename T>
+  std::string Format(T const& value) const {
+    std::ostringstream os;
+    os << value;
+    return Truncate(os.str());
+  }
+
+ private:
+  static std::uint64_t constexpr kRateScale = 1000 * 1000;
+
+  std::uint64_t scaled_rate_;
+  std::size_t max_payload_size_;
+  std::chrono::milliseconds slow_request_threshold_;
+  std::atomic<std::uint64_t> calls_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_TRACE_SAMPLER_H
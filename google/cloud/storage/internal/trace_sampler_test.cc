@@ -0,0 +1,94 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/trace_sampler.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::testing::HasSubstr;
+using ::testing::StartsWith;
+
+int CountSampled(TraceSampler& tested, int calls) {
+  int count = 0;
+  for (int i = 0; i != calls; ++i) {
+    if (tested.Sample()) ++count;
+  }
+  return count;
+}
+
+TEST(TraceSamplerTest, SampleAll) {
+  TraceSampler tested(1.0, 0, std::chrono::milliseconds(0));
+  EXPECT_EQ(100, CountSampled(tested, 100));
+}
+
+TEST(TraceSamplerTest, SampleNone) {
+  TraceSampler tested(0.0, 0, std::chrono::milliseconds(0));
+  EXPECT_EQ(0, CountSampled(tested, 100));
+}
+
+TEST(TraceSamplerTest, SampleFraction) {
+  TraceSampler tested(0.25, 0, std::chrono::milliseconds(0));
+  // The sampled calls are evenly spread.
+  EXPECT_EQ(1, CountSampled(tested, 4));
+  EXPECT_EQ(1, CountSampled(tested, 4));
+  EXPECT_EQ(25, CountSampled(tested, 100));
+}
+
+TEST(TraceSamplerTest, FromClientOptions) {
+  ClientOptions options(oauth2::CreateAnonymousCredentials());
+  options.set_tracing_sample_rate(0.5)
+      .set_tracing_max_payload_size(4)
+      .set_tracing_slow_request_threshold(std::chrono::milliseconds(10));
+  TraceSampler tested(options);
+  EXPECT_EQ(50, CountSampled(tested, 100));
+  EXPECT_THAT(tested.Truncate("0123456789"), StartsWith("0123..."));
+  EXPECT_TRUE(tested.IsSlow(std::chrono::milliseconds(10)));
+}
+
+TEST(TraceSamplerTest, IsSlow) {
+  TraceSampler disabled(1.0, 0, std::chrono::milliseconds(0));
+  EXPECT_FALSE(disabled.IsSlow(std::chrono::hours(1)));
+
+  TraceSampler tested(1.0, 0, std::chrono::milliseconds(100));
+  EXPECT_FALSE(tested.IsSlow(std::chrono::milliseconds(99)));
+  EXPECT_TRUE(tested.IsSlow(std::chrono::milliseconds(100)));
+  EXPECT_TRUE(tested.IsSlow(std::chrono::seconds(1)));
+}
+
+TEST(TraceSamplerTest, Truncate) {
+  TraceSampler unlimited(1.0, 0, std::chrono::milliseconds(0));
+  std::string const payload(1000, 'x');
+  EXPECT_EQ(payload, unlimited.Truncate(payload));
+
+  TraceSampler tested(1.0, 16, std::chrono::milliseconds(0));
+  EXPECT_EQ("short", tested.Truncate("short"));
+  auto actual = tested.Truncate(payload);
+  EXPECT_THAT(actual, StartsWith(std::string(16, 'x') + "..."));
+  EXPECT_THAT(actual, HasSubstr("truncated 984 bytes"));
+  EXPECT_THAT(tested.Format(std::string(20, 'y')), HasSubstr("truncated 4"));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
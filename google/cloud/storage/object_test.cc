@@ -88,6 +88,30 @@ TEST_F(ObjectTest, InsertObjectMedia) {
   EXPECT_EQ(expected, *actual);
 }
 
+TEST_F(ObjectTest, InsertObjectMediaSharedContents) {
+  std::string text = R"""({
+      "name": "test-bucket-name/test-object-name/1"
+})""";
+  auto expected =
+      storage::internal::ObjectMetadataParser::FromString(text).value();
+  auto contents = std::make_shared<std::string const>("test object contents");
+
+  EXPECT_CALL(*mock, InsertObjectMedia(_))
+      .WillOnce(Invoke([&expected, contents](
+                           internal::InsertObjectMediaRequest const& request) {
+        EXPECT_EQ("test-bucket-name", request.bucket_name());
+        EXPECT_EQ("test-object-name", request.object_name());
+        // The buffer is shared with the application, not copied.
+        EXPECT_EQ(contents.get(), &request.contents());
+        return make_status_or(expected);
+      }));
+
+  auto actual =
+      client->InsertObject("test-bucket-name", "test-object-name", contents);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(expected, *actual);
+}
+
 TEST_F(ObjectTest, InsertObjectMediaTooManyFailures) {
   testing::TooManyFailuresStatusTest<ObjectMetadata>(
       mock, EXPECT_CALL(*mock, InsertObjectMedia(_)),
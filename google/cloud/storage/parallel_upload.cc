@@ -26,9 +26,10 @@ class ParallelObjectWriteStreambuf : public ObjectWriteStreambuf {
       std::shared_ptr<ParallelUploadStateImpl> state, std::size_t stream_idx,
       std::unique_ptr<ResumableUploadSession> upload_session,
       std::size_t max_buffer_size,
-      std::unique_ptr<HashValidator> hash_validator)
+      std::unique_ptr<HashValidator> hash_validator,
+      std::shared_ptr<BufferPool> const& buffer_pool)
       : ObjectWriteStreambuf(std::move(upload_session), max_buffer_size,
-                             std::move(hash_validator)),
+                             std::move(hash_validator), buffer_pool),
         state_(std::move(state)),
         stream_idx_(stream_idx) {}
 
@@ -86,7 +87,8 @@ StatusOr<ObjectWriteStream> ParallelUploadStateImpl::CreateStream(
       google::cloud::internal::make_unique<ParallelObjectWriteStreambuf>(
           shared_from_this(), idx, *std::move(session),
           raw_client.client_options().upload_buffer_size(),
-          CreateHashValidator(request)));
+          CreateHashValidator(request),
+          raw_client.client_options().buffer_pool()));
 }
 
 std::string ParallelUploadPersistentState::ToString() const {
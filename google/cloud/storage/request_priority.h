@@ -0,0 +1,81 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_REQUEST_PRIORITY_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_REQUEST_PRIORITY_H
+
+#include "google/cloud/storage/internal/complex_option.h"
+#include "google/cloud/storage/version.h"
+#include <iosfwd>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/// The scheduling classes for requests sharing a `Client`.
+enum class RequestPriorityClass {
+  kNormal,
+  kHigh,
+};
+
+std::ostream& operator<<(std::ostream& os, RequestPriorityClass rhs);
+
+/**
+ * Set the scheduling class for a request.
+ *
+ * By default all the requests made through a `Client` share the same pool of
+ * HTTP connections. Large transfers can hold on to these connections for a long
+ * time, forcing small requests to create (and negotiate) new connections. Use
+ * this option to mark latency-sensitive requests, such as metadata reads or
+ * small downloads, as high priority. High priority requests:
+ *
+ * - Use connections from a separate pool, sized by
+ *   `ClientOptions::high_priority_connection_pool_size()`, which normal
+ *   requests never use.
+ * - Are not delayed by the `BandwidthLimiter` configured in `ClientOptions`,
+ *   if any.
+ *
+ * @par Example
+ * @code
+ * namespace gcs = google::cloud::storage;
+ * gcs::Client client = ...;
+ * auto metadata = client.GetObjectMetadata(
+ *     "my-bucket", "my-object", gcs::HighPriority());
+ * @endcode
+ */
+struct RequestPriority
+    : public internal::ComplexOption<RequestPriority, RequestPriorityClass> {
+  using ComplexOption<RequestPriority, RequestPriorityClass>::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  RequestPriority() = default;
+  static char const* name() { return "request-priority"; }
+};
+
+/// Create a RequestPriority option for latency-sensitive requests.
+inline RequestPriority HighPriority() {
+  return RequestPriority(RequestPriorityClass::kHigh);
+}
+
+/// Create a RequestPriority option for requests without special requirements.
+inline RequestPriority NormalPriority() {
+  return RequestPriority(RequestPriorityClass::kNormal);
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_REQUEST_PRIORITY_H
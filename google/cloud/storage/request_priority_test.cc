@@ -0,0 +1,43 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/request_priority.h"
+#include <gmock/gmock.h>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+TEST(RequestPriorityTest, Helpers) {
+  EXPECT_FALSE(RequestPriority().has_value());
+  EXPECT_EQ(RequestPriorityClass::kHigh, HighPriority().value());
+  EXPECT_EQ(RequestPriorityClass::kNormal, NormalPriority().value());
+}
+
+TEST(RequestPriorityTest, Streaming) {
+  std::ostringstream os;
+  os << HighPriority() << " " << NormalPriority() << " " << RequestPriority();
+  EXPECT_EQ("request-priority=HIGH request-priority=NORMAL"
+            " request-priority=<not set>",
+            os.str());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
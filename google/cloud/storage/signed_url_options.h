@@ -209,6 +209,32 @@ struct SigningAccountDelegates
   static char const* name() { return "signing-account-delegates"; }
 };
 
+/**
+ * Sign a V4 URL using an HMAC key instead of a service account key.
+ *
+ * With this option the URL is signed using the `GOOG4-HMAC-SHA256` algorithm.
+ * The signature is computed locally from the HMAC secret, without any RSA
+ * private key operations or calls to the `SignBlob` API. The value is a pair
+ * with the HMAC key access id and its secret, for example as returned by
+ * `Client::CreateHmacKey()`.
+ *
+ * @see https://cloud.google.com/storage/docs/authentication/hmackeys for a
+ *     general description of HMAC keys.
+ */
+struct SigningHmacKey
+    : public internal::ComplexOption<SigningHmacKey,
+                                     std::pair<std::string, std::string>> {
+  using ComplexOption<SigningHmacKey,
+                      std::pair<std::string, std::string>>::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  SigningHmacKey() = default;
+  SigningHmacKey(std::string access_id, std::string secret)
+      : ComplexOption(std::make_pair(std::move(access_id), std::move(secret))) {
+  }
+  static char const* name() { return "signing-hmac-key"; }
+};
+
 /**
  * Indicate that the bucket should be a part of hostname in the URL.
  *
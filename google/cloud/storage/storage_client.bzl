@@ -17,8 +17,10 @@
 """Automatically generated source lists for storage_client - DO NOT EDIT."""
 
 storage_client_hdrs = [
+    "bandwidth_limiter.h",
     "bucket_access_control.h",
     "bucket_metadata.h",
+    "buffer_pool.h",
     "client.h",
     "client_options.h",
     "download_options.h",
@@ -33,6 +35,7 @@ storage_client_hdrs = [
     "internal/common_metadata.h",
     "internal/complex_option.h",
     "internal/compute_engine_util.h",
+    "internal/copy_accounting.h",
     "internal/curl_client.h",
     "internal/curl_download_request.h",
     "internal/curl_handle.h",
@@ -42,6 +45,7 @@ storage_client_hdrs = [
     "internal/curl_resumable_upload_session.h",
     "internal/curl_wrappers.h",
     "internal/default_object_acl_requests.h",
+    "internal/download_checkpoint.h",
     "internal/empty_response.h",
     "internal/generate_message_boundary.h",
     "internal/generic_object_request.h",
@@ -74,6 +78,8 @@ storage_client_hdrs = [
     "internal/sha256_hash.h",
     "internal/sign_blob_requests.h",
     "internal/signed_url_requests.h",
+    "internal/token_bucket.h",
+    "internal/trace_sampler.h",
     "internal/tuple_filter.h",
     "lifecycle_rule.h",
     "list_buckets_reader.h",
@@ -98,6 +104,7 @@ storage_client_hdrs = [
     "override_default_project.h",
     "parallel_upload.h",
     "policy_document.h",
+    "request_priority.h",
     "retry_policy.h",
     "service_account.h",
     "signed_url_options.h",
@@ -110,8 +117,10 @@ storage_client_hdrs = [
 ]
 
 storage_client_srcs = [
+    "bandwidth_limiter.cc",
     "bucket_access_control.cc",
     "bucket_metadata.cc",
+    "buffer_pool.cc",
     "client.cc",
     "client_options.cc",
     "hashing_options.cc",
@@ -123,6 +132,7 @@ storage_client_srcs = [
     "internal/bucket_acl_requests.cc",
     "internal/bucket_requests.cc",
     "internal/compute_engine_util.cc",
+    "internal/copy_accounting.cc",
     "internal/curl_client.cc",
     "internal/curl_download_request.cc",
     "internal/curl_handle.cc",
@@ -132,6 +142,7 @@ storage_client_srcs = [
     "internal/curl_resumable_upload_session.cc",
     "internal/curl_wrappers.cc",
     "internal/default_object_acl_requests.cc",
+    "internal/download_checkpoint.cc",
     "internal/empty_response.cc",
     "internal/hash_validator.cc",
     "internal/hash_validator_impl.cc",
@@ -154,6 +165,8 @@ storage_client_srcs = [
     "internal/sha256_hash.cc",
     "internal/sign_blob_requests.cc",
     "internal/signed_url_requests.cc",
+    "internal/token_bucket.cc",
+    "internal/trace_sampler.cc",
     "lifecycle_rule.cc",
     "list_buckets_reader.cc",
     "list_hmac_keys_reader.cc",
@@ -173,6 +186,7 @@ storage_client_srcs = [
     "object_stream.cc",
     "parallel_upload.cc",
     "policy_document.cc",
+    "request_priority.cc",
     "service_account.cc",
     "version.cc",
     "well_known_headers.cc",
@@ -17,11 +17,14 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 storage_client_unit_tests = [
+    "bandwidth_limiter_test.cc",
     "bucket_access_control_test.cc",
     "bucket_metadata_test.cc",
     "bucket_test.cc",
+    "buffer_pool_test.cc",
     "client_bucket_acl_test.cc",
     "client_default_object_acl_test.cc",
+    "client_download_checkpoint_test.cc",
     "client_notifications_test.cc",
     "client_object_acl_test.cc",
     "client_object_copy_test.cc",
@@ -49,6 +52,7 @@ storage_client_unit_tests = [
     "internal/curl_wrappers_locking_disabled_test.cc",
     "internal/curl_wrappers_locking_enabled_test.cc",
     "internal/default_object_acl_requests_test.cc",
+    "internal/download_checkpoint_test.cc",
     "internal/generate_message_boundary_test.cc",
     "internal/generic_request_test.cc",
     "internal/hash_validator_test.cc",
@@ -75,6 +79,8 @@ storage_client_unit_tests = [
     "internal/sha256_hash_test.cc",
     "internal/sign_blob_requests_test.cc",
     "internal/signed_url_requests_test.cc",
+    "internal/token_bucket_test.cc",
+    "internal/trace_sampler_test.cc",
     "internal/tuple_filter_test.cc",
     "lifecycle_rule_test.cc",
     "list_buckets_reader_test.cc",
@@ -93,6 +99,7 @@ storage_client_unit_tests = [
     "object_test.cc",
     "parallel_uploads_test.cc",
     "policy_document_test.cc",
+    "request_priority_test.cc",
     "retry_policy_test.cc",
     "service_account_test.cc",
     "signed_url_options_test.cc",
@@ -12,9 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "google/cloud/storage/bandwidth_limiter.h"
 #include "google/cloud/storage/internal/curl_request_builder.h"
 #include "google/cloud/storage/internal/nljson.h"
 #include "google/cloud/storage/oauth2/anonymous_credentials.h"
+#include "google/cloud/storage/request_priority.h"
 #include "google/cloud/internal/getenv.h"
 #include "google/cloud/log.h"
 #include "google/cloud/testing_util/assert_ok.h"
@@ -415,6 +417,146 @@ TEST(CurlRequestTest, Logging) {
   EXPECT_THAT(log_messages, HasSubstr("curl(Recv Header)"));
   EXPECT_THAT(log_messages, HasSubstr("curl(Recv Data)"));
 }
+
+/// @test Verify that a payload split across several buffers arrives intact.
+TEST(CurlRequestTest, UploadBufferSequence) {
+  // Use the same layout as a multipart upload: a preamble, the payload, and an
+  // epilogue, each in a separate buffer.
+  std::string const preamble =
+      "--boundary\r\ncontent-type: application/octet-stream\r\n\r\n";
+  std::string const epilogue = "\r\n--boundary--\r\n";
+  // The payload is larger than the libcurl read buffer, and the buffers are not
+  // aligned with it, so some read callbacks span two buffers. The contents do
+  // not repeat with a period that is a power of two, so data sent out of order
+  // would be detected.
+  std::string const chars =
+      "abcdefghijklmnopqrstuvwxyz012456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  std::string payload;
+  for (int i = 0; i != 300001; ++i) payload += chars[i % chars.size()];
+  auto const split = std::size_t{100003};
+
+  storage::internal::CurlRequestBuilder request(
+      HttpBinEndpoint() + "/post",
+      storage::internal::GetDefaultCurlHandleFactory());
+  request.AddHeader("Content-Type: application/octet-stream");
+  auto response = request.BuildRequest().MakeUploadRequest({
+      ConstBuffer{preamble.data(), 0},
+      ConstBuffer{preamble.data(), preamble.size()},
+      ConstBuffer{payload.data(), 0},
+      ConstBuffer{payload.data(), split},
+      ConstBuffer{payload.data() + split, payload.size() - split},
+      ConstBuffer{epilogue.data(), epilogue.size()},
+      ConstBuffer{epilogue.data(), 0},
+  });
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ(200, response->status_code);
+  nl::json parsed = nl::json::parse(response->payload);
+  auto const received = parsed["data"].get<std::string>();
+  ASSERT_EQ(preamble.size() + payload.size() + epilogue.size(),
+            received.size());
+  EXPECT_EQ(preamble, received.substr(0, preamble.size()));
+  EXPECT_TRUE(payload == received.substr(preamble.size(), payload.size()));
+  EXPECT_EQ(epilogue, received.substr(preamble.size() + payload.size()));
+}
+
+/// @test Verify that a sequence of empty buffers sends an empty payload.
+TEST(CurlRequestTest, UploadEmptyBufferSequence) {
+  std::string const empty;
+  for (auto const& buffers :
+       {ConstBufferSequence{},
+        ConstBufferSequence{{empty.data(), 0}, {empty.data(), 0}}}) {
+    storage::internal::CurlRequestBuilder request(
+        HttpBinEndpoint() + "/post",
+        storage::internal::GetDefaultCurlHandleFactory());
+    request.AddHeader("Content-Type: application/octet-stream");
+    auto response = request.BuildRequest().MakeUploadRequest(buffers);
+    ASSERT_STATUS_OK(response);
+    EXPECT_EQ(200, response->status_code);
+    nl::json parsed = nl::json::parse(response->payload);
+    EXPECT_EQ("", parsed["data"].get<std::string>());
+  }
+}
+
+// The payload is half the limiter's one second burst, so the transfers never
+// wait, but they use enough tokens to be detected for the next 500ms.
+std::int64_t constexpr kLimiterRate = 1024 * 1024;
+
+/// Post a payload with the given priority, using @p limiter for the transfer.
+void PostWithPriority(std::shared_ptr<BandwidthLimiter> const& limiter,
+                      RequestPriority const& priority) {
+  storage::internal::CurlRequestBuilder request(
+      HttpBinEndpoint() + "/post",
+      storage::internal::GetDefaultCurlHandleFactory());
+  auto options =
+      ClientOptions(std::make_shared<storage::oauth2::AnonymousCredentials>())
+          .set_bandwidth_limiter(limiter);
+  request.ApplyClientOptions(options);
+  request.AddOption(priority);
+  request.AddHeader("Content-Type: application/octet-stream");
+
+  std::string const payload(kLimiterRate / 2, 'x');
+  auto response = request.BuildRequest().MakeRequest(payload);
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ(200, response->status_code);
+  nl::json parsed = nl::json::parse(response->payload);
+  EXPECT_EQ(payload, parsed["data"].get<std::string>());
+}
+
+/// @test Verify that high priority requests are not throttled.
+TEST(CurlRequestTest, HighPrioritySkipsBandwidthLimiter) {
+  auto limiter = std::make_shared<BandwidthLimiter>(kLimiterRate, kLimiterRate);
+  PostWithPriority(limiter, HighPriority());
+
+  // A full bucket has tokens for one second of transfers without waiting.
+  EXPECT_EQ(std::chrono::microseconds(0), limiter->ReserveUpload(kLimiterRate));
+  EXPECT_EQ(std::chrono::microseconds(0),
+            limiter->ReserveDownload(kLimiterRate));
+}
+
+/// @test Verify that normal priority requests are throttled.
+TEST(CurlRequestTest, NormalPriorityUsesBandwidthLimiter) {
+  auto limiter = std::make_shared<BandwidthLimiter>(kLimiterRate, kLimiterRate);
+  PostWithPriority(limiter, NormalPriority());
+
+  EXPECT_LT(std::chrono::microseconds(0), limiter->ReserveUpload(kLimiterRate));
+  EXPECT_LT(std::chrono::microseconds(0),
+            limiter->ReserveDownload(kLimiterRate));
+}
+
+/// @test Verify that uploads are throttled by the bandwidth limiter.
+TEST(CurlRequestTest, UploadBandwidthLimit) {
+  std::int64_t const rate = 128 * 1024;
+  auto limiter = std::make_shared<BandwidthLimiter>(rate, 0);
+  // Consume the initial burst, so the full upload is throttled.
+  (void)limiter->ReserveUpload(rate);
+
+  storage::internal::CurlRequestBuilder request(
+      HttpBinEndpoint() + "/post",
+      storage::internal::GetDefaultCurlHandleFactory());
+  auto options =
+      ClientOptions(std::make_shared<storage::oauth2::AnonymousCredentials>())
+          .set_bandwidth_limiter(limiter);
+  request.ApplyClientOptions(options);
+  request.AddHeader("Content-Type: application/octet-stream");
+
+  std::string const chars =
+      "abcdefghijklmnopqrstuvwxyz012456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  std::string payload;
+  for (int i = 0; i != 2 * rate; ++i) payload += chars[i % chars.size()];
+
+  auto const start = std::chrono::steady_clock::now();
+  auto response = request.BuildRequest().MakeRequest(payload);
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ(200, response->status_code);
+  nl::json parsed = nl::json::parse(response->payload);
+  EXPECT_TRUE(payload == parsed["data"].get<std::string>());
+
+  // The limiter rounds each wait down to a microsecond, allow for that.
+  auto const expected = std::chrono::seconds(payload.size() / rate);
+  EXPECT_LE(expected - std::chrono::milliseconds(1), elapsed);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -20,8 +20,12 @@ google_cloud_cpp_testing_grpc_hdrs = [
     "is_proto_equal.h",
     "mock_async_response_reader.h",
     "mock_completion_queue.h",
+    "simulated_completion_queue.h",
+    "simulated_service.h",
 ]
 
 google_cloud_cpp_testing_grpc_srcs = [
     "is_proto_equal.cc",
+    "simulated_completion_queue.cc",
+    "simulated_service.cc",
 ]
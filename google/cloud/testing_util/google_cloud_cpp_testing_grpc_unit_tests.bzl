@@ -18,4 +18,5 @@
 
 google_cloud_cpp_testing_grpc_unit_tests = [
     "is_proto_equal_test.cc",
+    "simulated_completion_queue_test.cc",
 ]
@@ -0,0 +1,66 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/testing_util/simulated_completion_queue.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+// Starting at the origin of the timers keeps the simulation independent of the
+// real time when it runs.
+SimulatedCompletionQueue::SimulatedCompletionQueue()
+    : start_(TimersOrigin()), now_(start_) {
+  UseManualTimers();
+}
+
+void SimulatedCompletionQueue::ScheduleAt(TimePoint when,
+                                          std::function<void()> event) {
+  events_.push_back(Event{(std::max)(when, now_), sequence_++,
+                          std::move(event)});
+  std::push_heap(events_.begin(), events_.end(), Later{});
+}
+
+std::size_t SimulatedCompletionQueue::RunUntil(TimePoint deadline) {
+  std::size_t count = 0;
+  for (;;) {
+    auto const timer = NextTimerWakeup();
+    bool const has_event = !events_.empty();
+    if (!timer && !has_event) break;
+    // Timers run before any event scheduled at the same time.
+    bool const run_timers =
+        timer.has_value() && (!has_event || *timer <= events_.front().when);
+    auto const when = run_timers ? *timer : events_.front().when;
+    if (when > deadline) break;
+    now_ = (std::max)(now_, when);
+    ++count;
+    if (run_timers) {
+      ExpireTimers();
+      continue;
+    }
+    std::pop_heap(events_.begin(), events_.end(), Later{});
+    auto callback = std::move(events_.back().callback);
+    events_.pop_back();
+    callback();
+  }
+  if (deadline != TimePoint::max()) now_ = (std::max)(now_, deadline);
+  return count;
+}
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,117 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_SIMULATED_COMPLETION_QUEUE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_SIMULATED_COMPLETION_QUEUE_H
+
+#include "google/cloud/internal/completion_queue_impl.h"
+#include "google/cloud/version.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+/**
+ * A completion queue driven by a virtual clock, used for simulations.
+ *
+ * The timers, and any events scheduled with `ScheduleAt()`, run in virtual
+ * time order from `RunUntil()`, in the calling thread. Hours of simulated
+ * traffic through the library retry, backoff and polling loops run in a few
+ * seconds, and two simulations with the same inputs produce the same results.
+ *
+ * Wrap the object in a `google::cloud::CompletionQueue` to use it with the
+ * library, but do not call `Run()` on that completion queue. Operations that
+ * need a real `grpc::CompletionQueue` are not supported, fake services should
+ * deliver their results using `ScheduleAt()`, see `SimulatedService`.
+ *
+ * Code that reads `std::chrono::system_clock` directly, such as
+ * `LimitedTimeRetryPolicy`, still uses the real clock. The timers have a
+ * resolution of 1ms.
+ *
+ * This class is not thread-safe, all the work happens in `RunUntil()`.
+ */
+class SimulatedCompletionQueue
+    : public google::cloud::internal::CompletionQueueImpl {
+ public:
+  using Clock = std::chrono::system_clock;
+  using TimePoint = Clock::time_point;
+
+  SimulatedCompletionQueue();
+
+  TimePoint Now() const override { return now_; }
+
+  /// The virtual time when the simulation started.
+  TimePoint start() const { return start_; }
+
+  /// The virtual time elapsed since the simulation started.
+  Clock::duration elapsed() const { return now_ - start_; }
+
+  /// Run @p event when the virtual clock reaches @p when.
+  void ScheduleAt(TimePoint when, std::function<void()> event);
+
+  /// Run @p event after @p delay in virtual time.
+  template <typename Rep, typename Period>
+  void ScheduleAfter(std::chrono::duration<Rep, Period> delay,
+                     std::function<void()> event) {
+    ScheduleAt(now_ + std::chrono::duration_cast<Clock::duration>(delay),
+               std::move(event));
+  }
+
+  /**
+   * Run the events and timers due at or before @p deadline.
+   *
+   * The virtual clock advances to each event in turn, and finally to
+   * @p deadline.
+   *
+   * @return the number of events and timer wheel steps processed.
+   */
+  std::size_t RunUntil(TimePoint deadline);
+
+  /// Run all the events and timers, including any created while running.
+  std::size_t RunUntilIdle() { return RunUntil(TimePoint::max()); }
+
+  /// The number of scheduled events, not including timers.
+  std::size_t pending_events() const { return events_.size(); }
+
+ private:
+  struct Event {
+    TimePoint when;
+    std::uint64_t sequence;
+    std::function<void()> callback;
+  };
+  /// Order the events in a heap, the earliest (then first scheduled) on top.
+  struct Later {
+    bool operator()(Event const& a, Event const& b) const {
+      if (a.when != b.when) return a.when > b.when;
+      return a.sequence > b.sequence;
+    }
+  };
+
+  TimePoint start_;
+  TimePoint now_;
+  std::uint64_t sequence_ = 0;
+  std::vector<Event> events_;
+};
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_SIMULATED_COMPLETION_QUEUE_H
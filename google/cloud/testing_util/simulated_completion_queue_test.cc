@@ -0,0 +1,175 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/testing_util/simulated_completion_queue.h"
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/internal/async_retry_unary_rpc.h"
+#include "google/cloud/internal/backoff_policy.h"
+#include "google/cloud/internal/retry_policy.h"
+#include "google/cloud/testing_util/simulated_service.h"
+#include <gmock/gmock.h>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+TEST(SimulatedCompletionQueueTest, RelativeTimerUsesVirtualClock) {
+  auto impl = std::make_shared<SimulatedCompletionQueue>();
+  CompletionQueue cq(impl);
+
+  auto timer = cq.MakeRelativeTimer(std::chrono::hours(2));
+  EXPECT_EQ(std::future_status::timeout,
+            timer.wait_for(std::chrono::milliseconds(0)));
+
+  EXPECT_LT(0, impl->RunUntilIdle());
+  EXPECT_EQ(std::future_status::ready,
+            timer.wait_for(std::chrono::milliseconds(0)));
+  auto expiration = timer.get();
+  ASSERT_TRUE(expiration.ok());
+  EXPECT_GE(impl->elapsed(), std::chrono::hours(2));
+  EXPECT_LE(impl->elapsed(),
+            std::chrono::hours(2) + std::chrono::milliseconds(1));
+  EXPECT_LE(*expiration, impl->Now());
+}
+
+TEST(SimulatedCompletionQueueTest, EventsRunInOrder) {
+  auto impl = std::make_shared<SimulatedCompletionQueue>();
+  std::vector<int> order;
+  auto record = [&order](int v) { return [&order, v] { order.push_back(v); }; };
+  impl->ScheduleAfter(std::chrono::milliseconds(30), record(4));
+  impl->ScheduleAfter(std::chrono::milliseconds(10), record(1));
+  impl->ScheduleAfter(std::chrono::milliseconds(20), record(3));
+  impl->ScheduleAfter(std::chrono::milliseconds(10), record(2));
+
+  EXPECT_EQ(2, impl->RunUntil(impl->start() + std::chrono::milliseconds(15)));
+  EXPECT_THAT(order, ElementsAre(1, 2));
+  EXPECT_EQ(std::chrono::milliseconds(15), impl->elapsed());
+  EXPECT_EQ(2, impl->pending_events());
+
+  EXPECT_EQ(2, impl->RunUntilIdle());
+  EXPECT_THAT(order, ElementsAre(1, 2, 3, 4));
+  EXPECT_EQ(std::chrono::milliseconds(30), impl->elapsed());
+}
+
+TEST(SimulatedCompletionQueueTest, CancelledTimer) {
+  auto impl = std::make_shared<SimulatedCompletionQueue>();
+  CompletionQueue cq(impl);
+
+  auto timer = cq.MakeRelativeTimer(std::chrono::hours(1));
+  timer.cancel();
+  impl->RunUntilIdle();
+  EXPECT_EQ(std::future_status::ready,
+            timer.wait_for(std::chrono::milliseconds(0)));
+  EXPECT_FALSE(timer.get().ok());
+  EXPECT_LT(impl->elapsed(), std::chrono::hours(1));
+}
+
+struct IsRetryableTraits {
+  static bool IsPermanentFailure(Status const& status) {
+    return !status.ok() && status.code() != StatusCode::kUnavailable;
+  }
+};
+
+using RetryPolicy =
+    google::cloud::internal::LimitedErrorCountRetryPolicy<Status,
+                                                          IsRetryableTraits>;
+
+/// `ExponentialBackoffPolicy` jitter is not reproducible, use a fixed delay.
+class FixedBackoffPolicy : public google::cloud::internal::BackoffPolicy {
+ public:
+  explicit FixedBackoffPolicy(std::chrono::milliseconds delay)
+      : delay_(delay) {}
+
+  std::unique_ptr<BackoffPolicy> clone() const override {
+    return std::unique_ptr<BackoffPolicy>(new FixedBackoffPolicy(delay_));
+  }
+  std::chrono::milliseconds OnCompletion() override { return delay_; }
+
+ private:
+  std::chrono::milliseconds delay_;
+};
+
+/// Send @p count requests, one every 10ms, retrying through an error burst.
+SimulationReport RunRetrySimulation(int count, std::uint64_t seed) {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  using std::chrono::milliseconds;
+
+  auto impl = std::make_shared<SimulatedCompletionQueue>();
+  CompletionQueue cq(impl);
+  SimulatedService<std::string, std::string> service(
+      impl, ExponentialLatency(microseconds(2000), microseconds(5000)),
+      [](std::string const& request) { return "response-" + request; },
+      {ErrorBurst{milliseconds(500), milliseconds(1500),
+                  Status(StatusCode::kUnavailable, "try-again"), 0.5}},
+      seed);
+
+  SimulationStats stats;
+  for (int i = 0; i != count; ++i) {
+    impl->ScheduleAfter(milliseconds(10 * i), [=, &stats]() mutable {
+      auto const start = impl->Now();
+      google::cloud::internal::StartRetryAsyncUnaryRpc(
+          cq, __func__, RetryPolicy(20).clone(),
+          FixedBackoffPolicy(milliseconds(50)).clone(),
+          /*is_idempotent=*/true,
+          [service](std::unique_ptr<grpc::ClientContext>,
+                    std::string const& request) mutable {
+            return service.Call(request);
+          },
+          std::to_string(i))
+          .then([impl, start, &stats](future<StatusOr<std::string>> f) {
+            stats.Record(duration_cast<microseconds>(impl->Now() - start),
+                         f.get().status());
+          });
+    });
+  }
+  impl->RunUntilIdle();
+  return stats.Report(service.calls(),
+                      duration_cast<microseconds>(impl->elapsed()));
+}
+
+TEST(SimulatedCompletionQueueTest, RetryThroughErrorBurst) {
+  auto const report = RunRetrySimulation(/*count=*/500, /*seed=*/42);
+  EXPECT_EQ(500, report.operations);
+  EXPECT_EQ(0, report.errors);
+  EXPECT_GT(report.retry_amplification(), 1.0);
+  EXPECT_GE(report.p99, std::chrono::milliseconds(50));
+  EXPECT_GE(report.elapsed, std::chrono::milliseconds(10 * 499));
+
+  std::ostringstream os;
+  os << report;
+  EXPECT_THAT(os.str(), HasSubstr("operations=500"));
+  EXPECT_THAT(os.str(), HasSubstr("errors=0"));
+}
+
+TEST(SimulatedCompletionQueueTest, Reproducible) {
+  auto const a = RunRetrySimulation(/*count=*/200, /*seed=*/7);
+  auto const b = RunRetrySimulation(/*count=*/200, /*seed=*/7);
+  EXPECT_EQ(a.attempts, b.attempts);
+  EXPECT_EQ(a.p50, b.p50);
+  EXPECT_EQ(a.p99, b.p99);
+  EXPECT_EQ(a.max, b.max);
+}
+
+}  // namespace
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
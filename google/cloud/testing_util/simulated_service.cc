@@ -0,0 +1,84 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/testing_util/simulated_service.h"
+#include <algorithm>
+#include <iostream>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+LatencyModel FixedLatency(std::chrono::microseconds latency) {
+  return [latency](internal::DefaultPRNG&) { return latency; };
+}
+
+LatencyModel ExponentialLatency(std::chrono::microseconds minimum,
+                                std::chrono::microseconds mean) {
+  auto const excess = (std::max)(mean - minimum, std::chrono::microseconds(1));
+  return [minimum, excess](internal::DefaultPRNG& generator) {
+    std::exponential_distribution<double> d(1.0 / excess.count());
+    return minimum +
+           std::chrono::microseconds(static_cast<std::int64_t>(d(generator)));
+  };
+}
+
+double SimulationReport::throughput() const {
+  if (elapsed.count() <= 0) return 0.0;
+  auto const seconds =
+      std::chrono::duration_cast<std::chrono::duration<double>>(elapsed);
+  return static_cast<double>(operations - errors) / seconds.count();
+}
+
+double SimulationReport::retry_amplification() const {
+  if (operations == 0) return 0.0;
+  return static_cast<double>(attempts) / static_cast<double>(operations);
+}
+
+std::ostream& operator<<(std::ostream& os, SimulationReport const& rhs) {
+  return os << "operations=" << rhs.operations << ", errors=" << rhs.errors
+            << ", attempts=" << rhs.attempts
+            << ", elapsed=" << rhs.elapsed.count() << "us"
+            << ", p50=" << rhs.p50.count() << "us"
+            << ", p99=" << rhs.p99.count() << "us"
+            << ", max=" << rhs.max.count() << "us"
+            << ", throughput=" << rhs.throughput() << "/s"
+            << ", retry_amplification=" << rhs.retry_amplification();
+}
+
+void SimulationStats::Record(std::chrono::microseconds latency,
+                             Status const& status) {
+  latencies_.push_back(latency);
+  if (!status.ok()) ++errors_;
+}
+
+SimulationReport SimulationStats::Report(
+    std::uint64_t attempts, std::chrono::microseconds elapsed) const {
+  auto sorted = latencies_;
+  std::sort(sorted.begin(), sorted.end());
+  auto percentile = [&sorted](double p) {
+    if (sorted.empty()) return std::chrono::microseconds(0);
+    auto index = static_cast<std::size_t>(p * (sorted.size() - 1));
+    return sorted[index];
+  };
+  return SimulationReport{sorted.size(), errors_,         attempts,
+                          elapsed,       percentile(0.5), percentile(0.99),
+                          percentile(1.0)};
+}
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
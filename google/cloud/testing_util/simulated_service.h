@@ -0,0 +1,173 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_SIMULATED_SERVICE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_SIMULATED_SERVICE_H
+
+#include "google/cloud/future.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/testing_util/simulated_completion_queue.h"
+#include "google/cloud/version.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+/// Returns the latency of a simulated request.
+using LatencyModel =
+    std::function<std::chrono::microseconds(internal::DefaultPRNG&)>;
+
+/// A latency model where all requests take @p latency.
+LatencyModel FixedLatency(std::chrono::microseconds latency);
+
+/// A latency model with an exponential distribution above @p minimum.
+LatencyModel ExponentialLatency(std::chrono::microseconds minimum,
+                                std::chrono::microseconds mean);
+
+/**
+ * A period of time where a simulated service fails some requests.
+ *
+ * The times are relative to the start of the simulation. Requests starting in
+ * `[start, end)` fail with `status` with the given `probability`.
+ */
+struct ErrorBurst {
+  std::chrono::microseconds start;
+  std::chrono::microseconds end;
+  Status status;
+  double probability;
+};
+
+/**
+ * A fake service for simulations with a `SimulatedCompletionQueue`.
+ *
+ * Each call completes after a delay sampled from the latency model, in virtual
+ * time. The calls fail as configured by the error bursts, otherwise they
+ * succeed with the value returned by the responder. The random number
+ * generator is seeded explicitly, so simulations are reproducible.
+ *
+ * To use this service with `internal::StartRetryAsyncUnaryRpc()` wrap `Call()`
+ * in a functor receiving a `std::unique_ptr<grpc::ClientContext>` and the
+ * request.
+ */
+template <typename Request, typename Response>
+class SimulatedService {
+ public:
+  using Responder = std::function<Response(Request const&)>;
+
+  SimulatedService(std::shared_ptr<SimulatedCompletionQueue> cq,
+                   LatencyModel latency, Responder responder,
+                   std::vector<ErrorBurst> bursts = {},
+                   internal::DefaultPRNG::result_type seed = 0)
+      : state_(std::make_shared<State>(State{
+            std::move(cq), std::move(latency), std::move(responder),
+            std::move(bursts), internal::DefaultPRNG(seed), 0, 0})) {}
+
+  future<StatusOr<Response>> Call(Request const& request) {
+    auto state = state_;
+    ++state->calls;
+    auto const latency = state->latency(state->generator);
+    auto status = Fail(*state);
+    if (!status.ok()) ++state->failures;
+    promise<StatusOr<Response>> p;
+    auto f = p.get_future();
+    auto response =
+        status.ok() ? StatusOr<Response>(state->responder(request))
+                    : StatusOr<Response>(std::move(status));
+    // `std::function<>` requires copyable callables, share the promise.
+    auto shared = std::make_shared<promise<StatusOr<Response>>>(std::move(p));
+    state->cq->ScheduleAfter(latency, [shared, response] {
+      shared->set_value(std::move(response));
+    });
+    return f;
+  }
+
+  /// The number of calls made to this service.
+  std::uint64_t calls() const { return state_->calls; }
+
+  /// The number of calls that failed due to an error burst.
+  std::uint64_t failures() const { return state_->failures; }
+
+ private:
+  struct State {
+    std::shared_ptr<SimulatedCompletionQueue> cq;
+    LatencyModel latency;
+    Responder responder;
+    std::vector<ErrorBurst> bursts;
+    internal::DefaultPRNG generator;
+    std::uint64_t calls;
+    std::uint64_t failures;
+  };
+
+  static Status Fail(State& state) {
+    auto const now = state.cq->elapsed();
+    for (auto const& b : state.bursts) {
+      if (now < b.start || now >= b.end) continue;
+      if (std::uniform_real_distribution<double>(0, 1)(state.generator) <
+          b.probability) {
+        return b.status;
+      }
+    }
+    return Status{};
+  }
+
+  std::shared_ptr<State> state_;
+};
+
+/// The result of a simulation, see `SimulationStats`.
+struct SimulationReport {
+  std::uint64_t operations;
+  std::uint64_t errors;
+  std::uint64_t attempts;
+  std::chrono::microseconds elapsed;
+  std::chrono::microseconds p50;
+  std::chrono::microseconds p99;
+  std::chrono::microseconds max;
+
+  /// Successful operations per second of virtual time.
+  double throughput() const;
+
+  /// The number of attempts per operation, 1.0 means no retries.
+  double retry_amplification() const;
+};
+
+std::ostream& operator<<(std::ostream& os, SimulationReport const& rhs);
+
+/// Collects the latency of each operation in a simulation.
+class SimulationStats {
+ public:
+  void Record(std::chrono::microseconds latency, Status const& status);
+
+  /// Produce the report, @p attempts is typically `SimulatedService::calls()`.
+  SimulationReport Report(std::uint64_t attempts,
+                          std::chrono::microseconds elapsed) const;
+
+ private:
+  std::vector<std::chrono::microseconds> latencies_;
+  std::uint64_t errors_ = 0;
+};
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_SIMULATED_SERVICE_H